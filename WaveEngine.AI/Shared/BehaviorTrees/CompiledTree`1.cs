@@ -0,0 +1,151 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace WaveEngine.AI.BehaviorTrees
+{
+    /// <summary>
+    /// Represents a flattened, read only version of a behavior tree.
+    /// </summary>
+    /// <remarks>
+    /// Nodes are stored in breadth-first order so the children of every node are contiguous in the array.
+    /// A compiled tree can be shared by any number of evaluators, even from several threads at once.
+    /// </remarks>
+    /// <typeparam name="T">The type of elements a behavior tree will contain</typeparam>
+    public sealed class CompiledTree<T>
+        where T : NodeInfo
+    {
+        /// <summary>
+        /// Child count used to mark a leaf node
+        /// </summary>
+        private const int LeafChildCount = -1;
+
+        /// <summary>
+        /// The flattened nodes
+        /// </summary>
+        private readonly Node<T>[] nodes;
+
+        /// <summary>
+        /// The index of the first child of each node
+        /// </summary>
+        private readonly int[] firstChild;
+
+        /// <summary>
+        /// The number of children of each node, or <see cref="LeafChildCount"/> for leaf nodes
+        /// </summary>
+        private readonly int[] childCount;
+
+        /// <summary>
+        /// The root node
+        /// </summary>
+        private readonly Node<T> root;
+
+        /// <summary>
+        /// Gets the root node of the source tree.
+        /// </summary>
+        public Node<T> Root
+        {
+            get { return this.root; }
+        }
+
+        /// <summary>
+        /// Gets the number of nodes of the tree.
+        /// </summary>
+        public int Count
+        {
+            get { return this.nodes.Length; }
+        }
+
+        /// <summary>
+        /// Gets the node at the specified index.
+        /// </summary>
+        /// <param name="index">The node index.</param>
+        /// <returns>The node</returns>
+        public Node<T> this[int index]
+        {
+            get { return this.nodes[index]; }
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CompiledTree{T}"/> class.
+        /// </summary>
+        /// <remarks>
+        /// Later changes in the children of the source nodes are not reflected in the compiled tree.
+        /// </remarks>
+        /// <param name="root">The root node of the tree.</param>
+        public CompiledTree(Node<T> root)
+        {
+            if (root == null)
+            {
+                throw new ArgumentNullException("root");
+            }
+
+            this.root = root;
+
+            var nodeList = new List<Node<T>>();
+            var firstChildList = new List<int>();
+            var childCountList = new List<int>();
+
+            nodeList.Add(root);
+
+            for (int i = 0; i < nodeList.Count; i++)
+            {
+                var children = nodeList[i].Children;
+
+                firstChildList.Add(nodeList.Count);
+
+                if (children == null)
+                {
+                    childCountList.Add(LeafChildCount);
+                }
+                else
+                {
+                    childCountList.Add(children.Count);
+                    nodeList.AddRange(children);
+                }
+            }
+
+            this.nodes = nodeList.ToArray();
+            this.firstChild = firstChildList.ToArray();
+            this.childCount = childCountList.ToArray();
+        }
+
+        /// <summary>
+        /// Evaluates the tree and finds the leaf node to execute.
+        /// </summary>
+        /// <param name="nodeInfo">The node information.</param>
+        /// <param name="stack">The evaluation stack. Its length must be at least <see cref="Count"/>.</param>
+        /// <returns>The index of the leaf node reached, or -1 if no leaf node has been reached.</returns>
+        public int Evaluate(T nodeInfo, int[] stack)
+        {
+            int top = 0;
+            stack[top++] = 0;
+
+            while (top > 0)
+            {
+                int current = stack[--top];
+
+                if (this.nodes[current].Evaluate(nodeInfo))
+                {
+                    int count = this.childCount[current];
+
+                    if (count == LeafChildCount)
+                    {
+                        return current;
+                    }
+
+                    int first = this.firstChild[current];
+                    for (int i = first + count - 1; i >= first; i--)
+                    {
+                        stack[top++] = i;
+                    }
+                }
+            }
+
+            return -1;
+        }
+    }
+}
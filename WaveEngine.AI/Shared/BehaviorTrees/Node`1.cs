@@ -4,6 +4,7 @@ using System;
 using System.Collections.Generic;
 using System.Linq;
 using System.Text;
+using System.Threading;
 using WaveEngine.Framework;
 
 namespace WaveEngine.AI.BehaviorTrees
@@ -15,11 +16,31 @@ namespace WaveEngine.AI.BehaviorTrees
     public abstract class Node<T>
         where T : NodeInfo
     {
+        /// <summary>
+        /// The version of the structure of the trees, incremented every time a child is added to a node
+        /// </summary>
+        private static int structureVersion;
+
         /// <summary>
         /// The children of the node
         /// </summary>
+        /// <remarks>
+        /// Changes made directly to this list are not tracked, call <see cref="TreeExecutorBehavior{T}.Recompile"/>
+        /// after them. Use <see cref="AddChild(Node{T})"/> to have the executors pick the new children up.
+        /// </remarks>
         public List<Node<T>> Children;
 
+        /// <summary>
+        /// Gets the version of the structure of the trees of this node type.
+        /// </summary>
+        internal static int StructureVersion
+        {
+            get
+            {
+                return Volatile.Read(ref structureVersion);
+            }
+        }
+
         /// <summary>
         /// Adds a child to the node
         /// </summary>
@@ -33,6 +54,7 @@ namespace WaveEngine.AI.BehaviorTrees
             }
 
             this.Children.Add(children);
+            Interlocked.Increment(ref structureVersion);
             return this;
         }
 
@@ -0,0 +1,196 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using WaveEngine.Framework;
+
+namespace WaveEngine.AI.BehaviorTrees
+{
+    /// <summary>
+    /// Represents a scene behavior that ticks the behavior trees of many entities at once.
+    /// </summary>
+    /// <remarks>
+    /// The evaluation phase of the registered trees runs in parallel, so <see cref="Node{T}.Evaluate(T)"/>
+    /// implementations must only read shared state. The execution phase runs on the main thread in registration order.
+    /// All the trees are evaluated before any of them is executed, so unlike <see cref="TreeExecutorBehavior{T}.Execute(TimeSpan)"/>,
+    /// an evaluation does not see the changes made by the execution of the trees registered before it in the same frame.
+    /// Executors added or removed while the trees are ticked take effect on the next frame.
+    /// </remarks>
+    /// <typeparam name="T">The type of elements a behavior tree will contain</typeparam>
+    public class TreeBatchExecutor<T> : SceneBehavior
+        where T : NodeInfo
+    {
+        /// <summary>
+        /// The minimum number of pending evaluations needed to evaluate in parallel
+        /// </summary>
+        private const int DefaultParallelThreshold = 64;
+
+        /// <summary>
+        /// The registered executors
+        /// </summary>
+        private List<TreeExecutorBehavior<T>> executors;
+
+        /// <summary>
+        /// The executors registered when the current frame started
+        /// </summary>
+        private TreeExecutorBehavior<T>[] batch;
+
+        /// <summary>
+        /// The executors that need to be evaluated this frame
+        /// </summary>
+        private TreeExecutorBehavior<T>[] pending;
+
+        /// <summary>
+        /// The game time of the current frame
+        /// </summary>
+        private TimeSpan currentGameTime;
+
+        /// <summary>
+        /// The cached evaluation delegate
+        /// </summary>
+        private Action<int> evaluateAction;
+
+        /// <summary>
+        /// Gets or sets the minimum number of pending evaluations needed to evaluate in parallel.
+        /// </summary>
+        public int ParallelThreshold { get; set; }
+
+        /// <summary>
+        /// Gets the number of registered executors.
+        /// </summary>
+        public int Count
+        {
+            get { return this.executors.Count; }
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TreeBatchExecutor{T}"/> class.
+        /// </summary>
+        public TreeBatchExecutor()
+        {
+            this.executors = new List<TreeExecutorBehavior<T>>();
+            this.batch = new TreeExecutorBehavior<T>[0];
+            this.pending = new TreeExecutorBehavior<T>[0];
+            this.evaluateAction = this.EvaluatePending;
+            this.ParallelThreshold = DefaultParallelThreshold;
+        }
+
+        /// <summary>
+        /// Registers a tree executor. Registered executors are no longer ticked by their own update.
+        /// </summary>
+        /// <param name="executor">The tree executor.</param>
+        public void Add(TreeExecutorBehavior<T> executor)
+        {
+            if (executor == null)
+            {
+                throw new ArgumentNullException("executor");
+            }
+
+            if (executor.BatchExecutor != null)
+            {
+                throw new InvalidOperationException("The tree executor is already registered in a batch executor");
+            }
+
+            executor.BatchExecutor = this;
+            this.executors.Add(executor);
+        }
+
+        /// <summary>
+        /// Unregisters a tree executor.
+        /// </summary>
+        /// <param name="executor">The tree executor.</param>
+        /// <returns>True if the executor has been removed, false in other case</returns>
+        public bool Remove(TreeExecutorBehavior<T> executor)
+        {
+            if (executor == null || executor.BatchExecutor != this)
+            {
+                return false;
+            }
+
+            executor.BatchExecutor = null;
+            return this.executors.Remove(executor);
+        }
+
+        /// <summary>
+        /// Evaluates all the registered trees that need it and executes their current nodes.
+        /// </summary>
+        /// <param name="gameTime">The game time.</param>
+        public void Execute(TimeSpan gameTime)
+        {
+            int count = this.executors.Count;
+            if (this.batch.Length < count)
+            {
+                this.batch = new TreeExecutorBehavior<T>[count];
+                this.pending = new TreeExecutorBehavior<T>[count];
+            }
+
+            // Executors can be added or removed by the execution of a node, so the frame iterates over a copy
+            this.executors.CopyTo(this.batch);
+
+            int pendingCount = 0;
+            for (int i = 0; i < count; i++)
+            {
+                var executor = this.batch[i];
+                if (executor.IsActive && executor.NodeInfo.EvaluateTree)
+                {
+                    this.pending[pendingCount++] = executor;
+                }
+            }
+
+            this.currentGameTime = gameTime;
+
+            if (pendingCount >= this.ParallelThreshold)
+            {
+                Parallel.For(0, pendingCount, this.evaluateAction);
+            }
+            else
+            {
+                for (int i = 0; i < pendingCount; i++)
+                {
+                    this.EvaluatePending(i);
+                }
+            }
+
+            Array.Clear(this.pending, 0, pendingCount);
+
+            for (int i = 0; i < count; i++)
+            {
+                var executor = this.batch[i];
+                if (executor.BatchExecutor == this && executor.IsActive)
+                {
+                    executor.ExecuteCurrentNode();
+                }
+            }
+
+            Array.Clear(this.batch, 0, count);
+        }
+
+        /// <summary>
+        /// Resolves the dependencies.
+        /// </summary>
+        protected override void ResolveDependencies()
+        {
+        }
+
+        /// <summary>
+        /// Updates the registered trees.
+        /// </summary>
+        /// <param name="gameTime">The game time.</param>
+        protected override void Update(TimeSpan gameTime)
+        {
+            this.Execute(gameTime);
+        }
+
+        /// <summary>
+        /// Evaluates a pending executor.
+        /// </summary>
+        /// <param name="index">The index of the pending executor.</param>
+        private void EvaluatePending(int index)
+        {
+            this.pending[index].EvaluateTree(this.currentGameTime);
+        }
+    }
+}
@@ -19,6 +19,16 @@ namespace WaveEngine.AI.BehaviorTrees
         /// </summary>
         public Node<T> CurrentNode;
 
+        /// <summary>
+        /// The stack reused by <see cref="Evaluate(T, Node{T})"/>
+        /// </summary>
+        private Stack<Node<T>> stack = new Stack<Node<T>>();
+
+        /// <summary>
+        /// The index stack reused by <see cref="Evaluate(T, CompiledTree{T})"/>
+        /// </summary>
+        private int[] indexStack;
+
         /// <summary>
         /// Evaluates the given tree and find the current node.
         /// </summary>
@@ -26,11 +36,12 @@ namespace WaveEngine.AI.BehaviorTrees
         /// <param name="tree">The tree behavior.</param>
         public void Evaluate(T nodeInfo, Node<T> tree)
         {
-            var stack = new Stack<Node<T>>();
+            var stack = this.stack;
+            stack.Clear();
 
             stack.Push(tree);
 
-            while (stack.Any())
+            while (stack.Count > 0)
             {
                 var current = stack.Pop();
                 if (current.Evaluate(nodeInfo))
@@ -51,5 +62,27 @@ namespace WaveEngine.AI.BehaviorTrees
                 }
             }
         }
+
+        /// <summary>
+        /// Evaluates the given compiled tree and find the current node.
+        /// </summary>
+        /// <remarks>
+        /// This method does not allocate once the evaluator has been used with a tree of the same size.
+        /// </remarks>
+        /// <param name="nodeInfo">The node information.</param>
+        /// <param name="tree">The compiled tree behavior.</param>
+        public void Evaluate(T nodeInfo, CompiledTree<T> tree)
+        {
+            if (this.indexStack == null || this.indexStack.Length < tree.Count)
+            {
+                this.indexStack = new int[tree.Count];
+            }
+
+            int index = tree.Evaluate(nodeInfo, this.indexStack);
+            if (index >= 0)
+            {
+                this.CurrentNode = tree[index];
+            }
+        }
     }
 }
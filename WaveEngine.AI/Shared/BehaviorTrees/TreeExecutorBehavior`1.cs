@@ -31,6 +31,21 @@ namespace WaveEngine.AI.BehaviorTrees
         /// </summary>
         private Node<T> tree;
 
+        /// <summary>
+        /// The compiled version of the tree
+        /// </summary>
+        private CompiledTree<T> compiledTree;
+
+        /// <summary>
+        /// The <see cref="Node{T}.StructureVersion"/> the tree was compiled with
+        /// </summary>
+        private int compiledVersion;
+
+        /// <summary>
+        /// The batch executor this behavior is registered in
+        /// </summary>
+        internal TreeBatchExecutor<T> BatchExecutor;
+
         /// <summary>
         /// The node information
         /// </summary>
@@ -39,6 +54,11 @@ namespace WaveEngine.AI.BehaviorTrees
         /// <summary>
         /// Gets or sets the behavior tree.
         /// </summary>
+        /// <remarks>
+        /// The tree is compiled on its next evaluation, and compiled again when children are added
+        /// with <see cref="Node{T}.AddChild(Node{T})"/>. Call <see cref="Recompile"/> after changing
+        /// a <see cref="Node{T}.Children"/> list directly.
+        /// </remarks>
         /// <value>
         /// The tree.
         /// </value>
@@ -53,6 +73,7 @@ namespace WaveEngine.AI.BehaviorTrees
             {
                 this.validator.Validate(value);
                 this.tree = value;
+                this.compiledTree = null;
             }
         }
 
@@ -84,6 +105,16 @@ namespace WaveEngine.AI.BehaviorTrees
             this.evaluator = treeEvaluator;
         }
 
+        /// <summary>
+        /// Compiles the tree again, picking up the changes made to its nodes.
+        /// </summary>
+        public void Recompile()
+        {
+            this.validator.Validate(this.tree);
+            this.compiledVersion = Node<T>.StructureVersion;
+            this.compiledTree = new CompiledTree<T>(this.tree);
+        }
+
         /// <summary>
         /// Initializes this instance.
         /// </summary>
@@ -92,13 +123,29 @@ namespace WaveEngine.AI.BehaviorTrees
             base.Initialize();
         }
 
+        /// <summary>
+        /// Unregisters the behavior from its batch executor.
+        /// </summary>
+        protected override void DeleteDependencies()
+        {
+            if (this.BatchExecutor != null)
+            {
+                this.BatchExecutor.Remove(this);
+            }
+
+            base.DeleteDependencies();
+        }
+
         /// <summary>
         /// The update
         /// </summary>
         /// <param name="gameTime">The game time.</param>
         protected override void Update(TimeSpan gameTime)
         {
-            this.Execute(gameTime);
+            if (this.BatchExecutor == null)
+            {
+                this.Execute(gameTime);
+            }
         }
 
         /// <summary>
@@ -109,11 +156,33 @@ namespace WaveEngine.AI.BehaviorTrees
         {
             if (this.NodeInfo.EvaluateTree)
             {
-                this.NodeInfo.GameTime = gameTime;
-                this.evaluator.Evaluate(this.NodeInfo, this.Tree);
-                this.NodeInfo.EvaluateTree = false;
+                this.EvaluateTree(gameTime);
             }
 
+            this.ExecuteCurrentNode();
+        }
+
+        /// <summary>
+        /// Evaluates the tree of the entity to find the node to execute.
+        /// </summary>
+        /// <param name="gameTime">The game time.</param>
+        internal void EvaluateTree(TimeSpan gameTime)
+        {
+            if (this.compiledTree == null || this.compiledVersion != Node<T>.StructureVersion)
+            {
+                this.Recompile();
+            }
+
+            this.NodeInfo.GameTime = gameTime;
+            this.evaluator.Evaluate(this.NodeInfo, this.compiledTree);
+            this.NodeInfo.EvaluateTree = false;
+        }
+
+        /// <summary>
+        /// Executes the current node of the tree.
+        /// </summary>
+        internal void ExecuteCurrentNode()
+        {
             if (this.evaluator.CurrentNode != null)
             {
                 this.evaluator.CurrentNode.Execute(this.NodeInfo);
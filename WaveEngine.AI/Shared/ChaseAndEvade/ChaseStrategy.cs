@@ -11,7 +11,7 @@ namespace WaveEngine.AI.ChaseAndEvade
     /// <summary>
     /// Chase strategy base class
     /// </summary>
-    public abstract class ChaseStrategy : Component
+    public abstract class ChaseStrategy : ProximityStrategy
     {
         /// <summary>
         /// Checks if the target is detected
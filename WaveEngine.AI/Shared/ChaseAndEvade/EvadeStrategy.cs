@@ -11,7 +11,7 @@ namespace WaveEngine.AI.ChaseAndEvade
     /// <summary>
     /// The evade strategy base Component
     /// </summary>
-    public abstract class EvadeStrategy : Component
+    public abstract class EvadeStrategy : ProximityStrategy
     {
         /// <summary>
         /// Executes the evade strategy.
@@ -0,0 +1,800 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using WaveEngine.Common;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework;
+using WaveEngine.Framework.Graphics;
+
+namespace WaveEngine.AI.ChaseAndEvade
+{
+    /// <summary>
+    /// Service that keeps a spatial hash of registered entities to answer radius and nearest neighbor queries.
+    /// </summary>
+    /// <remarks>
+    /// The hash is rebuilt once per frame from the entity transforms, so query results reflect the positions
+    /// at the beginning of the frame. Entities are stored sorted by cell in flat arrays to keep queries cache friendly.
+    /// </remarks>
+    public class ProximityService : UpdatableService
+    {
+        /// <summary>
+        /// The default cell size
+        /// </summary>
+        private const float DefaultCellSize = 100;
+
+        /// <summary>
+        /// The minimum number of hash buckets
+        /// </summary>
+        private const int MinBucketCount = 16;
+
+        /// <summary>
+        /// The registered members
+        /// </summary>
+        private List<Member> members;
+
+        /// <summary>
+        /// The index of each registered entity in the members list
+        /// </summary>
+        private Dictionary<Entity, int> memberIndices;
+
+        /// <summary>
+        /// The first sorted entry of each bucket. Has one extra element with the total count.
+        /// </summary>
+        private int[] bucketStart;
+
+        /// <summary>
+        /// The sorted entry positions
+        /// </summary>
+        private Vector3[] positions;
+
+        /// <summary>
+        /// The sorted entry cell coordinates
+        /// </summary>
+        private CellCoordinates[] cells;
+
+        /// <summary>
+        /// The sorted entry entities
+        /// </summary>
+        private Entity[] entities;
+
+        /// <summary>
+        /// The sorted entry groups
+        /// </summary>
+        private int[] groups;
+
+        /// <summary>
+        /// Scratch buffer with the bucket of every member
+        /// </summary>
+        private int[] memberBuckets;
+
+        /// <summary>
+        /// Scratch buffer with the position of every member
+        /// </summary>
+        private Vector3[] memberPositions;
+
+        /// <summary>
+        /// Scratch buffer with the cell of every member
+        /// </summary>
+        private CellCoordinates[] memberCells;
+
+        /// <summary>
+        /// Scratch buffer with the entries of the nearest query candidates
+        /// </summary>
+        private int[] candidateEntries;
+
+        /// <summary>
+        /// Scratch buffer with the squared distances of the nearest query candidates
+        /// </summary>
+        private float[] candidateDistances;
+
+        /// <summary>
+        /// The number of entries of the hash
+        /// </summary>
+        private int entryCount;
+
+        /// <summary>
+        /// The minimum corner of the entries bounding box
+        /// </summary>
+        private Vector3 boundsMin;
+
+        /// <summary>
+        /// The maximum corner of the entries bounding box
+        /// </summary>
+        private Vector3 boundsMax;
+
+        /// <summary>
+        /// The cell size
+        /// </summary>
+        private float cellSize;
+
+        /// <summary>
+        /// Gets or sets the size of the hash cells. A good value is the most common query radius.
+        /// </summary>
+        public float CellSize
+        {
+            get
+            {
+                return this.cellSize;
+            }
+
+            set
+            {
+                if (value <= 0)
+                {
+                    throw new ArgumentOutOfRangeException("value", "Cell size must be greater than zero");
+                }
+
+                this.cellSize = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of registered entities.
+        /// </summary>
+        public int Count
+        {
+            get { return this.members.Count; }
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="ProximityService"/> class.
+        /// </summary>
+        public ProximityService()
+        {
+            this.members = new List<Member>();
+            this.memberIndices = new Dictionary<Entity, int>();
+            this.bucketStart = new int[MinBucketCount + 1];
+            this.positions = new Vector3[0];
+            this.cells = new CellCoordinates[0];
+            this.entities = new Entity[0];
+            this.groups = new int[0];
+            this.memberBuckets = new int[0];
+            this.memberPositions = new Vector3[0];
+            this.memberCells = new CellCoordinates[0];
+            this.candidateEntries = new int[0];
+            this.candidateDistances = new float[0];
+            this.cellSize = DefaultCellSize;
+        }
+
+        /// <summary>
+        /// Registers an entity. The entity needs a <see cref="Transform2D"/> or a <see cref="Transform3D"/> component.
+        /// </summary>
+        /// <remarks>
+        /// Registrations are counted, so several components can register the same entity.
+        /// The entity belongs to the groups of all its registrations and stays registered until every registration is removed.
+        /// </remarks>
+        /// <param name="entity">The entity.</param>
+        /// <param name="group">The group bit of the entity, used to filter queries.</param>
+        public void Register(Entity entity, int group)
+        {
+            if (entity == null)
+            {
+                throw new ArgumentNullException("entity");
+            }
+
+            int index;
+            if (this.memberIndices.TryGetValue(entity, out index))
+            {
+                var registered = this.members[index];
+                registered.Registrations.Add(group);
+                registered.Group |= group;
+                this.members[index] = registered;
+                return;
+            }
+
+            var member = new Member()
+            {
+                Entity = entity,
+                Group = group,
+                Registrations = new List<int>() { group },
+                Transform2D = entity.FindComponent<Transform2D>(),
+            };
+
+            if (member.Transform2D == null)
+            {
+                member.Transform3D = entity.FindComponent<Transform3D>();
+
+                if (member.Transform3D == null)
+                {
+                    throw new Exception(entity.Name + " entity need a Transform2D or Transform3D component");
+                }
+            }
+
+            this.memberIndices.Add(entity, this.members.Count);
+            this.members.Add(member);
+        }
+
+        /// <summary>
+        /// Removes one registration of an entity. The entity is unregistered when it has no registrations left.
+        /// </summary>
+        /// <param name="entity">The entity.</param>
+        /// <param name="group">The group the entity was registered with.</param>
+        /// <returns>True if the entity had a registration with the group, false in other case</returns>
+        public bool Unregister(Entity entity, int group)
+        {
+            int index;
+            if (entity == null || !this.memberIndices.TryGetValue(entity, out index))
+            {
+                return false;
+            }
+
+            var member = this.members[index];
+            if (!member.Registrations.Remove(group))
+            {
+                return false;
+            }
+
+            if (member.Registrations.Count == 0)
+            {
+                this.RemoveMember(index);
+                return true;
+            }
+
+            member.Group = 0;
+            for (int i = 0; i < member.Registrations.Count; i++)
+            {
+                member.Group |= member.Registrations[i];
+            }
+
+            this.members[index] = member;
+            return true;
+        }
+
+        /// <summary>
+        /// Unregisters an entity, removing all its registrations.
+        /// </summary>
+        /// <param name="entity">The entity.</param>
+        /// <returns>True if the entity was registered, false in other case</returns>
+        public bool Unregister(Entity entity)
+        {
+            int index;
+            if (entity == null || !this.memberIndices.TryGetValue(entity, out index))
+            {
+                return false;
+            }
+
+            this.RemoveMember(index);
+            return true;
+        }
+
+        /// <summary>
+        /// Rebuilds the spatial hash from the current positions of the registered entities.
+        /// </summary>
+        public void Rebuild()
+        {
+            int count = this.members.Count;
+            this.EnsureCapacity(count);
+
+            int bucketCount = MinBucketCount;
+            while (bucketCount < count * 2)
+            {
+                bucketCount <<= 1;
+            }
+
+            if (this.bucketStart.Length != bucketCount + 1)
+            {
+                this.bucketStart = new int[bucketCount + 1];
+            }
+            else
+            {
+                Array.Clear(this.bucketStart, 0, this.bucketStart.Length);
+            }
+
+            float inverseCellSize = 1 / this.cellSize;
+            int mask = bucketCount - 1;
+            var min = new Vector3(float.MaxValue, float.MaxValue, float.MaxValue);
+            var max = new Vector3(float.MinValue, float.MinValue, float.MinValue);
+
+            // Count the members of every bucket
+            for (int i = 0; i < count; i++)
+            {
+                var position = this.members[i].GetPosition();
+                min.X = Math.Min(min.X, position.X);
+                min.Y = Math.Min(min.Y, position.Y);
+                min.Z = Math.Min(min.Z, position.Z);
+                max.X = Math.Max(max.X, position.X);
+                max.Y = Math.Max(max.Y, position.Y);
+                max.Z = Math.Max(max.Z, position.Z);
+
+                var cell = new CellCoordinates(ref position, inverseCellSize);
+                int bucket = cell.GetHash() & mask;
+
+                this.memberPositions[i] = position;
+                this.memberCells[i] = cell;
+                this.memberBuckets[i] = bucket;
+                this.bucketStart[bucket + 1]++;
+            }
+
+            for (int i = 1; i <= bucketCount; i++)
+            {
+                this.bucketStart[i] += this.bucketStart[i - 1];
+            }
+
+            // Scatter the members sorted by bucket
+            for (int i = 0; i < count; i++)
+            {
+                int slot = this.bucketStart[this.memberBuckets[i]]++;
+                var member = this.members[i];
+
+                this.positions[slot] = this.memberPositions[i];
+                this.cells[slot] = this.memberCells[i];
+                this.entities[slot] = member.Entity;
+                this.groups[slot] = member.Group;
+            }
+
+            // The scatter pass has moved every bucket start to the start of the next bucket
+            for (int i = bucketCount; i > 0; i--)
+            {
+                this.bucketStart[i] = this.bucketStart[i - 1];
+            }
+
+            this.bucketStart[0] = 0;
+
+            if (count < this.entryCount)
+            {
+                Array.Clear(this.entities, count, this.entryCount - count);
+            }
+
+            this.entryCount = count;
+            this.boundsMin = min;
+            this.boundsMax = max;
+        }
+
+        /// <summary>
+        /// Finds the entities inside a sphere (or a circle for 2D entities).
+        /// </summary>
+        /// <param name="position">The center of the query.</param>
+        /// <param name="radius">The radius of the query.</param>
+        /// <param name="groupMask">The mask of the groups to include.</param>
+        /// <param name="exclude">An entity to exclude from the results. Can be null.</param>
+        /// <param name="results">The buffer that receives the entities found.</param>
+        /// <returns>The number of entities written into the results buffer.</returns>
+        public int QueryRadius(Vector3 position, float radius, int groupMask, Entity exclude, Entity[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+
+            if (this.entryCount == 0 || results.Length == 0)
+            {
+                return 0;
+            }
+
+            int count = 0;
+            float radiusSquared = radius * radius;
+            CellCoordinates minCell, maxCell;
+
+            if (!this.GetCellRange(ref position, radius, out minCell, out maxCell))
+            {
+                for (int i = 0; i < this.entryCount && count < results.Length; i++)
+                {
+                    if (this.IsCandidate(i, groupMask, exclude) && this.DistanceSquared(i, ref position) <= radiusSquared)
+                    {
+                        results[count++] = this.entities[i];
+                    }
+                }
+
+                return count;
+            }
+
+            int mask = this.bucketStart.Length - 2;
+            CellCoordinates cell;
+            for (cell.Z = minCell.Z; cell.Z <= maxCell.Z; cell.Z++)
+            {
+                for (cell.Y = minCell.Y; cell.Y <= maxCell.Y; cell.Y++)
+                {
+                    for (cell.X = minCell.X; cell.X <= maxCell.X; cell.X++)
+                    {
+                        int bucket = cell.GetHash() & mask;
+                        int end = this.bucketStart[bucket + 1];
+
+                        for (int i = this.bucketStart[bucket]; i < end; i++)
+                        {
+                            if (this.cells[i].Equals(cell) &&
+                                this.IsCandidate(i, groupMask, exclude) &&
+                                this.DistanceSquared(i, ref position) <= radiusSquared)
+                            {
+                                results[count++] = this.entities[i];
+
+                                if (count == results.Length)
+                                {
+                                    return count;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        /// Finds the nearest entities to a position, sorted by distance. The number of entities searched is the length of the results buffer.
+        /// </summary>
+        /// <param name="position">The position.</param>
+        /// <param name="maxDistance">The maximum distance of the entities to find.</param>
+        /// <param name="groupMask">The mask of the groups to include.</param>
+        /// <param name="exclude">An entity to exclude from the results. Can be null.</param>
+        /// <param name="results">The buffer that receives the entities found.</param>
+        /// <returns>The number of entities written into the results buffer.</returns>
+        public int QueryNearest(Vector3 position, float maxDistance, int groupMask, Entity exclude, Entity[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+
+            int count = this.FindNearestEntries(ref position, maxDistance, groupMask, exclude, results.Length);
+
+            for (int i = 0; i < count; i++)
+            {
+                results[i] = this.entities[this.candidateEntries[i]];
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        /// Finds the nearest entity to a position.
+        /// </summary>
+        /// <param name="position">The position.</param>
+        /// <param name="maxDistance">The maximum distance of the entity to find.</param>
+        /// <param name="groupMask">The mask of the groups to include.</param>
+        /// <param name="exclude">An entity to exclude from the results. Can be null.</param>
+        /// <param name="entity">The entity found.</param>
+        /// <param name="entityPosition">The position of the entity found when the hash was rebuilt.</param>
+        /// <returns>True if an entity has been found, false in other case</returns>
+        public bool FindNearest(Vector3 position, float maxDistance, int groupMask, Entity exclude, out Entity entity, out Vector3 entityPosition)
+        {
+            if (this.FindNearestEntries(ref position, maxDistance, groupMask, exclude, 1) == 0)
+            {
+                entity = null;
+                entityPosition = Vector3.Zero;
+                return false;
+            }
+
+            int entry = this.candidateEntries[0];
+            entity = this.entities[entry];
+            entityPosition = this.positions[entry];
+            return true;
+        }
+
+        /// <summary>
+        /// Rebuilds the spatial hash.
+        /// </summary>
+        /// <param name="gameTime">The game time.</param>
+        public override void Update(TimeSpan gameTime)
+        {
+            this.Rebuild();
+        }
+
+        /// <summary>
+        /// Finds the nearest entries to a position and stores them sorted in the candidate buffers.
+        /// </summary>
+        /// <param name="position">The position.</param>
+        /// <param name="maxDistance">The maximum distance of the entries to find.</param>
+        /// <param name="groupMask">The mask of the groups to include.</param>
+        /// <param name="exclude">An entity to exclude from the results.</param>
+        /// <param name="k">The number of entries to find.</param>
+        /// <returns>The number of entries found.</returns>
+        private int FindNearestEntries(ref Vector3 position, float maxDistance, int groupMask, Entity exclude, int k)
+        {
+            if (k == 0 || this.entryCount == 0)
+            {
+                return 0;
+            }
+
+            if (this.candidateEntries.Length < k)
+            {
+                this.candidateEntries = new int[k];
+                this.candidateDistances = new float[k];
+            }
+
+            // Distance to the farthest corner of the entries bounding box. Any radius beyond it finds every entry.
+            float dx = Math.Max(Math.Abs(position.X - this.boundsMin.X), Math.Abs(position.X - this.boundsMax.X));
+            float dy = Math.Max(Math.Abs(position.Y - this.boundsMin.Y), Math.Abs(position.Y - this.boundsMax.Y));
+            float dz = Math.Max(Math.Abs(position.Z - this.boundsMin.Z), Math.Abs(position.Z - this.boundsMax.Z));
+            float reach = Math.Min((float)Math.Sqrt((dx * dx) + (dy * dy) + (dz * dz)), maxDistance);
+
+            float radius = Math.Min(this.cellSize, reach);
+            while (true)
+            {
+                int count = this.CollectNearest(ref position, radius, groupMask, exclude, k);
+
+                if (count == k || radius >= reach)
+                {
+                    return count;
+                }
+
+                radius = Math.Min(radius * 2, reach);
+            }
+        }
+
+        /// <summary>
+        /// Collects the nearest entries inside a radius.
+        /// </summary>
+        /// <param name="position">The position.</param>
+        /// <param name="radius">The radius.</param>
+        /// <param name="groupMask">The mask of the groups to include.</param>
+        /// <param name="exclude">An entity to exclude from the results.</param>
+        /// <param name="k">The number of entries to collect.</param>
+        /// <returns>The number of entries collected.</returns>
+        private int CollectNearest(ref Vector3 position, float radius, int groupMask, Entity exclude, int k)
+        {
+            int count = 0;
+            float radiusSquared = radius * radius;
+            CellCoordinates minCell, maxCell;
+
+            if (!this.GetCellRange(ref position, radius, out minCell, out maxCell))
+            {
+                for (int i = 0; i < this.entryCount; i++)
+                {
+                    if (this.IsCandidate(i, groupMask, exclude))
+                    {
+                        float distanceSquared = this.DistanceSquared(i, ref position);
+                        if (distanceSquared <= radiusSquared)
+                        {
+                            this.InsertCandidate(i, distanceSquared, k, ref count);
+                        }
+                    }
+                }
+
+                return count;
+            }
+
+            int mask = this.bucketStart.Length - 2;
+            CellCoordinates cell;
+            for (cell.Z = minCell.Z; cell.Z <= maxCell.Z; cell.Z++)
+            {
+                for (cell.Y = minCell.Y; cell.Y <= maxCell.Y; cell.Y++)
+                {
+                    for (cell.X = minCell.X; cell.X <= maxCell.X; cell.X++)
+                    {
+                        int bucket = cell.GetHash() & mask;
+                        int end = this.bucketStart[bucket + 1];
+
+                        for (int i = this.bucketStart[bucket]; i < end; i++)
+                        {
+                            if (this.cells[i].Equals(cell) && this.IsCandidate(i, groupMask, exclude))
+                            {
+                                float distanceSquared = this.DistanceSquared(i, ref position);
+                                if (distanceSquared <= radiusSquared)
+                                {
+                                    this.InsertCandidate(i, distanceSquared, k, ref count);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        /// Inserts a candidate in the sorted candidate buffers, discarding the farthest one when the buffers are full.
+        /// </summary>
+        /// <param name="entry">The entry index.</param>
+        /// <param name="distanceSquared">The squared distance of the entry.</param>
+        /// <param name="k">The number of candidates to keep.</param>
+        /// <param name="count">The number of candidates.</param>
+        private void InsertCandidate(int entry, float distanceSquared, int k, ref int count)
+        {
+            if (count == k && distanceSquared >= this.candidateDistances[k - 1])
+            {
+                return;
+            }
+
+            int i = count < k ? count++ : k - 1;
+            while (i > 0 && this.candidateDistances[i - 1] > distanceSquared)
+            {
+                this.candidateDistances[i] = this.candidateDistances[i - 1];
+                this.candidateEntries[i] = this.candidateEntries[i - 1];
+                i--;
+            }
+
+            this.candidateDistances[i] = distanceSquared;
+            this.candidateEntries[i] = entry;
+        }
+
+        /// <summary>
+        /// Gets the range of cells covered by a query.
+        /// </summary>
+        /// <param name="position">The center of the query.</param>
+        /// <param name="radius">The radius of the query.</param>
+        /// <param name="minCell">The minimum cell.</param>
+        /// <param name="maxCell">The maximum cell.</param>
+        /// <returns>False if the query covers more cells than entries, so a linear scan is cheaper.</returns>
+        private bool GetCellRange(ref Vector3 position, float radius, out CellCoordinates minCell, out CellCoordinates maxCell)
+        {
+            float inverseCellSize = 1 / this.cellSize;
+            var min = new Vector3(
+                Math.Max(position.X - radius, this.boundsMin.X),
+                Math.Max(position.Y - radius, this.boundsMin.Y),
+                Math.Max(position.Z - radius, this.boundsMin.Z));
+            var max = new Vector3(
+                Math.Min(position.X + radius, this.boundsMax.X),
+                Math.Min(position.Y + radius, this.boundsMax.Y),
+                Math.Min(position.Z + radius, this.boundsMax.Z));
+
+            minCell = new CellCoordinates(ref min, inverseCellSize);
+            maxCell = new CellCoordinates(ref max, inverseCellSize);
+
+            long cellCount = ((long)maxCell.X - minCell.X + 1) * ((long)maxCell.Y - minCell.Y + 1) * ((long)maxCell.Z - minCell.Z + 1);
+            return cellCount <= this.entryCount;
+        }
+
+        /// <summary>
+        /// Checks whether an entry passes the query filters.
+        /// </summary>
+        /// <param name="entry">The entry index.</param>
+        /// <param name="groupMask">The mask of the groups to include.</param>
+        /// <param name="exclude">The entity to exclude.</param>
+        /// <returns>True if the entry passes the filters, false in other case</returns>
+        private bool IsCandidate(int entry, int groupMask, Entity exclude)
+        {
+            return (this.groups[entry] & groupMask) != 0 && this.entities[entry] != exclude;
+        }
+
+        /// <summary>
+        /// Gets the squared distance from an entry to a position.
+        /// </summary>
+        /// <param name="entry">The entry index.</param>
+        /// <param name="position">The position.</param>
+        /// <returns>The squared distance</returns>
+        private float DistanceSquared(int entry, ref Vector3 position)
+        {
+            float dx = this.positions[entry].X - position.X;
+            float dy = this.positions[entry].Y - position.Y;
+            float dz = this.positions[entry].Z - position.Z;
+            return (dx * dx) + (dy * dy) + (dz * dz);
+        }
+
+        /// <summary>
+        /// Removes a member, moving the last member to its index.
+        /// </summary>
+        /// <param name="index">The index of the member.</param>
+        private void RemoveMember(int index)
+        {
+            var entity = this.members[index].Entity;
+            int last = this.members.Count - 1;
+            if (index != last)
+            {
+                var moved = this.members[last];
+                this.members[index] = moved;
+                this.memberIndices[moved.Entity] = index;
+            }
+
+            this.members.RemoveAt(last);
+            this.memberIndices.Remove(entity);
+        }
+
+        /// <summary>
+        /// Ensures the entry buffers can hold the specified number of entries.
+        /// </summary>
+        /// <param name="count">The number of entries.</param>
+        private void EnsureCapacity(int count)
+        {
+            if (this.positions.Length >= count)
+            {
+                return;
+            }
+
+            int capacity = Math.Max(count, this.positions.Length * 2);
+
+            var newEntities = new Entity[capacity];
+            Array.Copy(this.entities, newEntities, this.entryCount);
+
+            this.entities = newEntities;
+            this.positions = new Vector3[capacity];
+            this.cells = new CellCoordinates[capacity];
+            this.groups = new int[capacity];
+            this.memberBuckets = new int[capacity];
+            this.memberPositions = new Vector3[capacity];
+            this.memberCells = new CellCoordinates[capacity];
+        }
+
+        /// <summary>
+        /// A registered entity
+        /// </summary>
+        private struct Member
+        {
+            /// <summary>
+            /// The entity
+            /// </summary>
+            public Entity Entity;
+
+            /// <summary>
+            /// The group bits of all the registrations
+            /// </summary>
+            public int Group;
+
+            /// <summary>
+            /// The group of every registration of the entity
+            /// </summary>
+            public List<int> Registrations;
+
+            /// <summary>
+            /// The 2D transform, if the entity is 2D
+            /// </summary>
+            public Transform2D Transform2D;
+
+            /// <summary>
+            /// The 3D transform, if the entity is 3D
+            /// </summary>
+            public Transform3D Transform3D;
+
+            /// <summary>
+            /// Gets the current position of the entity.
+            /// </summary>
+            /// <returns>The position</returns>
+            public Vector3 GetPosition()
+            {
+                if (this.Transform2D != null)
+                {
+                    var position = this.Transform2D.Position;
+                    return new Vector3(position.X, position.Y, 0);
+                }
+
+                return this.Transform3D.Position;
+            }
+        }
+
+        /// <summary>
+        /// The integer coordinates of a hash cell
+        /// </summary>
+        private struct CellCoordinates
+        {
+            /// <summary>
+            /// The X coordinate
+            /// </summary>
+            public int X;
+
+            /// <summary>
+            /// The Y coordinate
+            /// </summary>
+            public int Y;
+
+            /// <summary>
+            /// The Z coordinate
+            /// </summary>
+            public int Z;
+
+            /// <summary>
+            /// Initializes a new instance of the <see cref="CellCoordinates"/> struct.
+            /// </summary>
+            /// <param name="position">The position.</param>
+            /// <param name="inverseCellSize">The inverse of the cell size.</param>
+            public CellCoordinates(ref Vector3 position, float inverseCellSize)
+            {
+                this.X = (int)Math.Floor(position.X * inverseCellSize);
+                this.Y = (int)Math.Floor(position.Y * inverseCellSize);
+                this.Z = (int)Math.Floor(position.Z * inverseCellSize);
+            }
+
+            /// <summary>
+            /// Gets the hash of the cell.
+            /// </summary>
+            /// <returns>The hash</returns>
+            public int GetHash()
+            {
+                return unchecked((this.X * 73856093) ^ (this.Y * 19349663) ^ (this.Z * 83492791));
+            }
+
+            /// <summary>
+            /// Checks whether two cells are the same.
+            /// </summary>
+            /// <param name="other">The other cell.</param>
+            /// <returns>True if both cells are the same, false in other case</returns>
+            public bool Equals(CellCoordinates other)
+            {
+                return this.X == other.X && this.Y == other.Y && this.Z == other.Z;
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using WaveEngine.Framework;
+using WaveEngine.Framework.Services;
+
+namespace WaveEngine.AI.ChaseAndEvade
+{
+    /// <summary>
+    /// Base class of the strategies that register their owner entity in the <see cref="ProximityService"/>
+    /// </summary>
+    public abstract class ProximityStrategy : Component
+    {
+        /// <summary>
+        /// The proximity group
+        /// </summary>
+        private int proximityGroup;
+
+        /// <summary>
+        /// The group the owner entity is registered with, or 0 if it is not registered
+        /// </summary>
+        private int registeredGroup;
+
+        /// <summary>
+        /// The proximity service
+        /// </summary>
+        private ProximityService proximityService;
+
+        /// <summary>
+        /// Gets or sets the group bit used to register the owner entity in the <see cref="ProximityService"/>.
+        /// The entity is not registered when the group is 0 or the service is not available.
+        /// </summary>
+        public int ProximityGroup
+        {
+            get
+            {
+                return this.proximityGroup;
+            }
+
+            set
+            {
+                this.proximityGroup = value;
+                this.UpdateRegistration();
+            }
+        }
+
+        /// <summary>
+        /// Gets the proximity service, or null if it is not registered.
+        /// </summary>
+        protected ProximityService ProximityService
+        {
+            get { return this.proximityService; }
+        }
+
+        /// <summary>
+        /// Initializes this instance.
+        /// </summary>
+        protected override void Initialize()
+        {
+            base.Initialize();
+
+            this.proximityService = WaveServices.GetService<ProximityService>(false);
+            this.UpdateRegistration();
+        }
+
+        /// <summary>
+        /// Deletes the dependencies.
+        /// </summary>
+        protected override void DeleteDependencies()
+        {
+            base.DeleteDependencies();
+
+            if (this.proximityService != null && this.registeredGroup != 0)
+            {
+                this.proximityService.Unregister(this.Owner, this.registeredGroup);
+            }
+
+            this.registeredGroup = 0;
+            this.proximityService = null;
+        }
+
+        /// <summary>
+        /// Registers the owner entity again when the group has changed after the initialization.
+        /// </summary>
+        private void UpdateRegistration()
+        {
+            if (this.proximityService == null || this.registeredGroup == this.proximityGroup)
+            {
+                return;
+            }
+
+            if (this.registeredGroup != 0)
+            {
+                this.proximityService.Unregister(this.Owner, this.registeredGroup);
+            }
+
+            if (this.proximityGroup != 0)
+            {
+                this.proximityService.Register(this.Owner, this.proximityGroup);
+            }
+
+            this.registeredGroup = this.proximityGroup;
+        }
+    }
+}
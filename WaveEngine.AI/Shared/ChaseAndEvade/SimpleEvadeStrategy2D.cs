@@ -56,6 +56,11 @@ namespace WaveEngine.AI.ChaseAndEvade
         /// </summary>
         private Entity evadeFromEntity;
 
+        /// <summary>
+        /// The threat groups
+        /// </summary>
+        private int threatGroups;
+
         /// <summary>
         /// Gets or sets the evade velocity.
         /// </summary>
@@ -100,6 +105,16 @@ namespace WaveEngine.AI.ChaseAndEvade
             }
         }
 
+        /// <summary>
+        /// Gets or sets the mask of the <see cref="ProximityService"/> groups to evade from.
+        /// When it is not 0 the strategy evades from the nearest entity of these groups instead of <see cref="EvadeFromEntity"/>.
+        /// </summary>
+        public int ThreatGroups
+        {
+            get { return this.threatGroups; }
+            set { this.threatGroups = value; }
+        }
+
         /// <summary>
         /// Initializes a new instance of the <see cref="SimpleEvadeStrategy2D"/> class.
         /// </summary>
@@ -152,9 +167,10 @@ namespace WaveEngine.AI.ChaseAndEvade
         /// <param name="gameTime">The game time.</param>
         public override void Evade(TimeSpan gameTime)
         {
-            if (this.evadeFromTransform != null)
+            Vector2 threatPosition;
+            if (this.TryGetThreatPosition(out threatPosition))
             {
-                this.movingComponent.Direction = this.Transform.Position - this.evadeFromTransform.Position;
+                this.movingComponent.Direction = this.Transform.Position - threatPosition;
 
                 if (this.movingComponent.Direction != Vector2.Zero)
                 {
@@ -175,12 +191,42 @@ namespace WaveEngine.AI.ChaseAndEvade
         {
             bool evade = false;
 
-            if (this.evadeFromTransform != null)
+            Vector2 threatPosition;
+            if (this.TryGetThreatPosition(out threatPosition))
             {
-                evade = Vector2.Distance(this.Transform.Position, this.evadeFromTransform.Position) < this.distance;
+                evade = Vector2.Distance(this.Transform.Position, threatPosition) < this.distance;
             }
 
             return evade;
         }
+
+        /// <summary>
+        /// Gets the position of the entity to evade from.
+        /// </summary>
+        /// <param name="threatPosition">The threat position.</param>
+        /// <returns>True if there is a threat, false in other case</returns>
+        private bool TryGetThreatPosition(out Vector2 threatPosition)
+        {
+            if (this.threatGroups != 0 && this.ProximityService != null)
+            {
+                var position = this.Transform.Position;
+                Entity threat;
+                Vector3 threatPosition3D;
+
+                if (this.ProximityService.FindNearest(new Vector3(position.X, position.Y, 0), this.distance, this.threatGroups, this.Owner, out threat, out threatPosition3D))
+                {
+                    threatPosition = new Vector2(threatPosition3D.X, threatPosition3D.Y);
+                    return true;
+                }
+            }
+            else if (this.evadeFromTransform != null)
+            {
+                threatPosition = this.evadeFromTransform.Position;
+                return true;
+            }
+
+            threatPosition = Vector2.Zero;
+            return false;
+        }
     }
 }
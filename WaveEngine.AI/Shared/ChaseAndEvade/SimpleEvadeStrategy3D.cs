@@ -51,6 +51,11 @@ namespace WaveEngine.AI.ChaseAndEvade
         /// </summary>
         private float evadeVelocity;
 
+        /// <summary>
+        /// The threat groups
+        /// </summary>
+        private int threatGroups;
+
         /// <summary>
         /// Gets or sets the evade from entity.
         /// </summary>
@@ -95,6 +100,16 @@ namespace WaveEngine.AI.ChaseAndEvade
             set { this.evadeVelocity = value; }
         }
 
+        /// <summary>
+        /// Gets or sets the mask of the <see cref="ProximityService"/> groups to evade from.
+        /// When it is not 0 the strategy evades from the nearest entity of these groups instead of <see cref="EvadeFromEntity"/>.
+        /// </summary>
+        public int ThreatGroups
+        {
+            get { return this.threatGroups; }
+            set { this.threatGroups = value; }
+        }
+
         /// <summary>
         /// Resolves the dependencies.
         /// </summary>
@@ -114,7 +129,13 @@ namespace WaveEngine.AI.ChaseAndEvade
             var color = this.Owner.FindComponent<MaterialsMap>();
             ((StandardMaterial)color.DefaultMaterial).DiffuseColor = Color.Red;
 
-            this.movingComponent.Direction = this.transform.Position - this.evadeFromTransform.Position;
+            Vector3 threatPosition;
+            if (!this.TryGetThreatPosition(out threatPosition))
+            {
+                return;
+            }
+
+            this.movingComponent.Direction = this.transform.Position - threatPosition;
             this.movingComponent.Direction.Normalize();
 
             this.transform.Position += this.movingComponent.Direction * this.movingComponent.NormalVelocity;
@@ -129,14 +150,38 @@ namespace WaveEngine.AI.ChaseAndEvade
         {
             bool evade = false;
 
-            if (this.evadeFromTransform != null)
+            Vector3 threatPosition;
+            if (this.TryGetThreatPosition(out threatPosition))
             {
-                evade = Vector3.Distance(this.transform.Position, this.evadeFromTransform.Position) < this.distance;
+                evade = Vector3.Distance(this.transform.Position, threatPosition) < this.distance;
             }
 
             return evade;
         }
 
+        /// <summary>
+        /// Gets the position of the entity to evade from.
+        /// </summary>
+        /// <param name="threatPosition">The threat position.</param>
+        /// <returns>True if there is a threat, false in other case</returns>
+        private bool TryGetThreatPosition(out Vector3 threatPosition)
+        {
+            if (this.threatGroups != 0 && this.ProximityService != null)
+            {
+                Entity threat;
+                return this.ProximityService.FindNearest(this.transform.Position, this.distance, this.threatGroups, this.Owner, out threat, out threatPosition);
+            }
+
+            if (this.evadeFromTransform != null)
+            {
+                threatPosition = this.evadeFromTransform.Position;
+                return true;
+            }
+
+            threatPosition = Vector3.Zero;
+            return false;
+        }
+
         /// <summary>
         /// Gets the evade entity transform.
         /// </summary>
@@ -0,0 +1,92 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using NUnit.Framework;
+using WaveEngine.AI.BehaviorTrees;
+
+namespace WaveEngine.AI.Tests.BehaviorTrees
+{
+    /// <summary>
+    /// Tests of <see cref="CompiledTree{T}"/>
+    /// </summary>
+    [TestFixture]
+    public class CompiledTreeTests
+    {
+        /// <summary>
+        /// The compiled tree selects the same leaf as the evaluation of the node graph.
+        /// </summary>
+        [Test]
+        public void EvaluateMatchesNodeGraph()
+        {
+            var random = new Random(26);
+
+            for (int iteration = 0; iteration < 50; iteration++)
+            {
+                var root = new InitNode<TestNodeInfo>();
+                BuildRandomTree(random, root, 0, 100, 0);
+
+                var compiled = new CompiledTree<TestNodeInfo>(root);
+                var graphEvaluator = new TreeEvaluator<TestNodeInfo>();
+                var compiledEvaluator = new TreeEvaluator<TestNodeInfo>();
+
+                for (int value = -1; value <= 100; value++)
+                {
+                    var nodeInfo = new TestNodeInfo() { Value = value };
+                    graphEvaluator.CurrentNode = null;
+                    compiledEvaluator.CurrentNode = null;
+
+                    graphEvaluator.Evaluate(nodeInfo, root);
+                    compiledEvaluator.Evaluate(nodeInfo, compiled);
+
+                    Assert.AreSame(graphEvaluator.CurrentNode, compiledEvaluator.CurrentNode, "Value " + value);
+                }
+            }
+        }
+
+        /// <summary>
+        /// The compiled tree contains every node of the graph once.
+        /// </summary>
+        [Test]
+        public void CountIncludesEveryNode()
+        {
+            var root = new InitNode<TestNodeInfo>();
+            var branch = new TestNode(0, 10);
+            branch.AddChild(new TestNode(0, 5));
+            branch.AddChild(new TestNode(5, 10));
+            root.AddChild(branch);
+            root.AddChild(new TestNode(10, 20));
+
+            var compiled = new CompiledTree<TestNodeInfo>(root);
+
+            Assert.AreEqual(5, compiled.Count);
+            Assert.AreSame(root, compiled.Root);
+        }
+
+        /// <summary>
+        /// Adds random children to a node, splitting its value range between them.
+        /// </summary>
+        /// <param name="random">The random generator.</param>
+        /// <param name="parent">The parent node.</param>
+        /// <param name="min">The minimum value of the parent range.</param>
+        /// <param name="max">The maximum value of the parent range.</param>
+        /// <param name="depth">The depth of the parent.</param>
+        private static void BuildRandomTree(Random random, Node<TestNodeInfo> parent, int min, int max, int depth)
+        {
+            int children = random.Next(1, 4);
+            for (int i = 0; i < children; i++)
+            {
+                // Overlapping ranges make the order of the children matter
+                int childMin = random.Next(min, max);
+                int childMax = random.Next(childMin, max + 1);
+                var child = new TestNode(childMin, childMax);
+                parent.AddChild(child);
+
+                if (depth < 4 && random.Next(3) != 0)
+                {
+                    BuildRandomTree(random, child, childMin, childMax, depth + 1);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using WaveEngine.AI.BehaviorTrees;
+
+namespace WaveEngine.AI.Tests.BehaviorTrees
+{
+    /// <summary>
+    /// Node information used by the test trees
+    /// </summary>
+    public class TestNodeInfo : NodeInfo
+    {
+        /// <summary>
+        /// The value the conditions of the test nodes compare against
+        /// </summary>
+        public int Value;
+
+        /// <summary>
+        /// The number of times a leaf has been executed for this agent
+        /// </summary>
+        public int Executions;
+
+        /// <summary>
+        /// The last executed leaf
+        /// </summary>
+        public TestNode LastExecuted;
+    }
+
+    /// <summary>
+    /// Node that is entered when the value of the node info is in a range
+    /// </summary>
+    public class TestNode : Node<TestNodeInfo>
+    {
+        /// <summary>
+        /// The minimum value, inclusive
+        /// </summary>
+        private int min;
+
+        /// <summary>
+        /// The maximum value, exclusive
+        /// </summary>
+        private int max;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TestNode"/> class.
+        /// </summary>
+        /// <param name="min">The minimum value, inclusive.</param>
+        /// <param name="max">The maximum value, exclusive.</param>
+        public TestNode(int min, int max)
+        {
+            this.min = min;
+            this.max = max;
+        }
+
+        /// <summary>
+        /// Gets or sets an action invoked when the node is executed.
+        /// </summary>
+        public Action<TestNodeInfo> OnExecute { get; set; }
+
+        /// <summary>
+        /// Executes the node.
+        /// </summary>
+        /// <param name="nodeInfo">The node information.</param>
+        public override void Execute(TestNodeInfo nodeInfo)
+        {
+            nodeInfo.Executions++;
+            nodeInfo.LastExecuted = this;
+
+            if (this.OnExecute != null)
+            {
+                this.OnExecute(nodeInfo);
+            }
+        }
+
+        /// <summary>
+        /// Evaluates the node.
+        /// </summary>
+        /// <param name="nodeInfo">The node information.</param>
+        /// <returns>True if the value is in the range of the node</returns>
+        public override bool Evaluate(TestNodeInfo nodeInfo)
+        {
+            return nodeInfo.Value >= this.min && nodeInfo.Value < this.max;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Diagnostics;
+using NUnit.Framework;
+using WaveEngine.AI.BehaviorTrees;
+
+namespace WaveEngine.AI.Tests.BehaviorTrees
+{
+    /// <summary>
+    /// Measures the tick time of the behavior trees of 10k agents
+    /// </summary>
+    [TestFixture]
+    [Category("Benchmark")]
+    public class TreeBatchExecutorBenchmark
+    {
+        /// <summary>
+        /// The number of agents
+        /// </summary>
+        private const int Agents = 10000;
+
+        /// <summary>
+        /// The number of measured frames
+        /// </summary>
+        private const int Frames = 100;
+
+        /// <summary>
+        /// Compares ticking every agent on its own with ticking them through a batch executor.
+        /// </summary>
+        [Test]
+        [Explicit]
+        public void TickTenThousandAgents()
+        {
+            var executors = new TreeExecutorBehavior<TestNodeInfo>[Agents];
+            var batch = new TreeBatchExecutor<TestNodeInfo>();
+            for (int i = 0; i < Agents; i++)
+            {
+                executors[i] = CreateAgent(i);
+            }
+
+            double single = Measure(() =>
+            {
+                for (int i = 0; i < Agents; i++)
+                {
+                    executors[i].NodeInfo.EvaluateTree = true;
+                    executors[i].Execute(TimeSpan.Zero);
+                }
+            });
+
+            for (int i = 0; i < Agents; i++)
+            {
+                batch.Add(executors[i]);
+            }
+
+            double batched = Measure(() =>
+            {
+                for (int i = 0; i < Agents; i++)
+                {
+                    executors[i].NodeInfo.EvaluateTree = true;
+                }
+
+                batch.Execute(TimeSpan.Zero);
+            });
+
+            TestContext.Progress.WriteLine(
+                "{0} agents: {1:0.000} ms per frame one by one, {2:0.000} ms per frame batched ({3} cores)",
+                Agents,
+                single,
+                batched,
+                Environment.ProcessorCount);
+        }
+
+        /// <summary>
+        /// Measures the average time of a frame.
+        /// </summary>
+        /// <param name="frame">The frame.</param>
+        /// <returns>The average milliseconds per frame</returns>
+        private static double Measure(Action frame)
+        {
+            // Warm up
+            frame();
+
+            var stopwatch = Stopwatch.StartNew();
+            for (int i = 0; i < Frames; i++)
+            {
+                frame();
+            }
+
+            return stopwatch.Elapsed.TotalMilliseconds / Frames;
+        }
+
+        /// <summary>
+        /// Creates the executor of an agent with a tree of 3 levels.
+        /// </summary>
+        /// <param name="seed">The seed of the agent.</param>
+        /// <returns>The tree executor</returns>
+        private static TreeExecutorBehavior<TestNodeInfo> CreateAgent(int seed)
+        {
+            var root = new InitNode<TestNodeInfo>();
+            for (int i = 0; i < 4; i++)
+            {
+                var branch = new TestNode(i * 25, (i + 1) * 25);
+                for (int j = 0; j < 5; j++)
+                {
+                    branch.AddChild(new TestNode((i * 25) + (j * 5), (i * 25) + ((j + 1) * 5)));
+                }
+
+                root.AddChild(branch);
+            }
+
+            var executor = new TreeExecutorBehavior<TestNodeInfo>();
+            executor.NodeInfo = new TestNodeInfo() { Value = seed % 100 };
+            executor.Tree = root;
+            return executor;
+        }
+    }
+}
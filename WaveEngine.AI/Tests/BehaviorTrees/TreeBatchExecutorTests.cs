@@ -0,0 +1,127 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+using WaveEngine.AI.BehaviorTrees;
+
+namespace WaveEngine.AI.Tests.BehaviorTrees
+{
+    /// <summary>
+    /// Tests of <see cref="TreeBatchExecutor{T}"/>
+    /// </summary>
+    [TestFixture]
+    public class TreeBatchExecutorTests
+    {
+        /// <summary>
+        /// Every registered tree is evaluated and its leaf executed once per frame.
+        /// </summary>
+        [Test]
+        public void ExecuteTicksEveryTree()
+        {
+            var batch = new TreeBatchExecutor<TestNodeInfo>() { ParallelThreshold = 1 };
+            var executors = new TreeExecutorBehavior<TestNodeInfo>[200];
+            for (int i = 0; i < executors.Length; i++)
+            {
+                executors[i] = CreateExecutor(i % 2, new TestNode(0, 1), new TestNode(1, 2));
+                batch.Add(executors[i]);
+            }
+
+            batch.Execute(TimeSpan.FromSeconds(1));
+
+            for (int i = 0; i < executors.Length; i++)
+            {
+                var nodeInfo = executors[i].NodeInfo;
+                Assert.AreEqual(1, nodeInfo.Executions);
+                Assert.AreSame(executors[i].Tree.Children[i % 2], nodeInfo.LastExecuted);
+                Assert.IsFalse(nodeInfo.EvaluateTree);
+            }
+        }
+
+        /// <summary>
+        /// An executor removed by the execution of another tree is not executed, and the frame completes.
+        /// </summary>
+        [Test]
+        public void ExecutorRemovedDuringExecutionIsSkipped()
+        {
+            var batch = new TreeBatchExecutor<TestNodeInfo>();
+            var leaf = new TestNode(0, 1);
+            var first = CreateExecutor(0, leaf);
+            var second = CreateExecutor(0, new TestNode(0, 1));
+            var third = CreateExecutor(0, new TestNode(0, 1));
+            batch.Add(first);
+            batch.Add(second);
+            batch.Add(third);
+
+            leaf.OnExecute = (nodeInfo) =>
+            {
+                batch.Remove(first);
+                batch.Remove(third);
+            };
+
+            Assert.DoesNotThrow(() => batch.Execute(TimeSpan.Zero));
+
+            Assert.AreEqual(1, first.NodeInfo.Executions);
+            Assert.AreEqual(1, second.NodeInfo.Executions);
+            Assert.AreEqual(0, third.NodeInfo.Executions);
+            Assert.AreEqual(1, batch.Count);
+        }
+
+        /// <summary>
+        /// An executor added by the execution of another tree is ticked from the next frame.
+        /// </summary>
+        [Test]
+        public void ExecutorAddedDuringExecutionStartsOnNextFrame()
+        {
+            var batch = new TreeBatchExecutor<TestNodeInfo>();
+            var leaf = new TestNode(0, 1);
+            var added = CreateExecutor(0, new TestNode(0, 1));
+            batch.Add(CreateExecutor(0, leaf));
+
+            leaf.OnExecute = (nodeInfo) =>
+            {
+                if (added.BatchExecutor == null)
+                {
+                    batch.Add(added);
+                }
+            };
+
+            batch.Execute(TimeSpan.Zero);
+            Assert.AreEqual(0, added.NodeInfo.Executions);
+
+            batch.Execute(TimeSpan.Zero);
+            Assert.AreEqual(1, added.NodeInfo.Executions);
+        }
+
+        /// <summary>
+        /// An executor cannot be registered in two batch executors.
+        /// </summary>
+        [Test]
+        public void AddTwiceThrows()
+        {
+            var executor = CreateExecutor(0, new TestNode(0, 1));
+            new TreeBatchExecutor<TestNodeInfo>().Add(executor);
+
+            Assert.Throws<InvalidOperationException>(() => new TreeBatchExecutor<TestNodeInfo>().Add(executor));
+        }
+
+        /// <summary>
+        /// Creates a tree executor whose tree has the given leaves under the root.
+        /// </summary>
+        /// <param name="value">The value of the node information.</param>
+        /// <param name="leaves">The leaves of the tree.</param>
+        /// <returns>The tree executor</returns>
+        internal static TreeExecutorBehavior<TestNodeInfo> CreateExecutor(int value, params TestNode[] leaves)
+        {
+            var root = new InitNode<TestNodeInfo>();
+            for (int i = 0; i < leaves.Length; i++)
+            {
+                root.AddChild(leaves[i]);
+            }
+
+            var executor = new TreeExecutorBehavior<TestNodeInfo>();
+            executor.NodeInfo = new TestNodeInfo() { Value = value, EvaluateTree = true };
+            executor.Tree = root;
+            return executor;
+        }
+    }
+}
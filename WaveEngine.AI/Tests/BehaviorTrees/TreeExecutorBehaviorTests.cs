@@ -0,0 +1,70 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+using WaveEngine.AI.BehaviorTrees;
+
+namespace WaveEngine.AI.Tests.BehaviorTrees
+{
+    /// <summary>
+    /// Tests of <see cref="TreeExecutorBehavior{T}"/>
+    /// </summary>
+    [TestFixture]
+    public class TreeExecutorBehaviorTests
+    {
+        /// <summary>
+        /// A child added with AddChild after the tree is assigned is evaluated.
+        /// </summary>
+        [Test]
+        public void ChildAddedAfterAssignmentIsEvaluated()
+        {
+            var executor = TreeBatchExecutorTests.CreateExecutor(1, new TestNode(0, 1));
+            var added = new TestNode(1, 2);
+            executor.Tree.AddChild(added);
+
+            executor.Execute(TimeSpan.Zero);
+
+            Assert.AreSame(added, executor.NodeInfo.LastExecuted);
+        }
+
+        /// <summary>
+        /// A child added to an already evaluated tree is evaluated on the next evaluation.
+        /// </summary>
+        [Test]
+        public void ChildAddedAfterEvaluationIsEvaluated()
+        {
+            var executor = TreeBatchExecutorTests.CreateExecutor(1, new TestNode(0, 1));
+            executor.Execute(TimeSpan.Zero);
+            Assert.AreEqual(0, executor.NodeInfo.Executions);
+
+            var branch = new TestNode(1, 2);
+            executor.Tree.AddChild(branch);
+            var leaf = new TestNode(1, 2);
+            branch.AddChild(leaf);
+            executor.NodeInfo.EvaluateTree = true;
+            executor.Execute(TimeSpan.Zero);
+
+            Assert.AreSame(leaf, executor.NodeInfo.LastExecuted);
+        }
+
+        /// <summary>
+        /// Changes made directly to a children list are picked up after Recompile.
+        /// </summary>
+        [Test]
+        public void RecompilePicksUpDirectChanges()
+        {
+            var first = new TestNode(0, 1);
+            var executor = TreeBatchExecutorTests.CreateExecutor(0, first);
+            executor.Execute(TimeSpan.Zero);
+            Assert.AreSame(first, executor.NodeInfo.LastExecuted);
+
+            var replacement = new TestNode(0, 1);
+            executor.Tree.Children[0] = replacement;
+            executor.Recompile();
+            executor.NodeInfo.EvaluateTree = true;
+            executor.Execute(TimeSpan.Zero);
+
+            Assert.AreSame(replacement, executor.NodeInfo.LastExecuted);
+        }
+    }
+}
@@ -0,0 +1,132 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+using WaveEngine.AI.ChaseAndEvade;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework;
+using WaveEngine.Framework.Graphics;
+
+namespace WaveEngine.AI.Tests.ChaseAndEvade
+{
+    /// <summary>
+    /// Tests of <see cref="ProximityService"/>
+    /// </summary>
+    [TestFixture]
+    public class ProximityServiceTests
+    {
+        /// <summary>
+        /// An entity registered by two components keeps the registration of one when the other is removed.
+        /// </summary>
+        [Test]
+        public void RegistrationsAreCountedPerOwner()
+        {
+            var service = new ProximityService();
+            var entity = CreateEntity(0, 0);
+            var results = new Entity[4];
+
+            service.Register(entity, 1);
+            service.Register(entity, 2);
+            Assert.AreEqual(1, service.Count);
+
+            service.Rebuild();
+            Assert.AreEqual(1, service.QueryRadius(Vector3.Zero, 10, 1, null, results));
+            Assert.AreEqual(1, service.QueryRadius(Vector3.Zero, 10, 2, null, results));
+
+            Assert.IsTrue(service.Unregister(entity, 1));
+            service.Rebuild();
+            Assert.AreEqual(1, service.Count);
+            Assert.AreEqual(0, service.QueryRadius(Vector3.Zero, 10, 1, null, results));
+            Assert.AreEqual(1, service.QueryRadius(Vector3.Zero, 10, 2, null, results));
+
+            Assert.IsFalse(service.Unregister(entity, 1));
+            Assert.IsTrue(service.Unregister(entity, 2));
+            Assert.AreEqual(0, service.Count);
+        }
+
+        /// <summary>
+        /// Unregistering an entity without a group removes all its registrations.
+        /// </summary>
+        [Test]
+        public void UnregisterRemovesAllRegistrations()
+        {
+            var service = new ProximityService();
+            var first = CreateEntity(0, 0);
+            var second = CreateEntity(5, 0);
+
+            service.Register(first, 1);
+            service.Register(first, 1);
+            service.Register(second, 1);
+
+            Assert.IsTrue(service.Unregister(first));
+            Assert.AreEqual(1, service.Count);
+
+            service.Rebuild();
+            var results = new Entity[4];
+            Assert.AreEqual(1, service.QueryRadius(Vector3.Zero, 10, 1, null, results));
+            Assert.AreSame(second, results[0]);
+        }
+
+        /// <summary>
+        /// The nearest query returns the entities sorted by distance.
+        /// </summary>
+        [Test]
+        public void QueryNearestIsSortedByDistance()
+        {
+            var service = new ProximityService() { CellSize = 10 };
+            var random = new Random(27);
+            var entities = new Entity[500];
+            for (int i = 0; i < entities.Length; i++)
+            {
+                entities[i] = CreateEntity((float)(random.NextDouble() * 1000), (float)(random.NextDouble() * 1000));
+                service.Register(entities[i], 1);
+            }
+
+            service.Rebuild();
+
+            var position = new Vector3(500, 500, 0);
+            var results = new Entity[8];
+            int count = service.QueryNearest(position, float.MaxValue, 1, null, results);
+            Assert.AreEqual(results.Length, count);
+
+            // Brute force the 8th nearest distance
+            var distances = new float[entities.Length];
+            for (int i = 0; i < entities.Length; i++)
+            {
+                distances[i] = DistanceSquared(entities[i], position);
+            }
+
+            Array.Sort(distances);
+
+            for (int i = 0; i < count; i++)
+            {
+                Assert.AreEqual(distances[i], DistanceSquared(results[i], position), 1e-3);
+            }
+        }
+
+        /// <summary>
+        /// Creates a 2D entity.
+        /// </summary>
+        /// <param name="x">The X position.</param>
+        /// <param name="y">The Y position.</param>
+        /// <returns>The entity</returns>
+        private static Entity CreateEntity(float x, float y)
+        {
+            return new Entity().AddComponent(new Transform2D() { Position = new Vector2(x, y) });
+        }
+
+        /// <summary>
+        /// Gets the squared distance from a 2D entity to a position.
+        /// </summary>
+        /// <param name="entity">The entity.</param>
+        /// <param name="position">The position.</param>
+        /// <returns>The squared distance</returns>
+        private static float DistanceSquared(Entity entity, Vector3 position)
+        {
+            var entityPosition = entity.FindComponent<Transform2D>().Position;
+            float dx = entityPosition.X - position.X;
+            float dy = entityPosition.Y - position.Y;
+            return (dx * dx) + (dy * dy);
+        }
+    }
+}
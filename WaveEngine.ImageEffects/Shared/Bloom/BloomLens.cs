@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -15,8 +16,13 @@ namespace WaveEngine.ImageEffects
     /// Represent a Bloom as postprocessing filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class BloomLens : Lens
+    public class BloomLens : Lens, ITransientTargetLens
     {
+        /// <summary>
+        /// Renders a material to a render target, used to build the pyramid
+        /// </summary>
+        private Action<RenderTarget, Material> renderToImage;
+
         #region Properties
 
         /// <summary>
@@ -101,6 +107,16 @@ namespace WaveEngine.ImageEffects
                 (this.material as BloomMaterial).BloomTint = value;
             }
         }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
+
+        /// <summary>
+        /// Gets or sets the blur pyramid shared with other lenses of the camera, or null to downsample the source directly.
+        /// </summary>
+        public BlurPyramid Pyramid { get; set; }
         #endregion
 
         #region Initialize
@@ -126,6 +142,16 @@ namespace WaveEngine.ImageEffects
 
         #region Public Methods
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            requests.Add(new TransientTargetRequest(4, 0, 1));
+            requests.Add(new TransientTargetRequest(4, 1, 2));
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -139,35 +165,56 @@ namespace WaveEngine.ImageEffects
                 mat.TexcoordOffset.Y = 1f / this.Source.Height;
             }
 
+            Vector2 texcoordOffset = mat.TexcoordOffset;
+
             int width = this.Source.Width / 4;
             int height = this.Source.Height / 4;
 
-            RenderTarget rt1 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            RenderTarget rt2 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            graphicsDevice.Viewport = new Viewport(0, 0, width, height);
+            Texture downSampleSource = this.Source;
+            if (this.Pyramid != null)
+            {
+                if (this.renderToImage == null)
+                {
+                    this.renderToImage = this.RenderToImage;
+                }
+
+                downSampleSource = this.Pyramid.GetLevel(this, this.Source, 2, this.renderToImage);
+            }
+
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 0, width, height);
+            RenderTarget rt2 = TransientTargetPool.Acquire(this, 1, width, height);
+            TransientTargetPool.SetViewport(rt1);
 
             // Down sampler
             mat.Pass = BloomMaterial.Passes.DownSampler;
-            mat.Texture = this.Source;
+            mat.Texture = downSampleSource;
+            mat.TexcoordOffset = new Vector2(1f / downSampleSource.Width, 1f / downSampleSource.Height);
+            LensProfiler.BeginPass(this, "Down sampler");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
 
             // Bloom
             mat.Pass = BloomMaterial.Passes.Bloom;
+            mat.TexcoordOffset = texcoordOffset;
             mat.Texture = rt1;
+            LensProfiler.BeginPass(this, "Bloom");
             this.RenderToImage(rt2, this.material);
+            LensProfiler.EndPass();
 
             // UpCombine
-            graphicsDevice.Viewport = new Viewport(0, 0, this.Source.Width, this.Source.Height);
+            TransientTargetPool.RestoreViewport(this);
             mat.Pass = BloomMaterial.Passes.UpCombine;
             mat.Texture = this.Source;
             mat.Texture1 = rt2;
+            LensProfiler.BeginPass(this, "UpCombine");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
             mat.Texture1 = null;
 
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt1);
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt2);
+            TransientTargetPool.Release(this, rt1);
+            TransientTargetPool.Release(this, rt2);
         }
         #endregion
 
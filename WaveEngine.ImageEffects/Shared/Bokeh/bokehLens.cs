@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -15,7 +16,7 @@ namespace WaveEngine.ImageEffects
     /// Represent a Depth of Field bokeh using poligonaly aperture as postprocessing filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class BokehLens : Lens
+    public class BokehLens : Lens, ITransientTargetLens
     {
         private float fstops;
         private float maxBlur;
@@ -169,6 +170,11 @@ namespace WaveEngine.ImageEffects
                 (this.material as BokehMaterial).Quality = value;
             }
         }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
         #endregion
 
         #region Initialize
@@ -196,6 +202,16 @@ namespace WaveEngine.ImageEffects
 
         #region Public Methods
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            requests.Add(new TransientTargetRequest(1, 0, 1));
+            requests.Add(new TransientTargetRequest(1, 1, 2));
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -209,30 +225,36 @@ namespace WaveEngine.ImageEffects
 
             var mat = this.material as BokehMaterial;
 
-            RenderTarget rt0 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(this.Source.Width, this.Source.Height);
-            RenderTarget rt1 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(this.Source.Width, this.Source.Height);
+            RenderTarget rt0 = TransientTargetPool.Acquire(this, 0, this.Source.Width, this.Source.Height);
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 1, this.Source.Width, this.Source.Height);
 
             Vector2 aspect = new Vector2((float)rt0.Width / rt0.Height, 1);
 
             // CoC Map
             mat.Pass = BokehMaterial.Passes.CoCMap;
             mat.Texture = this.Source;
+            LensProfiler.BeginPass(this, "CoC Map");
             this.RenderToImage(rt0, this.material);
+            LensProfiler.EndPass();
 
             // Horizontal blur pass
             mat.Pass = BokehMaterial.Passes.HorizontalBlur;
             mat.BlurDisp = (new Vector2(0, 1f) / aspect) * this.maxBlur;
             mat.Texture = rt0;
+            LensProfiler.BeginPass(this, "Horizontal blur pass");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
 
             // Diagonal blur pass
             mat.Pass = BokehMaterial.Passes.DiagonalBlurCombine;
             mat.BlurDisp = (new Vector2(1.0f, 0.57735f) / aspect) * this.maxBlur;
             mat.Texture = rt1;
+            LensProfiler.BeginPass(this, "Diagonal blur pass");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt0);
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt1);
+            TransientTargetPool.Release(this, rt0);
+            TransientTargetPool.Release(this, rt1);
         }
         #endregion
 
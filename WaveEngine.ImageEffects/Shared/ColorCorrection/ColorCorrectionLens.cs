@@ -64,7 +64,9 @@ namespace WaveEngine.ImageEffects
         public override void Render(TimeSpan gameTime)
         {
             (this.material as ColorCorrectionMaterial).Texture = this.Source;
+            LensProfiler.BeginPass(this, "Render");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
         }
         #endregion
 
@@ -0,0 +1,279 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// An RGBA image stored as floats in main memory, processed by the <see cref="CpuLensProcessor"/>.
+    /// </summary>
+    public class CpuImage
+    {
+        /// <summary>
+        /// Number of channels of a pixel
+        /// </summary>
+        public const int Channels = 4;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the width in pixels.
+        /// </summary>
+        public int Width { get; private set; }
+
+        /// <summary>
+        /// Gets the height in pixels.
+        /// </summary>
+        public int Height { get; private set; }
+
+        /// <summary>
+        /// Gets the interleaved RGBA components of the pixels, row by row.
+        /// </summary>
+        public float[] Pixels { get; private set; }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CpuImage"/> class, with all the pixels transparent black.
+        /// </summary>
+        /// <param name="width">The width in pixels.</param>
+        /// <param name="height">The height in pixels.</param>
+        public CpuImage(int width, int height)
+        {
+            if (width <= 0)
+            {
+                throw new ArgumentOutOfRangeException("width");
+            }
+
+            if (height <= 0)
+            {
+                throw new ArgumentOutOfRangeException("height");
+            }
+
+            this.Width = width;
+            this.Height = height;
+            this.Pixels = new float[width * height * Channels];
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Creates an image from 8 bits per channel RGBA data.
+        /// </summary>
+        /// <param name="width">The width in pixels.</param>
+        /// <param name="height">The height in pixels.</param>
+        /// <param name="rgba">The RGBA data, row by row.</param>
+        /// <returns>The new image</returns>
+        public static CpuImage FromRgba32(int width, int height, byte[] rgba)
+        {
+            if (rgba == null)
+            {
+                throw new ArgumentNullException("rgba");
+            }
+
+            var image = new CpuImage(width, height);
+            var pixels = image.Pixels;
+
+            if (rgba.Length < pixels.Length)
+            {
+                throw new ArgumentException("The data is smaller than the image", "rgba");
+            }
+
+            const float Scale = 1.0f / 255.0f;
+            for (int i = 0; i < pixels.Length; i++)
+            {
+                pixels[i] = rgba[i] * Scale;
+            }
+
+            return image;
+        }
+
+        /// <summary>
+        /// Converts the image to 8 bits per channel RGBA data, saturating the components as a render target does.
+        /// </summary>
+        /// <returns>The RGBA data, row by row</returns>
+        public byte[] ToRgba32()
+        {
+            var pixels = this.Pixels;
+            var rgba = new byte[pixels.Length];
+
+            for (int i = 0; i < pixels.Length; i++)
+            {
+                float value = pixels[i];
+
+                // NaN is stored as 0
+                if (!(value > 0))
+                {
+                    rgba[i] = 0;
+                }
+                else if (value >= 1)
+                {
+                    rgba[i] = 255;
+                }
+                else
+                {
+                    rgba[i] = (byte)((value * 255) + 0.5f);
+                }
+            }
+
+            return rgba;
+        }
+
+        /// <summary>
+        /// Compares this image with a golden image, as they would be stored in an 8 bits per channel render target.
+        /// </summary>
+        /// <param name="golden">The golden image.</param>
+        /// <param name="maxError">The largest difference of a component, from 0 to 255.</param>
+        /// <returns>The peak signal to noise ratio in decibels, or <see cref="double.PositiveInfinity"/> if the images are equal</returns>
+        public double Compare(CpuImage golden, out int maxError)
+        {
+            if (golden == null)
+            {
+                throw new ArgumentNullException("golden");
+            }
+
+            if (golden.Width != this.Width || golden.Height != this.Height)
+            {
+                throw new ArgumentException("The golden image must have the size of this image", "golden");
+            }
+
+            var actual = this.ToRgba32();
+            var expected = golden.ToRgba32();
+
+            double squaredErrors = 0;
+            maxError = 0;
+
+            for (int i = 0; i < actual.Length; i++)
+            {
+                int error = Math.Abs(actual[i] - expected[i]);
+                maxError = Math.Max(maxError, error);
+                squaredErrors += error * error;
+            }
+
+            if (squaredErrors == 0)
+            {
+                return double.PositiveInfinity;
+            }
+
+            double meanSquaredError = squaredErrors / actual.Length;
+            return 10 * Math.Log10((255.0 * 255.0) / meanSquaredError);
+        }
+
+        /// <summary>
+        /// Samples the image with bilinear filtering and clamped coordinates, as a texture sampler does.
+        /// </summary>
+        /// <param name="u">The horizontal texture coordinate, from 0 to 1.</param>
+        /// <param name="v">The vertical texture coordinate, from 0 to 1.</param>
+        /// <param name="color">The array where the RGBA components are stored.</param>
+        /// <param name="offset">The index of the first component in the array.</param>
+        public void Sample(float u, float v, float[] color, int offset)
+        {
+            float x = (u * this.Width) - 0.5f;
+            float y = (v * this.Height) - 0.5f;
+
+            int x0 = (int)Math.Floor(x);
+            int y0 = (int)Math.Floor(y);
+            float fx = x - x0;
+            float fy = y - y0;
+
+            int x1 = this.ClampX(x0 + 1);
+            int y1 = this.ClampY(y0 + 1);
+            x0 = this.ClampX(x0);
+            y0 = this.ClampY(y0);
+
+            this.Interpolate(x0, x1, y0, y1, fx, fy, color, offset);
+        }
+
+        /// <summary>
+        /// Samples the image with bilinear filtering and wrapped coordinates, as a texture sampler in wrap mode does.
+        /// </summary>
+        /// <param name="u">The horizontal texture coordinate, repeated every unit.</param>
+        /// <param name="v">The vertical texture coordinate, repeated every unit.</param>
+        /// <param name="color">The array where the RGBA components are stored.</param>
+        /// <param name="offset">The index of the first component in the array.</param>
+        public void SampleWrapped(float u, float v, float[] color, int offset)
+        {
+            float x = (u * this.Width) - 0.5f;
+            float y = (v * this.Height) - 0.5f;
+
+            int x0 = (int)Math.Floor(x);
+            int y0 = (int)Math.Floor(y);
+            float fx = x - x0;
+            float fy = y - y0;
+
+            int x1 = Wrap(x0 + 1, this.Width);
+            int y1 = Wrap(y0 + 1, this.Height);
+            x0 = Wrap(x0, this.Width);
+            y0 = Wrap(y0, this.Height);
+
+            this.Interpolate(x0, x1, y0, y1, fx, fy, color, offset);
+        }
+
+        /// <summary>
+        /// Clamps a column to the image.
+        /// </summary>
+        /// <param name="x">The column.</param>
+        /// <returns>The clamped column</returns>
+        public int ClampX(int x)
+        {
+            return x < 0 ? 0 : (x >= this.Width ? this.Width - 1 : x);
+        }
+
+        /// <summary>
+        /// Clamps a row to the image.
+        /// </summary>
+        /// <param name="y">The row.</param>
+        /// <returns>The clamped row</returns>
+        public int ClampY(int y)
+        {
+            return y < 0 ? 0 : (y >= this.Height ? this.Height - 1 : y);
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Wraps a coordinate to a range
+        /// </summary>
+        /// <param name="value">The coordinate.</param>
+        /// <param name="size">The size of the range.</param>
+        /// <returns>The wrapped coordinate</returns>
+        private static int Wrap(int value, int size)
+        {
+            int wrapped = value % size;
+            return wrapped < 0 ? wrapped + size : wrapped;
+        }
+
+        /// <summary>
+        /// Interpolates four pixels of the image
+        /// </summary>
+        /// <param name="x0">The left column.</param>
+        /// <param name="x1">The right column.</param>
+        /// <param name="y0">The top row.</param>
+        /// <param name="y1">The bottom row.</param>
+        /// <param name="fx">The horizontal weight of the right column.</param>
+        /// <param name="fy">The vertical weight of the bottom row.</param>
+        /// <param name="color">The array where the RGBA components are stored.</param>
+        /// <param name="offset">The index of the first component in the array.</param>
+        private void Interpolate(int x0, int x1, int y0, int y1, float fx, float fy, float[] color, int offset)
+        {
+            var pixels = this.Pixels;
+            int i00 = ((y0 * this.Width) + x0) * Channels;
+            int i10 = ((y0 * this.Width) + x1) * Channels;
+            int i01 = ((y1 * this.Width) + x0) * Channels;
+            int i11 = ((y1 * this.Width) + x1) * Channels;
+
+            for (int c = 0; c < Channels; c++)
+            {
+                float top = pixels[i00 + c] + ((pixels[i10 + c] - pixels[i00 + c]) * fx);
+                float bottom = pixels[i01 + c] + ((pixels[i11 + c] - pixels[i01 + c]) * fx);
+                color[offset + c] = top + ((bottom - top) * fy);
+            }
+        }
+        #endregion
+    }
+}
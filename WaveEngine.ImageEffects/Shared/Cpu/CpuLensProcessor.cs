@@ -0,0 +1,2107 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading.Tasks;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework.Graphics;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// CPU reference implementation of the lenses, for environments without a graphics device.
+    /// </summary>
+    /// <remarks>
+    /// Each method reproduces the shaders of a lens, with the same parameters, on a <see cref="CpuImage"/>.
+    /// The textures that the materials load from assets, like the normals of the distortion, are given as properties of the processor.
+    /// Images are processed in tiles of rows in parallel, and blurs are applied as two separable passes.
+    /// The throughput of each lens is measured in megapixels per second.
+    /// Chains of lenses fuse consecutive pointwise lenses in a single pass. The intermediate images of the CPU are float,
+    /// so the fused output matches rendering the lenses one by one on the CPU. A GPU chain stores every pass in an 8 bits
+    /// per channel render target, so it can differ from the fused output by the quantization and saturation between passes.
+    /// </remarks>
+    public class CpuLensProcessor
+    {
+        /// <summary>
+        /// The default number of rows of a tile
+        /// </summary>
+        private const int DefaultRowsPerTile = 16;
+
+        /// <summary>
+        /// Number of weights of the gaussian blur shader
+        /// </summary>
+        private const int GaussianBlurTaps = 14;
+
+        /// <summary>
+        /// Number of samples of the circular blur of the bloom, glow, fast blur and tilt shift shaders
+        /// </summary>
+        private const int CircleBlurSamples = 15;
+
+        /// <summary>
+        /// The color correction table used when none is given, as the default table of the <see cref="ColorCorrectionLens"/>
+        /// </summary>
+        private static readonly CpuImage DefaultColorTable = CreateColorTable(16);
+
+        /// <summary>
+        /// The throughput of the last render of each lens, in megapixels per second
+        /// </summary>
+        private Dictionary<Type, double> throughput;
+
+        /// <summary>
+        /// Measures the render time
+        /// </summary>
+        private Stopwatch stopwatch;
+
+        /// <summary>
+        /// Generates the grain offsets and intensities, with the seed of the film grain material
+        /// </summary>
+        private Random grainRandom;
+
+        /// <summary>
+        /// Applies a pointwise lens to a pixel, in place
+        /// </summary>
+        /// <param name="pixels">The RGBA pixels.</param>
+        /// <param name="index">The index of the first component of the pixel.</param>
+        /// <param name="u">The horizontal texture coordinate of the pixel center.</param>
+        /// <param name="v">The vertical texture coordinate of the pixel center.</param>
+        /// <param name="tap">Scratch RGBA components for the texture samples.</param>
+        private delegate void PixelOperation(float[] pixels, int index, float u, float v, float[] tap);
+
+        /// <summary>
+        /// Computes a pixel of a pass, as a pixel shader does
+        /// </summary>
+        /// <param name="u">The horizontal texture coordinate of the pixel center.</param>
+        /// <param name="v">The vertical texture coordinate of the pixel center.</param>
+        /// <param name="tap">Scratch RGBA components for the texture samples.</param>
+        /// <param name="pixels">The RGBA pixels of the destination.</param>
+        /// <param name="index">The index of the first component of the pixel.</param>
+        private delegate void PixelShader(float u, float v, float[] tap, float[] pixels, int index);
+
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the number of rows processed by each parallel task.
+        /// </summary>
+        public int RowsPerTile { get; set; }
+
+        /// <summary>
+        /// Gets or sets a value indicating whether consecutive pointwise lenses of a chain are rendered in a single pass.
+        /// </summary>
+        public bool FuseLenses { get; set; }
+
+        /// <summary>
+        /// Gets the number of passes saved by fusing lenses in the last rendered chain.
+        /// </summary>
+        public int PassesSaved { get; private set; }
+
+        /// <summary>
+        /// Gets or sets the normal map of the <see cref="DistortionLens"/>, whose red and green components displace the source.
+        /// </summary>
+        public CpuImage DistortionNormal { get; set; }
+
+        /// <summary>
+        /// Gets or sets the grain texture of the <see cref="FilmGrainLens"/>, repeated over the image.
+        /// </summary>
+        public CpuImage FilmGrainTexture { get; set; }
+
+        /// <summary>
+        /// Gets or sets the table of the <see cref="ColorCorrectionLens"/>, or null to use the identity table of 16 entries.
+        /// The table of N entries per channel is a strip of N slices of N x N texels, one per blue entry, as the RGBTable16x1 texture.
+        /// </summary>
+        public CpuImage ColorCorrectionTable { get; set; }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CpuLensProcessor"/> class.
+        /// </summary>
+        public CpuLensProcessor()
+        {
+            this.throughput = new Dictionary<Type, double>();
+            this.stopwatch = new Stopwatch();
+            this.RowsPerTile = DefaultRowsPerTile;
+            this.FuseLenses = true;
+            this.grainRandom = new Random(23);
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Gets the throughput of the last render of a lens.
+        /// </summary>
+        /// <param name="lensType">The type of the lens.</param>
+        /// <returns>The throughput in megapixels per second, or 0 if the lens has not been rendered</returns>
+        public double GetMegapixelsPerSecond(Type lensType)
+        {
+            double value;
+            this.throughput.TryGetValue(lensType, out value);
+            return value;
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether a lens only depends on the pixel being shaded, so it can be fused with its neighbours in a chain.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <returns><c>true</c> if the lens is pointwise</returns>
+        public static bool IsPointwise(Lens lens)
+        {
+            return lens is GrayScaleLens
+                || lens is InvertLens
+                || lens is SepiaLens
+                || lens is ToneMappingLens
+                || lens is PosterizeLens
+                || lens is VignetteLens
+                || lens is ScanlinesLens
+                || lens is FilmGrainLens
+                || lens is ColorCorrectionLens
+                || lens is FusedPointwiseLens;
+        }
+
+        /// <summary>
+        /// Creates a color correction table that leaves the colors unchanged, with the layout of <see cref="ColorCorrectionTable"/>.
+        /// </summary>
+        /// <param name="size">The number of entries per channel.</param>
+        /// <returns>The table</returns>
+        public static CpuImage CreateColorTable(int size)
+        {
+            if (size < 2)
+            {
+                throw new ArgumentOutOfRangeException("size");
+            }
+
+            var table = new CpuImage(size * size, size);
+            for (int g = 0; g < size; g++)
+            {
+                for (int b = 0; b < size; b++)
+                {
+                    for (int r = 0; r < size; r++)
+                    {
+                        int i = ((g * table.Width) + (b * size) + r) * CpuImage.Channels;
+                        table.Pixels[i] = r / (size - 1f);
+                        table.Pixels[i + 1] = g / (size - 1f);
+                        table.Pixels[i + 2] = b / (size - 1f);
+                        table.Pixels[i + 3] = 1;
+                    }
+                }
+            }
+
+            return table;
+        }
+
+        /// <summary>
+        /// Gets the number of passes needed to render a chain of lenses.
+        /// </summary>
+        /// <param name="lenses">The lenses, in render order.</param>
+        /// <param name="fuse">Whether consecutive pointwise lenses are fused in a single pass.</param>
+        /// <returns>The number of passes</returns>
+        public static int GetPassCount(IList<Lens> lenses, bool fuse)
+        {
+            if (lenses == null)
+            {
+                throw new ArgumentNullException("lenses");
+            }
+
+            int passes = 0;
+            bool previousPointwise = false;
+
+            for (int i = 0; i < lenses.Count; i++)
+            {
+                bool pointwise = fuse && IsPointwise(lenses[i]);
+                if (!pointwise || !previousPointwise)
+                {
+                    passes++;
+                }
+
+                previousPointwise = pointwise;
+            }
+
+            return passes;
+        }
+
+        /// <summary>
+        /// Renders a chain of lenses. When <see cref="FuseLenses"/> is set, each run of consecutive pointwise lenses
+        /// is evaluated in a single pass that applies the lenses in sequence to every pixel.
+        /// </summary>
+        /// <param name="lenses">The lenses, in render order.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(IList<Lens> lenses, CpuImage source, CpuImage destination)
+        {
+            if (lenses == null)
+            {
+                throw new ArgumentNullException("lenses");
+            }
+
+            if (lenses.Count == 0)
+            {
+                throw new ArgumentException("The chain must contain at least one lens", "lenses");
+            }
+
+            int passes = GetPassCount(lenses, this.FuseLenses);
+            var input = source;
+            CpuImage spare = null;
+            int pass = 0;
+            int first = 0;
+
+            while (first < lenses.Count)
+            {
+                int end = first + 1;
+                if (this.FuseLenses && IsPointwise(lenses[first]))
+                {
+                    while (end < lenses.Count && IsPointwise(lenses[end]))
+                    {
+                        end++;
+                    }
+                }
+
+                pass++;
+                CpuImage output;
+                if (pass == passes)
+                {
+                    output = destination;
+                }
+                else
+                {
+                    if (spare == null)
+                    {
+                        spare = new CpuImage(source.Width, source.Height);
+                    }
+
+                    output = spare;
+                }
+
+                if (end - first > 1)
+                {
+                    this.RenderPointwise(lenses, first, end, input, output);
+                }
+                else
+                {
+                    this.RenderLens(lenses[first], input, output);
+                }
+
+                // The previous input can be reused as the next output, except the caller source
+                spare = input != source ? input : null;
+                input = output;
+                first = end;
+            }
+
+            this.PassesSaved = lenses.Count - passes;
+        }
+
+        /// <summary>
+        /// Builds the levels of a <see cref="BlurPyramid"/>. Each level halves the size of the previous one
+        /// with the dual filter of the <see cref="DualFilterMaterial"/>: the center tap weighs 4 and the diagonal taps, one source texel away, weigh 1.
+        /// </summary>
+        /// <param name="source">The source image.</param>
+        /// <param name="levels">The number of levels.</param>
+        /// <returns>The levels, the first one is the source</returns>
+        public CpuImage[] BuildPyramid(CpuImage source, int levels)
+        {
+            if (source == null)
+            {
+                throw new ArgumentNullException("source");
+            }
+
+            if (levels < 0)
+            {
+                throw new ArgumentOutOfRangeException("levels");
+            }
+
+            var pyramid = new CpuImage[levels + 1];
+            pyramid[0] = source;
+
+            for (int level = 1; level <= levels; level++)
+            {
+                var previous = pyramid[level - 1];
+                var current = new CpuImage(Math.Max(1, source.Width >> level), Math.Max(1, source.Height >> level));
+
+                float offsetU = 1f / previous.Width;
+                float offsetV = 1f / previous.Height;
+
+                this.ForEachTile(current.Height, (firstRow, endRow) =>
+                {
+                    var dst = current.Pixels;
+                    var tap = new float[CpuImage.Channels];
+                    for (int y = firstRow; y < endRow; y++)
+                    {
+                        float v = (y + 0.5f) / current.Height;
+                        for (int x = 0; x < current.Width; x++)
+                        {
+                            float u = (x + 0.5f) / current.Width;
+                            int index = ((y * current.Width) + x) * CpuImage.Channels;
+
+                            previous.Sample(u, v, dst, index);
+                            for (int c = 0; c < CpuImage.Channels; c++)
+                            {
+                                dst[index + c] *= 4;
+                            }
+
+                            for (int corner = 0; corner < 4; corner++)
+                            {
+                                previous.Sample(u + ((corner & 1) == 0 ? -offsetU : offsetU), v + (corner < 2 ? -offsetV : offsetV), tap, 0);
+                                for (int c = 0; c < CpuImage.Channels; c++)
+                                {
+                                    dst[index + c] += tap[c];
+                                }
+                            }
+
+                            for (int c = 0; c < CpuImage.Channels; c++)
+                            {
+                                dst[index + c] *= 0.125f;
+                            }
+                        }
+                    }
+                });
+
+                pyramid[level] = current;
+            }
+
+            return pyramid;
+        }
+
+        /// <summary>
+        /// Upsamples the result of a lens rendered at a reduced resolution, weighting the bilinear taps by their depth similarity
+        /// so the low resolution texels of a different surface do not bleed across depth edges.
+        /// </summary>
+        /// <param name="lowResolution">The low resolution image.</param>
+        /// <param name="lowResolutionDepth">The depth of the low resolution texels, in the red channel.</param>
+        /// <param name="depth">The full resolution depth, in the red channel.</param>
+        /// <param name="destination">The full resolution destination image, with the size of <paramref name="depth"/>.</param>
+        /// <param name="depthSigma">The depth difference where the weight of a tap falls to 60%.</param>
+        public void BilateralUpsample(CpuImage lowResolution, CpuImage lowResolutionDepth, CpuImage depth, CpuImage destination, float depthSigma)
+        {
+            if (lowResolution == null)
+            {
+                throw new ArgumentNullException("lowResolution");
+            }
+
+            if (lowResolutionDepth == null)
+            {
+                throw new ArgumentNullException("lowResolutionDepth");
+            }
+
+            if (depth == null)
+            {
+                throw new ArgumentNullException("depth");
+            }
+
+            if (destination == null)
+            {
+                throw new ArgumentNullException("destination");
+            }
+
+            if (depthSigma <= 0)
+            {
+                throw new ArgumentOutOfRangeException("depthSigma");
+            }
+
+            if (lowResolutionDepth.Width != lowResolution.Width || lowResolutionDepth.Height != lowResolution.Height)
+            {
+                throw new ArgumentException("The low resolution depth must have the size of the low resolution image", "lowResolutionDepth");
+            }
+
+            if (depth.Width != destination.Width || depth.Height != destination.Height)
+            {
+                throw new ArgumentException("The destination must have the size of the depth", "destination");
+            }
+
+            float inverseVariance = 1.0f / (2 * depthSigma * depthSigma);
+            int lowWidth = lowResolution.Width;
+            var low = lowResolution.Pixels;
+            var lowDepth = lowResolutionDepth.Pixels;
+            var fullDepth = depth.Pixels;
+
+            this.ForEachTile(destination.Height, (firstRow, endRow) =>
+            {
+                var dst = destination.Pixels;
+                var taps = new int[4];
+                var weights = new float[4];
+
+                for (int y = firstRow; y < endRow; y++)
+                {
+                    float ly = (((y + 0.5f) / destination.Height) * lowResolution.Height) - 0.5f;
+                    int y0 = (int)Math.Floor(ly);
+                    float fy = ly - y0;
+                    int y1 = lowResolution.ClampY(y0 + 1);
+                    y0 = lowResolution.ClampY(y0);
+
+                    for (int x = 0; x < destination.Width; x++)
+                    {
+                        float lx = (((x + 0.5f) / destination.Width) * lowWidth) - 0.5f;
+                        int x0 = (int)Math.Floor(lx);
+                        float fx = lx - x0;
+                        int x1 = lowResolution.ClampX(x0 + 1);
+                        x0 = lowResolution.ClampX(x0);
+
+                        taps[0] = ((y0 * lowWidth) + x0) * CpuImage.Channels;
+                        taps[1] = ((y0 * lowWidth) + x1) * CpuImage.Channels;
+                        taps[2] = ((y1 * lowWidth) + x0) * CpuImage.Channels;
+                        taps[3] = ((y1 * lowWidth) + x1) * CpuImage.Channels;
+                        weights[0] = (1 - fx) * (1 - fy);
+                        weights[1] = fx * (1 - fy);
+                        weights[2] = (1 - fx) * fy;
+                        weights[3] = fx * fy;
+
+                        int i = ((y * destination.Width) + x) * CpuImage.Channels;
+                        float pixelDepth = fullDepth[i];
+                        float total = 0;
+                        int closest = 0;
+                        float closestDifference = float.MaxValue;
+
+                        for (int t = 0; t < 4; t++)
+                        {
+                            float difference = Math.Abs(lowDepth[taps[t]] - pixelDepth);
+                            if (difference < closestDifference)
+                            {
+                                closestDifference = difference;
+                                closest = t;
+                            }
+
+                            weights[t] *= (float)Math.Exp(-difference * difference * inverseVariance);
+                            total += weights[t];
+                        }
+
+                        if (total < 1e-6f)
+                        {
+                            // No tap belongs to the surface of the pixel, the nearest in depth is used
+                            weights[0] = weights[1] = weights[2] = weights[3] = 0;
+                            weights[closest] = 1;
+                            total = 1;
+                        }
+
+                        for (int c = 0; c < CpuImage.Channels; c++)
+                        {
+                            float value = 0;
+                            for (int t = 0; t < 4; t++)
+                            {
+                                value += low[taps[t] + c] * weights[t];
+                            }
+
+                            dst[i + c] = value / total;
+                        }
+                    }
+                }
+            });
+        }
+
+        /// <summary>
+        /// Renders a <see cref="GrayScaleLens"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(GrayScaleLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders an <see cref="InvertLens"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(InvertLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="SepiaLens"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(SepiaLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="ToneMappingLens"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(ToneMappingLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="PosterizeLens"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(PosterizeLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="VignetteLens"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(VignetteLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="ScanlinesLens"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(ScanlinesLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="FusedPointwiseLens"/>. The stages are evaluated as the fused shader does, saturating every stage,
+        /// so the result matches the fused lenses rendered one by one and saturated after each pass.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(FusedPointwiseLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="ConvolutionLens"/>. The filters sample the neighbour pixels.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(ConvolutionLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            var filter = lens.Filter;
+            float scale = lens.Scale;
+
+            this.ForEachTile(source.Height, (firstRow, endRow) =>
+            {
+                var dst = destination.Pixels;
+                var sum = new float[CpuImage.Channels];
+
+                for (int y = firstRow; y < endRow; y++)
+                {
+                    for (int x = 0; x < source.Width; x++)
+                    {
+                        int i = ((y * source.Width) + x) * CpuImage.Channels;
+                        Convolve(filter, scale, source, x, y, sum);
+
+                        dst[i] = sum[0];
+                        dst[i + 1] = sum[1];
+                        dst[i + 2] = sum[2];
+                        dst[i + 3] = sum[3];
+                    }
+                }
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="GaussianBlurLens"/> as a horizontal and a vertical pass.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(GaussianBlurLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            float[] offsets;
+            float[] weights;
+            if (lens.Sigma > 0)
+            {
+                var kernel = GaussianKernel.Create(lens.Sigma, GaussianBlurMaterial.MaxTaps);
+                offsets = new float[kernel.TapCount];
+                weights = kernel.Weights;
+                for (int i = 0; i < offsets.Length; i++)
+                {
+                    offsets[i] = kernel.Offsets[i] * lens.Factor;
+                }
+            }
+            else
+            {
+                ComputeGaussianBlur(lens.Factor, out offsets, out weights);
+            }
+
+            var temporal = new CpuImage(source.Width, source.Height);
+            this.BlurPass(source, temporal, true, offsets, weights);
+            this.BlurPass(temporal, destination, false, offsets, weights);
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Applies a separable gaussian blur with the full discrete kernel, one texel per tap.
+        /// It is the reference for the linear sampling taps of <see cref="GaussianKernel"/>.
+        /// </summary>
+        /// <param name="sigma">The standard deviation, in texels.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void RenderDiscreteGaussian(float sigma, CpuImage source, CpuImage destination)
+        {
+            if (sigma <= 0)
+            {
+                throw new ArgumentOutOfRangeException("sigma");
+            }
+
+            if (source == null)
+            {
+                throw new ArgumentNullException("source");
+            }
+
+            if (destination == null)
+            {
+                throw new ArgumentNullException("destination");
+            }
+
+            int radius = (int)Math.Ceiling(3 * sigma);
+            var offsets = new float[(radius * 2) + 1];
+            var weights = new float[(radius * 2) + 1];
+            double total = 0;
+
+            for (int k = -radius; k <= radius; k++)
+            {
+                double weight = Math.Exp(-(k * k) / (2.0 * sigma * sigma));
+                offsets[k + radius] = k;
+                weights[k + radius] = (float)weight;
+                total += weight;
+            }
+
+            for (int i = 0; i < weights.Length; i++)
+            {
+                weights[i] = (float)(weights[i] / total);
+            }
+
+            var temporal = new CpuImage(source.Width, source.Height);
+            this.BlurPass(source, temporal, true, offsets, weights);
+            this.BlurPass(temporal, destination, false, offsets, weights);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="BloomLens"/>: a bright pass at a quarter of the resolution, a circular blur and an upsampled combine.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(BloomLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            int width = Math.Max(1, source.Width / 4);
+            int height = Math.Max(1, source.Height / 4);
+            var bright = new CpuImage(width, height);
+            var bloom = new CpuImage(width, height);
+
+            float threshold = lens.BloomThreshold;
+            Vector3 tint = lens.BloomTint;
+            float intensity = lens.Intensity;
+
+            // Down sampler
+            this.ForEachTile(height, (firstRow, endRow) =>
+            {
+                var color = new float[CpuImage.Channels];
+                var dst = bright.Pixels;
+
+                for (int y = firstRow; y < endRow; y++)
+                {
+                    for (int x = 0; x < width; x++)
+                    {
+                        source.Sample((x + 0.5f) / width, (y + 0.5f) / height, color, 0);
+
+                        float luminance = (color[0] * 0.3f) + (color[1] * 0.59f) + (color[2] * 0.11f);
+                        float amount = MathHelper.Clamp((luminance - threshold) * 0.5f, 0, 1);
+
+                        int i = ((y * width) + x) * CpuImage.Channels;
+                        dst[i] = color[0] * amount;
+                        dst[i + 1] = color[1] * amount;
+                        dst[i + 2] = color[2] * amount;
+                        dst[i + 3] = 1;
+                    }
+                }
+            });
+
+            // Bloom, the sample offsets are relative to the size of the source as in the material
+            float scale = 0.66f * lens.BloomScale * 2.0f;
+            this.CircleBlur(bright, bloom, scale / source.Width, scale / source.Height);
+
+            // Up sampler and combine
+            this.ForEachTile(source.Height, (firstRow, endRow) =>
+            {
+                var color = new float[CpuImage.Channels];
+                var src = source.Pixels;
+                var dst = destination.Pixels;
+
+                for (int y = firstRow; y < endRow; y++)
+                {
+                    for (int x = 0; x < source.Width; x++)
+                    {
+                        bloom.Sample((x + 0.5f) / source.Width, (y + 0.5f) / source.Height, color, 0);
+
+                        int i = ((y * source.Width) + x) * CpuImage.Channels;
+                        dst[i] = src[i] + (color[0] * tint.X * intensity);
+                        dst[i + 1] = src[i + 1] + (color[1] * tint.Y * intensity);
+                        dst[i + 2] = src[i + 2] + (color[2] * tint.Z * intensity);
+                        dst[i + 3] = 1;
+                    }
+                }
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="FilmGrainLens"/> with the <see cref="FilmGrainTexture"/>. The grain offset and intensity are random on every render, as in the material.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(FilmGrainLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="ColorCorrectionLens"/> with the <see cref="ColorCorrectionTable"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(ColorCorrectionLens lens, CpuImage source, CpuImage destination)
+        {
+            this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="ChromaticAberrationLens"/>: the red and blue channels are sampled apart from the center, by the square of the distance.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(ChromaticAberrationLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            float offsetU = lens.AberrationStrength / source.Width;
+            float offsetV = lens.AberrationStrength / source.Height;
+
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                float x = (u - 0.5f) * 2;
+                float y = (v - 0.5f) * 2;
+                float distance = (x * x) + (y * y);
+                float shiftU = offsetU * distance * x;
+                float shiftV = offsetV * distance * y;
+
+                source.Sample(u - shiftU, v - shiftV, tap, 0);
+                pixels[i] = tap[0];
+                source.Sample(u, v, tap, 0);
+                pixels[i + 1] = tap[1];
+                source.Sample(u + shiftU, v + shiftV, tap, 0);
+                pixels[i + 2] = tap[2];
+                pixels[i + 3] = 1;
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="DistortionLens"/>, displacing the source by the <see cref="DistortionNormal"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(DistortionLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            var normal = this.DistortionNormal;
+            if (normal == null)
+            {
+                throw new InvalidOperationException("The distortion lens needs the DistortionNormal image");
+            }
+
+            float power = lens.Power;
+
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                normal.Sample(u, v, tap, 0);
+                float shiftU = (tap[0] - 0.5f) * power;
+                float shiftV = (tap[1] - 0.5f) * power;
+
+                source.Sample(u + shiftU, v + shiftV, pixels, i);
+                pixels[i + 3] = 1;
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="FishEyeLens"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(FishEyeLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            // The lens computes the aspect ratio with an integer division
+            float aspectRatio = source.Width / source.Height;
+            float intensityX = lens.StrengthX * aspectRatio;
+            float intensityY = lens.StrengthY * aspectRatio;
+
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                float x = (u - 0.5f) * 2;
+                float y = (v - 0.5f) * 2;
+                float shiftU = (1 - (y * y)) * intensityY * x;
+                float shiftV = (1 - (x * x)) * intensityX * y;
+
+                source.Sample(u - shiftU, v - shiftV, pixels, i);
+                pixels[i + 3] = 1;
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="PixelateLens"/>: every block of <see cref="PixelateLens.PixelSize"/> pixels takes the color of its corner.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(PixelateLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            float blocksU = source.Width / lens.PixelSize.X;
+            float blocksV = source.Height / lens.PixelSize.Y;
+
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                source.Sample((float)Math.Floor(u * blocksU) / blocksU, (float)Math.Floor(v * blocksV) / blocksV, pixels, i);
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="RadialBlurLens"/>, averaging samples scaled away from the center.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(RadialBlurLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            // The shader divides by zero with less than two samples, the center is sampled once instead
+            int samples = Math.Max(1, lens.Nsamples);
+            float step = samples > 1 ? lens.BlurWidth / (samples - 1) : 0;
+            Vector2 center = lens.Center;
+
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                float r = 0, g = 0, b = 0;
+
+                for (int s = 0; s < samples; s++)
+                {
+                    float scale = 1 + (s * step);
+                    source.Sample(((u - center.X) * scale) + center.X, ((v - center.Y) * scale) + center.Y, tap, 0);
+                    r += tap[0];
+                    g += tap[1];
+                    b += tap[2];
+                }
+
+                pixels[i] = r / samples;
+                pixels[i + 1] = g / samples;
+                pixels[i + 2] = b / samples;
+                pixels[i + 3] = 1;
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="SobelLens"/> with the luma of the neighbour pixels.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(SobelLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            float offsetU = 1f / source.Width;
+            float offsetV = 1f / source.Height;
+            var effect = lens.Effect;
+            float threshold = lens.Threshold;
+
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                float s00 = Luma(source, u - offsetU, v - offsetV, tap);
+                float s01 = Luma(source, u, v - offsetV, tap);
+                float s02 = Luma(source, u + offsetU, v - offsetV, tap);
+                float s10 = Luma(source, u - offsetU, v, tap);
+                float s12 = Luma(source, u + offsetU, v, tap);
+                float s20 = Luma(source, u - offsetU, v + offsetV, tap);
+                float s21 = Luma(source, u, v + offsetV, tap);
+                float s22 = Luma(source, u + offsetU, v + offsetV, tap);
+
+                float sobelX = s00 + (2 * s10) + s20 - s02 - (2 * s12) - s22;
+                float sobelY = s00 + (2 * s01) + s02 - s20 - (2 * s21) - s22;
+                float edgeSquared = (sobelX * sobelX) + (sobelY * sobelY);
+
+                if (effect == SobelMaterial.SobelEffect.Sobel)
+                {
+                    float edge = (float)Math.Sqrt(edgeSquared);
+                    pixels[i] = edge;
+                    pixels[i + 1] = edge;
+                    pixels[i + 2] = edge;
+                    pixels[i + 3] = edge;
+                }
+                else if (edgeSquared > threshold)
+                {
+                    pixels[i] = 0;
+                    pixels[i + 1] = 0;
+                    pixels[i + 2] = 0;
+                    pixels[i + 3] = 1;
+                }
+                else
+                {
+                    if (effect == SobelMaterial.SobelEffect.SobelEdgeColor)
+                    {
+                        source.Sample(u, v, pixels, i);
+                    }
+                    else
+                    {
+                        pixels[i] = 1;
+                        pixels[i + 1] = 1;
+                        pixels[i + 2] = 1;
+                    }
+
+                    pixels[i + 3] = 1;
+                }
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="TilingLens"/>: every tile takes the color of its center, with a bevel of the edge color.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(TilingLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            float size = 1.0f / lens.NumTiles;
+            float threshold = lens.Threshhold;
+            Vector3 edgeColor = lens.EdgeColor;
+
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                float baseU = u - (u % size);
+                float baseV = v - (v % size);
+                float tileU = (u - baseU) / size;
+                float tileV = (v - baseV) / size;
+
+                // The bevel is added on the top right half of the tile, lit near its top and left sides and shadowed near its bottom and right sides
+                float bevel = 0;
+                if (tileU > tileV)
+                {
+                    if (tileU < threshold || tileV < threshold)
+                    {
+                        bevel++;
+                    }
+
+                    if (tileU > 1 - threshold || tileV > 1 - threshold)
+                    {
+                        bevel--;
+                    }
+                }
+
+                source.Sample(baseU + (size / 2), baseV + (size / 2), pixels, i);
+                pixels[i] += (1 - edgeColor.X) * bevel;
+                pixels[i + 1] += (1 - edgeColor.Y) * bevel;
+                pixels[i + 2] += (1 - edgeColor.Z) * bevel;
+                pixels[i + 3] += bevel;
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="FastBlurLens"/> as a single circular blur.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(FastBlurLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            float scale = 0.66f * lens.BlurScale * 2.0f;
+            this.CircleBlur(source, destination, scale / source.Width, scale / source.Height);
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="GlowLens"/>: the color weighted by its alpha at a quarter of the resolution, a circular blur and an upsampled combine.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(GlowLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            var down = new CpuImage(Math.Max(1, source.Width / 4), Math.Max(1, source.Height / 4));
+            var glow = new CpuImage(down.Width, down.Height);
+
+            // Down sampler
+            this.ForEachPixel(down, (u, v, tap, pixels, i) =>
+            {
+                source.Sample(u, v, tap, 0);
+                pixels[i] = tap[0] * tap[3];
+                pixels[i + 1] = tap[1] * tap[3];
+                pixels[i + 2] = tap[2] * tap[3];
+                pixels[i + 3] = 1;
+            });
+
+            // Blur, the sample offsets are relative to the size of the source as in the material
+            float scale = 0.66f * lens.GlowScale * 2.0f;
+            this.CircleBlur(down, glow, scale / source.Width, scale / source.Height);
+
+            // Up sampler and combine
+            float intensity = lens.Intensity;
+            var src = source.Pixels;
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                glow.Sample(u, v, tap, 0);
+                pixels[i] = src[i] + (tap[0] * intensity);
+                pixels[i + 1] = src[i + 1] + (tap[1] * intensity);
+                pixels[i + 2] = src[i + 2] + (tap[2] * intensity);
+                pixels[i + 3] = 1;
+            });
+
+            this.EndRender(lens, source);
+        }
+
+        /// <summary>
+        /// Renders a <see cref="TiltShiftLens"/>: a circular blur at a reduced resolution, blended with the source away from the tilt position.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        public void Render(TiltShiftLens lens, CpuImage source, CpuImage destination)
+        {
+            this.BeginRender(lens, source, destination);
+
+            int width = Math.Max(1, (int)(source.Width / lens.DownSampleScale));
+            int height = Math.Max(1, (int)(source.Height / lens.DownSampleScale));
+            var down = new CpuImage(width, height);
+            var blur = new CpuImage(width, height);
+
+            // Down sampler
+            this.ForEachPixel(down, (u, v, tap, pixels, i) =>
+            {
+                source.Sample(u, v, pixels, i);
+            });
+
+            // Fast blur, with the fixed scale of the shader
+            float scale = 0.66f * 4.0f * 2.0f * lens.BlurScale;
+            this.CircleBlur(down, blur, scale / source.Width, scale / source.Height);
+
+            // Tilt shift
+            float power = lens.Power;
+            float tiltPosition = lens.TiltPosition;
+            var src = source.Pixels;
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                float focus = MathHelper.Clamp((float)Math.Cos((v - tiltPosition) * Math.PI), 0, 1);
+                focus = (float)Math.Pow(focus, power);
+
+                blur.Sample(u, v, tap, 0);
+                pixels[i] = tap[0] + ((src[i] - tap[0]) * focus);
+                pixels[i + 1] = tap[1] + ((src[i + 1] - tap[1]) * focus);
+                pixels[i + 2] = tap[2] + ((src[i + 2] - tap[2]) * focus);
+                pixels[i + 3] = 1;
+            });
+
+            this.EndRender(lens, source);
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Renders any supported lens
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        private void RenderLens(Lens lens, CpuImage source, CpuImage destination)
+        {
+            if (IsPointwise(lens))
+            {
+                this.RenderPointwise(new Lens[] { lens }, 0, 1, source, destination);
+            }
+            else if (lens is ConvolutionLens)
+            {
+                this.Render((ConvolutionLens)lens, source, destination);
+            }
+            else if (lens is GaussianBlurLens)
+            {
+                this.Render((GaussianBlurLens)lens, source, destination);
+            }
+            else if (lens is BloomLens)
+            {
+                this.Render((BloomLens)lens, source, destination);
+            }
+            else if (lens is ChromaticAberrationLens)
+            {
+                this.Render((ChromaticAberrationLens)lens, source, destination);
+            }
+            else if (lens is DistortionLens)
+            {
+                this.Render((DistortionLens)lens, source, destination);
+            }
+            else if (lens is FishEyeLens)
+            {
+                this.Render((FishEyeLens)lens, source, destination);
+            }
+            else if (lens is PixelateLens)
+            {
+                this.Render((PixelateLens)lens, source, destination);
+            }
+            else if (lens is RadialBlurLens)
+            {
+                this.Render((RadialBlurLens)lens, source, destination);
+            }
+            else if (lens is SobelLens)
+            {
+                this.Render((SobelLens)lens, source, destination);
+            }
+            else if (lens is TilingLens)
+            {
+                this.Render((TilingLens)lens, source, destination);
+            }
+            else if (lens is FastBlurLens)
+            {
+                this.Render((FastBlurLens)lens, source, destination);
+            }
+            else if (lens is GlowLens)
+            {
+                this.Render((GlowLens)lens, source, destination);
+            }
+            else if (lens is TiltShiftLens)
+            {
+                this.Render((TiltShiftLens)lens, source, destination);
+            }
+            else
+            {
+                throw new NotSupportedException(string.Format("The lens {0} has no CPU implementation", lens != null ? lens.GetType().Name : "null"));
+            }
+        }
+
+        /// <summary>
+        /// Renders a run of pointwise lenses in a single pass
+        /// </summary>
+        /// <param name="lenses">The lenses.</param>
+        /// <param name="first">The index of the first lens of the run.</param>
+        /// <param name="end">The index after the last lens of the run.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        private void RenderPointwise(IList<Lens> lenses, int first, int end, CpuImage source, CpuImage destination)
+        {
+            var operations = new PixelOperation[end - first];
+            for (int i = first; i < end; i++)
+            {
+                this.BeginRender(lenses[i], source, destination);
+
+                // The parameters are read on every render, so they can be animated
+                operations[i - first] = this.CreatePixelOperation(lenses[i], source);
+            }
+
+            var src = source.Pixels;
+            var dst = destination.Pixels;
+            int width = source.Width;
+            int height = source.Height;
+
+            this.ForEachTile(height, (firstRow, endRow) =>
+            {
+                var tap = new float[CpuImage.Channels];
+
+                for (int y = firstRow; y < endRow; y++)
+                {
+                    float v = (y + 0.5f) / height;
+
+                    for (int x = 0; x < width; x++)
+                    {
+                        float u = (x + 0.5f) / width;
+                        int i = ((y * width) + x) * CpuImage.Channels;
+
+                        dst[i] = src[i];
+                        dst[i + 1] = src[i + 1];
+                        dst[i + 2] = src[i + 2];
+                        dst[i + 3] = src[i + 3];
+
+                        for (int o = 0; o < operations.Length; o++)
+                        {
+                            operations[o](dst, i, u, v, tap);
+                        }
+                    }
+                }
+            });
+
+            for (int i = first; i < end; i++)
+            {
+                this.EndRender(lenses[i], source);
+            }
+        }
+
+        /// <summary>
+        /// Creates the pixel operation of a pointwise lens with its current parameters
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <returns>The pixel operation</returns>
+        private PixelOperation CreatePixelOperation(Lens lens, CpuImage source)
+        {
+            if (lens is GrayScaleLens)
+            {
+                return (pixels, i, u, v, tap) =>
+                {
+                    float grey = (pixels[i] * 0.3f) + (pixels[i + 1] * 0.59f) + (pixels[i + 2] * 0.11f);
+                    pixels[i] = grey;
+                    pixels[i + 1] = grey;
+                    pixels[i + 2] = grey;
+                    pixels[i + 3] = 1;
+                };
+            }
+
+            if (lens is InvertLens)
+            {
+                return (pixels, i, u, v, tap) =>
+                {
+                    pixels[i] = 1 - pixels[i];
+                    pixels[i + 1] = 1 - pixels[i + 1];
+                    pixels[i + 2] = 1 - pixels[i + 2];
+                    pixels[i + 3] = 1 - pixels[i + 3];
+                };
+            }
+
+            if (lens is SepiaLens)
+            {
+                var sepia = (SepiaLens)lens;
+                Vector3 imageTone = sepia.ImageTone;
+                Vector3 darkTone = sepia.DarkTone;
+                Vector3 greyTransfer = sepia.GreyTransfer;
+                float desaturation = sepia.Desaturation;
+                float toning = sepia.Toning;
+                float globalAlpha = sepia.GlobalAlpha;
+
+                return (pixels, i, u, v, tap) =>
+                {
+                    float r = pixels[i] * imageTone.X;
+                    float g = pixels[i + 1] * imageTone.Y;
+                    float b = pixels[i + 2] * imageTone.Z;
+
+                    float grey = (greyTransfer.X * r) + (greyTransfer.Y * g) + (greyTransfer.Z * b);
+
+                    float mutedR = r + ((grey - r) * desaturation);
+                    float mutedG = g + ((grey - g) * desaturation);
+                    float mutedB = b + ((grey - b) * desaturation);
+
+                    float sepiaR = darkTone.X + ((imageTone.X - darkTone.X) * grey);
+                    float sepiaG = darkTone.Y + ((imageTone.Y - darkTone.Y) * grey);
+                    float sepiaB = darkTone.Z + ((imageTone.Z - darkTone.Z) * grey);
+
+                    pixels[i] = mutedR + ((sepiaR - mutedR) * toning);
+                    pixels[i + 1] = mutedG + ((sepiaG - mutedG) * toning);
+                    pixels[i + 2] = mutedB + ((sepiaB - mutedB) * toning);
+                    pixels[i + 3] = globalAlpha;
+                };
+            }
+
+            if (lens is ToneMappingLens)
+            {
+                var toneMapping = (ToneMappingLens)lens;
+                var toneOperator = toneMapping.Operator;
+                float exposure = toneMapping.Exposure;
+                float inverseGamma = 1.0f / toneMapping.Gamma;
+
+                return (pixels, i, u, v, tap) =>
+                {
+                    ToneMap(toneOperator, exposure, inverseGamma, pixels, i);
+                    pixels[i + 3] = 1;
+                };
+            }
+
+            if (lens is PosterizeLens)
+            {
+                var posterize = (PosterizeLens)lens;
+                float gamma = posterize.Gamma;
+                float inverseGamma = 1.0f / gamma;
+                float regions = posterize.Regions;
+
+                return (pixels, i, u, v, tap) =>
+                {
+                    for (int c = 0; c < 3; c++)
+                    {
+                        float value = (float)Math.Pow(pixels[i + c], gamma);
+                        value = (float)Math.Floor(value * regions) / regions;
+                        pixels[i + c] = (float)Math.Pow(value, inverseGamma);
+                    }
+
+                    pixels[i + 3] = 1;
+                };
+            }
+
+            if (lens is VignetteLens)
+            {
+                var vignette = (VignetteLens)lens;
+                float power = vignette.Power;
+                float radio = vignette.Radio;
+
+                return (pixels, i, u, v, tap) =>
+                {
+                    float dx = (u - 0.5f) * radio;
+                    float dy = (v - 0.5f) * radio;
+                    float factor = 1 - (((dx * dx) + (dy * dy)) * power);
+
+                    pixels[i] *= factor;
+                    pixels[i + 1] *= factor;
+                    pixels[i + 2] *= factor;
+                    pixels[i + 3] *= factor;
+                };
+            }
+
+            if (lens is ScanlinesLens)
+            {
+                var scanlines = (ScanlinesLens)lens;
+                float linesFactor = scanlines.LinesFactor;
+                float attenuation = scanlines.Attenuation;
+
+                return (pixels, i, u, v, tap) =>
+                {
+                    float scanline = (float)Math.Sin(v * linesFactor) * attenuation;
+                    pixels[i] -= scanline;
+                    pixels[i + 1] -= scanline;
+                    pixels[i + 2] -= scanline;
+                    pixels[i + 3] = 1;
+                };
+            }
+
+            if (lens is FilmGrainLens)
+            {
+                var grain = this.FilmGrainTexture;
+                if (grain == null)
+                {
+                    throw new InvalidOperationException("The film grain lens needs the FilmGrainTexture image");
+                }
+
+                var filmGrain = (FilmGrainLens)lens;
+                float minimum = MathHelper.Clamp(filmGrain.GrainIntensityMin, 0.0f, 5.0f);
+                float maximum = MathHelper.Clamp(filmGrain.GrainIntensityMax, 0.0f, 5.0f);
+                float grainScale = 1.0f / MathHelper.Clamp(filmGrain.GrainSize, 0.1f, 50.0f);
+
+                float offsetU = (float)this.grainRandom.NextDouble();
+                float offsetV = (float)this.grainRandom.NextDouble();
+                float scaleU = (float)source.Width / grain.Width * grainScale;
+                float scaleV = (float)source.Height / grain.Height * grainScale;
+                float intensity = ((float)this.grainRandom.NextDouble() * (maximum - minimum)) + minimum;
+
+                return (pixels, i, u, v, tap) =>
+                {
+                    grain.SampleWrapped((u * scaleU) + offsetU, (v * scaleV) + offsetV, tap, 0);
+                    pixels[i] += ((tap[0] * 2) - 1) * intensity;
+                    pixels[i + 1] += ((tap[1] * 2) - 1) * intensity;
+                    pixels[i + 2] += ((tap[2] * 2) - 1) * intensity;
+                    pixels[i + 3] = 1;
+                };
+            }
+
+            if (lens is ColorCorrectionLens)
+            {
+                var table = this.ColorCorrectionTable ?? DefaultColorTable;
+                if (table.Height < 2 || table.Width != table.Height * table.Height)
+                {
+                    throw new InvalidOperationException("The color correction table must be a strip of N slices of N x N texels");
+                }
+
+                bool linear = ((ColorCorrectionLens)lens).ColorSpace == ColorCorrectionMaterial.ColorSpaceType.Linear;
+
+                return (pixels, i, u, v, tap) =>
+                {
+                    if (linear)
+                    {
+                        for (int c = 0; c < 3; c++)
+                        {
+                            pixels[i + c] = (float)Math.Sqrt(pixels[i + c]);
+                        }
+                    }
+
+                    SampleColorTable(table, pixels, i);
+
+                    if (linear)
+                    {
+                        for (int c = 0; c < 3; c++)
+                        {
+                            pixels[i + c] *= pixels[i + c];
+                        }
+                    }
+
+                    pixels[i + 3] = 1;
+                };
+            }
+
+            if (lens is FusedPointwiseLens)
+            {
+                var fused = (FusedPointwiseLens)lens;
+                fused.Stages.Update(fused.Lenses);
+                var constants = (float[])fused.Stages.Constants.Clone();
+                var table = this.ColorCorrectionTable ?? DefaultColorTable;
+
+                return (pixels, i, u, v, tap) => EvaluateStages(constants, table, pixels, i, u, v, tap);
+            }
+
+            throw new NotSupportedException(string.Format("The lens {0} is not pointwise", lens.GetType().Name));
+        }
+
+        /// <summary>
+        /// Evaluates the constants of a <see cref="FusedPointwiseStages"/> on a pixel, in place, as the fused shader does
+        /// </summary>
+        /// <param name="constants">The constants.</param>
+        /// <param name="table">The color correction table.</param>
+        /// <param name="pixels">The RGBA pixels.</param>
+        /// <param name="index">The index of the first component of the pixel.</param>
+        /// <param name="u">The horizontal texture coordinate of the pixel center.</param>
+        /// <param name="v">The vertical texture coordinate of the pixel center.</param>
+        /// <param name="tap">Scratch RGBA components.</param>
+        private static void EvaluateStages(float[] constants, CpuImage table, float[] pixels, int index, float u, float v, float[] tap)
+        {
+            float vignette = ((u - 0.5f) * (u - 0.5f)) + ((v - 0.5f) * (v - 0.5f));
+
+            for (int stage = 0; stage < FusedPointwiseStages.MaxStages; stage++)
+            {
+                int c = stage * FusedPointwiseStages.RegistersPerStage * 4;
+                float red = pixels[index];
+                float green = pixels[index + 1];
+                float blue = pixels[index + 2];
+
+                for (int row = 0; row < 3; row++)
+                {
+                    int r = c + (row * 4);
+                    tap[row] = (red * constants[r]) + (green * constants[r + 1]) + (blue * constants[r + 2]) + constants[r + 3];
+                }
+
+                tap[3] = (pixels[index + 3] * constants[c + 12]) + constants[c + 13];
+
+                float factor = 1 - (vignette * constants[c + 16]);
+                float scanline = (float)Math.Sin(v * constants[c + 17]) * constants[c + 18];
+                for (int channel = 0; channel < 4; channel++)
+                {
+                    tap[channel] *= factor;
+                }
+
+                float weight = constants[c + 20];
+                float gamma = constants[c + 21];
+                float regions = constants[c + 22];
+                for (int channel = 0; channel < 3; channel++)
+                {
+                    float value = tap[channel] - scanline;
+
+                    // An unused posterization has no weight, so it is skipped
+                    if (weight != 0)
+                    {
+                        float level = (float)Math.Pow(Math.Max(value, 0), gamma);
+                        level = (float)Math.Floor(level * regions) / regions;
+                        level = (float)Math.Pow(level, 1.0f / gamma);
+                        value += (level - value) * weight;
+                    }
+
+                    pixels[index + channel] = MathHelper.Clamp(value, 0, 1);
+                }
+
+                pixels[index + 3] = MathHelper.Clamp(tap[3], 0, 1);
+            }
+
+            int lookup = FusedPointwiseStages.LookupRegister * 4;
+            float lookupWeight = constants[lookup];
+            if (lookupWeight != 0)
+            {
+                bool linear = constants[lookup + 1] != 0;
+                for (int channel = 0; channel < 3; channel++)
+                {
+                    tap[channel] = linear ? (float)Math.Sqrt(pixels[index + channel]) : pixels[index + channel];
+                }
+
+                SampleColorTable(table, tap, 0);
+
+                for (int channel = 0; channel < 3; channel++)
+                {
+                    float value = linear ? tap[channel] * tap[channel] : tap[channel];
+                    pixels[index + channel] += (value - pixels[index + channel]) * lookupWeight;
+                }
+
+                pixels[index + 3] += (1 - pixels[index + 3]) * lookupWeight;
+            }
+        }
+
+        /// <summary>
+        /// Validates the arguments of a render and starts measuring it
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        private void BeginRender(Lens lens, CpuImage source, CpuImage destination)
+        {
+            if (lens == null)
+            {
+                throw new ArgumentNullException("lens");
+            }
+
+            if (source == null)
+            {
+                throw new ArgumentNullException("source");
+            }
+
+            if (destination == null)
+            {
+                throw new ArgumentNullException("destination");
+            }
+
+            if (source.Width != destination.Width || source.Height != destination.Height)
+            {
+                throw new ArgumentException("The destination must have the size of the source", "destination");
+            }
+
+            if (source == destination)
+            {
+                throw new ArgumentException("The destination must be a different image than the source", "destination");
+            }
+
+            this.stopwatch.Restart();
+        }
+
+        /// <summary>
+        /// Stores the throughput of a render
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="source">The source image.</param>
+        private void EndRender(Lens lens, CpuImage source)
+        {
+            this.stopwatch.Stop();
+
+            double seconds = Math.Max(this.stopwatch.Elapsed.TotalSeconds, double.Epsilon);
+            double megapixels = (double)source.Width * source.Height / 1000000.0;
+            this.throughput[lens.GetType()] = megapixels / seconds;
+        }
+
+        /// <summary>
+        /// Processes the rows of an image in parallel, in tiles of <see cref="RowsPerTile"/> rows
+        /// </summary>
+        /// <param name="height">The number of rows.</param>
+        /// <param name="processRows">The action that processes the rows from the first one to the end one, excluded.</param>
+        private void ForEachTile(int height, Action<int, int> processRows)
+        {
+            int rowsPerTile = Math.Max(1, this.RowsPerTile);
+            int tiles = (height + rowsPerTile - 1) / rowsPerTile;
+
+            Parallel.For(0, tiles, tile =>
+            {
+                int firstRow = tile * rowsPerTile;
+                processRows(firstRow, Math.Min(height, firstRow + rowsPerTile));
+            });
+        }
+
+        /// <summary>
+        /// Computes every pixel of an image in parallel, in tiles of <see cref="RowsPerTile"/> rows
+        /// </summary>
+        /// <param name="destination">The destination image.</param>
+        /// <param name="shader">The function that computes a pixel.</param>
+        private void ForEachPixel(CpuImage destination, PixelShader shader)
+        {
+            int width = destination.Width;
+            int height = destination.Height;
+            var pixels = destination.Pixels;
+
+            this.ForEachTile(height, (firstRow, endRow) =>
+            {
+                var tap = new float[CpuImage.Channels];
+
+                for (int y = firstRow; y < endRow; y++)
+                {
+                    float v = (y + 0.5f) / height;
+
+                    for (int x = 0; x < width; x++)
+                    {
+                        shader((x + 0.5f) / width, v, tap, pixels, ((y * width) + x) * CpuImage.Channels);
+                    }
+                }
+            });
+        }
+
+        /// <summary>
+        /// Averages the center and 14 samples on a circle around it, as the circular blur shaders do
+        /// </summary>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        /// <param name="radiusU">The horizontal radius of the circle, in texture coordinates.</param>
+        /// <param name="radiusV">The vertical radius of the circle, in texture coordinates.</param>
+        private void CircleBlur(CpuImage source, CpuImage destination, float radiusU, float radiusV)
+        {
+            var sampleOffsets = new Vector2[CircleBlurSamples];
+            float start = 2.0f / 14.0f;
+            for (int s = 1; s < CircleBlurSamples; s++)
+            {
+                float angle = (float)(Math.PI * 2.0 / 14.0) * (s - 1 + start);
+                sampleOffsets[s] = new Vector2((float)Math.Sin(angle) * radiusU, (float)Math.Cos(angle) * radiusV);
+            }
+
+            this.ForEachPixel(destination, (u, v, tap, pixels, i) =>
+            {
+                const float Weight = 1.0f / CircleBlurSamples;
+                float r = 0, g = 0, b = 0;
+
+                for (int s = 0; s < CircleBlurSamples; s++)
+                {
+                    source.Sample(u + sampleOffsets[s].X, v + sampleOffsets[s].Y, tap, 0);
+                    r += tap[0];
+                    g += tap[1];
+                    b += tap[2];
+                }
+
+                pixels[i] = r * Weight;
+                pixels[i + 1] = g * Weight;
+                pixels[i + 2] = b * Weight;
+                pixels[i + 3] = 1;
+            });
+        }
+
+        /// <summary>
+        /// Samples the luma of an image, with the weights of the sobel shader
+        /// </summary>
+        /// <param name="image">The image.</param>
+        /// <param name="u">The horizontal texture coordinate.</param>
+        /// <param name="v">The vertical texture coordinate.</param>
+        /// <param name="tap">Scratch RGBA components for the sample.</param>
+        /// <returns>The luma</returns>
+        private static float Luma(CpuImage image, float u, float v, float[] tap)
+        {
+            image.Sample(u, v, tap, 0);
+            return (tap[0] * 0.2126f) + (tap[1] * 0.7152f) + (tap[2] * 0.0722f);
+        }
+
+        /// <summary>
+        /// Replaces a color by its entry in a color correction table, with trilinear filtering as the 3D texture of the shader.
+        /// The color is scaled and offset to the centers of the first and last entries, as the material does.
+        /// </summary>
+        /// <param name="table">The table, with the layout of <see cref="ColorCorrectionTable"/>.</param>
+        /// <param name="pixels">The pixels, the RGB components are replaced by the result.</param>
+        /// <param name="index">The index of the first component of the pixel.</param>
+        private static void SampleColorTable(CpuImage table, float[] pixels, int index)
+        {
+            int size = table.Height;
+            var entries = table.Pixels;
+
+            // The scale of the material maps the colors from the center of the first entry to the center of the last one
+            float red = MathHelper.Clamp(pixels[index], 0, 1) * (size - 1);
+            float green = MathHelper.Clamp(pixels[index + 1], 0, 1) * (size - 1);
+            float blue = MathHelper.Clamp(pixels[index + 2], 0, 1) * (size - 1);
+            int red0 = Math.Min((int)red, size - 2);
+            int green0 = Math.Min((int)green, size - 2);
+            int blue0 = Math.Min((int)blue, size - 2);
+            float fr = red - red0;
+            float fg = green - green0;
+            float fb = blue - blue0;
+
+            float r = 0, g = 0, b = 0;
+            for (int corner = 0; corner < 8; corner++)
+            {
+                int dr = corner & 1;
+                int dg = (corner >> 1) & 1;
+                int db = (corner >> 2) & 1;
+                float weight = (dr == 0 ? 1 - fr : fr) * (dg == 0 ? 1 - fg : fg) * (db == 0 ? 1 - fb : fb);
+
+                int i = (((green0 + dg) * table.Width) + ((blue0 + db) * size) + red0 + dr) * CpuImage.Channels;
+                r += entries[i] * weight;
+                g += entries[i + 1] * weight;
+                b += entries[i + 2] * weight;
+            }
+
+            pixels[index] = r;
+            pixels[index + 1] = g;
+            pixels[index + 2] = b;
+        }
+
+        /// <summary>
+        /// Applies a one dimensional blur with linear filtering between texels
+        /// </summary>
+        /// <param name="source">The source image.</param>
+        /// <param name="destination">The destination image.</param>
+        /// <param name="horizontal">Whether the blur is horizontal or vertical.</param>
+        /// <param name="offsets">The offsets of the taps, in texels.</param>
+        /// <param name="weights">The weights of the taps.</param>
+        private void BlurPass(CpuImage source, CpuImage destination, bool horizontal, float[] offsets, float[] weights)
+        {
+            int taps = offsets.Length;
+            var baseOffsets = new int[taps];
+            var fractions = new float[taps];
+
+            for (int t = 0; t < taps; t++)
+            {
+                float floor = (float)Math.Floor(offsets[t]);
+                baseOffsets[t] = (int)floor;
+                fractions[t] = offsets[t] - floor;
+            }
+
+            int width = source.Width;
+            int height = source.Height;
+
+            this.ForEachTile(height, (firstRow, endRow) =>
+            {
+                var src = source.Pixels;
+                var dst = destination.Pixels;
+
+                for (int y = firstRow; y < endRow; y++)
+                {
+                    for (int x = 0; x < width; x++)
+                    {
+                        float r = 0, g = 0, b = 0;
+
+                        for (int t = 0; t < taps; t++)
+                        {
+                            int i0, i1;
+                            if (horizontal)
+                            {
+                                int row = y * width;
+                                i0 = (row + source.ClampX(x + baseOffsets[t])) * CpuImage.Channels;
+                                i1 = (row + source.ClampX(x + baseOffsets[t] + 1)) * CpuImage.Channels;
+                            }
+                            else
+                            {
+                                i0 = ((source.ClampY(y + baseOffsets[t]) * width) + x) * CpuImage.Channels;
+                                i1 = ((source.ClampY(y + baseOffsets[t] + 1) * width) + x) * CpuImage.Channels;
+                            }
+
+                            float f = fractions[t];
+                            float w = weights[t];
+                            r += (src[i0] + ((src[i1] - src[i0]) * f)) * w;
+                            g += (src[i0 + 1] + ((src[i1 + 1] - src[i0 + 1]) * f)) * w;
+                            b += (src[i0 + 2] + ((src[i1 + 2] - src[i0 + 2]) * f)) * w;
+                        }
+
+                        int i = ((y * width) + x) * CpuImage.Channels;
+                        dst[i] = r;
+                        dst[i + 1] = g;
+                        dst[i + 2] = b;
+                        dst[i + 3] = 1;
+                    }
+                }
+            });
+        }
+
+        /// <summary>
+        /// Computes the taps used by the gaussian blur shader, in texels
+        /// </summary>
+        /// <param name="factor">The blur factor of the lens.</param>
+        /// <param name="offsets">The offsets of the taps.</param>
+        /// <param name="weights">The weights of the taps.</param>
+        private static void ComputeGaussianBlur(float factor, out float[] offsets, out float[] weights)
+        {
+            // The material computes 15 weights, but the shader only reads the first 14
+            int sampleCount = 15;
+            var sampleWeights = new float[sampleCount];
+            var sampleOffsets = new float[sampleCount];
+
+            sampleWeights[0] = ComputeGaussian(0);
+            float totalWeights = sampleWeights[0];
+
+            for (int i = 0; i < sampleCount / 2; i++)
+            {
+                float weight = ComputeGaussian(i + 1);
+                sampleWeights[(i * 2) + 1] = weight;
+                sampleWeights[(i * 2) + 2] = weight;
+                totalWeights += weight * 2;
+
+                float sampleOffset = ((i * 2) + 1.5f) * factor;
+                sampleOffsets[(i * 2) + 1] = sampleOffset;
+                sampleOffsets[(i * 2) + 2] = -sampleOffset;
+            }
+
+            offsets = new float[GaussianBlurTaps];
+            weights = new float[GaussianBlurTaps];
+            for (int i = 0; i < GaussianBlurTaps; i++)
+            {
+                offsets[i] = sampleOffsets[i];
+                weights[i] = sampleWeights[i] / totalWeights;
+            }
+        }
+
+        /// <summary>
+        /// Computes the gaussian function used by the gaussian blur material
+        /// </summary>
+        /// <param name="n">The distance to the center.</param>
+        /// <returns>The weight</returns>
+        private static float ComputeGaussian(float n)
+        {
+            float theta = 4;
+
+            return (float)((1.0 / Math.Sqrt(2 * Math.PI * theta)) *
+                           Math.Exp(-(n * n) / (2 * theta * theta)));
+        }
+
+        /// <summary>
+        /// Applies a tone mapping operator to a color
+        /// </summary>
+        /// <param name="toneOperator">The operator.</param>
+        /// <param name="exposure">The exposure.</param>
+        /// <param name="inverseGamma">The inverse of the gamma.</param>
+        /// <param name="color">The pixels, the RGB components are replaced by the result.</param>
+        /// <param name="index">The index of the first component of the pixel.</param>
+        private static void ToneMap(ToneMappingMaterial.OperatorType toneOperator, float exposure, float inverseGamma, float[] color, int index)
+        {
+            bool applyGamma = true;
+
+            switch (toneOperator)
+            {
+                case ToneMappingMaterial.OperatorType.Linear:
+                    for (int c = 0; c < 3; c++)
+                    {
+                        color[index + c] *= exposure;
+                    }
+
+                    break;
+
+                case ToneMappingMaterial.OperatorType.SimpleReinhard:
+                    for (int c = 0; c < 3; c++)
+                    {
+                        color[index + c] *= exposure / (1.0f + (color[index + c] / exposure));
+                    }
+
+                    break;
+
+                case ToneMappingMaterial.OperatorType.LumaBasedReinhard:
+                case ToneMappingMaterial.OperatorType.WhitePreservingLumaBasedReinhard:
+                    {
+                        for (int c = 0; c < 3; c++)
+                        {
+                            color[index + c] *= exposure;
+                        }
+
+                        float luma = (color[index] * 0.2126f) + (color[index + 1] * 0.7152f) + (color[index + 2] * 0.0722f);
+                        float toneMappedLuma;
+                        if (toneOperator == ToneMappingMaterial.OperatorType.LumaBasedReinhard)
+                        {
+                            toneMappedLuma = luma / (1.0f + luma);
+                        }
+                        else
+                        {
+                            float white = 2;
+                            toneMappedLuma = luma * (1.0f + (luma / (white * white))) / (1.0f + luma);
+                        }
+
+                        for (int c = 0; c < 3; c++)
+                        {
+                            color[index + c] *= toneMappedLuma / luma;
+                        }
+                    }
+
+                    break;
+
+                case ToneMappingMaterial.OperatorType.RombinDaHouse:
+                    for (int c = 0; c < 3; c++)
+                    {
+                        color[index + c] = (float)Math.Exp(-1.0 / ((2.72 * color[index + c] * exposure) + 0.15));
+                    }
+
+                    break;
+
+                case ToneMappingMaterial.OperatorType.Photography:
+                    applyGamma = false;
+                    for (int c = 0; c < 3; c++)
+                    {
+                        color[index + c] = 1.0f - (float)Math.Pow(2, -exposure * color[index + c]);
+                    }
+
+                    break;
+
+                case ToneMappingMaterial.OperatorType.Filmic:
+                    applyGamma = false;
+                    for (int c = 0; c < 3; c++)
+                    {
+                        float x = Math.Max(0, (color[index + c] * exposure) - 0.004f);
+                        color[index + c] = (x * ((6.2f * x) + 0.5f)) / ((x * ((6.2f * x) + 1.7f)) + 0.06f);
+                    }
+
+                    break;
+
+                case ToneMappingMaterial.OperatorType.Uncharted2:
+                    {
+                        float white = Uncharted2(11.2f);
+                        for (int c = 0; c < 3; c++)
+                        {
+                            color[index + c] = Uncharted2(color[index + c] * exposure * 2.0f) / white;
+                        }
+                    }
+
+                    break;
+            }
+
+            if (applyGamma)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    color[index + c] = (float)Math.Pow(color[index + c], inverseGamma);
+                }
+            }
+        }
+
+        /// <summary>
+        /// The Uncharted 2 filmic curve
+        /// </summary>
+        /// <param name="x">The value.</param>
+        /// <returns>The mapped value</returns>
+        private static float Uncharted2(float x)
+        {
+            const float A = 0.15f;
+            const float B = 0.50f;
+            const float C = 0.10f;
+            const float D = 0.20f;
+            const float E = 0.02f;
+            const float F = 0.30f;
+
+            return ((x * ((A * x) + (C * B)) + (D * E)) / ((x * ((A * x) + B)) + (D * F))) - (E / F);
+        }
+
+        /// <summary>
+        /// Applies a convolution filter to a pixel
+        /// </summary>
+        /// <param name="filter">The filter.</param>
+        /// <param name="scale">The scale of the Laplace filters.</param>
+        /// <param name="source">The source image.</param>
+        /// <param name="x">The column of the pixel.</param>
+        /// <param name="y">The row of the pixel.</param>
+        /// <param name="result">The RGBA result.</param>
+        private static void Convolve(ConvolutionMaterial.FilterType filter, float scale, CpuImage source, int x, int y, float[] result)
+        {
+            var src = source.Pixels;
+            int center = PixelIndex(source, x, y);
+
+            switch (filter)
+            {
+                case ConvolutionMaterial.FilterType.Laplace:
+                case ConvolutionMaterial.FilterType.LaplaceGreyScale:
+                case ConvolutionMaterial.FilterType.Sharpen:
+                    {
+                        int up = PixelIndex(source, x, y - 1);
+                        int left = PixelIndex(source, x - 1, y);
+                        int right = PixelIndex(source, x + 1, y);
+                        int down = PixelIndex(source, x, y + 1);
+
+                        for (int c = 0; c < CpuImage.Channels; c++)
+                        {
+                            float neighbours = src[up + c] + src[left + c] + src[right + c] + src[down + c];
+
+                            if (filter == ConvolutionMaterial.FilterType.Sharpen)
+                            {
+                                result[c] = (5 * src[center + c]) - neighbours;
+                            }
+                            else
+                            {
+                                float laplace = scale * (neighbours - (4 * src[center + c]));
+                                result[c] = filter == ConvolutionMaterial.FilterType.Laplace ? laplace : 0.5f + laplace;
+                            }
+                        }
+                    }
+
+                    break;
+
+                case ConvolutionMaterial.FilterType.Blur3x3:
+                case ConvolutionMaterial.FilterType.Blur5x5:
+                    {
+                        int radius = filter == ConvolutionMaterial.FilterType.Blur3x3 ? 1 : 2;
+                        int size = (radius * 2) + 1;
+                        Array.Clear(result, 0, CpuImage.Channels);
+
+                        for (int j = -radius; j <= radius; j++)
+                        {
+                            for (int i = -radius; i <= radius; i++)
+                            {
+                                int index = PixelIndex(source, x + i, y + j);
+                                for (int c = 0; c < CpuImage.Channels; c++)
+                                {
+                                    result[c] += src[index + c];
+                                }
+                            }
+                        }
+
+                        // The shader only averages the color, the alpha is the sum
+                        for (int c = 0; c < 3; c++)
+                        {
+                            result[c] /= size * size;
+                        }
+                    }
+
+                    break;
+
+                case ConvolutionMaterial.FilterType.Emboss:
+                    {
+                        int topLeft = PixelIndex(source, x - 1, y - 1);
+                        int bottomRight = PixelIndex(source, x + 1, y + 1);
+                        float grey = 0;
+
+                        for (int c = 0; c < 3; c++)
+                        {
+                            grey += 0.5f - (2 * src[topLeft + c]) + (2 * src[bottomRight + c]);
+                        }
+
+                        grey /= 3.0f;
+                        result[0] = grey;
+                        result[1] = grey;
+                        result[2] = grey;
+                        result[3] = 1.0f - (2 * src[topLeft + 3]) + (2 * src[bottomRight + 3]);
+                    }
+
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Gets the index of the first component of a pixel, clamping its coordinates to the image
+        /// </summary>
+        /// <param name="image">The image.</param>
+        /// <param name="x">The column.</param>
+        /// <param name="y">The row.</param>
+        /// <returns>The index of the pixel</returns>
+        private static int PixelIndex(CpuImage image, int x, int y)
+        {
+            return ((image.ClampY(y) * image.Width) + image.ClampX(x)) * CpuImage.Channels;
+        }
+        #endregion
+    }
+}
@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -15,13 +16,23 @@ namespace WaveEngine.ImageEffects
     /// Represent a Depth of Field as postprocessing filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class DepthOfFieldLens : Lens
+    public class DepthOfFieldLens : Lens, ITransientTargetLens
     {
         /// <summary>
         /// The blur downsample factor
         /// </summary>
         private float downSampleFactor;
 
+        /// <summary>
+        /// The resolution scale
+        /// </summary>
+        private float resolutionScale;
+
+        /// <summary>
+        /// Renders a material to a render target, used to build the pyramid
+        /// </summary>
+        private Action<RenderTarget, Material> renderToImage;
+
         #region Properties
 
         /// <summary>
@@ -80,6 +91,54 @@ namespace WaveEngine.ImageEffects
             }
         }
 
+        /// <summary>
+        /// Gets or sets the fraction of the source resolution where the blur is rendered, on top of <see cref="DownSampleFactor"/>.
+        /// The blur is upsampled to the source resolution by the combine pass. Default value is 1.
+        /// </summary>
+        [DataMember]
+        [RenderPropertyAsSlider(0.25f, 1, 0.25f)]
+        public float ResolutionScale
+        {
+            get
+            {
+                return this.resolutionScale;
+            }
+
+            set
+            {
+                if (value <= 0 || value > 1)
+                {
+                    throw new ArgumentOutOfRangeException("value");
+                }
+
+                this.resolutionScale = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets a value indicating whether the blur is upsampled weighting its texels by their depth,
+        /// so the blurred background does not bleed over the objects in focus. Default value is false.
+        /// </summary>
+        [DataMember]
+        public bool BilateralUpsample { get; set; }
+
+        /// <summary>
+        /// Gets or sets the depth difference where the weight of a blur texel falls to 60% in the bilateral upsample, default value is 0.001f.
+        /// </summary>
+        [DataMember]
+        public float DepthSigma
+        {
+            get
+            {
+                return (this.material as DepthOfFieldMaterial).DepthSigma;
+            }
+
+            set
+            {
+                (this.material as DepthOfFieldMaterial).DepthSigma = value;
+            }
+        }
+
         /// <summary>
         /// Gets or sets focus range of the lens.
         /// </summary>
@@ -97,6 +156,27 @@ namespace WaveEngine.ImageEffects
                 (this.material as DepthOfFieldMaterial).FocusRange = value;
             }
         }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
+
+        /// <summary>
+        /// Gets or sets the blur pyramid shared with other lenses of the camera, or null to downsample the source directly.
+        /// </summary>
+        public BlurPyramid Pyramid { get; set; }
+
+        /// <summary>
+        /// Gets the divisor of the source size that gives the size of the intermediate targets
+        /// </summary>
+        private float Divisor
+        {
+            get
+            {
+                return this.downSampleFactor / this.resolutionScale;
+            }
+        }
         #endregion
 
         #region Initialize
@@ -117,12 +197,24 @@ namespace WaveEngine.ImageEffects
             base.DefaultValues();
 
             this.downSampleFactor = 4;
+            this.resolutionScale = 1;
             this.material = new DepthOfFieldMaterial();
         }
         #endregion
 
         #region Public Methods
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            float divisor = this.Divisor;
+            requests.Add(new TransientTargetRequest(divisor, 0, 1));
+            requests.Add(new TransientTargetRequest(divisor, 1, 2));
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -141,34 +233,58 @@ namespace WaveEngine.ImageEffects
                 mat.TexcoordOffset.Y = 1f / this.Source.Height;
             }
 
-            int width = (int)(this.Source.Width / this.downSampleFactor);
-            int height = (int)(this.Source.Height / this.downSampleFactor);
+            Vector2 texcoordOffset = mat.TexcoordOffset;
+
+            float divisor = this.Divisor;
+            int width = (int)(this.Source.Width / divisor);
+            int height = (int)(this.Source.Height / divisor);
 
-            RenderTarget rt1 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            RenderTarget rt2 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            graphicsDevice.Viewport = new Viewport(0, 0, width, height);
+            Texture downSampleSource = this.Source;
+            int pyramidLevel = BlurPyramid.GetLevelForDivisor(divisor);
+            if (this.Pyramid != null && pyramidLevel >= 1 && pyramidLevel <= this.Pyramid.MaxLevels)
+            {
+                if (this.renderToImage == null)
+                {
+                    this.renderToImage = this.RenderToImage;
+                }
+
+                downSampleSource = this.Pyramid.GetLevel(this, this.Source, pyramidLevel, this.renderToImage);
+            }
+
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 0, width, height);
+            RenderTarget rt2 = TransientTargetPool.Acquire(this, 1, width, height);
+            TransientTargetPool.SetViewport(rt1);
 
             // Down sampler
             mat.Pass = DepthOfFieldMaterial.Passes.DownSampler;
-            mat.Texture = this.Source;
+            mat.Texture = downSampleSource;
+            mat.TexcoordOffset = new Vector2(1f / downSampleSource.Width, 1f / downSampleSource.Height);
             mat.Texture1 = null;
+            LensProfiler.BeginPass(this, "Down sampler");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
 
             // Blur
             mat.Pass = DepthOfFieldMaterial.Passes.Blur;
+            mat.TexcoordOffset = texcoordOffset;
             mat.Texture = rt1;
             mat.Texture1 = null;
+            LensProfiler.BeginPass(this, "Blur");
             this.RenderToImage(rt2, this.material);
+            LensProfiler.EndPass();
 
             // UpCombine
-            graphicsDevice.Viewport = new Viewport(0, 0, this.Source.Width, this.Source.Height);
-            mat.Pass = DepthOfFieldMaterial.Passes.Combine;
+            TransientTargetPool.RestoreViewport(this);
+            mat.Pass = this.BilateralUpsample && divisor > 1 ? DepthOfFieldMaterial.Passes.CombineBilateral : DepthOfFieldMaterial.Passes.Combine;
             mat.Texture = this.Source;
             mat.Texture1 = rt2;
+            mat.BlurTextureSize = new Vector2(width, height);
+            LensProfiler.BeginPass(this, "UpCombine");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt1);
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt2);
+            TransientTargetPool.Release(this, rt1);
+            TransientTargetPool.Release(this, rt2);
         }
         #endregion
 
@@ -36,6 +36,11 @@ namespace WaveEngine.ImageEffects
             /// Combine
             /// </summary>
             Combine,
+
+            /// <summary>
+            /// Combine with a bilateral upsample of the blur
+            /// </summary>
+            CombineBilateral,
         }
 
         /// <summary>
@@ -76,6 +81,7 @@ namespace WaveEngine.ImageEffects
             new ShaderTechnique("DownSampler", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psDown", VertexPositionTexture.VertexFormat),
             new ShaderTechnique("Blur", "vsBlur", "psBlur", VertexPositionTexture.VertexFormat),
             new ShaderTechnique("Combine", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psCombine", VertexPositionTexture.VertexFormat),
+            new ShaderTechnique("CombineBilateral", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psCombineBilateral", VertexPositionTexture.VertexFormat),
         };
 
         #region Struct
@@ -83,7 +89,7 @@ namespace WaveEngine.ImageEffects
         /// <summary>
         /// Shader parameters.
         /// </summary>
-        [StructLayout(LayoutKind.Explicit, Size = 32)]
+        [StructLayout(LayoutKind.Explicit, Size = 48)]
         private struct DOFEffectParameters
         {
             [FieldOffset(0)]
@@ -103,6 +109,12 @@ namespace WaveEngine.ImageEffects
 
             [FieldOffset(24)]
             public float BlurScale;
+
+            [FieldOffset(32)]
+            public Vector2 BlurTextureSize;
+
+            [FieldOffset(40)]
+            public float DepthSigma;
         }
         #endregion
 
@@ -123,6 +135,16 @@ namespace WaveEngine.ImageEffects
         /// </summary>
         public float FocusRange { get; set; }
 
+        /// <summary>
+        /// Gets or sets the size in texels of the blur texture, used by the bilateral combine pass.
+        /// </summary>
+        public Vector2 BlurTextureSize { get; set; }
+
+        /// <summary>
+        /// Gets or sets the depth difference where the weight of a blur texel falls to 60% in the bilateral combine pass.
+        /// </summary>
+        public float DepthSigma { get; set; }
+
         /// <summary>
         /// Gets or sets the texture.
         /// </summary>
@@ -219,6 +241,7 @@ namespace WaveEngine.ImageEffects
             this.BlurScale = 4.0f;
             this.FocusRange = 2;
             this.FocusDistance = 4;
+            this.DepthSigma = 0.001f;
             this.TexcoordOffset = Vector2.Zero;
             this.shaderParameters = new DOFEffectParameters();
             this.shaderParameters.TexcoordOffset = this.TexcoordOffset;
@@ -249,7 +272,7 @@ namespace WaveEngine.ImageEffects
             {
                 this.shaderParameters.TexcoordOffset = this.TexcoordOffset;
 
-                if (this.Pass == Passes.Combine)
+                if (this.Pass == Passes.Combine || this.Pass == Passes.CombineBilateral)
                 {
                     Camera camera = this.renderManager.CurrentDrawingCamera;
 
@@ -258,6 +281,8 @@ namespace WaveEngine.ImageEffects
                     this.shaderParameters.NearPlane = camera.NearPlane;
                     this.shaderParameters.FarParam = camera.FarPlane / (camera.FarPlane - camera.NearPlane);
                     this.shaderParameters.BlurScale = this.BlurScale;
+                    this.shaderParameters.BlurTextureSize = this.BlurTextureSize;
+                    this.shaderParameters.DepthSigma = this.DepthSigma;
                     this.Parameters = this.shaderParameters;
 
                     this.depthTexture = this.renderManager.GraphicsDevice.RenderTargets.DefaultDepthTexture;
@@ -78,7 +78,9 @@ namespace WaveEngine.ImageEffects
         public override void Render(TimeSpan gameTime)
         {
             (this.material as DistortionMaterial).Texture = this.Source;
+            LensProfiler.BeginPass(this, "Render");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
         }
         #endregion
 
@@ -76,7 +76,9 @@ namespace WaveEngine.ImageEffects
             }
 
             mat.Texture = this.Source;
+            LensProfiler.BeginPass(this, "Render");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
         }
@@ -126,7 +126,9 @@ namespace WaveEngine.ImageEffects
             mat.ScreenHeigth = this.Source.Height;
 
             mat.Texture = this.Source;
+            LensProfiler.BeginPass(this, "Render");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
         }
@@ -69,7 +69,9 @@ namespace WaveEngine.ImageEffects
             var mat = this.material as FishEyeMaterial;
             mat.Intensity = new Vector2(this.StrengthX * aspectRatio, this.StrengthY * aspectRatio);
             mat.Texture = this.Source;
+            LensProfiler.BeginPass(this, "Render");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
         }
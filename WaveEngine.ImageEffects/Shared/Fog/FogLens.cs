@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -15,8 +16,13 @@ namespace WaveEngine.ImageEffects
     /// Represent a Fog as postprocessing filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class FogLens : Lens
+    public class FogLens : Lens, ITransientTargetLens
     {
+        /// <summary>
+        /// The resolution scale
+        /// </summary>
+        private float resolutionScale;
+
         #region Properties
 
         /// <summary>
@@ -110,6 +116,52 @@ namespace WaveEngine.ImageEffects
                 (this.material as FogMaterial).EndFog = value;
             }
         }
+
+        /// <summary>
+        /// Gets or sets the fraction of the source resolution where the fog amount is rendered. Below 1, the fog amount is
+        /// upsampled weighting its texels by their depth, so it does not bleed across the edges of the objects. Default value is 1.
+        /// </summary>
+        [DataMember]
+        [RenderPropertyAsSlider(0.25f, 1, 0.25f)]
+        public float ResolutionScale
+        {
+            get
+            {
+                return this.resolutionScale;
+            }
+
+            set
+            {
+                if (value <= 0 || value > 1)
+                {
+                    throw new ArgumentOutOfRangeException("value");
+                }
+
+                this.resolutionScale = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the depth difference where the weight of a fog amount texel falls to 60% in the bilateral upsample, default value is 0.001f.
+        /// </summary>
+        [DataMember]
+        public float DepthSigma
+        {
+            get
+            {
+                return (this.material as FogMaterial).DepthSigma;
+            }
+
+            set
+            {
+                (this.material as FogMaterial).DepthSigma = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
         #endregion
 
         #region Initialize
@@ -130,11 +182,25 @@ namespace WaveEngine.ImageEffects
             base.DefaultValues();
 
             this.material = new FogMaterial();
+            this.resolutionScale = 1;
         }
         #endregion
 
         #region Public Methods
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            if (this.resolutionScale < 1)
+            {
+                // The upcombine pass only reads the red channel of the fog amount
+                requests.Add(new TransientTargetRequest(1 / this.resolutionScale, 0, 1, PixelFormat.R8));
+            }
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -142,10 +208,47 @@ namespace WaveEngine.ImageEffects
         public override void Render(TimeSpan gameTime)
         {
             var mat = this.material as FogMaterial;
+            if (this.resolutionScale >= 1)
+            {
+                mat.Pass = FogMaterial.Passes.Fog;
+                mat.Texture = this.Source;
+                LensProfiler.BeginPass(this, "Render");
+                this.RenderToImage(this.Destination, this.material);
+                LensProfiler.EndPass();
+
+                mat.Texture = null;
+                return;
+            }
+
+            float divisor = 1 / this.resolutionScale;
+            int width = (int)(this.Source.Width / divisor);
+            int height = (int)(this.Source.Height / divisor);
+
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 0, width, height);
+            TransientTargetPool.SetViewport(rt1);
+
+            // Fog amount
+            mat.Pass = FogMaterial.Passes.FogAmount;
+            mat.Texture = null;
+            mat.FogAmountTexture = null;
+            LensProfiler.BeginPass(this, "Fog amount");
+            this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
+
+            // UpCombine
+            TransientTargetPool.RestoreViewport(this);
+            mat.Pass = FogMaterial.Passes.CombineBilateral;
             mat.Texture = this.Source;
+            mat.FogAmountTexture = rt1;
+            mat.FogTextureSize = new Vector2(width, height);
+            LensProfiler.BeginPass(this, "UpCombine");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
+            mat.FogAmountTexture = null;
+
+            TransientTargetPool.Release(this, rt1);
         }
         #endregion
 
@@ -38,11 +38,42 @@ namespace WaveEngine.ImageEffects
             ExponencialSquared = 2
         }
 
+        /// <summary>
+        /// Effect passes
+        /// </summary>
+        public enum Passes
+        {
+            /// <summary>
+            /// Fog, at the resolution of the source
+            /// </summary>
+            Fog,
+
+            /// <summary>
+            /// The fog amount, at a reduced resolution
+            /// </summary>
+            FogAmount,
+
+            /// <summary>
+            /// Combine with a bilateral upsample of the fog amount
+            /// </summary>
+            CombineBilateral,
+        }
+
+        /// <summary>
+        /// Steps of this effects
+        /// </summary>
+        public Passes Pass;
+
         /// <summary>
         /// The texture
         /// </summary>
         private Texture texture;
 
+        /// <summary>
+        /// The fog amount texture
+        /// </summary>
+        private Texture fogAmountTexture;
+
         /// <summary>
         /// The depth texture
         /// </summary>
@@ -56,6 +87,10 @@ namespace WaveEngine.ImageEffects
             new ShaderTechnique("Linear", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psFog", VertexPositionTexture.VertexFormat),
             new ShaderTechnique("Exponencial", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psFogExp", VertexPositionTexture.VertexFormat),
             new ShaderTechnique("ExponencialSquared", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psFogExp2", VertexPositionTexture.VertexFormat),
+            new ShaderTechnique("LinearAmount", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psFogAmount", VertexPositionTexture.VertexFormat),
+            new ShaderTechnique("ExponencialAmount", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psFogExpAmount", VertexPositionTexture.VertexFormat),
+            new ShaderTechnique("ExponencialSquaredAmount", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psFogExp2Amount", VertexPositionTexture.VertexFormat),
+            new ShaderTechnique("CombineBilateral", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psFogCombineBilateral", VertexPositionTexture.VertexFormat),
         };
 
         #region Struct
@@ -63,7 +98,7 @@ namespace WaveEngine.ImageEffects
         /// <summary>
         /// Shader parameters.
         /// </summary>
-        [StructLayout(LayoutKind.Explicit, Size = 32)]
+        [StructLayout(LayoutKind.Explicit, Size = 48)]
         private struct FogEffectParameters
         {
             [FieldOffset(0)]
@@ -83,6 +118,12 @@ namespace WaveEngine.ImageEffects
 
             [FieldOffset(28)]
             public float FogEnd;
+
+            [FieldOffset(32)]
+            public Vector2 FogTextureSize;
+
+            [FieldOffset(40)]
+            public float DepthSigma;
         }
         #endregion
 
@@ -121,6 +162,16 @@ namespace WaveEngine.ImageEffects
         /// </summary>
         public float FogDensity { get; set; }
 
+        /// <summary>
+        /// Gets or sets the size in texels of the fog amount texture, used by the bilateral combine pass.
+        /// </summary>
+        public Vector2 FogTextureSize { get; set; }
+
+        /// <summary>
+        /// Gets or sets the depth difference where the weight of a fog amount texel falls to 60% in the bilateral combine pass.
+        /// </summary>
+        public float DepthSigma { get; set; }
+
         /// <summary>
         /// Gets or sets the texture.
         /// </summary>
@@ -140,6 +191,22 @@ namespace WaveEngine.ImageEffects
             }
         }
 
+        /// <summary>
+        /// Gets or sets the fog amount texture, read by the bilateral combine pass.
+        /// </summary>
+        public Texture FogAmountTexture
+        {
+            get
+            {
+                return this.fogAmountTexture;
+            }
+
+            set
+            {
+                this.fogAmountTexture = value;
+            }
+        }
+
         /// <summary>
         /// Gets or sets the Depth Texture.
         /// </summary>
@@ -166,7 +233,22 @@ namespace WaveEngine.ImageEffects
         {
             get
             {
-                int index = (int)this.Technique;
+                int index = 0;
+
+                switch (this.Pass)
+                {
+                    case Passes.FogAmount:
+                        index = 3 + (int)this.Technique;
+                        break;
+                    case Passes.CombineBilateral:
+                        index = 6;
+                        break;
+                    case Passes.Fog:
+                    default:
+                        index = (int)this.Technique;
+                        break;
+                }
+
                 return techniques[index].Name;
             }
         }
@@ -194,6 +276,7 @@ namespace WaveEngine.ImageEffects
             this.EndFog = 0.8f;
             this.FogColor = new Color(0.5f, 0.6f, 0.7f);
             this.FogDensity = 10f;
+            this.DepthSigma = 0.001f;
             this.shaderParameters = new FogEffectParameters();
             this.Parameters = this.shaderParameters;
 
@@ -228,6 +311,8 @@ namespace WaveEngine.ImageEffects
                 this.shaderParameters.FogDensity = this.FogDensity;
                 this.shaderParameters.ZParamA = 1f - (camera.FarPlane / camera.NearPlane);
                 this.shaderParameters.ZParamB = camera.FarPlane / camera.NearPlane;
+                this.shaderParameters.FogTextureSize = this.FogTextureSize;
+                this.shaderParameters.DepthSigma = this.DepthSigma;
                 this.Parameters = this.shaderParameters;
 
                 if (this.texture != null)
@@ -241,6 +326,11 @@ namespace WaveEngine.ImageEffects
                 {
                     this.graphicsDevice.SetTexture(this.depthTexture, 1);
                 }
+
+                if (this.fogAmountTexture != null)
+                {
+                    this.graphicsDevice.SetTexture(this.fogAmountTexture, 2);
+                }
             }
         }
         #endregion
@@ -0,0 +1,173 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System;
+using System.Collections.Generic;
+using System.Runtime.Serialization;
+using WaveEngine.Framework.Graphics;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// Represent a run of consecutive pointwise lenses rendered in a single pass, as postprocessing filter.
+    /// </summary>
+    /// <remarks>
+    /// The fused lenses are not added to the camera. The lens reads their parameters on every render, so they can still be changed
+    /// or animated. Every lens is saturated as if it was rendered to its own 8 bits per channel target, so the output only differs
+    /// from the unfused chain by the quantization between passes. Use <see cref="Fuse"/> to replace the fusable runs of a chain:
+    /// <code>
+    /// var chain = FusedPointwiseLens.Fuse(new Lens[] { ImageEffects.Bloom(), ImageEffects.Sepia(), ImageEffects.Vignette() });
+    /// foreach (var lens in chain)
+    /// {
+    ///     camera.Entity.AddComponent(lens);
+    /// }
+    /// </code>
+    /// </remarks>
+    [DataContract(Namespace = "WaveEngine.ImageEffects")]
+    public class FusedPointwiseLens : Lens
+    {
+        /// <summary>
+        /// The fused lenses
+        /// </summary>
+        private List<Lens> lenses;
+
+        /// <summary>
+        /// The stages of the fused lenses
+        /// </summary>
+        private FusedPointwiseStages stages;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the fused lenses, in render order. They must fit in a single pass, see <see cref="FusedPointwiseStages.GetRunLength"/>.
+        /// </summary>
+        public IList<Lens> Lenses
+        {
+            get
+            {
+                return this.lenses;
+            }
+        }
+
+        /// <summary>
+        /// Gets the stages of the fused lenses, as of the last render.
+        /// </summary>
+        public FusedPointwiseStages Stages
+        {
+            get
+            {
+                return this.stages;
+            }
+        }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="FusedPointwiseLens"/> class.
+        /// </summary>
+        public FusedPointwiseLens()
+            : base()
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="FusedPointwiseLens"/> class.
+        /// </summary>
+        /// <param name="lenses">The fused lenses, in render order.</param>
+        public FusedPointwiseLens(IEnumerable<Lens> lenses)
+            : base()
+        {
+            if (lenses == null)
+            {
+                throw new ArgumentNullException("lenses");
+            }
+
+            this.lenses.AddRange(lenses);
+            this.stages.Update(this.lenses);
+        }
+
+        /// <summary>
+        /// Sets default values for this instance.
+        /// </summary>
+        protected override void DefaultValues()
+        {
+            base.DefaultValues();
+            this.lenses = new List<Lens>();
+            this.stages = new FusedPointwiseStages();
+            this.material = new FusedPointwiseMaterial() { Stages = this.stages };
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Replaces every run of two or more consecutive lenses that fit in a single pass by a <see cref="FusedPointwiseLens"/>.
+        /// </summary>
+        /// <param name="chain">The lenses, in render order.</param>
+        /// <returns>The lenses to add to the camera, in render order. Each fused run saves all its passes but one.</returns>
+        public static List<Lens> Fuse(IList<Lens> chain)
+        {
+            if (chain == null)
+            {
+                throw new ArgumentNullException("chain");
+            }
+
+            var result = new List<Lens>();
+            int first = 0;
+            while (first < chain.Count)
+            {
+                int length = FusedPointwiseStages.GetRunLength(chain, first);
+                if (length > 1)
+                {
+                    var run = new Lens[length];
+                    for (int i = 0; i < length; i++)
+                    {
+                        run[i] = chain[first + i];
+                    }
+
+                    result.Add(new FusedPointwiseLens(run));
+                    first += length;
+                }
+                else
+                {
+                    result.Add(chain[first]);
+                    first++;
+                }
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        /// Renders to image.
+        /// </summary>
+        /// <param name="gameTime">The game time.</param>
+        public override void Render(TimeSpan gameTime)
+        {
+            // The parameters of the fused lenses are read on every render, so they can be animated
+            this.stages.Update(this.lenses);
+
+            var mat = this.material as FusedPointwiseMaterial;
+            mat.Texture = this.Source;
+            LensProfiler.BeginPass(this, "Render");
+            this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
+
+            mat.Texture = null;
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Releases unmanaged and - optionally - managed resources
+        /// </summary>
+        /// <param name="disposing"><c>true</c> to release both managed and unmanaged resources; <c>false</c> to release only unmanaged resources.</param>
+        protected override void Dispose(bool disposing)
+        {
+        }
+        #endregion
+    }
+}
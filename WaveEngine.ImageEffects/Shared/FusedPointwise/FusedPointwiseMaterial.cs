@@ -0,0 +1,377 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Runtime.InteropServices;
+using WaveEngine.Common.Graphics;
+using WaveEngine.Common.Graphics.VertexFormats;
+using WaveEngine.Common.Helpers;
+using WaveEngine.Common.IO;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework.Graphics;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// FusedPointwiseMaterial effect, evaluates a run of pointwise lenses in a single pass.
+    /// </summary>
+    public class FusedPointwiseMaterial : Material
+    {
+        /// <summary>
+        /// The texture
+        /// </summary>
+        private Texture texture;
+
+        /// <summary>
+        /// The LUT texture of the color correction
+        /// </summary>
+        private Texture lutTexture;
+
+        /// <summary>
+        /// The stages
+        /// </summary>
+        private FusedPointwiseStages stages;
+
+        /// <summary>
+        /// The techniques
+        /// </summary>
+        private static ShaderTechnique[] techniques =
+        {
+            new ShaderTechnique("FusedPointwise", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "FusedPointwisepsFusedPointwise", VertexPositionTexture.VertexFormat),
+        };
+
+        #region Struct
+
+        /// <summary>
+        /// Shader parameters.
+        /// </summary>
+        [StructLayout(LayoutKind.Explicit, Size = 400)]
+        private struct FusedPointwiseEffectParameters
+        {
+            /// <summary>
+            /// The red row of the color matrix of the stage 0
+            /// </summary>
+            [FieldOffset(0)]
+            public Vector4 Stage0Red;
+
+            /// <summary>
+            /// The green row of the color matrix of the stage 0
+            /// </summary>
+            [FieldOffset(16)]
+            public Vector4 Stage0Green;
+
+            /// <summary>
+            /// The blue row of the color matrix of the stage 0
+            /// </summary>
+            [FieldOffset(32)]
+            public Vector4 Stage0Blue;
+
+            /// <summary>
+            /// The alpha scale and offset of the stage 0
+            /// </summary>
+            [FieldOffset(48)]
+            public Vector4 Stage0Alpha;
+
+            /// <summary>
+            /// The vignette and scanlines of the stage 0
+            /// </summary>
+            [FieldOffset(64)]
+            public Vector4 Stage0Screen;
+
+            /// <summary>
+            /// The posterization of the stage 0
+            /// </summary>
+            [FieldOffset(80)]
+            public Vector4 Stage0Posterize;
+
+            /// <summary>
+            /// The red row of the color matrix of the stage 1
+            /// </summary>
+            [FieldOffset(96)]
+            public Vector4 Stage1Red;
+
+            /// <summary>
+            /// The green row of the color matrix of the stage 1
+            /// </summary>
+            [FieldOffset(112)]
+            public Vector4 Stage1Green;
+
+            /// <summary>
+            /// The blue row of the color matrix of the stage 1
+            /// </summary>
+            [FieldOffset(128)]
+            public Vector4 Stage1Blue;
+
+            /// <summary>
+            /// The alpha scale and offset of the stage 1
+            /// </summary>
+            [FieldOffset(144)]
+            public Vector4 Stage1Alpha;
+
+            /// <summary>
+            /// The vignette and scanlines of the stage 1
+            /// </summary>
+            [FieldOffset(160)]
+            public Vector4 Stage1Screen;
+
+            /// <summary>
+            /// The posterization of the stage 1
+            /// </summary>
+            [FieldOffset(176)]
+            public Vector4 Stage1Posterize;
+
+            /// <summary>
+            /// The red row of the color matrix of the stage 2
+            /// </summary>
+            [FieldOffset(192)]
+            public Vector4 Stage2Red;
+
+            /// <summary>
+            /// The green row of the color matrix of the stage 2
+            /// </summary>
+            [FieldOffset(208)]
+            public Vector4 Stage2Green;
+
+            /// <summary>
+            /// The blue row of the color matrix of the stage 2
+            /// </summary>
+            [FieldOffset(224)]
+            public Vector4 Stage2Blue;
+
+            /// <summary>
+            /// The alpha scale and offset of the stage 2
+            /// </summary>
+            [FieldOffset(240)]
+            public Vector4 Stage2Alpha;
+
+            /// <summary>
+            /// The vignette and scanlines of the stage 2
+            /// </summary>
+            [FieldOffset(256)]
+            public Vector4 Stage2Screen;
+
+            /// <summary>
+            /// The posterization of the stage 2
+            /// </summary>
+            [FieldOffset(272)]
+            public Vector4 Stage2Posterize;
+
+            /// <summary>
+            /// The red row of the color matrix of the stage 3
+            /// </summary>
+            [FieldOffset(288)]
+            public Vector4 Stage3Red;
+
+            /// <summary>
+            /// The green row of the color matrix of the stage 3
+            /// </summary>
+            [FieldOffset(304)]
+            public Vector4 Stage3Green;
+
+            /// <summary>
+            /// The blue row of the color matrix of the stage 3
+            /// </summary>
+            [FieldOffset(320)]
+            public Vector4 Stage3Blue;
+
+            /// <summary>
+            /// The alpha scale and offset of the stage 3
+            /// </summary>
+            [FieldOffset(336)]
+            public Vector4 Stage3Alpha;
+
+            /// <summary>
+            /// The vignette and scanlines of the stage 3
+            /// </summary>
+            [FieldOffset(352)]
+            public Vector4 Stage3Screen;
+
+            /// <summary>
+            /// The posterization of the stage 3
+            /// </summary>
+            [FieldOffset(368)]
+            public Vector4 Stage3Posterize;
+
+            /// <summary>
+            /// The color correction lookup
+            /// </summary>
+            [FieldOffset(384)]
+            public Vector4 Lookup;
+        }
+        #endregion
+
+        /// <summary>
+        /// Handle the shader parameters struct.
+        /// </summary>
+        private FusedPointwiseEffectParameters shaderParameters;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the texture.
+        /// </summary>
+        /// <value>
+        /// The texture.
+        /// </value>
+        public Texture Texture
+        {
+            get
+            {
+                return this.texture;
+            }
+
+            set
+            {
+                this.texture = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the stages evaluated by the shader.
+        /// </summary>
+        public FusedPointwiseStages Stages
+        {
+            get
+            {
+                return this.stages;
+            }
+
+            set
+            {
+                if (value == null)
+                {
+                    throw new ArgumentNullException("value");
+                }
+
+                this.stages = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets the current technique.
+        /// </summary>
+        /// <value>
+        /// The current technique.
+        /// </value>
+        public override string CurrentTechnique
+        {
+            get
+            {
+                return techniques[0].Name;
+            }
+        }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="FusedPointwiseMaterial"/> class.
+        /// </summary>
+        public FusedPointwiseMaterial()
+            : base(DefaultLayers.Opaque)
+        {
+            this.stages = new FusedPointwiseStages();
+
+            this.shaderParameters = new FusedPointwiseEffectParameters();
+            this.UpdateParameters();
+
+            this.InitializeTechniques(techniques);
+        }
+
+        /// <summary>
+        /// Initializes the specified assets.
+        /// </summary>
+        /// <param name="assets">The assets.</param>
+        public override void Initialize(WaveEngine.Framework.Services.AssetsContainer assets)
+        {
+            base.Initialize(assets);
+
+            // The same table as the ColorCorrectionMaterial
+            var assembly = this.GetMemberAssembly();
+            var currentNamespace = assembly.GetName().Name;
+
+            var textureResourcePath = currentNamespace + ".ColorCorrection.RGBTable16x1.png";
+            using (var textureStream = ResourceLoader.GetEmbeddedResourceStream(assembly, textureResourcePath))
+            {
+                this.lutTexture = Texture2D.FromFile(this.graphicsDevice, textureStream);
+            }
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Applies the pass.
+        /// </summary>
+        /// <param name="cached">The efect is cached.</param>
+        public override void SetParameters(bool cached)
+        {
+            if (!cached)
+            {
+                this.UpdateParameters();
+
+                if (this.texture != null)
+                {
+                    this.graphicsDevice.SetTexture(this.texture, 0);
+                }
+
+                if (this.lutTexture != null)
+                {
+                    this.graphicsDevice.SetTexture(this.lutTexture, 1);
+                }
+            }
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Copies the constants of the stages to the shader parameters
+        /// </summary>
+        private void UpdateParameters()
+        {
+            var constants = this.stages.Constants;
+
+            this.shaderParameters.Stage0Red = GetRegister(constants, 0);
+            this.shaderParameters.Stage0Green = GetRegister(constants, 1);
+            this.shaderParameters.Stage0Blue = GetRegister(constants, 2);
+            this.shaderParameters.Stage0Alpha = GetRegister(constants, 3);
+            this.shaderParameters.Stage0Screen = GetRegister(constants, 4);
+            this.shaderParameters.Stage0Posterize = GetRegister(constants, 5);
+            this.shaderParameters.Stage1Red = GetRegister(constants, 6);
+            this.shaderParameters.Stage1Green = GetRegister(constants, 7);
+            this.shaderParameters.Stage1Blue = GetRegister(constants, 8);
+            this.shaderParameters.Stage1Alpha = GetRegister(constants, 9);
+            this.shaderParameters.Stage1Screen = GetRegister(constants, 10);
+            this.shaderParameters.Stage1Posterize = GetRegister(constants, 11);
+            this.shaderParameters.Stage2Red = GetRegister(constants, 12);
+            this.shaderParameters.Stage2Green = GetRegister(constants, 13);
+            this.shaderParameters.Stage2Blue = GetRegister(constants, 14);
+            this.shaderParameters.Stage2Alpha = GetRegister(constants, 15);
+            this.shaderParameters.Stage2Screen = GetRegister(constants, 16);
+            this.shaderParameters.Stage2Posterize = GetRegister(constants, 17);
+            this.shaderParameters.Stage3Red = GetRegister(constants, 18);
+            this.shaderParameters.Stage3Green = GetRegister(constants, 19);
+            this.shaderParameters.Stage3Blue = GetRegister(constants, 20);
+            this.shaderParameters.Stage3Alpha = GetRegister(constants, 21);
+            this.shaderParameters.Stage3Screen = GetRegister(constants, 22);
+            this.shaderParameters.Stage3Posterize = GetRegister(constants, 23);
+            this.shaderParameters.Lookup = GetRegister(constants, FusedPointwiseStages.LookupRegister);
+            this.Parameters = this.shaderParameters;
+        }
+
+        /// <summary>
+        /// Gets a float4 register of the constants
+        /// </summary>
+        /// <param name="constants">The constants.</param>
+        /// <param name="register">The register.</param>
+        /// <returns>The register value</returns>
+        private static Vector4 GetRegister(float[] constants, int register)
+        {
+            int i = register * 4;
+            return new Vector4(constants[i], constants[i + 1], constants[i + 2], constants[i + 3]);
+        }
+        #endregion
+    }
+}
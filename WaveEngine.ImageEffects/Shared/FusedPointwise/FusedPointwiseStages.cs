@@ -0,0 +1,308 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework.Graphics;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// The shader constants that evaluate a run of pointwise lenses in the single pass of a <see cref="FusedPointwiseMaterial"/>.
+    /// </summary>
+    /// <remarks>
+    /// Every lens of the run is translated to a stage of the shader. A stage applies, in this order, a color matrix with an offset,
+    /// a scale and offset of the alpha, the vignette, the scanlines and the posterization, and saturates the result as the render
+    /// target of its own pass would. Gray scale, invert and sepia are color matrices, so every supported lens only uses some of the
+    /// operations and leaves the others with neutral values. A color correction lens does not use a stage: its lookup can only
+    /// follow the last stage, so it ends the run.
+    /// <para>
+    /// The constants are stored as <see cref="Registers"/> float4 registers. The registers of the stage <c>s</c> start at
+    /// <c>s * RegistersPerStage</c>:
+    /// </para>
+    /// <list type="bullet">
+    /// <item><description>Red, green and blue: the rows of the color matrix in xyz, and the offset in w.</description></item>
+    /// <item><description>Alpha: the scale in x and the offset in y.</description></item>
+    /// <item><description>Screen: the vignette strength in x, and the scanlines frequency and attenuation in y and z.</description></item>
+    /// <item><description>Posterize: the weight in x, the gamma in y and the regions in z.</description></item>
+    /// </list>
+    /// The last register is the color correction lookup: the weight in x, 1 for the linear color space in y, and the scale and offset
+    /// of the table coordinates in z and w.
+    /// </remarks>
+    public class FusedPointwiseStages
+    {
+        /// <summary>
+        /// The number of stages of the shader
+        /// </summary>
+        public const int MaxStages = 4;
+
+        /// <summary>
+        /// The number of float4 registers of a stage
+        /// </summary>
+        public const int RegistersPerStage = 6;
+
+        /// <summary>
+        /// The register of the color correction lookup
+        /// </summary>
+        public const int LookupRegister = MaxStages * RegistersPerStage;
+
+        /// <summary>
+        /// The number of float4 registers of the constants
+        /// </summary>
+        public const int Registers = LookupRegister + 1;
+
+        /// <summary>
+        /// The number of entries per channel of the color correction table
+        /// </summary>
+        private const int ColorTableSize = 16;
+
+        /// <summary>
+        /// The register of the alpha, in a stage
+        /// </summary>
+        private const int AlphaRegister = 3;
+
+        /// <summary>
+        /// The register of the vignette and scanlines, in a stage
+        /// </summary>
+        private const int ScreenRegister = 4;
+
+        /// <summary>
+        /// The register of the posterization, in a stage
+        /// </summary>
+        private const int PosterizeRegister = 5;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the constants, as consecutive float4 registers.
+        /// </summary>
+        public float[] Constants { get; private set; }
+
+        /// <summary>
+        /// Gets the number of stages used by the lenses of the last update.
+        /// </summary>
+        public int StageCount { get; private set; }
+
+        /// <summary>
+        /// Gets a value indicating whether the lenses of the last update end with a color correction.
+        /// </summary>
+        public bool UsesLookup { get; private set; }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="FusedPointwiseStages"/> class, with the neutral values of all stages.
+        /// </summary>
+        public FusedPointwiseStages()
+        {
+            this.Constants = new float[Registers * 4];
+            this.Update(new Lens[0]);
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Gets a value indicating whether a lens can be evaluated by the fused shader.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <returns><c>true</c> if the lens can be fused</returns>
+        public static bool CanFuse(Lens lens)
+        {
+            return lens is GrayScaleLens
+                || lens is InvertLens
+                || lens is SepiaLens
+                || lens is PosterizeLens
+                || lens is VignetteLens
+                || lens is ScanlinesLens
+                || lens is ColorCorrectionLens;
+        }
+
+        /// <summary>
+        /// Gets the number of consecutive lenses, from a given one, that fit in a single fused pass.
+        /// </summary>
+        /// <param name="lenses">The lenses, in render order.</param>
+        /// <param name="first">The index of the first lens.</param>
+        /// <returns>The number of lenses of the run, 0 if the first lens cannot be fused</returns>
+        public static int GetRunLength(IList<Lens> lenses, int first)
+        {
+            if (lenses == null)
+            {
+                throw new ArgumentNullException("lenses");
+            }
+
+            int stages = 0;
+            int end = first;
+            while (end < lenses.Count && CanFuse(lenses[end]))
+            {
+                if (lenses[end] is ColorCorrectionLens)
+                {
+                    end++;
+                    break;
+                }
+
+                if (stages == MaxStages)
+                {
+                    break;
+                }
+
+                stages++;
+                end++;
+            }
+
+            return end - first;
+        }
+
+        /// <summary>
+        /// Translates the current parameters of a run of lenses to the constants. Stages without a lens are left neutral.
+        /// </summary>
+        /// <param name="lenses">The lenses, in render order. They must fit in a single pass, see <see cref="GetRunLength"/>.</param>
+        public void Update(IList<Lens> lenses)
+        {
+            if (GetRunLength(lenses, 0) != lenses.Count)
+            {
+                throw new ArgumentException("The lenses cannot be evaluated in a single fused pass", "lenses");
+            }
+
+            for (int stage = 0; stage < MaxStages; stage++)
+            {
+                this.ResetStage(stage);
+            }
+
+            this.SetRegister(LookupRegister, 0, 0, (ColorTableSize - 1f) / ColorTableSize, 1.0f / (2.0f * ColorTableSize));
+            this.StageCount = 0;
+            this.UsesLookup = false;
+
+            for (int i = 0; i < lenses.Count; i++)
+            {
+                var lens = lenses[i];
+                if (lens is ColorCorrectionLens)
+                {
+                    bool linear = ((ColorCorrectionLens)lens).ColorSpace == ColorCorrectionMaterial.ColorSpaceType.Linear;
+                    this.Constants[LookupRegister * 4] = 1;
+                    this.Constants[(LookupRegister * 4) + 1] = linear ? 1 : 0;
+                    this.UsesLookup = true;
+                }
+                else
+                {
+                    this.SetStage(this.StageCount++, lens);
+                }
+            }
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Sets the neutral values of a stage
+        /// </summary>
+        /// <param name="stage">The stage.</param>
+        private void ResetStage(int stage)
+        {
+            int register = stage * RegistersPerStage;
+            this.SetRegister(register, 1, 0, 0, 0);
+            this.SetRegister(register + 1, 0, 1, 0, 0);
+            this.SetRegister(register + 2, 0, 0, 1, 0);
+            this.SetRegister(register + AlphaRegister, 1, 0, 0, 0);
+            this.SetRegister(register + ScreenRegister, 0, 0, 0, 0);
+            this.SetRegister(register + PosterizeRegister, 0, 1, 1, 0);
+        }
+
+        /// <summary>
+        /// Sets the values of a stage from the parameters of a lens
+        /// </summary>
+        /// <param name="stage">The stage.</param>
+        /// <param name="lens">The lens.</param>
+        private void SetStage(int stage, Lens lens)
+        {
+            int register = stage * RegistersPerStage;
+
+            if (lens is GrayScaleLens)
+            {
+                for (int row = 0; row < 3; row++)
+                {
+                    this.SetRegister(register + row, 0.3f, 0.59f, 0.11f, 0);
+                }
+
+                this.SetRegister(register + AlphaRegister, 0, 1, 0, 0);
+            }
+            else if (lens is InvertLens)
+            {
+                this.SetRegister(register, -1, 0, 0, 1);
+                this.SetRegister(register + 1, 0, -1, 0, 1);
+                this.SetRegister(register + 2, 0, 0, -1, 1);
+                this.SetRegister(register + AlphaRegister, -1, 1, 0, 0);
+            }
+            else if (lens is SepiaLens)
+            {
+                var sepia = (SepiaLens)lens;
+                this.SetSepia(register, sepia.ImageTone, sepia.DarkTone, sepia.GreyTransfer, sepia.Desaturation, sepia.Toning);
+                this.SetRegister(register + AlphaRegister, 0, sepia.GlobalAlpha, 0, 0);
+            }
+            else if (lens is PosterizeLens)
+            {
+                var posterize = (PosterizeLens)lens;
+                this.SetRegister(register + AlphaRegister, 0, 1, 0, 0);
+                this.SetRegister(register + PosterizeRegister, 1, posterize.Gamma, posterize.Regions, 0);
+            }
+            else if (lens is VignetteLens)
+            {
+                // The vignette scales the squared distance to the center by the radio before applying the power
+                var vignette = (VignetteLens)lens;
+                this.Constants[(register + ScreenRegister) * 4] = vignette.Power * vignette.Radio * vignette.Radio;
+            }
+            else if (lens is ScanlinesLens)
+            {
+                var scanlines = (ScanlinesLens)lens;
+                this.SetRegister(register + AlphaRegister, 0, 1, 0, 0);
+                this.SetRegister(register + ScreenRegister, 0, scanlines.LinesFactor, scanlines.Attenuation, 0);
+            }
+        }
+
+        /// <summary>
+        /// Sets the color matrix of a sepia lens. The sepia shader is linear in the color: it tints it, takes its grey level,
+        /// desaturates the tinted color towards it and blends with the ramp between the dark tone and the image tone.
+        /// </summary>
+        /// <param name="register">The first register of the stage.</param>
+        /// <param name="imageTone">The image tone.</param>
+        /// <param name="darkTone">The dark tone.</param>
+        /// <param name="greyTransfer">The grey transfer.</param>
+        /// <param name="desaturation">The desaturation.</param>
+        /// <param name="toning">The toning.</param>
+        private void SetSepia(int register, Vector3 imageTone, Vector3 darkTone, Vector3 greyTransfer, float desaturation, float toning)
+        {
+            var grey = new Vector3(greyTransfer.X * imageTone.X, greyTransfer.Y * imageTone.Y, greyTransfer.Z * imageTone.Z);
+            float muted = (1 - toning) * (1 - desaturation);
+
+            float greyWeight = ((1 - toning) * desaturation) + (toning * (imageTone.X - darkTone.X));
+            this.SetRegister(register, (greyWeight * grey.X) + (muted * imageTone.X), greyWeight * grey.Y, greyWeight * grey.Z, toning * darkTone.X);
+
+            greyWeight = ((1 - toning) * desaturation) + (toning * (imageTone.Y - darkTone.Y));
+            this.SetRegister(register + 1, greyWeight * grey.X, (greyWeight * grey.Y) + (muted * imageTone.Y), greyWeight * grey.Z, toning * darkTone.Y);
+
+            greyWeight = ((1 - toning) * desaturation) + (toning * (imageTone.Z - darkTone.Z));
+            this.SetRegister(register + 2, greyWeight * grey.X, greyWeight * grey.Y, (greyWeight * grey.Z) + (muted * imageTone.Z), toning * darkTone.Z);
+        }
+
+        /// <summary>
+        /// Sets the components of a register
+        /// </summary>
+        /// <param name="register">The register.</param>
+        /// <param name="x">The x component.</param>
+        /// <param name="y">The y component.</param>
+        /// <param name="z">The z component.</param>
+        /// <param name="w">The w component.</param>
+        private void SetRegister(int register, float x, float y, float z, float w)
+        {
+            int i = register * 4;
+            this.Constants[i] = x;
+            this.Constants[i + 1] = y;
+            this.Constants[i + 2] = z;
+            this.Constants[i + 3] = w;
+        }
+        #endregion
+    }
+}
@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -15,7 +16,7 @@ namespace WaveEngine.ImageEffects
     /// Represent a GaussianBlur as postprocessing filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class GaussianBlurLens : Lens
+    public class GaussianBlurLens : Lens, ITransientTargetLens
     {
         #region Properties
 
@@ -36,6 +37,29 @@ namespace WaveEngine.ImageEffects
                 (this.material as GaussianBlurMaterial).Factor = value;
             }
         }
+
+        /// <summary>
+        /// Gets or sets the standard deviation of the blur in texels, by default this value is 0, which uses the fixed kernel.
+        /// </summary>
+        [DataMember]
+        [RenderPropertyAsSlider(0.0f, 16.0f, 0.1f)]
+        public float Sigma
+        {
+            get
+            {
+                return (this.material as GaussianBlurMaterial).Sigma;
+            }
+
+            set
+            {
+                (this.material as GaussianBlurMaterial).Sigma = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
         #endregion
 
         #region Initialize
@@ -61,6 +85,15 @@ namespace WaveEngine.ImageEffects
 
         #region Public Methods
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            requests.Add(new TransientTargetRequest(1, 0, 1));
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -69,18 +102,22 @@ namespace WaveEngine.ImageEffects
         {
             var mat = this.material as GaussianBlurMaterial;
 
-            RenderTarget rt1 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(this.Source.Width, this.Source.Height);
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 0, this.Source.Width, this.Source.Height);
             mat.Pass = GaussianBlurMaterial.Passes.Horizontal;
             mat.Texture = this.Source;
+            LensProfiler.BeginPass(this, "Horizontal");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
 
             mat.Pass = GaussianBlurMaterial.Passes.Vertical;
             mat.Texture = rt1;
+            LensProfiler.BeginPass(this, "Vertical");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
 
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt1);
+            TransientTargetPool.Release(this, rt1);
         }
         #endregion
 
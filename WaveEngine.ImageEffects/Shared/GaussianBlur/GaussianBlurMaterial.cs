@@ -17,6 +17,11 @@ namespace WaveEngine.ImageEffects
     /// </summary>
     public class GaussianBlurMaterial : Material
     {
+        /// <summary>
+        /// The number of taps of the shader
+        /// </summary>
+        public const int MaxTaps = 14;
+
         /// <summary>
         /// Effects passes.
         /// </summary>
@@ -38,6 +43,21 @@ namespace WaveEngine.ImageEffects
         /// </summary>
         private Texture texture;
 
+        /// <summary>
+        /// The weights of the taps
+        /// </summary>
+        private float[] sampleWeights;
+
+        /// <summary>
+        /// The texture coordinate offsets of the taps
+        /// </summary>
+        private Vector2[] sampleOffsets;
+
+        /// <summary>
+        /// The kernel of the current sigma
+        /// </summary>
+        private GaussianKernel kernel;
+
         /// <summary>
         /// The techniques
         /// </summary>
@@ -157,6 +177,11 @@ namespace WaveEngine.ImageEffects
         /// </summary>
         public float Factor { get; set; }
 
+        /// <summary>
+        /// Gets or sets the standard deviation of the blur, in texels. When it is 0 the fixed kernel is used. In both cases the offsets are scaled by <see cref="Factor"/>.
+        /// </summary>
+        public float Sigma { get; set; }
+
         /// <summary>
         /// Gets or sets the texture.
         /// </summary>
@@ -208,6 +233,8 @@ namespace WaveEngine.ImageEffects
         {
             base.DefaultValues();
             this.Factor = 1.0f;
+            this.sampleWeights = new float[15];
+            this.sampleOffsets = new Vector2[15];
             this.shaderParameters = new BlurEffectParameters();
             this.Parameters = this.shaderParameters;
 
@@ -232,15 +259,27 @@ namespace WaveEngine.ImageEffects
         /// <param name="cached">The efect is cached.</param>
         public override void SetParameters(bool cached)
         {
+            Vector2 direction;
             if (this.Pass == Passes.Horizontal)
             {
-                this.ComputeGaussianBlur(this.Factor / this.texture.Width, 0);
+                direction = new Vector2(this.Factor / this.texture.Width, 0);
             }
             else
             {
-                this.ComputeGaussianBlur(0, this.Factor / this.texture.Height);
+                direction = new Vector2(0, this.Factor / this.texture.Height);
             }
 
+            if (this.Sigma > 0)
+            {
+                this.ComputeKernelBlur(direction);
+            }
+            else
+            {
+                this.ComputeGaussianBlur(direction.X, direction.Y);
+            }
+
+            this.UpdateShaderSamples();
+
             this.Parameters = this.shaderParameters;
 
             if (this.texture != null)
@@ -262,9 +301,8 @@ namespace WaveEngine.ImageEffects
             // Look up how many samples our gaussian blur effect supports.
             int sampleCount = 15;
 
-            // Create temporary arrays for computing our filter settings.
-            float[] sampleWeights = new float[sampleCount];
-            Vector2[] sampleOffsets = new Vector2[sampleCount];
+            float[] sampleWeights = this.sampleWeights;
+            Vector2[] sampleOffsets = this.sampleOffsets;
 
             // The first sample always has a zero offset.
             sampleWeights[0] = this.ComputeGaussian(0);
@@ -307,6 +345,41 @@ namespace WaveEngine.ImageEffects
             {
                 sampleWeights[i] /= totalWeights;
             }
+        }
+
+        /// <summary>
+        /// Computes the taps of the generated kernel of <see cref="Sigma"/>
+        /// </summary>
+        /// <param name="direction">The size of a texel along the blur direction.</param>
+        private void ComputeKernelBlur(Vector2 direction)
+        {
+            if (this.kernel == null || this.kernel.Sigma != this.Sigma)
+            {
+                this.kernel = GaussianKernel.Create(this.Sigma, MaxTaps);
+            }
+
+            for (int i = 0; i < this.sampleWeights.Length; i++)
+            {
+                if (i < this.kernel.TapCount)
+                {
+                    this.sampleWeights[i] = this.kernel.Weights[i];
+                    this.sampleOffsets[i] = direction * this.kernel.Offsets[i];
+                }
+                else
+                {
+                    this.sampleWeights[i] = 0;
+                    this.sampleOffsets[i] = Vector2.Zero;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Copies the taps to the shader parameters
+        /// </summary>
+        private void UpdateShaderSamples()
+        {
+            var sampleOffsets = this.sampleOffsets;
+            var sampleWeights = this.sampleWeights;
 
             // Tell the effect about our new filter settings.
             this.shaderParameters.SampleOffsets0 = sampleOffsets[0];
@@ -0,0 +1,144 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// The taps of a one dimensional gaussian blur that uses linear sampling.
+    /// </summary>
+    /// <remarks>
+    /// Each tap, except the center one, samples between two texels so the bilinear filter weights both of them,
+    /// which halves the number of taps of the discrete kernel. The taps are stored as the center tap followed by
+    /// pairs of positive and negative offsets, in texels.
+    /// </remarks>
+    public class GaussianKernel
+    {
+        #region Properties
+
+        /// <summary>
+        /// Gets the standard deviation, in texels.
+        /// </summary>
+        public float Sigma { get; private set; }
+
+        /// <summary>
+        /// Gets the distance between the texels of the discrete kernel. It is 1 unless the kernel
+        /// has been stretched to fit the available taps.
+        /// </summary>
+        public int Step { get; private set; }
+
+        /// <summary>
+        /// Gets the radius of the discrete kernel, in texels.
+        /// </summary>
+        public int Radius { get; private set; }
+
+        /// <summary>
+        /// Gets the offsets of the taps, in texels.
+        /// </summary>
+        public float[] Offsets { get; private set; }
+
+        /// <summary>
+        /// Gets the normalized weights of the taps.
+        /// </summary>
+        public float[] Weights { get; private set; }
+
+        /// <summary>
+        /// Gets the number of taps.
+        /// </summary>
+        public int TapCount
+        {
+            get { return this.Offsets.Length; }
+        }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Prevents a default instance of the <see cref="GaussianKernel"/> class from being created.
+        /// </summary>
+        private GaussianKernel()
+        {
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Creates the kernel of a standard deviation.
+        /// </summary>
+        /// <remarks>
+        /// The discrete kernel covers three standard deviations. When it needs more taps than available,
+        /// its texels are spread by a larger <see cref="Step"/>, which approximates the blur with the available taps.
+        /// </remarks>
+        /// <param name="sigma">The standard deviation, in texels.</param>
+        /// <param name="maxTaps">The maximum number of taps of the shader.</param>
+        /// <returns>The kernel</returns>
+        public static GaussianKernel Create(float sigma, int maxTaps)
+        {
+            if (sigma <= 0)
+            {
+                throw new ArgumentOutOfRangeException("sigma");
+            }
+
+            if (maxTaps < 1)
+            {
+                throw new ArgumentOutOfRangeException("maxTaps");
+            }
+
+            // The center tap and a number of symmetric pairs
+            int maxPairs = (maxTaps - 1) / 2;
+
+            int step = 1;
+            int radius;
+            while (true)
+            {
+                radius = (int)Math.Ceiling(3 * sigma / step);
+                if ((radius + 1) / 2 <= maxPairs)
+                {
+                    break;
+                }
+
+                step++;
+            }
+
+            float gridSigma = sigma / step;
+            var discrete = new double[radius + 2];
+            double total = 0;
+            for (int k = 0; k <= radius; k++)
+            {
+                discrete[k] = Math.Exp(-(k * k) / (2.0 * gridSigma * gridSigma));
+                total += k == 0 ? discrete[k] : discrete[k] * 2;
+            }
+
+            int pairs = (radius + 1) / 2;
+            var kernel = new GaussianKernel()
+            {
+                Sigma = sigma,
+                Step = step,
+                Radius = radius * step,
+                Offsets = new float[1 + (pairs * 2)],
+                Weights = new float[1 + (pairs * 2)],
+            };
+
+            kernel.Weights[0] = (float)(discrete[0] / total);
+
+            for (int p = 0; p < pairs; p++)
+            {
+                // The texels k and k + 1 are merged in a single tap
+                int k = (p * 2) + 1;
+                double weight = discrete[k] + discrete[k + 1];
+                double offset = ((k * discrete[k]) + ((k + 1) * discrete[k + 1])) / weight;
+
+                kernel.Offsets[(p * 2) + 1] = (float)(offset * step);
+                kernel.Offsets[(p * 2) + 2] = (float)(-offset * step);
+                kernel.Weights[(p * 2) + 1] = (float)(weight / total);
+                kernel.Weights[(p * 2) + 2] = (float)(weight / total);
+            }
+
+            return kernel;
+        }
+        #endregion
+    }
+}
@@ -1,7 +1,7 @@
 ﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
 
 #region Usings Statements
-
+using WaveEngine.Framework.Graphics;
 #endregion
 
 namespace WaveEngine.ImageEffects
@@ -112,6 +112,17 @@ namespace WaveEngine.ImageEffects
             return new FishEyeLens();
         }
 
+        /// <summary>
+        /// Gets a new <see cref="FusedPointwiseLens"/> that renders consecutive pointwise lenses in a single pass.
+        /// The fused lenses are not added to the camera.
+        /// </summary>
+        /// <param name="lenses">The fused lenses, in render order.</param>
+        /// <returns>A instance of FusedPointwiseLens.</returns>
+        public static FusedPointwiseLens FusedPointwise(params Lens[] lenses)
+        {
+            return new FusedPointwiseLens(lenses);
+        }
+
         /// <summary>
         /// Gets a new <see cref="FogLens"/>.
         /// </summary>
@@ -284,6 +295,19 @@ namespace WaveEngine.ImageEffects
             return new ToneMappingLens();
         }
 
+        /// <summary>
+        /// Gets a new <see cref="TransientTargetPool"/> that shares the intermediate render targets of a chain of lenses.
+        /// The pool must be disposed when the lenses are removed.
+        /// </summary>
+        /// <param name="lenses">The lenses of the camera, in render order.</param>
+        /// <returns>A instance of TransientTargetPool bound to the lenses.</returns>
+        public static TransientTargetPool TransientTargets(params Lens[] lenses)
+        {
+            var pool = new TransientTargetPool();
+            pool.SetLenses(lenses);
+            return pool;
+        }
+
         /// <summary>
         /// Gets a new <see cref="VignetteLens"/>.
         /// </summary>
@@ -39,7 +39,9 @@ namespace WaveEngine.ImageEffects
         {
             var mat = this.material as InvertMaterial;
             mat.Texture = this.Source;
+            LensProfiler.BeginPass(this, "Render");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
         }
@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -15,7 +16,7 @@ namespace WaveEngine.ImageEffects
     /// Represent a Lens Flare as postprocessing filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class LensFlareLens : Lens
+    public class LensFlareLens : Lens, ITransientTargetLens
     {
         #region Properties
 
@@ -126,6 +127,11 @@ namespace WaveEngine.ImageEffects
                 (this.material as LensFlareMaterial).Intensity = value;
             }
         }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
         #endregion
 
         #region Initialize
@@ -151,6 +157,16 @@ namespace WaveEngine.ImageEffects
 
         #region Public Methods
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            requests.Add(new TransientTargetRequest(4, 0, 3));
+            requests.Add(new TransientTargetRequest(4, 1, 2));
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -168,40 +184,48 @@ namespace WaveEngine.ImageEffects
             int width = this.Source.Width / 4;
             int height = this.Source.Height / 4;
 
-            RenderTarget rt1 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            RenderTarget rt2 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            graphicsDevice.Viewport = new Viewport(0, 0, width, height);
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 0, width, height);
+            RenderTarget rt2 = TransientTargetPool.Acquire(this, 1, width, height);
+            TransientTargetPool.SetViewport(rt1);
 
             // Down sampler
             mat.Pass = LensFlareMaterial.Passes.DownSampler;
             mat.Texture = this.Source;
             mat.LensFlareTexture = null;
+            LensProfiler.BeginPass(this, "Down sampler");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
 
             // LensFlare
             mat.Pass = LensFlareMaterial.Passes.LensFlare;
             mat.Texture = rt1;
             mat.LensFlareTexture = null;
+            LensProfiler.BeginPass(this, "LensFlare");
             this.RenderToImage(rt2, this.material);
+            LensProfiler.EndPass();
 
             // Blur
             mat.Pass = LensFlareMaterial.Passes.Blur;
             mat.Texture = rt2;
             mat.LensFlareTexture = null;
+            LensProfiler.BeginPass(this, "Blur");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
 
             // Combine
-            graphicsDevice.Viewport = new Viewport(0, 0, this.Source.Width, this.Source.Height);
+            TransientTargetPool.RestoreViewport(this);
             mat.Pass = LensFlareMaterial.Passes.Combine;
             mat.Texture = this.Source;
             mat.LensFlareTexture = rt1;
+            LensProfiler.BeginPass(this, "Combine");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
             mat.LensFlareTexture = null;
 
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt1);
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt2);
+            TransientTargetPool.Release(this, rt1);
+            TransientTargetPool.Release(this, rt2);
         }
         #endregion
 
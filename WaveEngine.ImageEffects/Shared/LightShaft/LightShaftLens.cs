@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -16,18 +17,28 @@ namespace WaveEngine.ImageEffects
     /// Represent a Light shaft as postprocessing filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class LightShaftLens : Lens
+    public class LightShaftLens : Lens, ITransientTargetLens
     {
         /// <summary>
         /// The blur downsample factor
         /// </summary>
         private float downSampleFactor;
 
+        /// <summary>
+        /// The resolution scale
+        /// </summary>
+        private float resolutionScale;
+
         /// <summary>
         /// The directional light entity path
         /// </summary>
         private string directionalLightPath;
 
+        /// <summary>
+        /// Renders a material to a render target, used to build the pyramid
+        /// </summary>
+        private Action<RenderTarget, Material> renderToImage;
+
         #region Properties
 
         /// <summary>
@@ -226,6 +237,54 @@ namespace WaveEngine.ImageEffects
             }
         }
 
+        /// <summary>
+        /// Gets or sets the fraction of the source resolution where the light shafts are rendered, on top of <see cref="DownSampleFactor"/>.
+        /// The light shafts are upsampled to the source resolution by the combine pass. Default value is 1.
+        /// </summary>
+        [DataMember]
+        [RenderPropertyAsSlider(0.25f, 1, 0.25f)]
+        public float ResolutionScale
+        {
+            get
+            {
+                return this.resolutionScale;
+            }
+
+            set
+            {
+                if (value <= 0 || value > 1)
+                {
+                    throw new ArgumentOutOfRangeException("value");
+                }
+
+                this.resolutionScale = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets a value indicating whether the light shafts are upsampled weighting their texels by their depth,
+        /// so they do not bleed over the occluders. Default value is false.
+        /// </summary>
+        [DataMember]
+        public bool BilateralUpsample { get; set; }
+
+        /// <summary>
+        /// Gets or sets the depth difference where the weight of a light shaft texel falls to 60% in the bilateral upsample, default value is 0.001f.
+        /// </summary>
+        [DataMember]
+        public float DepthSigma
+        {
+            get
+            {
+                return (this.material as LightShaftMaterial).DepthSigma;
+            }
+
+            set
+            {
+                (this.material as LightShaftMaterial).DepthSigma = value;
+            }
+        }
+
         /// <summary>
         /// Gets or sets light Shaft quality, Low by default.
         /// </summary>
@@ -265,6 +324,27 @@ namespace WaveEngine.ImageEffects
                 }
             }
         }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
+
+        /// <summary>
+        /// Gets or sets the blur pyramid shared with other lenses of the camera, or null to downsample the source directly.
+        /// </summary>
+        public BlurPyramid Pyramid { get; set; }
+
+        /// <summary>
+        /// Gets the divisor of the source size that gives the size of the intermediate targets
+        /// </summary>
+        private float Divisor
+        {
+            get
+            {
+                return this.downSampleFactor / this.resolutionScale;
+            }
+        }
         #endregion
 
         #region Initialize
@@ -285,6 +365,7 @@ namespace WaveEngine.ImageEffects
             base.DefaultValues();
 
             this.downSampleFactor = 2;
+            this.resolutionScale = 1;
             this.material = new LightShaftMaterial();
         }
         #endregion
@@ -301,6 +382,17 @@ namespace WaveEngine.ImageEffects
             this.RefrehsDirectionalLight();
         }
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            float divisor = this.Divisor;
+            requests.Add(new TransientTargetRequest(divisor, 0, 1));
+            requests.Add(new TransientTargetRequest(divisor, 1, 2));
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -319,35 +411,59 @@ namespace WaveEngine.ImageEffects
                 mat.TexcoordOffset.Y = 1f / this.Source.Height;
             }
 
-            int width = (int)(this.Source.Width / this.downSampleFactor);
-            int height = (int)(this.Source.Height / this.downSampleFactor);
+            Vector2 texcoordOffset = mat.TexcoordOffset;
 
-            RenderTarget rt1 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            RenderTarget rt2 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            graphicsDevice.Viewport = new Viewport(0, 0, width, height);
+            float divisor = this.Divisor;
+            int width = (int)(this.Source.Width / divisor);
+            int height = (int)(this.Source.Height / divisor);
+
+            Texture downSampleSource = this.Source;
+            int pyramidLevel = BlurPyramid.GetLevelForDivisor(divisor);
+            if (this.Pyramid != null && pyramidLevel >= 1 && pyramidLevel <= this.Pyramid.MaxLevels)
+            {
+                if (this.renderToImage == null)
+                {
+                    this.renderToImage = this.RenderToImage;
+                }
+
+                downSampleSource = this.Pyramid.GetLevel(this, this.Source, pyramidLevel, this.renderToImage);
+            }
+
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 0, width, height);
+            RenderTarget rt2 = TransientTargetPool.Acquire(this, 1, width, height);
+            TransientTargetPool.SetViewport(rt1);
 
             // Black mask
             mat.Pass = LightShaftMaterial.Passes.BlackMask;
-            mat.Texture = this.Source;
+            mat.Texture = downSampleSource;
+            mat.TexcoordOffset = new Vector2(1f / downSampleSource.Width, 1f / downSampleSource.Height);
+            LensProfiler.BeginPass(this, "Black mask");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
+            mat.TexcoordOffset = texcoordOffset;
 
             // LightShaft
             mat.Pass = LightShaftMaterial.Passes.LightShaft;
             mat.Texture = rt1;
+            LensProfiler.BeginPass(this, "LightShaft");
             this.RenderToImage(rt2, this.material);
+            LensProfiler.EndPass();
 
             // UpCombine
-            graphicsDevice.Viewport = new Viewport(0, 0, this.Source.Width, this.Source.Height);
-            mat.Pass = LightShaftMaterial.Passes.Combine;
+            TransientTargetPool.RestoreViewport(this);
+            mat.Pass = this.BilateralUpsample && divisor > 1 ? LightShaftMaterial.Passes.CombineBilateral : LightShaftMaterial.Passes.Combine;
             mat.Texture = this.Source;
             mat.Texture1 = rt2;
+            mat.ShaftTextureSize = new Vector2(width, height);
+            LensProfiler.BeginPass(this, "UpCombine");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
             mat.Texture1 = null;
 
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt1);
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt2);
+            TransientTargetPool.Release(this, rt1);
+            TransientTargetPool.Release(this, rt2);
         }
         #endregion
 
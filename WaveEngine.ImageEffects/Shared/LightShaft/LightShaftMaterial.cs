@@ -59,6 +59,11 @@ namespace WaveEngine.ImageEffects
             /// The blur
             /// </summary>
             LightShaft = 2,
+
+            /// <summary>
+            /// Combine with a bilateral upsample of the light shafts
+            /// </summary>
+            CombineBilateral = 3,
         }
 
         /// <summary>
@@ -102,6 +107,7 @@ namespace WaveEngine.ImageEffects
             new ShaderTechnique("LightShaft_Low", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psLightShaft", VertexPositionTexture.VertexFormat, null, new string[] { "LOW" }),
             new ShaderTechnique("LightShaft_Medium", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psLightShaft", VertexPositionTexture.VertexFormat, null, new string[] { "MEDIUM" }),
             new ShaderTechnique("LightShaft_High", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psLightShaft", VertexPositionTexture.VertexFormat, null, new string[] { "HIGH" }),
+            new ShaderTechnique("CombineBilateral", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psLSCombineBilateral", VertexPositionTexture.VertexFormat),
         };
 
         #region Struct
@@ -109,7 +115,7 @@ namespace WaveEngine.ImageEffects
         /// <summary>
         /// Shader parameters.
         /// </summary>
-        [StructLayout(LayoutKind.Explicit, Size = 64)]
+        [StructLayout(LayoutKind.Explicit, Size = 80)]
         private struct LSEffectParameters
         {
             [FieldOffset(0)]
@@ -147,6 +153,12 @@ namespace WaveEngine.ImageEffects
 
             [FieldOffset(60)]
             public float DepthThreshold;
+
+            [FieldOffset(64)]
+            public Vector2 ShaftTextureSize;
+
+            [FieldOffset(72)]
+            public float DepthSigma;
         }
         #endregion
 
@@ -233,6 +245,16 @@ namespace WaveEngine.ImageEffects
         /// </summary>
         public Vector2 LightCenter { get; set; }
 
+        /// <summary>
+        /// Gets or sets the size in texels of the light shaft texture, used by the bilateral combine pass.
+        /// </summary>
+        public Vector2 ShaftTextureSize { get; set; }
+
+        /// <summary>
+        /// Gets or sets the depth difference where the weight of a light shaft texel falls to 60% in the bilateral combine pass.
+        /// </summary>
+        public float DepthSigma { get; set; }
+
         /// <summary>
         /// Gets or sets the texture.
         /// </summary>
@@ -321,6 +343,11 @@ namespace WaveEngine.ImageEffects
                     case 2:
                         index += (int)this.Quality;
 
+                        break;
+                    case 3:
+                        // The bilateral combine follows the quality techniques
+                        index = techniques.Length - 1;
+
                         break;
                 }
 
@@ -363,6 +390,7 @@ namespace WaveEngine.ImageEffects
 
             this.LightCenter = new Vector2(0.5f);
             this.ShaftTint = Color.White;
+            this.DepthSigma = 0.001f;
             this.shaderParameters = new LSEffectParameters();
             this.Parameters = this.shaderParameters;
 
@@ -389,7 +417,7 @@ namespace WaveEngine.ImageEffects
         {
             if (!cached)
             {
-                if (this.Pass != Passes.Combine)
+                if (this.Pass != Passes.Combine && this.Pass != Passes.CombineBilateral)
                 {
                     // Calcule light projection
                     Camera camera = this.renderManager.CurrentDrawingCamera;
@@ -470,8 +498,18 @@ namespace WaveEngine.ImageEffects
                         this.Parameters = this.shaderParameters;
                     }
                 }
-                else
+                else if (this.Pass == Passes.CombineBilateral)
                 {
+                    // Bilateral Combine PASS
+                    this.depthTexture = this.renderManager.GraphicsDevice.RenderTargets.DefaultDepthTexture;
+                    this.shaderParameters.ShaftTextureSize = this.ShaftTextureSize;
+                    this.shaderParameters.DepthSigma = this.DepthSigma;
+                    this.Parameters = this.shaderParameters;
+
+                    if (this.depthTexture != null)
+                    {
+                        this.graphicsDevice.SetTexture(this.depthTexture, 2);
+                    }
                 }
 
                 if (this.texture != null)
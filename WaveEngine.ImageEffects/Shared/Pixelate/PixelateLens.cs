@@ -87,7 +87,9 @@ namespace WaveEngine.ImageEffects
             mat.PixelSize.X = this.Source.Width / this.pixelSize.X;
             mat.PixelSize.Y = this.Source.Height / this.pixelSize.Y;
 
+            LensProfiler.BeginPass(this, "Render");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
         }
@@ -0,0 +1,440 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Text;
+using WaveEngine.Framework.Graphics;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// Records the time spent in each pass of the lenses, for the last frames.
+    /// </summary>
+    /// <remarks>
+    /// The lenses report their passes to <see cref="Current"/>, so profiling is disabled while it is null.
+    /// Call <see cref="BeginFrame"/> once per frame, before the camera renders its lenses: passes are only recorded inside a frame,
+    /// and the frame is stored in the ring buffer by <see cref="EndFrame"/> or by the next <see cref="BeginFrame"/>.
+    /// Passes can be nested, each <see cref="End"/> closes the innermost open pass.
+    /// The recorded time is the CPU time to submit each pass, the graphics device does not expose GPU timestamp queries.
+    /// </remarks>
+    public class LensProfiler
+    {
+        /// <summary>
+        /// The default number of frames kept
+        /// </summary>
+        private const int DefaultFrameCapacity = 120;
+
+        /// <summary>
+        /// The ring buffer of frames
+        /// </summary>
+        private LensProfilerFrame[] frames;
+
+        /// <summary>
+        /// The frame being recorded, swapped with the oldest frame of the ring buffer when it is stored
+        /// </summary>
+        private LensProfilerFrame recordingFrame;
+
+        /// <summary>
+        /// The index of the ring buffer where the next frame is stored
+        /// </summary>
+        private int currentIndex;
+
+        /// <summary>
+        /// The number of stored frames
+        /// </summary>
+        private int storedFrames;
+
+        /// <summary>
+        /// Gets the current timestamp
+        /// </summary>
+        private Func<long> clock;
+
+        /// <summary>
+        /// The number of timestamp ticks per second
+        /// </summary>
+        private double ticksPerMillisecond;
+
+        /// <summary>
+        /// The timestamp of the creation of the profiler
+        /// </summary>
+        private long originTimestamp;
+
+        /// <summary>
+        /// Whether a frame is being recorded
+        /// </summary>
+        private bool frameStarted;
+
+        /// <summary>
+        /// The timestamp of the start of the current frame
+        /// </summary>
+        private long frameTimestamp;
+
+        /// <summary>
+        /// The open passes, the innermost one on top
+        /// </summary>
+        private Stack<LensProfilerSample> openPasses;
+
+        /// <summary>
+        /// The timestamps of the start of the open passes
+        /// </summary>
+        private Stack<long> openTimestamps;
+
+        /// <summary>
+        /// The number of the next frame
+        /// </summary>
+        private long frameNumber;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the profiler that records the passes of the lenses, or null to disable profiling.
+        /// </summary>
+        public static LensProfiler Current { get; set; }
+
+        /// <summary>
+        /// Gets the number of frames kept in the ring buffer.
+        /// </summary>
+        public int FrameCapacity
+        {
+            get { return this.frames.Length; }
+        }
+
+        /// <summary>
+        /// Gets the number of stored frames.
+        /// </summary>
+        public int FrameCount
+        {
+            get { return this.storedFrames; }
+        }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LensProfiler"/> class.
+        /// </summary>
+        public LensProfiler()
+            : this(DefaultFrameCapacity)
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LensProfiler"/> class.
+        /// </summary>
+        /// <param name="frameCapacity">The number of frames kept.</param>
+        public LensProfiler(int frameCapacity)
+            : this(frameCapacity, Stopwatch.GetTimestamp, Stopwatch.Frequency)
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LensProfiler"/> class.
+        /// </summary>
+        /// <param name="frameCapacity">The number of frames kept.</param>
+        /// <param name="clock">Gets the current timestamp.</param>
+        /// <param name="ticksPerSecond">The number of timestamp ticks per second.</param>
+        public LensProfiler(int frameCapacity, Func<long> clock, long ticksPerSecond)
+        {
+            if (frameCapacity < 1)
+            {
+                throw new ArgumentOutOfRangeException("frameCapacity");
+            }
+
+            if (clock == null)
+            {
+                throw new ArgumentNullException("clock");
+            }
+
+            if (ticksPerSecond <= 0)
+            {
+                throw new ArgumentOutOfRangeException("ticksPerSecond");
+            }
+
+            this.frames = new LensProfilerFrame[frameCapacity];
+            for (int i = 0; i < frameCapacity; i++)
+            {
+                this.frames[i] = new LensProfilerFrame();
+            }
+
+            this.recordingFrame = new LensProfilerFrame();
+            this.openPasses = new Stack<LensProfilerSample>();
+            this.openTimestamps = new Stack<long>();
+            this.clock = clock;
+            this.ticksPerMillisecond = ticksPerSecond / 1000.0;
+            this.originTimestamp = clock();
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Starts a pass of a lens in the current profiler.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="pass">The name of the pass.</param>
+        public static void BeginPass(Lens lens, string pass)
+        {
+            var profiler = Current;
+            if (profiler != null)
+            {
+                profiler.Begin(lens.GetType().Name, pass);
+            }
+        }
+
+        /// <summary>
+        /// Ends the open pass in the current profiler.
+        /// </summary>
+        public static void EndPass()
+        {
+            var profiler = Current;
+            if (profiler != null)
+            {
+                profiler.End();
+            }
+        }
+
+        /// <summary>
+        /// Starts recording a frame. The frame being recorded, if any, is stored first.
+        /// </summary>
+        public void BeginFrame()
+        {
+            this.EndFrame();
+
+            this.frameStarted = true;
+            this.frameTimestamp = this.clock();
+            this.recordingFrame.Clear();
+        }
+
+        /// <summary>
+        /// Starts a pass, nested in the open passes. It is ignored outside a frame.
+        /// </summary>
+        /// <param name="lens">The name of the lens.</param>
+        /// <param name="pass">The name of the pass.</param>
+        public void Begin(string lens, string pass)
+        {
+            if (!this.frameStarted)
+            {
+                return;
+            }
+
+            this.openPasses.Push(new LensProfilerSample()
+            {
+                Lens = lens ?? string.Empty,
+                Pass = pass ?? string.Empty,
+                Depth = this.openPasses.Count,
+            });
+
+            this.openTimestamps.Push(this.clock());
+        }
+
+        /// <summary>
+        /// Ends the innermost open pass and records its sample.
+        /// </summary>
+        public void End()
+        {
+            if (this.openPasses.Count == 0)
+            {
+                return;
+            }
+
+            long now = this.clock();
+            long start = this.openTimestamps.Pop();
+            var sample = this.openPasses.Pop();
+            sample.StartMilliseconds = (start - this.frameTimestamp) / this.ticksPerMillisecond;
+            sample.DurationMilliseconds = (now - start) / this.ticksPerMillisecond;
+            this.recordingFrame.Add(sample);
+        }
+
+        /// <summary>
+        /// Ends the open passes and stores the samples of the frame being recorded in the ring buffer.
+        /// Frames without samples are not stored.
+        /// </summary>
+        public void EndFrame()
+        {
+            while (this.openPasses.Count > 0)
+            {
+                this.End();
+            }
+
+            if (!this.frameStarted)
+            {
+                return;
+            }
+
+            this.frameStarted = false;
+            var frame = this.recordingFrame;
+            if (frame.Samples.Count == 0)
+            {
+                return;
+            }
+
+            this.recordingFrame = this.frames[this.currentIndex];
+            this.frames[this.currentIndex] = frame;
+            frame.FrameNumber = this.frameNumber++;
+            frame.StartMilliseconds = (this.frameTimestamp - this.originTimestamp) / this.ticksPerMillisecond;
+
+            this.currentIndex = (this.currentIndex + 1) % this.frames.Length;
+            this.storedFrames = Math.Min(this.storedFrames + 1, this.frames.Length);
+        }
+
+        /// <summary>
+        /// Gets a stored frame.
+        /// </summary>
+        /// <param name="age">The age of the frame, 0 is the last stored frame.</param>
+        /// <returns>The frame</returns>
+        public LensProfilerFrame GetFrame(int age)
+        {
+            if (age < 0 || age >= this.storedFrames)
+            {
+                throw new ArgumentOutOfRangeException("age");
+            }
+
+            int index = this.currentIndex - 1 - age;
+            if (index < 0)
+            {
+                index += this.frames.Length;
+            }
+
+            return this.frames[index];
+        }
+
+        /// <summary>
+        /// Removes all the stored frames.
+        /// </summary>
+        public void Clear()
+        {
+            this.openPasses.Clear();
+            this.openTimestamps.Clear();
+            this.frameStarted = false;
+            this.storedFrames = 0;
+            this.currentIndex = 0;
+        }
+
+        /// <summary>
+        /// Gets a summary of the stored frames, with the average and maximum time of each pass, to be shown in an overlay.
+        /// </summary>
+        /// <returns>One line per pass</returns>
+        public string GetOverlayText()
+        {
+            var keys = new List<string>();
+            var totals = new Dictionary<string, double>();
+            var maximums = new Dictionary<string, double>();
+            double frameTotal = 0;
+
+            for (int age = 0; age < this.storedFrames; age++)
+            {
+                var frame = this.GetFrame(age);
+                frameTotal += frame.TotalMilliseconds;
+
+                for (int i = 0; i < frame.Samples.Count; i++)
+                {
+                    var sample = frame.Samples[i];
+                    string key = sample.Lens + "." + sample.Pass;
+
+                    double total;
+                    if (!totals.TryGetValue(key, out total))
+                    {
+                        keys.Add(key);
+                        maximums[key] = 0;
+                    }
+
+                    totals[key] = total + sample.DurationMilliseconds;
+                    maximums[key] = Math.Max(maximums[key], sample.DurationMilliseconds);
+                }
+            }
+
+            var builder = new StringBuilder();
+            int frames = Math.Max(1, this.storedFrames);
+            builder.AppendFormat(CultureInfo.InvariantCulture, "Lenses: {0:0.000} ms avg ({1} frames)", frameTotal / frames, this.storedFrames);
+            builder.AppendLine();
+
+            for (int i = 0; i < keys.Count; i++)
+            {
+                string key = keys[i];
+                builder.AppendFormat(CultureInfo.InvariantCulture, "{0}: {1:0.000} ms avg, {2:0.000} ms max", key, totals[key] / frames, maximums[key]);
+                builder.AppendLine();
+            }
+
+            return builder.ToString();
+        }
+
+        /// <summary>
+        /// Writes the stored frames in the Chrome trace event format, which can be loaded in chrome://tracing.
+        /// </summary>
+        /// <param name="writer">The writer.</param>
+        public void ExportChromeTrace(TextWriter writer)
+        {
+            if (writer == null)
+            {
+                throw new ArgumentNullException("writer");
+            }
+
+            writer.Write("{\"traceEvents\":[");
+            bool first = true;
+
+            for (int age = this.storedFrames - 1; age >= 0; age--)
+            {
+                var frame = this.GetFrame(age);
+
+                for (int i = 0; i < frame.Samples.Count; i++)
+                {
+                    var sample = frame.Samples[i];
+                    if (!first)
+                    {
+                        writer.Write(',');
+                    }
+
+                    first = false;
+                    writer.Write(
+                        string.Format(
+                            CultureInfo.InvariantCulture,
+                            "{{\"name\":\"{0}\",\"cat\":\"{1}\",\"ph\":\"X\",\"ts\":{2:0.###},\"dur\":{3:0.###},\"pid\":1,\"tid\":1,\"args\":{{\"frame\":{4}}}}}",
+                            EscapeJson(sample.Pass),
+                            EscapeJson(sample.Lens),
+                            (frame.StartMilliseconds + sample.StartMilliseconds) * 1000,
+                            sample.DurationMilliseconds * 1000,
+                            frame.FrameNumber));
+                }
+            }
+
+            writer.Write("]}");
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Escapes a string to be written in a JSON string
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>The escaped value</returns>
+        private static string EscapeJson(string value)
+        {
+            var builder = new StringBuilder(value.Length);
+            for (int i = 0; i < value.Length; i++)
+            {
+                char c = value[i];
+                if (c == '"' || c == '\\')
+                {
+                    builder.Append('\\').Append(c);
+                }
+                else if (c < ' ')
+                {
+                    builder.AppendFormat(CultureInfo.InvariantCulture, "\\u{0:x4}", (int)c);
+                }
+                else
+                {
+                    builder.Append(c);
+                }
+            }
+
+            return builder.ToString();
+        }
+        #endregion
+    }
+}
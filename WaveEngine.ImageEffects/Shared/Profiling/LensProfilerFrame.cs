@@ -0,0 +1,91 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System.Collections.Generic;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// The samples of the lenses rendered in a frame.
+    /// </summary>
+    public class LensProfilerFrame
+    {
+        /// <summary>
+        /// The samples of the frame
+        /// </summary>
+        private List<LensProfilerSample> samples;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the number of the frame since the profiler was created.
+        /// </summary>
+        public long FrameNumber { get; internal set; }
+
+        /// <summary>
+        /// Gets the start of the frame, in milliseconds since the profiler was created.
+        /// </summary>
+        public double StartMilliseconds { get; internal set; }
+
+        /// <summary>
+        /// Gets the samples of the frame, in submission order.
+        /// </summary>
+        public IList<LensProfilerSample> Samples
+        {
+            get { return this.samples; }
+        }
+
+        /// <summary>
+        /// Gets the CPU time of all the passes of the frame, in milliseconds. Nested passes are included in the time of their outer pass.
+        /// </summary>
+        public double TotalMilliseconds
+        {
+            get
+            {
+                double total = 0;
+                for (int i = 0; i < this.samples.Count; i++)
+                {
+                    if (this.samples[i].Depth == 0)
+                    {
+                        total += this.samples[i].DurationMilliseconds;
+                    }
+                }
+
+                return total;
+            }
+        }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LensProfilerFrame"/> class.
+        /// </summary>
+        internal LensProfilerFrame()
+        {
+            this.samples = new List<LensProfilerSample>();
+        }
+        #endregion
+
+        #region Internal Methods
+
+        /// <summary>
+        /// Adds a sample
+        /// </summary>
+        /// <param name="sample">The sample.</param>
+        internal void Add(LensProfilerSample sample)
+        {
+            this.samples.Add(sample);
+        }
+
+        /// <summary>
+        /// Removes all the samples, so the frame can be reused
+        /// </summary>
+        internal void Clear()
+        {
+            this.samples.Clear();
+        }
+        #endregion
+    }
+}
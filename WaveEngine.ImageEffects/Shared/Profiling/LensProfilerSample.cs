@@ -0,0 +1,35 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// The time spent submitting a pass of a lens.
+    /// </summary>
+    public struct LensProfilerSample
+    {
+        /// <summary>
+        /// The name of the lens.
+        /// </summary>
+        public string Lens;
+
+        /// <summary>
+        /// The name of the pass.
+        /// </summary>
+        public string Pass;
+
+        /// <summary>
+        /// The start of the pass, in milliseconds since the start of the frame.
+        /// </summary>
+        public double StartMilliseconds;
+
+        /// <summary>
+        /// The CPU time of the pass, in milliseconds.
+        /// </summary>
+        public double DurationMilliseconds;
+
+        /// <summary>
+        /// The number of passes that were open when the pass started, 0 for a pass that is not nested.
+        /// </summary>
+        public int Depth;
+    }
+}
@@ -0,0 +1,243 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System;
+using System.Collections.Generic;
+using WaveEngine.Common.Graphics;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework.Graphics;
+using WaveEngine.Framework.Services;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// A chain of downsampled copies of a frame, shared by the lenses of a camera that need a low resolution version of their source.
+    /// </summary>
+    /// <remarks>
+    /// Each level halves the size of the previous one with the <see cref="DualFilterMaterial"/>.
+    /// Call <see cref="BeginFrame"/> once per frame, before the camera renders its lenses: the levels are built by the first request of the frame
+    /// and served to the next lenses of the frame, even if the chain has changed the image since then.
+    /// Until <see cref="BeginFrame"/> is called for the first time the levels are not shared, every request builds them again.
+    /// </remarks>
+    public class BlurPyramid : IDisposable
+    {
+        /// <summary>
+        /// The default number of levels
+        /// </summary>
+        private const int DefaultMaxLevels = 4;
+
+        /// <summary>
+        /// The material used to downsample
+        /// </summary>
+        private DualFilterMaterial material;
+
+        /// <summary>
+        /// The render targets of the levels, the first one is level 1
+        /// </summary>
+        private List<RenderTarget> levels;
+
+        /// <summary>
+        /// The number of levels built for the current source
+        /// </summary>
+        private int builtLevels;
+
+        /// <summary>
+        /// The source of the built levels
+        /// </summary>
+        private Texture source;
+
+        /// <summary>
+        /// Whether <see cref="BeginFrame"/> has been called
+        /// </summary>
+        private bool frameStarted;
+
+        /// <summary>
+        /// Whether the levels have been built since the last call to <see cref="BeginFrame"/>
+        /// </summary>
+        private bool builtThisFrame;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the maximum number of levels, default value is 4.
+        /// </summary>
+        public int MaxLevels { get; set; }
+
+        /// <summary>
+        /// Gets the number of times the pyramid has been built.
+        /// </summary>
+        public int BuildCount { get; private set; }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="BlurPyramid"/> class.
+        /// </summary>
+        public BlurPyramid()
+        {
+            this.levels = new List<RenderTarget>();
+            this.MaxLevels = DefaultMaxLevels;
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Gets the level that matches a downsample divisor.
+        /// </summary>
+        /// <param name="divisor">The divisor of the source size.</param>
+        /// <returns>The level, or -1 if the divisor is not a power of two</returns>
+        public static int GetLevelForDivisor(float divisor)
+        {
+            int level = 0;
+            for (float size = 1; size <= divisor; size *= 2)
+            {
+                if (size == divisor)
+                {
+                    return level;
+                }
+
+                level++;
+            }
+
+            return -1;
+        }
+
+        /// <summary>
+        /// Starts a new frame, the next request builds the levels again.
+        /// </summary>
+        public void BeginFrame()
+        {
+            this.frameStarted = true;
+            this.builtThisFrame = false;
+        }
+
+        /// <summary>
+        /// Gets a level of the pyramid of a source, building it if needed.
+        /// </summary>
+        /// <param name="lens">The lens that samples the level.</param>
+        /// <param name="source">The source of the lens. It is only used when the levels are built.</param>
+        /// <param name="level">The level, from 1 to <see cref="MaxLevels"/>. The size of the level is the size of the source divided by 2^level.</param>
+        /// <param name="renderToImage">Renders a material to a render target, provided by the lens.</param>
+        /// <returns>The render target of the level</returns>
+        public RenderTarget GetLevel(Lens lens, Texture source, int level, Action<RenderTarget, Material> renderToImage)
+        {
+            if (lens == null)
+            {
+                throw new ArgumentNullException("lens");
+            }
+
+            if (source == null)
+            {
+                throw new ArgumentNullException("source");
+            }
+
+            if (renderToImage == null)
+            {
+                throw new ArgumentNullException("renderToImage");
+            }
+
+            if (level < 1 || level > this.MaxLevels)
+            {
+                throw new ArgumentOutOfRangeException("level");
+            }
+
+            bool sameSize = this.source != null && this.source.Width == source.Width && this.source.Height == source.Height;
+            if (!this.frameStarted || !this.builtThisFrame || !sameSize)
+            {
+                this.source = source;
+                this.builtLevels = 0;
+                this.builtThisFrame = true;
+                this.BuildCount++;
+            }
+
+            if (this.builtLevels < level)
+            {
+                this.Build(lens, level, renderToImage);
+            }
+
+            return this.levels[level - 1];
+        }
+
+        /// <summary>
+        /// Forces the pyramid to be built again on the next request.
+        /// </summary>
+        public void Invalidate()
+        {
+            this.source = null;
+        }
+
+        /// <summary>
+        /// Destroys the render targets of the levels.
+        /// </summary>
+        public void Dispose()
+        {
+            for (int i = 0; i < this.levels.Count; i++)
+            {
+                WaveServices.GraphicsDevice.RenderTargets.DestroyRenderTarget(this.levels[i]);
+            }
+
+            this.levels.Clear();
+            this.builtLevels = 0;
+            this.source = null;
+            this.builtThisFrame = false;
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Builds the levels that have not been built yet for the current source
+        /// </summary>
+        /// <param name="lens">The lens that requested the level.</param>
+        /// <param name="level">The last level to build.</param>
+        /// <param name="renderToImage">Renders a material to a render target.</param>
+        private void Build(Lens lens, int level, Action<RenderTarget, Material> renderToImage)
+        {
+            if (this.material == null)
+            {
+                this.material = new DualFilterMaterial();
+                this.material.Initialize(WaveServices.Assets);
+            }
+
+            var graphicsDevice = WaveServices.GraphicsDevice;
+
+            for (int i = this.builtLevels + 1; i <= level; i++)
+            {
+                int width = Math.Max(1, this.source.Width >> i);
+                int height = Math.Max(1, this.source.Height >> i);
+
+                if (this.levels.Count < i)
+                {
+                    this.levels.Add(null);
+                }
+
+                var target = this.levels[i - 1];
+                if (target == null || target.Width != width || target.Height != height)
+                {
+                    if (target != null)
+                    {
+                        graphicsDevice.RenderTargets.DestroyRenderTarget(target);
+                    }
+
+                    target = graphicsDevice.RenderTargets.CreateRenderTarget(width, height);
+                    this.levels[i - 1] = target;
+                }
+
+                var levelSource = i == 1 ? this.source : this.levels[i - 2];
+                graphicsDevice.Viewport = new Viewport(0, 0, width, height);
+                this.material.Texture = levelSource;
+                this.material.TexcoordOffset = new Vector2(1f / levelSource.Width, 1f / levelSource.Height);
+                LensProfiler.BeginPass(lens, "Pyramid");
+                renderToImage(target, this.material);
+                LensProfiler.EndPass();
+            }
+
+            this.material.Texture = null;
+            this.builtLevels = level;
+        }
+        #endregion
+    }
+}
@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -15,13 +16,18 @@ namespace WaveEngine.ImageEffects
     /// Represent a Screen Space Ambient Occlusion filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class SSAOLens : Lens
+    public class SSAOLens : Lens, ITransientTargetLens
     {
         /// <summary>
         /// The blur downsample factor
         /// </summary>
         private float downSampleFactor;
 
+        /// <summary>
+        /// The resolution scale
+        /// </summary>
+        private float resolutionScale;
+
         #region Properties
 
         /// <summary>
@@ -50,6 +56,30 @@ namespace WaveEngine.ImageEffects
             }
         }
 
+        /// <summary>
+        /// Gets or sets the fraction of the source resolution where the AO is rendered, on top of <see cref="DownSampleFactor"/>.
+        /// The AO is upsampled to the source resolution by the combine pass. Default value is 1.
+        /// </summary>
+        [DataMember]
+        [RenderPropertyAsSlider(0.25f, 1, 0.25f)]
+        public float ResolutionScale
+        {
+            get
+            {
+                return this.resolutionScale;
+            }
+
+            set
+            {
+                if (value <= 0 || value > 1)
+                {
+                    throw new ArgumentOutOfRangeException("value");
+                }
+
+                this.resolutionScale = value;
+            }
+        }
+
         /// <summary>
         /// Gets or sets the AO intensity. Default value is 2.
         /// </summary>
@@ -107,6 +137,46 @@ namespace WaveEngine.ImageEffects
                 (this.material as SSAOMaterial).FilterRadius = value;
             }
         }
+
+        /// <summary>
+        /// Gets or sets a value indicating whether the AO, rendered at the size of the source divided by <see cref="DownSampleFactor"/>
+        /// and scaled by <see cref="ResolutionScale"/>, is upsampled weighting its texels by their depth, so it does not bleed across the edges of the objects. Default value is true.
+        /// </summary>
+        [DataMember]
+        public bool BilateralUpsample { get; set; }
+
+        /// <summary>
+        /// Gets or sets the depth difference where the weight of an AO texel falls to 60% in the bilateral upsample, default value is 0.001f.
+        /// </summary>
+        [DataMember]
+        public float DepthSigma
+        {
+            get
+            {
+                return (this.material as SSAOMaterial).DepthSigma;
+            }
+
+            set
+            {
+                (this.material as SSAOMaterial).DepthSigma = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
+
+        /// <summary>
+        /// Gets the divisor of the source size that gives the size of the AO target
+        /// </summary>
+        private float Divisor
+        {
+            get
+            {
+                return this.downSampleFactor / this.resolutionScale;
+            }
+        }
         #endregion
 
         #region Initialize
@@ -128,11 +198,23 @@ namespace WaveEngine.ImageEffects
 
             this.material = new SSAOMaterial();
             this.downSampleFactor = 2;
+            this.resolutionScale = 1;
+            this.BilateralUpsample = true;
         }
         #endregion
 
         #region Public Methods
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            // The upcombine passes only read the red channel of the occlusion
+            requests.Add(new TransientTargetRequest(this.Divisor, 0, 1, PixelFormat.R8));
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -140,39 +222,47 @@ namespace WaveEngine.ImageEffects
         public override void Render(TimeSpan gameTime)
         {
             var mat = this.material as SSAOMaterial;
-            int width = (int)(this.Source.Width / this.downSampleFactor);
-            int height = (int)(this.Source.Height / this.downSampleFactor);
+            float divisor = this.Divisor;
+            int width = (int)(this.Source.Width / divisor);
+            int height = (int)(this.Source.Height / divisor);
 
-            RenderTarget rt1 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            graphicsDevice.Viewport = new Viewport(0, 0, width, height);
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 0, width, height);
+            TransientTargetPool.SetViewport(rt1);
 
             // AO
             mat.Pass = SSAOMaterial.Passes.SSAO;
             mat.Texture = null;
             mat.AOTexture = null;
+            LensProfiler.BeginPass(this, "AO");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
 
             // UpCombine
-            graphicsDevice.Viewport = new Viewport(0, 0, this.Source.Width, this.Source.Height);
+            TransientTargetPool.RestoreViewport(this);
+            bool bilateral = this.BilateralUpsample && divisor > 1;
             if (this.OnlyAO)
             {
-                mat.Pass = SSAOMaterial.Passes.OnlyAO;
+                mat.Pass = bilateral ? SSAOMaterial.Passes.OnlyAOBilateral : SSAOMaterial.Passes.OnlyAO;
                 mat.Texture = this.Source;
                 mat.AOTexture = rt1;
             }
             else
             {
-                mat.Pass = SSAOMaterial.Passes.Combine;
+                mat.Pass = bilateral ? SSAOMaterial.Passes.CombineBilateral : SSAOMaterial.Passes.Combine;
                 mat.Texture = this.Source;
                 mat.AOTexture = rt1;
             }
 
+            mat.AOTextureSize = new Vector2(width, height);
+
+            LensProfiler.BeginPass(this, "UpCombine");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
             mat.AOTexture = null;
 
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt1);
+            TransientTargetPool.Release(this, rt1);
         }
         #endregion
 
@@ -35,7 +35,17 @@ namespace WaveEngine.ImageEffects
             /// <summary>
             /// The only AO
             /// </summary>
-            OnlyAO
+            OnlyAO,
+
+            /// <summary>
+            /// Combine with a bilateral upsample of the AO
+            /// </summary>
+            CombineBilateral,
+
+            /// <summary>
+            /// The only AO with a bilateral upsample
+            /// </summary>
+            OnlyAOBilateral,
         }
 
         /// <summary>
@@ -71,6 +81,8 @@ namespace WaveEngine.ImageEffects
             new ShaderTechnique("SSAO", string.Empty, "vsSSAO", string.Empty, "psSSAO", VertexPositionTexture.VertexFormat),
             new ShaderTechnique("Combine", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psSSAOCombine", VertexPositionTexture.VertexFormat),
             new ShaderTechnique("OnlyAO", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psOnlyAO", VertexPositionTexture.VertexFormat),
+            new ShaderTechnique("CombineBilateral", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psSSAOCombineBilateral", VertexPositionTexture.VertexFormat),
+            new ShaderTechnique("OnlyAOBilateral", "ImageEffectMaterial", "ImageEffectvsImageEffect", string.Empty, "psOnlyAOBilateral", VertexPositionTexture.VertexFormat),
         };
 
         #region Struct
@@ -78,7 +90,7 @@ namespace WaveEngine.ImageEffects
         /// <summary>
         /// Shader parameters.
         /// </summary>
-        [StructLayout(LayoutKind.Explicit, Size = 80)]
+        [StructLayout(LayoutKind.Explicit, Size = 96)]
         private struct SSAOEffectParameters
         {
             [FieldOffset(0)]
@@ -92,6 +104,12 @@ namespace WaveEngine.ImageEffects
 
             [FieldOffset(16)]
             public Matrix ViewProjectionInverse;
+
+            [FieldOffset(80)]
+            public Vector2 AOTextureSize;
+
+            [FieldOffset(88)]
+            public float DepthSigma;
         }
         #endregion
 
@@ -102,6 +120,16 @@ namespace WaveEngine.ImageEffects
 
         #region Properties
 
+        /// <summary>
+        /// Gets or sets the size in texels of the AO texture, used by the bilateral passes.
+        /// </summary>
+        public Vector2 AOTextureSize { get; set; }
+
+        /// <summary>
+        /// Gets or sets the depth difference where the weight of an AO texel falls to 60% in the bilateral passes.
+        /// </summary>
+        public float DepthSigma { get; set; }
+
         /// <summary>
         /// Gets or sets the ao intensity.
         /// </summary>
@@ -227,6 +255,7 @@ namespace WaveEngine.ImageEffects
             this.DistanceThreshold = 1.5f;
             this.AOIntensity = 2;
             this.FilterRadius = new Vector2(0.015f);
+            this.DepthSigma = 0.001f;
 
             this.shaderParameters = new SSAOEffectParameters();
             this.shaderParameters.DistanceThreshold = this.DistanceThreshold;
@@ -268,6 +297,8 @@ namespace WaveEngine.ImageEffects
                 this.shaderParameters.DistanceThreshold = this.DistanceThreshold;
                 this.shaderParameters.FilterRadius = this.FilterRadius;
                 this.shaderParameters.AOintensity = this.AOIntensity;
+                this.shaderParameters.AOTextureSize = this.AOTextureSize;
+                this.shaderParameters.DepthSigma = this.DepthSigma;
 
                 this.Parameters = this.shaderParameters;
 
@@ -150,7 +150,9 @@ namespace WaveEngine.ImageEffects
         {
             var mat = this.material as SepiaMaterial;
             mat.Texture = this.Source;
+            LensProfiler.BeginPass(this, "Render");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
         }
@@ -0,0 +1,89 @@
+﻿//-----------------------------------------------------------------------------
+// DepthOfField.fx
+//
+// Copyright © 2018 Wave Engine S.L. All rights reserved.
+// Use is subject to license terms.
+//-----------------------------------------------------------------------------
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+// Paramenters
+uniform float FocusDistance;
+uniform float FocusRange;
+uniform float NearPlane;
+uniform float FarParam;
+uniform vec2 BlurTextureSize;
+uniform float DepthSigma;
+
+uniform sampler2D Texture;
+uniform sampler2D Texture1;
+uniform sampler2D DepthTexture;
+
+// Input
+varying vec2 outTexCoord;
+
+vec3 blur;
+float total;
+vec3 closestBlur;
+float closestDifference;
+
+// Adds a low resolution blur texel to the bilateral up sampler. The depth is sampled at the
+// center of the texel.
+void BilateralTap(vec2 texel, float bilinearWeight, float pixelDepth)
+{
+	vec2 tapCoord = (texel + 0.5) / BlurTextureSize;
+	vec3 tapBlur = texture2D(Texture1, tapCoord).rgb;
+	float difference = abs(texture2D(DepthTexture, tapCoord).x - pixelDepth);
+	float weight = bilinearWeight * exp(-(difference * difference) / (2.0 * DepthSigma * DepthSigma));
+
+	if (difference < closestDifference)
+	{
+		closestDifference = difference;
+		closestBlur = tapBlur;
+	}
+
+	blur += tapBlur * weight;
+	total += weight;
+}
+
+// Bilateral up sampler: the four blur texels around the pixel are weighted by their bilinear weight and
+// by the similarity of their depth, so the blurred background does not bleed over the objects in focus.
+vec3 BilateralBlur(vec2 texCoord, float pixelDepth)
+{
+	vec2 position = texCoord * BlurTextureSize - 0.5;
+	vec2 texel = floor(position);
+	vec2 f = position - texel;
+
+	blur = vec3(0.0);
+	total = 0.0;
+	closestBlur = vec3(0.0);
+	closestDifference = 1e10;
+
+	BilateralTap(texel, (1.0 - f.x) * (1.0 - f.y), pixelDepth);
+	BilateralTap(texel + vec2(1.0, 0.0), f.x * (1.0 - f.y), pixelDepth);
+	BilateralTap(texel + vec2(0.0, 1.0), (1.0 - f.x) * f.y, pixelDepth);
+	BilateralTap(texel + vec2(1.0, 1.0), f.x * f.y, pixelDepth);
+
+	// When no texel belongs to the surface of the pixel, the nearest in depth is used
+	return total < 1e-6 ? closestBlur : blur / total;
+}
+
+void main()
+{
+	float depth = texture2D(DepthTexture, outTexCoord).x;
+	vec3 scene = texture2D(Texture, outTexCoord).rgb;
+	vec3 upsampledBlur = BilateralBlur(outTexCoord, depth);
+
+	// Back-transform depth into camera space
+	float sceneZ = (-NearPlane * FarParam) / (depth - FarParam);
+
+	// Compute blur factor
+	float blurFactor = clamp(abs(sceneZ - FocusDistance) / FocusRange, 0.0, 1.0);
+
+	// Compute resultant pixel
+	vec3 color = mix(scene, upsampledBlur, blurFactor);
+
+	gl_FragColor = vec4(color.rgb, 1.0);
+}
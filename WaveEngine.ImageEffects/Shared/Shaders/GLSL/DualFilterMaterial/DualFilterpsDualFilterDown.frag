@@ -0,0 +1,28 @@
+﻿//-----------------------------------------------------------------------------
+// DualFilter.fx
+//
+// Copyright © 2018 Wave Corporation
+// Use is subject to license terms.
+//-----------------------------------------------------------------------------
+
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+// Parameters
+uniform vec2 TexcoordOffset;
+uniform sampler2D Texture;
+
+// Input
+varying vec2 outTexCoord;
+
+void main()
+{
+	vec4 color = texture2D(Texture, outTexCoord) * 4.0;
+	color += texture2D(Texture, outTexCoord - TexcoordOffset);
+	color += texture2D(Texture, outTexCoord + TexcoordOffset);
+	color += texture2D(Texture, outTexCoord + vec2(TexcoordOffset.x, -TexcoordOffset.y));
+	color += texture2D(Texture, outTexCoord - vec2(TexcoordOffset.x, -TexcoordOffset.y));
+
+	gl_FragColor = color * 0.125;
+}
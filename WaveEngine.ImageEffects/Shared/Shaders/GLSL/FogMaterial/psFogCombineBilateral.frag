@@ -0,0 +1,80 @@
+﻿//-----------------------------------------------------------------------------
+// Fog.fx
+//
+// Copyright © 2018 Wave Engine S.L. All rights reserved.
+// Use is subject to license terms.
+//-----------------------------------------------------------------------------
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+// Parameters
+uniform vec3 FogColor;
+uniform vec2 FogTextureSize;
+uniform float DepthSigma;
+
+uniform sampler2D Texture;
+uniform sampler2D DepthTexture;
+uniform sampler2D FogAmountTexture;
+
+// Input
+varying vec2 outTexCoord;
+
+float fogAmount;
+float total;
+float closestFogAmount;
+float closestDifference;
+
+// Adds a low resolution fog amount texel to the bilateral up sampler. The depth is sampled at the
+// center of the texel, where the fog amount pass sampled it.
+void BilateralTap(vec2 texel, float bilinearWeight, float pixelDepth)
+{
+	vec2 tapCoord = (texel + 0.5) / FogTextureSize;
+	float tapFogAmount = texture2D(FogAmountTexture, tapCoord).x;
+	float difference = abs(texture2D(DepthTexture, tapCoord).x - pixelDepth);
+	float weight = bilinearWeight * exp(-(difference * difference) / (2.0 * DepthSigma * DepthSigma));
+
+	if (difference < closestDifference)
+	{
+		closestDifference = difference;
+		closestFogAmount = tapFogAmount;
+	}
+
+	fogAmount += tapFogAmount * weight;
+	total += weight;
+}
+
+// Bilateral up sampler: the four fog amount texels around the pixel are weighted by their bilinear weight and
+// by the similarity of their depth, so the fog does not bleed across depth edges.
+float BilateralFogAmount(vec2 texCoord)
+{
+	vec2 position = texCoord * FogTextureSize - 0.5;
+	vec2 texel = floor(position);
+	vec2 f = position - texel;
+	float pixelDepth = texture2D(DepthTexture, texCoord).x;
+
+	fogAmount = 0.0;
+	total = 0.0;
+	closestFogAmount = 1.0;
+	closestDifference = 1e10;
+
+	BilateralTap(texel, (1.0 - f.x) * (1.0 - f.y), pixelDepth);
+	BilateralTap(texel + vec2(1.0, 0.0), f.x * (1.0 - f.y), pixelDepth);
+	BilateralTap(texel + vec2(0.0, 1.0), (1.0 - f.x) * f.y, pixelDepth);
+	BilateralTap(texel + vec2(1.0, 1.0), f.x * f.y, pixelDepth);
+
+	// When no texel belongs to the surface of the pixel, the nearest in depth is used
+	return total < 1e-6 ? closestFogAmount : fogAmount / total;
+}
+
+void main()
+{
+	vec3 scene = texture2D(Texture, outTexCoord).rgb;
+	float amount = BilateralFogAmount(outTexCoord);
+
+	// Compute resultant pixel
+	vec3 color = mix(FogColor, scene, amount);
+
+	gl_FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,101 @@
+﻿//-----------------------------------------------------------------------------
+// FusedPointwise.fx
+//
+// Copyright © 2018 Wave Engine S.L. All rights reserved.
+// Use is subject to license terms.
+//-----------------------------------------------------------------------------
+
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+// Parameters
+uniform vec4 Stage0Red;
+uniform vec4 Stage0Green;
+uniform vec4 Stage0Blue;
+uniform vec4 Stage0Alpha;
+uniform vec4 Stage0Screen;
+uniform vec4 Stage0Posterize;
+uniform vec4 Stage1Red;
+uniform vec4 Stage1Green;
+uniform vec4 Stage1Blue;
+uniform vec4 Stage1Alpha;
+uniform vec4 Stage1Screen;
+uniform vec4 Stage1Posterize;
+uniform vec4 Stage2Red;
+uniform vec4 Stage2Green;
+uniform vec4 Stage2Blue;
+uniform vec4 Stage2Alpha;
+uniform vec4 Stage2Screen;
+uniform vec4 Stage2Posterize;
+uniform vec4 Stage3Red;
+uniform vec4 Stage3Green;
+uniform vec4 Stage3Blue;
+uniform vec4 Stage3Alpha;
+uniform vec4 Stage3Screen;
+uniform vec4 Stage3Posterize;
+uniform vec4 Lookup;
+uniform sampler2D Texture;
+uniform sampler2D LUTTexture;
+
+// Input
+varying vec2 outTexCoord;
+
+// The color table is a strip of LUTSize slices of LUTSize x LUTSize texels, one slice per blue entry
+const float LUTSize = 16.0;
+
+vec4 ApplyStage(vec4 color, vec4 red, vec4 green, vec4 blue, vec4 alpha, vec4 screen, vec4 posterize, float vignette, float v)
+{
+	vec4 result;
+	vec4 rgb1 = vec4(color.rgb, 1.0);
+	result.r = dot(rgb1, red);
+	result.g = dot(rgb1, green);
+	result.b = dot(rgb1, blue);
+	result.a = color.a * alpha.x + alpha.y;
+
+	result *= 1.0 - vignette * screen.x;
+	result.rgb -= sin(v * screen.y) * screen.z;
+
+	vec3 levels = pow(max(result.rgb, 0.0), vec3(posterize.y));
+	levels = floor(levels * posterize.z) / posterize.z;
+	levels = pow(levels, vec3(1.0 / posterize.y));
+	result.rgb = mix(result.rgb, levels, posterize.x);
+
+	// Each stage is stored like the render target of its own pass
+	return clamp(result, 0.0, 1.0);
+}
+
+vec3 SampleLUT(vec3 color)
+{
+	vec3 entry = clamp(color, 0.0, 1.0) * (LUTSize - 1.0);
+	float slice = min(floor(entry.b), LUTSize - 2.0);
+	float u = (slice * LUTSize + entry.r + 0.5) / (LUTSize * LUTSize);
+	float v = (entry.g + 0.5) / LUTSize;
+
+	vec3 lower = texture2D(LUTTexture, vec2(u, v)).rgb;
+	vec3 upper = texture2D(LUTTexture, vec2(u + 1.0 / LUTSize, v)).rgb;
+	return mix(lower, upper, entry.b - slice);
+}
+
+void main()
+{
+	vec4 color = texture2D(Texture, outTexCoord);
+
+	vec2 center = outTexCoord - 0.5;
+	float vignette = dot(center, center);
+	float v = outTexCoord.y;
+
+	color = ApplyStage(color, Stage0Red, Stage0Green, Stage0Blue, Stage0Alpha, Stage0Screen, Stage0Posterize, vignette, v);
+	color = ApplyStage(color, Stage1Red, Stage1Green, Stage1Blue, Stage1Alpha, Stage1Screen, Stage1Posterize, vignette, v);
+	color = ApplyStage(color, Stage2Red, Stage2Green, Stage2Blue, Stage2Alpha, Stage2Screen, Stage2Posterize, vignette, v);
+	color = ApplyStage(color, Stage3Red, Stage3Green, Stage3Blue, Stage3Alpha, Stage3Screen, Stage3Posterize, vignette, v);
+
+	// Color correction: x = weight, y = linear color space
+	vec3 lookup = mix(color.rgb, sqrt(color.rgb), Lookup.y);
+	lookup = SampleLUT(lookup);
+	lookup = mix(lookup, lookup * lookup, Lookup.y);
+	color.rgb = mix(color.rgb, lookup, Lookup.x);
+	color.a = mix(color.a, 1.0, Lookup.x);
+
+	gl_FragColor = color;
+}
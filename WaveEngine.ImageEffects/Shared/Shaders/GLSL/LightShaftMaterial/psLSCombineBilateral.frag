@@ -0,0 +1,84 @@
+﻿//-----------------------------------------------------------------------------
+// LightShaft.fx
+//
+// Copyright © 2018 Wave Engine S.L. All rights reserved.
+// Use is subject to license terms.
+//-----------------------------------------------------------------------------
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+// Parameters
+uniform float Blend;
+uniform vec3 ShaftTint;
+uniform vec2 ShaftTextureSize;
+uniform float DepthSigma;
+
+uniform sampler2D Texture;
+uniform sampler2D Texture1;
+uniform sampler2D DepthTexture;
+
+
+// Input
+varying vec2 outTexCoord;
+
+vec4 lightShaft;
+float total;
+vec4 closestLightShaft;
+float closestDifference;
+
+// Adds a low resolution light shaft texel to the bilateral up sampler. The depth is sampled at the
+// center of the texel.
+void BilateralTap(vec2 texel, float bilinearWeight, float pixelDepth)
+{
+	vec2 tapCoord = (texel + 0.5) / ShaftTextureSize;
+	vec4 tapLightShaft = texture2D(Texture1, tapCoord);
+	float difference = abs(texture2D(DepthTexture, tapCoord).x - pixelDepth);
+	float weight = bilinearWeight * exp(-(difference * difference) / (2.0 * DepthSigma * DepthSigma));
+
+	if (difference < closestDifference)
+	{
+		closestDifference = difference;
+		closestLightShaft = tapLightShaft;
+	}
+
+	lightShaft += tapLightShaft * weight;
+	total += weight;
+}
+
+// Bilateral up sampler: the four light shaft texels around the pixel are weighted by their bilinear weight
+// and by the similarity of their depth, so the shafts do not bleed over the occluders.
+vec4 BilateralLightShaft(vec2 texCoord)
+{
+	vec2 position = texCoord * ShaftTextureSize - 0.5;
+	vec2 texel = floor(position);
+	vec2 f = position - texel;
+	float pixelDepth = texture2D(DepthTexture, texCoord).x;
+
+	lightShaft = vec4(0.0);
+	total = 0.0;
+	closestLightShaft = vec4(0.0);
+	closestDifference = 1e10;
+
+	BilateralTap(texel, (1.0 - f.x) * (1.0 - f.y), pixelDepth);
+	BilateralTap(texel + vec2(1.0, 0.0), f.x * (1.0 - f.y), pixelDepth);
+	BilateralTap(texel + vec2(0.0, 1.0), (1.0 - f.x) * f.y, pixelDepth);
+	BilateralTap(texel + vec2(1.0, 1.0), f.x * f.y, pixelDepth);
+
+	// When no texel belongs to the surface of the pixel, the nearest in depth is used
+	return total < 1e-6 ? closestLightShaft : lightShaft / total;
+}
+
+void main()
+{
+	vec3 color = texture2D(Texture, outTexCoord).rgb;
+	vec4 shaft = BilateralLightShaft(outTexCoord);
+
+	shaft.rgb *= ShaftTint;
+
+	float faceShaft = shaft.a * Blend;
+	shaft.rgb *= faceShaft;
+
+	gl_FragColor = vec4(color.rgb + shaft.rgb, 1.0);
+}
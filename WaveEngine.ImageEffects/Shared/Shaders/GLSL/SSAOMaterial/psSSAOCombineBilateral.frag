@@ -0,0 +1,83 @@
+﻿//-----------------------------------------------------------------------------
+// SSAO.fx
+//
+// Copyright © 2018 Wave Engine S.L. All rights reserved.
+// Use is subject to license terms.
+//-----------------------------------------------------------------------------
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+// Parameters
+uniform float AOintensity;
+uniform vec2 AOTextureSize;
+uniform float DepthSigma;
+
+uniform sampler2D Texture;
+uniform sampler2D AOTexture;
+uniform sampler2D GBufferTexture;
+uniform sampler2D DepthTexture;
+
+
+// Input
+varying vec2 outTexCoord;
+
+float ao;
+float total;
+float closestAO;
+float closestDifference;
+
+// Adds a low resolution AO texel to the bilateral up sampler. The depth is sampled at the
+// center of the texel, where the AO pass sampled it.
+void BilateralTap(vec2 texel, float bilinearWeight, float pixelDepth)
+{
+	vec2 tapCoord = (texel + 0.5) / AOTextureSize;
+	float tapAO = texture2D(AOTexture, tapCoord).x;
+	float difference = abs(texture2D(DepthTexture, tapCoord).x - pixelDepth);
+	float weight = bilinearWeight * exp(-(difference * difference) / (2.0 * DepthSigma * DepthSigma));
+
+	if (difference < closestDifference)
+	{
+		closestDifference = difference;
+		closestAO = tapAO;
+	}
+
+	ao += tapAO * weight;
+	total += weight;
+}
+
+// Bilateral up sampler: the four AO texels around the pixel are weighted by their bilinear weight and
+// by the similarity of their depth, so the AO does not bleed across depth edges.
+float BilateralAO(vec2 texCoord)
+{
+	vec2 position = texCoord * AOTextureSize - 0.5;
+	vec2 texel = floor(position);
+	vec2 f = position - texel;
+	float pixelDepth = texture2D(DepthTexture, texCoord).x;
+
+	ao = 0.0;
+	total = 0.0;
+	closestAO = 1.0;
+	closestDifference = 1e10;
+
+	BilateralTap(texel, (1.0 - f.x) * (1.0 - f.y), pixelDepth);
+	BilateralTap(texel + vec2(1.0, 0.0), f.x * (1.0 - f.y), pixelDepth);
+	BilateralTap(texel + vec2(0.0, 1.0), (1.0 - f.x) * f.y, pixelDepth);
+	BilateralTap(texel + vec2(1.0, 1.0), f.x * f.y, pixelDepth);
+
+	// When no texel belongs to the surface of the pixel, the nearest in depth is used
+	return total < 1e-6 ? closestAO : ao / total;
+}
+
+void main()
+{
+	vec4 color = texture2D(Texture, outTexCoord);
+
+	float ao = BilateralAO(outTexCoord);
+	ao = pow(ao, AOintensity);
+
+	color.xyz *= ao;
+
+	gl_FragColor = color;
+}
@@ -11,6 +11,7 @@ call :CompileShader DepthOfField vs vsBlur
 call :CompileShader DepthOfField ps psDown
 call :CompileShader DepthOfField ps psBlur
 call :CompileShader DepthOfField ps psCombine
+call :CompileShader DepthOfField ps psCombineBilateral
 
 echo.
 
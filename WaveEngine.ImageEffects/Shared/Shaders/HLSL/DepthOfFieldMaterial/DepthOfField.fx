@@ -18,6 +18,8 @@ cbuffer Parameters : register(b1)
 	float NearPlane				: packoffset(c1.x);
 	float FarParam				: packoffset(c1.y);
 	float BlurScale				: packoffset(c1.z);
+	float2 BlurTextureSize		: packoffset(c2.x);
+	float DepthSigma			: packoffset(c2.z);
 };
 
 Texture2D DiffuseTexture : register(t0);
@@ -166,3 +168,63 @@ float4 psCombine(PS_IN_TEXTURE input) : SV_Target0
 	//return float4(color.rgb, 1.0);
 	return float4(color, 1.0);
 }
+
+// Adds a low resolution blur texel to the bilateral up sampler. The depth is sampled at the
+// center of the texel.
+void BilateralTap(float2 texel, float bilinearWeight, float pixelDepth, inout float3 blur, inout float total, inout float3 closestBlur, inout float closestDifference)
+{
+	float2 tapCoord = (texel + 0.5) / BlurTextureSize;
+	float3 tapBlur = DiffuseTexture1.Sample(DiffuseTextureSampler1, tapCoord).rgb;
+	float difference = abs(DepthTexture.Sample(DepthTextureSampler, tapCoord).x - pixelDepth);
+	float weight = bilinearWeight * exp(-(difference * difference) / (2.0 * DepthSigma * DepthSigma));
+
+	if (difference < closestDifference)
+	{
+		closestDifference = difference;
+		closestBlur = tapBlur;
+	}
+
+	blur += tapBlur * weight;
+	total += weight;
+}
+
+// Bilateral up sampler: the four blur texels around the pixel are weighted by their bilinear weight and
+// by the similarity of their depth, so the blurred background does not bleed over the objects in focus.
+float3 BilateralBlur(float2 texCoord, float pixelDepth)
+{
+	float2 position = texCoord * BlurTextureSize - 0.5;
+	float2 texel = floor(position);
+	float2 f = position - texel;
+
+	float3 blur = 0;
+	float total = 0;
+	float3 closestBlur = 0;
+	float closestDifference = 1e10;
+
+	BilateralTap(texel, (1 - f.x) * (1 - f.y), pixelDepth, blur, total, closestBlur, closestDifference);
+	BilateralTap(texel + float2(1, 0), f.x * (1 - f.y), pixelDepth, blur, total, closestBlur, closestDifference);
+	BilateralTap(texel + float2(0, 1), (1 - f.x) * f.y, pixelDepth, blur, total, closestBlur, closestDifference);
+	BilateralTap(texel + float2(1, 1), f.x * f.y, pixelDepth, blur, total, closestBlur, closestDifference);
+
+	// When no texel belongs to the surface of the pixel, the nearest in depth is used
+	return total < 1e-6 ? closestBlur : blur / total;
+}
+
+// Bilateral up sampler and combine
+float4 psCombineBilateral(PS_IN_TEXTURE input) : SV_Target0
+{
+	float depth = DepthTexture.Sample(DepthTextureSampler, input.TexCoord).x;
+	float3 scene = DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord).rgb;
+	float3 blur = BilateralBlur(input.TexCoord, depth);
+
+	// Back-transform depth into camera space
+	float sceneZ = (-NearPlane * FarParam) / (depth - FarParam);
+
+	// Compute blur factor
+	float blurFactor = saturate(abs(sceneZ - FocusDistance) / FocusRange);
+
+	// Compute resultant pixel
+	float3 color = lerp(scene, blur, blurFactor);
+
+	return float4(color, 1.0);
+}
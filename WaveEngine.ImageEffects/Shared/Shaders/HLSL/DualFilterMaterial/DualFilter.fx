@@ -0,0 +1,29 @@
+//-----------------------------------------------------------------------------
+// DualFilter.fx
+//
+// Copyright  2018 Wave Engine S.L. All rights reserved.
+// Use is subject to license terms.
+//-----------------------------------------------------------------------------
+
+#include "../Structures.fxh"
+
+cbuffer Parameters : register(b1)
+{
+	float2 TexcoordOffset		: packoffset(c0.x);
+};
+
+Texture2D DiffuseTexture : register(t0);
+SamplerState DiffuseTextureSampler : register(s0);
+
+// Dual filter down sampler. TexcoordOffset is the size of a source texel, so each
+// diagonal tap falls on a texel corner and the bilinear filter averages 2x2 texels.
+float4 psDualFilterDown(VS_OUT_TEXTURE input) : SV_Target0
+{
+	float4 color = DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord) * 4.0;
+	color += DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord - TexcoordOffset);
+	color += DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord + TexcoordOffset);
+	color += DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord + float2(TexcoordOffset.x, -TexcoordOffset.y));
+	color += DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord - float2(TexcoordOffset.x, -TexcoordOffset.y));
+
+	return color * 0.125;
+}
@@ -9,6 +9,10 @@ set fxcpath="C:\Program Files (x86)\Windows Kits\8.1\bin\x86\fxc.exe"
 call :CompileShader Fog ps psFog
 call :CompileShader Fog ps psFogExp
 call :CompileShader Fog ps psFogExp2
+call :CompileShader Fog ps psFogAmount
+call :CompileShader Fog ps psFogExpAmount
+call :CompileShader Fog ps psFogExp2Amount
+call :CompileShader Fog ps psFogCombineBilateral
 
 echo.
 
@@ -13,6 +13,8 @@ cbuffer Parameters : register(b1)
 	float ZParamB				: packoffset(c1.y);
 	float FogStart				: packoffset(c1.z);
 	float FogEnd				: packoffset(c1.w);
+	float2 FogTextureSize		: packoffset(c2.x);
+	float DepthSigma			: packoffset(c2.z);
 };
 
 Texture2D DiffuseTexture : register(t0);
@@ -29,6 +31,9 @@ sampler_state
 	MagFilter = POINT;
 };
 
+Texture2D FogAmountTexture : register(t2);
+SamplerState FogAmountTextureSampler : register(s2);
+
 struct PS_IN_TEXTURE
 {
 	float4 Position 	: SV_POSITION;
@@ -91,3 +96,96 @@ float4 psFogExp2(PS_IN_TEXTURE input) : SV_Target0
 
 	return float4(color, 1.0);
 }
+
+float4 psFogAmount(PS_IN_TEXTURE input) : SV_Target0
+{
+	float depth = DepthTexture.Sample(DepthTextureSampler, input.TexCoord).x;
+
+	// LinearDepth, range 0 - 1
+	float distance = LinearDepth(depth);
+
+	// Calculate linear fog amount
+	float fogAmount = (FogEnd - distance) / (FogEnd - FogStart);
+	fogAmount = saturate(fogAmount);
+
+	return fogAmount.xxxx;
+}
+
+float4 psFogExpAmount(PS_IN_TEXTURE input) : SV_Target0
+{
+	float depth = DepthTexture.Sample(DepthTextureSampler, input.TexCoord).x;
+
+	// LinearDepth, range 0 - 1
+	float distance = LinearDepth(depth);
+
+	// Calculate exponential fog amount
+	float fogAmount = exp2(-distance * FogDensity);
+
+	return fogAmount.xxxx;
+}
+
+float4 psFogExp2Amount(PS_IN_TEXTURE input) : SV_Target0
+{
+	float depth = DepthTexture.Sample(DepthTextureSampler, input.TexCoord).x;
+
+	// LinearDepth, range 0 - 1
+	float distance = LinearDepth(depth);
+
+	// Calculate exponential fog amount
+	float fogAmount = exp2(- pow(distance * FogDensity, 2));
+
+	return fogAmount.xxxx;
+}
+
+// Adds a low resolution fog amount texel to the bilateral up sampler. The depth is sampled at the
+// center of the texel, where the fog amount pass sampled it.
+void BilateralTap(float2 texel, float bilinearWeight, float pixelDepth, inout float fogAmount, inout float total, inout float closestFogAmount, inout float closestDifference)
+{
+	float2 tapCoord = (texel + 0.5) / FogTextureSize;
+	float tapFogAmount = FogAmountTexture.Sample(FogAmountTextureSampler, tapCoord).x;
+	float difference = abs(DepthTexture.Sample(DepthTextureSampler, tapCoord).x - pixelDepth);
+	float weight = bilinearWeight * exp(-(difference * difference) / (2.0 * DepthSigma * DepthSigma));
+
+	if (difference < closestDifference)
+	{
+		closestDifference = difference;
+		closestFogAmount = tapFogAmount;
+	}
+
+	fogAmount += tapFogAmount * weight;
+	total += weight;
+}
+
+// Bilateral up sampler: the four fog amount texels around the pixel are weighted by their bilinear weight and
+// by the similarity of their depth, so the fog does not bleed across depth edges.
+float BilateralFogAmount(float2 texCoord)
+{
+	float2 position = texCoord * FogTextureSize - 0.5;
+	float2 texel = floor(position);
+	float2 f = position - texel;
+	float pixelDepth = DepthTexture.Sample(DepthTextureSampler, texCoord).x;
+
+	float fogAmount = 0;
+	float total = 0;
+	float closestFogAmount = 1;
+	float closestDifference = 1e10;
+
+	BilateralTap(texel, (1 - f.x) * (1 - f.y), pixelDepth, fogAmount, total, closestFogAmount, closestDifference);
+	BilateralTap(texel + float2(1, 0), f.x * (1 - f.y), pixelDepth, fogAmount, total, closestFogAmount, closestDifference);
+	BilateralTap(texel + float2(0, 1), (1 - f.x) * f.y, pixelDepth, fogAmount, total, closestFogAmount, closestDifference);
+	BilateralTap(texel + float2(1, 1), f.x * f.y, pixelDepth, fogAmount, total, closestFogAmount, closestDifference);
+
+	// When no texel belongs to the surface of the pixel, the nearest in depth is used
+	return total < 1e-6 ? closestFogAmount : fogAmount / total;
+}
+
+float4 psFogCombineBilateral(PS_IN_TEXTURE input) : SV_Target0
+{
+	float3 scene = DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord).rgb;
+	float fogAmount = BilateralFogAmount(input.TexCoord);
+
+	// Compute resultant pixel
+	float3 color = lerp(FogColor, scene, fogAmount);
+
+	return float4(color, 1.0);
+}
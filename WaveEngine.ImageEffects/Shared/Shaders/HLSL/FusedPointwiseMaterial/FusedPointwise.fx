@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// FusedPointwise.fx
+//
+// Copyright  2018 Wave Engine S.L. All rights reserved.
+// Use is subject to license terms.
+//-----------------------------------------------------------------------------
+
+#include "../Structures.fxh"
+
+// Every stage applies one pointwise lens. The parameters of an unused stage leave the color unchanged.
+cbuffer Parameters : register(b1)
+{
+	float4 Stage0Red			: packoffset(c0);
+	float4 Stage0Green			: packoffset(c1);
+	float4 Stage0Blue			: packoffset(c2);
+	float4 Stage0Alpha			: packoffset(c3);
+	float4 Stage0Screen			: packoffset(c4);
+	float4 Stage0Posterize		: packoffset(c5);
+	float4 Stage1Red			: packoffset(c6);
+	float4 Stage1Green			: packoffset(c7);
+	float4 Stage1Blue			: packoffset(c8);
+	float4 Stage1Alpha			: packoffset(c9);
+	float4 Stage1Screen			: packoffset(c10);
+	float4 Stage1Posterize		: packoffset(c11);
+	float4 Stage2Red			: packoffset(c12);
+	float4 Stage2Green			: packoffset(c13);
+	float4 Stage2Blue			: packoffset(c14);
+	float4 Stage2Alpha			: packoffset(c15);
+	float4 Stage2Screen			: packoffset(c16);
+	float4 Stage2Posterize		: packoffset(c17);
+	float4 Stage3Red			: packoffset(c18);
+	float4 Stage3Green			: packoffset(c19);
+	float4 Stage3Blue			: packoffset(c20);
+	float4 Stage3Alpha			: packoffset(c21);
+	float4 Stage3Screen			: packoffset(c22);
+	float4 Stage3Posterize		: packoffset(c23);
+	float4 Lookup				: packoffset(c24);
+};
+
+Texture2D DiffuseTexture : register(t0);
+SamplerState DiffuseTextureSampler : register(s0);
+
+Texture3D LUTTexture : register(t1);
+SamplerState LUTTextureSampler : register(s1);
+
+// red, green, blue: rows of the color matrix, with the offset in w
+// alpha: x = alpha scale, y = alpha offset
+// screen: x = vignette strength, y = scanlines frequency, z = scanlines attenuation
+// posterize: x = weight, y = gamma, z = regions
+float4 ApplyStage(float4 color, float4 red, float4 green, float4 blue, float4 alpha, float4 screen, float4 posterize, float vignette, float v)
+{
+	float4 result;
+	float4 rgb1 = float4(color.rgb, 1.0);
+	result.r = dot(rgb1, red);
+	result.g = dot(rgb1, green);
+	result.b = dot(rgb1, blue);
+	result.a = color.a * alpha.x + alpha.y;
+
+	result *= 1 - vignette * screen.x;
+	result.rgb -= sin(v * screen.y) * screen.z;
+
+	float3 levels = pow(max(result.rgb, 0), posterize.y);
+	levels = floor(levels * posterize.z) / posterize.z;
+	levels = pow(levels, 1.0 / posterize.y);
+	result.rgb = lerp(result.rgb, levels, posterize.x);
+
+	// Each stage is stored like the render target of its own pass
+	return saturate(result);
+}
+
+float4 psFusedPointwise(VS_OUT_TEXTURE input) : SV_Target0
+{
+	float4 color = DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord);
+
+	float2 center = input.TexCoord - 0.5;
+	float vignette = dot(center, center);
+	float v = input.TexCoord.y;
+
+	color = ApplyStage(color, Stage0Red, Stage0Green, Stage0Blue, Stage0Alpha, Stage0Screen, Stage0Posterize, vignette, v);
+	color = ApplyStage(color, Stage1Red, Stage1Green, Stage1Blue, Stage1Alpha, Stage1Screen, Stage1Posterize, vignette, v);
+	color = ApplyStage(color, Stage2Red, Stage2Green, Stage2Blue, Stage2Alpha, Stage2Screen, Stage2Posterize, vignette, v);
+	color = ApplyStage(color, Stage3Red, Stage3Green, Stage3Blue, Stage3Alpha, Stage3Screen, Stage3Posterize, vignette, v);
+
+	// Color correction: x = weight, y = linear color space, z = scale, w = offset
+	float3 lookup = lerp(color.rgb, sqrt(color.rgb), Lookup.y);
+	lookup = LUTTexture.Sample(LUTTextureSampler, lookup * Lookup.z + Lookup.w).rgb;
+	lookup = lerp(lookup, lookup * lookup, Lookup.y);
+	color.rgb = lerp(color.rgb, lookup, Lookup.x);
+	color.a = lerp(color.a, 1.0, Lookup.x);
+
+	return color;
+}
@@ -12,6 +12,7 @@ call :CompileShader LightShaft ps psLightShaft LOW
 call :CompileShader LightShaft ps psLightShaft MEDIUM
 call :CompileShader LightShaft ps psLightShaft HIGH
 call :CompileShader LightShaft ps psLSCombine
+call :CompileShader LightShaft ps psLSCombineBilateral
 
 echo.
 
@@ -32,6 +32,8 @@ cbuffer Parameters : register(b1)
 	float EdgeSharpness			: packoffset(c3.y);
 	float SunIntensity			: packoffset(c3.z);
 	float DepthThreshold		: packoffset(c3.w);
+	float2 ShaftTextureSize		: packoffset(c4.x);
+	float DepthSigma			: packoffset(c4.z);
 };
 
 Texture2D DiffuseTexture : register(t0);
@@ -142,3 +144,59 @@ float4 psLSCombine(PS_IN_TEXTURE input) : SV_Target0
 
 	return float4(color.rgb + lightShaft.rgb, 1.0);
 }
+
+// Adds a low resolution light shaft texel to the bilateral up sampler. The depth is sampled at the
+// center of the texel.
+void BilateralTap(float2 texel, float bilinearWeight, float pixelDepth, inout float4 lightShaft, inout float total, inout float4 closestLightShaft, inout float closestDifference)
+{
+	float2 tapCoord = (texel + 0.5) / ShaftTextureSize;
+	float4 tapLightShaft = DiffuseTexture1.Sample(DiffuseTextureSampler1, tapCoord);
+	float difference = abs(DepthTexture.Sample(DepthTextureSampler, tapCoord).x - pixelDepth);
+	float weight = bilinearWeight * exp(-(difference * difference) / (2.0 * DepthSigma * DepthSigma));
+
+	if (difference < closestDifference)
+	{
+		closestDifference = difference;
+		closestLightShaft = tapLightShaft;
+	}
+
+	lightShaft += tapLightShaft * weight;
+	total += weight;
+}
+
+// Bilateral up sampler: the four light shaft texels around the pixel are weighted by their bilinear weight
+// and by the similarity of their depth, so the shafts do not bleed over the occluders.
+float4 BilateralLightShaft(float2 texCoord)
+{
+	float2 position = texCoord * ShaftTextureSize - 0.5;
+	float2 texel = floor(position);
+	float2 f = position - texel;
+	float pixelDepth = DepthTexture.Sample(DepthTextureSampler, texCoord).x;
+
+	float4 lightShaft = 0;
+	float total = 0;
+	float4 closestLightShaft = 0;
+	float closestDifference = 1e10;
+
+	BilateralTap(texel, (1 - f.x) * (1 - f.y), pixelDepth, lightShaft, total, closestLightShaft, closestDifference);
+	BilateralTap(texel + float2(1, 0), f.x * (1 - f.y), pixelDepth, lightShaft, total, closestLightShaft, closestDifference);
+	BilateralTap(texel + float2(0, 1), (1 - f.x) * f.y, pixelDepth, lightShaft, total, closestLightShaft, closestDifference);
+	BilateralTap(texel + float2(1, 1), f.x * f.y, pixelDepth, lightShaft, total, closestLightShaft, closestDifference);
+
+	// When no texel belongs to the surface of the pixel, the nearest in depth is used
+	return total < 1e-6 ? closestLightShaft : lightShaft / total;
+}
+
+// Bilateral up sampler and combine
+float4 psLSCombineBilateral(PS_IN_TEXTURE input) : SV_Target0
+{
+	float3 color = DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord).rgb;
+	float4 lightShaft = BilateralLightShaft(input.TexCoord);
+
+	lightShaft.rgb *= ShaftTint;
+
+	float faceShaft = lightShaft.a * Blend;
+	lightShaft.rgb *= faceShaft;
+
+	return float4(color.rgb + lightShaft.rgb, 1.0);
+}
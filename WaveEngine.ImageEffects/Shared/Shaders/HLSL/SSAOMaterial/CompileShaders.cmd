@@ -10,6 +10,8 @@ call :CompileShader SSAO vs vsSSAO
 call :CompileShader SSAO ps psSSAO
 call :CompileShader SSAO ps psSSAOCombine
 call :CompileShader SSAO ps psOnlyAO
+call :CompileShader SSAO ps psSSAOCombineBilateral
+call :CompileShader SSAO ps psOnlyAOBilateral
 
 echo.
 
@@ -17,6 +17,8 @@ cbuffer Parameters : register(b1)
 	float AOintensity						: packoffset(c0.y);
 	float2 FilterRadius						: packoffset(c0.z);
 	float4x4 ViewProjectionInverse			: packoffset(c1);
+	float2 AOTextureSize					: packoffset(c5.x);
+	float DepthSigma						: packoffset(c5.z);
 };
 
 Texture2D DiffuseTexture : register(t0);
@@ -143,5 +145,67 @@ float4 psOnlyAO(VS_OUT_TEXTURE input) : SV_Target0
 	float ao = AOTexture.Sample(AOTextureSampler, input.TexCoord).x;
 	ao = pow(ao, AOintensity);
 
+	return float4(ao.xxx, 1);
+}
+
+// Adds a low resolution AO texel to the bilateral up sampler. The depth is sampled at the
+// center of the texel, where the AO pass sampled it.
+void BilateralTap(float2 texel, float bilinearWeight, float pixelDepth, inout float ao, inout float total, inout float closestAO, inout float closestDifference)
+{
+	float2 tapCoord = (texel + 0.5) / AOTextureSize;
+	float tapAO = AOTexture.Sample(AOTextureSampler, tapCoord).x;
+	float difference = abs(DepthTexture.Sample(DepthTextureSampler, tapCoord).x - pixelDepth);
+	float weight = bilinearWeight * exp(-(difference * difference) / (2.0 * DepthSigma * DepthSigma));
+
+	if (difference < closestDifference)
+	{
+		closestDifference = difference;
+		closestAO = tapAO;
+	}
+
+	ao += tapAO * weight;
+	total += weight;
+}
+
+// Bilateral up sampler: the four AO texels around the pixel are weighted by their bilinear weight and
+// by the similarity of their depth, so the AO does not bleed across depth edges.
+float BilateralAO(float2 texCoord)
+{
+	float2 position = texCoord * AOTextureSize - 0.5;
+	float2 texel = floor(position);
+	float2 f = position - texel;
+	float pixelDepth = DepthTexture.Sample(DepthTextureSampler, texCoord).x;
+
+	float ao = 0;
+	float total = 0;
+	float closestAO = 1;
+	float closestDifference = 1e10;
+
+	BilateralTap(texel, (1 - f.x) * (1 - f.y), pixelDepth, ao, total, closestAO, closestDifference);
+	BilateralTap(texel + float2(1, 0), f.x * (1 - f.y), pixelDepth, ao, total, closestAO, closestDifference);
+	BilateralTap(texel + float2(0, 1), (1 - f.x) * f.y, pixelDepth, ao, total, closestAO, closestDifference);
+	BilateralTap(texel + float2(1, 1), f.x * f.y, pixelDepth, ao, total, closestAO, closestDifference);
+
+	// When no texel belongs to the surface of the pixel, the nearest in depth is used
+	return total < 1e-6 ? closestAO : ao / total;
+}
+
+float4 psSSAOCombineBilateral(VS_OUT_TEXTURE input) : SV_Target0
+{
+	float4 color = DiffuseTexture.Sample(DiffuseTextureSampler, input.TexCoord);
+
+	float ao = BilateralAO(input.TexCoord);
+	ao = pow(ao, AOintensity);
+
+	color.xyz *= ao;
+
+	return color;
+}
+
+float4 psOnlyAOBilateral(VS_OUT_TEXTURE input) : SV_Target0
+{
+	float ao = BilateralAO(input.TexCoord);
+	ao = pow(ao, AOintensity);
+
 	return float4(ao.xxx, 1);
 }
\ No newline at end of file
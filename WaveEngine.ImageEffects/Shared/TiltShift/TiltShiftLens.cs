@@ -2,6 +2,7 @@
 
 #region Usings Statements
 using System;
+using System.Collections.Generic;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
@@ -15,7 +16,7 @@ namespace WaveEngine.ImageEffects
     /// Represent a TiltShiftLens as postprocessing filter.
     /// </summary>
     [DataContract(Namespace = "WaveEngine.ImageEffects")]
-    public class TiltShiftLens : Lens
+    public class TiltShiftLens : Lens, ITransientTargetLens
     {
         #region Properties
 
@@ -76,6 +77,11 @@ namespace WaveEngine.ImageEffects
                 (this.material as TiltShiftMaterial).TiltPosition = value;
             }
         }
+
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        public TransientTargetPool TransientTargets { get; set; }
         #endregion
 
         #region Initialize
@@ -102,6 +108,16 @@ namespace WaveEngine.ImageEffects
 
         #region Public Methods
 
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        public void DeclareTransientTargets(IList<TransientTargetRequest> requests)
+        {
+            requests.Add(new TransientTargetRequest(this.DownSampleScale, 0, 1));
+            requests.Add(new TransientTargetRequest(this.DownSampleScale, 1, 2));
+        }
+
         /// <summary>
         /// Renders to image.
         /// </summary>
@@ -115,32 +131,38 @@ namespace WaveEngine.ImageEffects
             int width = (int)(this.Source.Width / this.DownSampleScale);
             int height = (int)(this.Source.Height / this.DownSampleScale);
 
-            RenderTarget rt1 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            RenderTarget rt2 = graphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
-            graphicsDevice.Viewport = new Viewport(0, 0, width, height);
+            RenderTarget rt1 = TransientTargetPool.Acquire(this, 0, width, height);
+            RenderTarget rt2 = TransientTargetPool.Acquire(this, 1, width, height);
+            TransientTargetPool.SetViewport(rt1);
 
             // Down sampler
             mat.Texture = this.Source;
             mat.Pass = TiltShiftMaterial.Passes.Simple;
+            LensProfiler.BeginPass(this, "Down sampler");
             this.RenderToImage(rt1, this.material);
+            LensProfiler.EndPass();
 
             // Fast Blur
             mat.Pass = TiltShiftMaterial.Passes.FastBlur;
             mat.Texture = rt1;
+            LensProfiler.BeginPass(this, "Fast Blur");
             this.RenderToImage(rt2, this.material);
+            LensProfiler.EndPass();
 
             // Tiltshift
-            graphicsDevice.Viewport = new Viewport(0, 0, this.Source.Width, this.Source.Height);
+            TransientTargetPool.RestoreViewport(this);
             mat.Pass = TiltShiftMaterial.Passes.TiltShift;
             mat.Texture = this.Source;
             mat.Texture1 = rt2;
+            LensProfiler.BeginPass(this, "Tiltshift");
             this.RenderToImage(this.Destination, this.material);
+            LensProfiler.EndPass();
 
             mat.Texture = null;
             mat.Texture1 = null;
 
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt1);
-            graphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(rt2);
+            TransientTargetPool.Release(this, rt1);
+            TransientTargetPool.Release(this, rt2);
         }
         #endregion
 
@@ -0,0 +1,25 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System.Collections.Generic;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// A lens that declares its intermediate render targets, so they can be planned by a <see cref="TransientTargetPool"/>.
+    /// </summary>
+    public interface ITransientTargetLens
+    {
+        /// <summary>
+        /// Gets or sets the pool that provides the intermediate targets, or null to use the temporal render targets.
+        /// </summary>
+        TransientTargetPool TransientTargets { get; set; }
+
+        /// <summary>
+        /// Adds the intermediate targets of the lens, in the order they are acquired.
+        /// </summary>
+        /// <param name="requests">The list where the requests are added.</param>
+        void DeclareTransientTargets(IList<TransientTargetRequest> requests);
+    }
+}
@@ -0,0 +1,289 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System;
+using System.Collections.Generic;
+using WaveEngine.Common.Graphics;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// Assigns intermediate targets to a minimum number of slots. Targets of the same size and format share a slot when their lifetimes do not overlap.
+    /// </summary>
+    /// <remarks>
+    /// The planner does not allocate any graphics resource, the slots are bound to render targets by <see cref="TransientTargetPool"/>.
+    /// </remarks>
+    public class TransientTargetPlanner
+    {
+        /// <summary>
+        /// The targets added to the planner
+        /// </summary>
+        private List<Entry> entries;
+
+        /// <summary>
+        /// The planned slots
+        /// </summary>
+        private List<Entry> slots;
+
+        /// <summary>
+        /// The entries sorted by their first pass
+        /// </summary>
+        private List<int> order;
+
+        /// <summary>
+        /// A target or a slot. The pass range of a slot is the range of its last assigned target.
+        /// </summary>
+        private struct Entry
+        {
+            /// <summary>
+            /// The width
+            /// </summary>
+            public int Width;
+
+            /// <summary>
+            /// The height
+            /// </summary>
+            public int Height;
+
+            /// <summary>
+            /// The pixel format
+            /// </summary>
+            public PixelFormat Format;
+
+            /// <summary>
+            /// The first pass
+            /// </summary>
+            public int FirstPass;
+
+            /// <summary>
+            /// The last pass
+            /// </summary>
+            public int LastPass;
+
+            /// <summary>
+            /// The assigned slot of a target
+            /// </summary>
+            public int Slot;
+        }
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the number of targets.
+        /// </summary>
+        public int TargetCount
+        {
+            get { return this.entries.Count; }
+        }
+
+        /// <summary>
+        /// Gets the number of planned slots.
+        /// </summary>
+        public int SlotCount
+        {
+            get { return this.slots.Count; }
+        }
+
+        /// <summary>
+        /// Gets the pixels of all the targets, as if each one had its own render target.
+        /// </summary>
+        public long RequestedPixels { get; private set; }
+
+        /// <summary>
+        /// Gets the pixels of all the planned slots.
+        /// </summary>
+        public long PlannedPixels { get; private set; }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TransientTargetPlanner"/> class.
+        /// </summary>
+        public TransientTargetPlanner()
+        {
+            this.entries = new List<Entry>();
+            this.slots = new List<Entry>();
+            this.order = new List<int>();
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Removes all the targets and slots.
+        /// </summary>
+        public void Clear()
+        {
+            this.entries.Clear();
+            this.slots.Clear();
+            this.RequestedPixels = 0;
+            this.PlannedPixels = 0;
+        }
+
+        /// <summary>
+        /// Adds a target with the default pixel format of the render targets.
+        /// </summary>
+        /// <param name="width">The width.</param>
+        /// <param name="height">The height.</param>
+        /// <param name="firstPass">The first pass of the chain that uses the target.</param>
+        /// <param name="lastPass">The last pass of the chain that uses the target.</param>
+        /// <returns>The index of the target</returns>
+        public int Add(int width, int height, int firstPass, int lastPass)
+        {
+            return this.Add(width, height, firstPass, lastPass, PixelFormat.R8G8B8A8);
+        }
+
+        /// <summary>
+        /// Adds a target.
+        /// </summary>
+        /// <param name="width">The width.</param>
+        /// <param name="height">The height.</param>
+        /// <param name="firstPass">The first pass of the chain that uses the target.</param>
+        /// <param name="lastPass">The last pass of the chain that uses the target.</param>
+        /// <param name="format">The pixel format.</param>
+        /// <returns>The index of the target</returns>
+        public int Add(int width, int height, int firstPass, int lastPass, PixelFormat format)
+        {
+            if (width <= 0)
+            {
+                throw new ArgumentOutOfRangeException("width");
+            }
+
+            if (height <= 0)
+            {
+                throw new ArgumentOutOfRangeException("height");
+            }
+
+            if (firstPass < 0 || lastPass < firstPass)
+            {
+                throw new ArgumentOutOfRangeException("lastPass");
+            }
+
+            this.entries.Add(new Entry()
+            {
+                Width = width,
+                Height = height,
+                Format = format,
+                FirstPass = firstPass,
+                LastPass = lastPass,
+                Slot = -1,
+            });
+
+            return this.entries.Count - 1;
+        }
+
+        /// <summary>
+        /// Assigns the targets to slots.
+        /// </summary>
+        public void Plan()
+        {
+            this.slots.Clear();
+            this.order.Clear();
+            this.RequestedPixels = 0;
+            this.PlannedPixels = 0;
+
+            for (int i = 0; i < this.entries.Count; i++)
+            {
+                this.order.Add(i);
+            }
+
+            // Sorted by first pass, ties keep the order of addition so the plan is stable
+            this.order.Sort((a, b) =>
+            {
+                int result = this.entries[a].FirstPass.CompareTo(this.entries[b].FirstPass);
+                return result != 0 ? result : a.CompareTo(b);
+            });
+
+            for (int i = 0; i < this.order.Count; i++)
+            {
+                int index = this.order[i];
+                var entry = this.entries[index];
+                this.RequestedPixels += (long)entry.Width * entry.Height;
+
+                int slot = -1;
+                for (int s = 0; s < this.slots.Count; s++)
+                {
+                    var candidate = this.slots[s];
+                    if (candidate.Width == entry.Width
+                        && candidate.Height == entry.Height
+                        && candidate.Format == entry.Format
+                        && candidate.LastPass < entry.FirstPass)
+                    {
+                        slot = s;
+                        break;
+                    }
+                }
+
+                if (slot < 0)
+                {
+                    slot = this.slots.Count;
+                    this.slots.Add(entry);
+                    this.PlannedPixels += (long)entry.Width * entry.Height;
+                }
+                else
+                {
+                    this.slots[slot] = entry;
+                }
+
+                entry.Slot = slot;
+                this.entries[index] = entry;
+            }
+        }
+
+        /// <summary>
+        /// Gets the slot assigned to a target.
+        /// </summary>
+        /// <param name="target">The index of the target.</param>
+        /// <returns>The index of the slot</returns>
+        public int GetSlot(int target)
+        {
+            if (target < 0 || target >= this.entries.Count)
+            {
+                throw new ArgumentOutOfRangeException("target");
+            }
+
+            int slot = this.entries[target].Slot;
+            if (slot < 0)
+            {
+                throw new InvalidOperationException("The targets have not been planned");
+            }
+
+            return slot;
+        }
+
+        /// <summary>
+        /// Gets the size of a slot.
+        /// </summary>
+        /// <param name="slot">The index of the slot.</param>
+        /// <param name="width">The width.</param>
+        /// <param name="height">The height.</param>
+        public void GetSlotSize(int slot, out int width, out int height)
+        {
+            if (slot < 0 || slot >= this.slots.Count)
+            {
+                throw new ArgumentOutOfRangeException("slot");
+            }
+
+            width = this.slots[slot].Width;
+            height = this.slots[slot].Height;
+        }
+
+        /// <summary>
+        /// Gets the pixel format of a slot.
+        /// </summary>
+        /// <param name="slot">The index of the slot.</param>
+        /// <returns>The pixel format</returns>
+        public PixelFormat GetSlotFormat(int slot)
+        {
+            if (slot < 0 || slot >= this.slots.Count)
+            {
+                throw new ArgumentOutOfRangeException("slot");
+            }
+
+            return this.slots[slot].Format;
+        }
+        #endregion
+    }
+}
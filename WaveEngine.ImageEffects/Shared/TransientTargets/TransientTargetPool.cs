@@ -0,0 +1,386 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System;
+using System.Collections.Generic;
+using System.Collections.ObjectModel;
+using WaveEngine.Common.Graphics;
+using WaveEngine.Framework.Graphics;
+using WaveEngine.Framework.Services;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// Provides the intermediate render targets of a chain of lenses.
+    /// </summary>
+    /// <remarks>
+    /// The targets declared by the lenses are planned across the whole chain with a <see cref="TransientTargetPlanner"/>,
+    /// so targets whose lifetimes do not overlap share the same render target. The render targets are kept between frames
+    /// and the chain is only planned again when the source size or a declared target changes.
+    /// <para>
+    /// Lenses use the temporal render targets of the graphics device until they are bound to a pool. To share the targets
+    /// of all the lenses of a camera, add a <see cref="TransientTargetsBehavior"/> to the camera entity. It keeps a pool bound
+    /// to the lenses of the entity and disposes it when it is removed:
+    /// </para>
+    /// <code>
+    /// camera.Entity.AddComponent(ImageEffects.Bloom())
+    ///              .AddComponent(ImageEffects.Glow())
+    ///              .AddComponent(new TransientTargetsBehavior());
+    /// </code>
+    /// <para>
+    /// A pool can also be created for a given chain with <see cref="ImageEffects.TransientTargets"/>, and must then be disposed
+    /// by the application when the lenses are removed.
+    /// </para>
+    /// </remarks>
+    public class TransientTargetPool : IDisposable
+    {
+        /// <summary>
+        /// The lenses of the chain, in render order
+        /// </summary>
+        private List<Lens> lenses;
+
+        /// <summary>
+        /// The index of the first target of each lens in the planner
+        /// </summary>
+        private Dictionary<Lens, int> firstTargets;
+
+        /// <summary>
+        /// The requests of the lens being declared
+        /// </summary>
+        private List<TransientTargetRequest> requests;
+
+        /// <summary>
+        /// The render target of each slot
+        /// </summary>
+        private List<RenderTarget> targets;
+
+        /// <summary>
+        /// The pixel format of each render target of <see cref="targets"/>
+        /// </summary>
+        private List<PixelFormat> targetFormats;
+
+        /// <summary>
+        /// The render targets of the previous plan, reused when their size and format are planned again
+        /// </summary>
+        private List<RenderTarget> previousTargets;
+
+        /// <summary>
+        /// The pixel format of each render target of <see cref="previousTargets"/>
+        /// </summary>
+        private List<PixelFormat> previousFormats;
+
+        /// <summary>
+        /// The planned source width
+        /// </summary>
+        private int sourceWidth;
+
+        /// <summary>
+        /// The planned source height
+        /// </summary>
+        private int sourceHeight;
+
+        /// <summary>
+        /// Whether the chain must be planned again
+        /// </summary>
+        private bool dirty;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the planner of the chain.
+        /// </summary>
+        public TransientTargetPlanner Planner { get; private set; }
+
+        /// <summary>
+        /// Gets the lenses of the chain, in render order.
+        /// </summary>
+        public ReadOnlyCollection<Lens> Lenses { get; private set; }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TransientTargetPool"/> class.
+        /// </summary>
+        public TransientTargetPool()
+        {
+            this.lenses = new List<Lens>();
+            this.firstTargets = new Dictionary<Lens, int>();
+            this.requests = new List<TransientTargetRequest>();
+            this.targets = new List<RenderTarget>();
+            this.targetFormats = new List<PixelFormat>();
+            this.previousTargets = new List<RenderTarget>();
+            this.previousFormats = new List<PixelFormat>();
+            this.Planner = new TransientTargetPlanner();
+            this.Lenses = this.lenses.AsReadOnly();
+            this.dirty = true;
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Sets the chain of lenses served by the pool. The lenses that declare their targets are bound to this pool.
+        /// </summary>
+        /// <param name="chain">The lenses, in render order.</param>
+        public void SetLenses(IEnumerable<Lens> chain)
+        {
+            if (chain == null)
+            {
+                throw new ArgumentNullException("chain");
+            }
+
+            this.UnbindLenses();
+
+            foreach (var lens in chain)
+            {
+                this.lenses.Add(lens);
+
+                var transientLens = lens as ITransientTargetLens;
+                if (transientLens != null)
+                {
+                    transientLens.TransientTargets = this;
+                }
+            }
+
+            this.dirty = true;
+        }
+
+        /// <summary>
+        /// Gets an intermediate target for a lens. Falls back to the temporal render targets when the lens is not bound to a pool.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="index">The index of the target in the lens declaration.</param>
+        /// <param name="width">The width.</param>
+        /// <param name="height">The height.</param>
+        /// <returns>The render target</returns>
+        public static RenderTarget Acquire(Lens lens, int index, int width, int height)
+        {
+            var transientLens = lens as ITransientTargetLens;
+            if (transientLens != null && transientLens.TransientTargets != null)
+            {
+                return transientLens.TransientTargets.GetTarget(lens, index, width, height);
+            }
+
+            return WaveServices.GraphicsDevice.RenderTargets.GetTemporalRenderTarget(width, height);
+        }
+
+        /// <summary>
+        /// Releases an intermediate target acquired with <see cref="Acquire"/>.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="target">The render target.</param>
+        public static void Release(Lens lens, RenderTarget target)
+        {
+            var transientLens = lens as ITransientTargetLens;
+            if (transientLens == null || transientLens.TransientTargets == null)
+            {
+                WaveServices.GraphicsDevice.RenderTargets.ReleaseTemporalRenderTarget(target);
+            }
+        }
+
+        /// <summary>
+        /// Sets the viewport of the graphics device to the size of an intermediate target, before rendering to it.
+        /// </summary>
+        /// <param name="target">The render target.</param>
+        public static void SetViewport(RenderTarget target)
+        {
+            WaveServices.GraphicsDevice.Viewport = new Viewport(0, 0, target.Width, target.Height);
+        }
+
+        /// <summary>
+        /// Restores the viewport of the graphics device to the size of the source of a lens, before rendering to its destination.
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        public static void RestoreViewport(Lens lens)
+        {
+            WaveServices.GraphicsDevice.Viewport = new Viewport(0, 0, lens.Source.Width, lens.Source.Height);
+        }
+
+        /// <summary>
+        /// Forces the chain to be planned again on the next acquire.
+        /// </summary>
+        public void Invalidate()
+        {
+            this.dirty = true;
+        }
+
+        /// <summary>
+        /// Destroys the render targets and unbinds the lenses.
+        /// </summary>
+        public void Dispose()
+        {
+            this.UnbindLenses();
+            this.DestroyTargets(this.targets, this.targetFormats);
+            this.Planner.Clear();
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Gets the planned render target of a lens
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="index">The index of the target in the lens declaration.</param>
+        /// <param name="width">The expected width.</param>
+        /// <param name="height">The expected height.</param>
+        /// <returns>The render target</returns>
+        private RenderTarget GetTarget(Lens lens, int index, int width, int height)
+        {
+            if (this.dirty || lens.Source.Width != this.sourceWidth || lens.Source.Height != this.sourceHeight)
+            {
+                this.PlanChain(lens.Source.Width, lens.Source.Height);
+            }
+
+            int target = this.FindTarget(lens, index);
+            var renderTarget = this.targets[this.Planner.GetSlot(target)];
+
+            if (renderTarget.Width != width || renderTarget.Height != height)
+            {
+                // A lens parameter has changed the size of its targets
+                this.PlanChain(lens.Source.Width, lens.Source.Height);
+                target = this.FindTarget(lens, index);
+                renderTarget = this.targets[this.Planner.GetSlot(target)];
+            }
+
+            return renderTarget;
+        }
+
+        /// <summary>
+        /// Finds the planner target of a lens target
+        /// </summary>
+        /// <param name="lens">The lens.</param>
+        /// <param name="index">The index of the target in the lens declaration.</param>
+        /// <returns>The index of the target in the planner</returns>
+        private int FindTarget(Lens lens, int index)
+        {
+            int first;
+            if (!this.firstTargets.TryGetValue(lens, out first))
+            {
+                throw new InvalidOperationException(string.Format("The lens {0} is not part of the chain of this pool", lens.GetType().Name));
+            }
+
+            return first + index;
+        }
+
+        /// <summary>
+        /// Plans the targets of the whole chain and binds the slots to render targets
+        /// </summary>
+        /// <param name="width">The source width.</param>
+        /// <param name="height">The source height.</param>
+        private void PlanChain(int width, int height)
+        {
+            this.Planner.Clear();
+            this.firstTargets.Clear();
+
+            // The passes of the chain are numbered consecutively, so targets of different lenses never overlap
+            int passOffset = 0;
+            for (int i = 0; i < this.lenses.Count; i++)
+            {
+                var transientLens = this.lenses[i] as ITransientTargetLens;
+                if (transientLens == null)
+                {
+                    passOffset++;
+                    continue;
+                }
+
+                this.requests.Clear();
+                transientLens.DeclareTransientTargets(this.requests);
+
+                int lastPass = 0;
+                this.firstTargets[this.lenses[i]] = this.Planner.TargetCount;
+                for (int r = 0; r < this.requests.Count; r++)
+                {
+                    var request = this.requests[r];
+                    this.Planner.Add(request.GetSize(width), request.GetSize(height), passOffset + request.FirstPass, passOffset + request.LastPass, request.Format);
+                    lastPass = Math.Max(lastPass, request.LastPass);
+                }
+
+                passOffset += lastPass + 1;
+            }
+
+            this.Planner.Plan();
+
+            var temp = this.previousTargets;
+            this.previousTargets = this.targets;
+            this.targets = temp;
+            this.targets.Clear();
+
+            var tempFormats = this.previousFormats;
+            this.previousFormats = this.targetFormats;
+            this.targetFormats = tempFormats;
+            this.targetFormats.Clear();
+
+            for (int slot = 0; slot < this.Planner.SlotCount; slot++)
+            {
+                int slotWidth, slotHeight;
+                this.Planner.GetSlotSize(slot, out slotWidth, out slotHeight);
+                PixelFormat slotFormat = this.Planner.GetSlotFormat(slot);
+
+                RenderTarget renderTarget = null;
+                for (int p = 0; p < this.previousTargets.Count; p++)
+                {
+                    var previous = this.previousTargets[p];
+                    if (previous.Width == slotWidth && previous.Height == slotHeight && this.previousFormats[p] == slotFormat)
+                    {
+                        renderTarget = previous;
+                        this.previousTargets.RemoveAt(p);
+                        this.previousFormats.RemoveAt(p);
+                        break;
+                    }
+                }
+
+                if (renderTarget == null)
+                {
+                    renderTarget = WaveServices.GraphicsDevice.RenderTargets.CreateRenderTarget(slotWidth, slotHeight, slotFormat);
+                }
+
+                this.targets.Add(renderTarget);
+                this.targetFormats.Add(slotFormat);
+            }
+
+            this.DestroyTargets(this.previousTargets, this.previousFormats);
+
+            this.sourceWidth = width;
+            this.sourceHeight = height;
+            this.dirty = false;
+        }
+
+        /// <summary>
+        /// Destroys a list of render targets
+        /// </summary>
+        /// <param name="renderTargets">The render targets.</param>
+        /// <param name="formats">The pixel formats of the render targets.</param>
+        private void DestroyTargets(List<RenderTarget> renderTargets, List<PixelFormat> formats)
+        {
+            for (int i = 0; i < renderTargets.Count; i++)
+            {
+                WaveServices.GraphicsDevice.RenderTargets.DestroyRenderTarget(renderTargets[i]);
+            }
+
+            renderTargets.Clear();
+            formats.Clear();
+        }
+
+        /// <summary>
+        /// Unbinds the lenses of the chain from this pool
+        /// </summary>
+        private void UnbindLenses()
+        {
+            for (int i = 0; i < this.lenses.Count; i++)
+            {
+                var transientLens = this.lenses[i] as ITransientTargetLens;
+                if (transientLens != null && transientLens.TransientTargets == this)
+                {
+                    transientLens.TransientTargets = null;
+                }
+            }
+
+            this.lenses.Clear();
+            this.dirty = true;
+        }
+        #endregion
+    }
+}
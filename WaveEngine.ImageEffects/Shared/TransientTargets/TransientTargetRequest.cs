@@ -0,0 +1,87 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System;
+using WaveEngine.Common.Graphics;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// Declares an intermediate render target used by a lens.
+    /// </summary>
+    public struct TransientTargetRequest
+    {
+        /// <summary>
+        /// The source size is divided by this value to get the target size.
+        /// </summary>
+        public float Divisor;
+
+        /// <summary>
+        /// The first pass of the lens that uses the target.
+        /// </summary>
+        public int FirstPass;
+
+        /// <summary>
+        /// The last pass of the lens that uses the target.
+        /// </summary>
+        public int LastPass;
+
+        /// <summary>
+        /// The pixel format of the target. Only targets with the same format share a render target.
+        /// </summary>
+        public PixelFormat Format;
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TransientTargetRequest"/> struct, with the default pixel format of the render targets.
+        /// </summary>
+        /// <param name="divisor">The source size is divided by this value to get the target size.</param>
+        /// <param name="firstPass">The first pass of the lens that uses the target.</param>
+        /// <param name="lastPass">The last pass of the lens that uses the target.</param>
+        public TransientTargetRequest(float divisor, int firstPass, int lastPass)
+            : this(divisor, firstPass, lastPass, PixelFormat.R8G8B8A8)
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TransientTargetRequest"/> struct.
+        /// </summary>
+        /// <param name="divisor">The source size is divided by this value to get the target size.</param>
+        /// <param name="firstPass">The first pass of the lens that uses the target.</param>
+        /// <param name="lastPass">The last pass of the lens that uses the target.</param>
+        /// <param name="format">The pixel format of the target.</param>
+        public TransientTargetRequest(float divisor, int firstPass, int lastPass, PixelFormat format)
+        {
+            if (divisor <= 0)
+            {
+                throw new ArgumentOutOfRangeException("divisor");
+            }
+
+            if (firstPass < 0 || lastPass < firstPass)
+            {
+                throw new ArgumentOutOfRangeException("lastPass");
+            }
+
+            this.Divisor = divisor;
+            this.FirstPass = firstPass;
+            this.LastPass = lastPass;
+            this.Format = format;
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Gets the size of the target for a source size.
+        /// </summary>
+        /// <param name="sourceSize">The source width or height.</param>
+        /// <returns>The target width or height</returns>
+        public int GetSize(int sourceSize)
+        {
+            return Math.Max(1, (int)(sourceSize / this.Divisor));
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,124 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Usings Statements
+using System;
+using System.Collections.Generic;
+using System.Runtime.Serialization;
+using WaveEngine.Framework;
+using WaveEngine.Framework.Graphics;
+#endregion
+
+namespace WaveEngine.ImageEffects
+{
+    /// <summary>
+    /// Shares the intermediate render targets of all the lenses of a camera entity through a <see cref="TransientTargetPool"/>.
+    /// </summary>
+    /// <remarks>
+    /// The pool is bound to the lenses of the entity, in the order they were added. The chain is checked once per frame, before
+    /// the lenses are rendered, so lenses added or removed later are planned again. Without this behavior every lens takes its
+    /// targets from the temporal render targets of the graphics device.
+    /// </remarks>
+    [DataContract(Namespace = "WaveEngine.ImageEffects")]
+    public class TransientTargetsBehavior : Behavior
+    {
+        /// <summary>
+        /// The pool of the lenses
+        /// </summary>
+        private TransientTargetPool pool;
+
+        /// <summary>
+        /// The lenses of the entity in the current frame
+        /// </summary>
+        private List<Lens> chain;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the pool bound to the lenses of the entity.
+        /// </summary>
+        public TransientTargetPool Pool
+        {
+            get
+            {
+                return this.pool;
+            }
+        }
+        #endregion
+
+        #region Initialize
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TransientTargetsBehavior"/> class.
+        /// </summary>
+        public TransientTargetsBehavior()
+        {
+        }
+
+        /// <summary>
+        /// Sets default values for this instance.
+        /// </summary>
+        protected override void DefaultValues()
+        {
+            base.DefaultValues();
+            this.pool = new TransientTargetPool();
+            this.chain = new List<Lens>();
+        }
+
+        /// <summary>
+        /// Destroys the render targets of the pool and unbinds the lenses.
+        /// </summary>
+        protected override void DeleteDependencies()
+        {
+            base.DeleteDependencies();
+            this.pool.Dispose();
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Binds the pool to the current lenses of the entity
+        /// </summary>
+        /// <param name="gameTime">The current game time</param>
+        protected override void Update(TimeSpan gameTime)
+        {
+            this.chain.Clear();
+            foreach (var lens in this.Owner.FindComponents<Lens>(false))
+            {
+                this.chain.Add(lens);
+            }
+
+            if (!this.IsBound(this.chain))
+            {
+                this.pool.SetLenses(this.chain);
+            }
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether the pool is bound to a chain of lenses
+        /// </summary>
+        /// <param name="lenses">The lenses, in render order.</param>
+        /// <returns><c>true</c> if the pool serves the same lenses in the same order</returns>
+        private bool IsBound(List<Lens> lenses)
+        {
+            var bound = this.pool.Lenses;
+            if (bound.Count != lenses.Count)
+            {
+                return false;
+            }
+
+            for (int i = 0; i < lenses.Count; i++)
+            {
+                // A lens bound to another pool is taken back
+                var transientLens = lenses[i] as ITransientTargetLens;
+                if (bound[i] != lenses[i] || (transientLens != null && transientLens.TransientTargets != this.pool))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        #endregion
+    }
+}
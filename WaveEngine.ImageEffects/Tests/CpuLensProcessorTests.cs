@@ -0,0 +1,635 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework.Graphics;
+
+namespace WaveEngine.ImageEffects.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="CpuLensProcessor"/>
+    /// </summary>
+    [TestFixture]
+    public class CpuLensProcessorTests
+    {
+        /// <summary>
+        /// The grayscale lens weights the channels as the shader does.
+        /// </summary>
+        [Test]
+        public void GrayScaleWeightsChannels()
+        {
+            var source = CreateImage(1, 1, 1, 0.5f, 0.25f, 0.5f);
+            var destination = new CpuImage(1, 1);
+
+            new CpuLensProcessor().Render(new GrayScaleLens(), source, destination);
+
+            float grey = (1 * 0.3f) + (0.5f * 0.59f) + (0.25f * 0.11f);
+            Assert.AreEqual(grey, destination.Pixels[0], 1e-6);
+            Assert.AreEqual(grey, destination.Pixels[1], 1e-6);
+            Assert.AreEqual(grey, destination.Pixels[2], 1e-6);
+            Assert.AreEqual(1, destination.Pixels[3], 1e-6);
+        }
+
+        /// <summary>
+        /// Inverting an image twice gives the original image.
+        /// </summary>
+        [Test]
+        public void InvertTwiceRestoresImage()
+        {
+            var source = CreateRandomImage(37, 23, 44);
+            var inverted = new CpuImage(source.Width, source.Height);
+            var restored = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+
+            processor.Render(new InvertLens(), source, inverted);
+            processor.Render(new InvertLens(), inverted, restored);
+
+            int maxError;
+            Assert.AreEqual(double.PositiveInfinity, restored.Compare(source, out maxError));
+        }
+
+        /// <summary>
+        /// The gaussian blur with a sigma keeps a constant image unchanged, because its weights add up to one.
+        /// The fixed kernel of the original shader drops its last weight, so it is not tested here.
+        /// </summary>
+        [Test]
+        public void GaussianBlurKeepsConstantImage()
+        {
+            var source = CreateImage(32, 16, 0.25f, 0.5f, 0.75f, 1);
+            var destination = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+
+            foreach (var sigma in new float[] { 0.5f, 1.5f, 4 })
+            {
+                processor.Render(new GaussianBlurLens() { Factor = 1, Sigma = sigma }, source, destination);
+
+                for (int i = 0; i < destination.Pixels.Length; i++)
+                {
+                    Assert.AreEqual(source.Pixels[i], destination.Pixels[i], 1e-4);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Each pyramid level halves the previous one, and a constant image stays constant.
+        /// </summary>
+        [Test]
+        public void PyramidLevelsHalveSize()
+        {
+            var source = CreateImage(64, 20, 0.5f, 0.5f, 0.5f, 1);
+            var pyramid = new CpuLensProcessor().BuildPyramid(source, 3);
+
+            Assert.AreEqual(4, pyramid.Length);
+            Assert.AreSame(source, pyramid[0]);
+            Assert.AreEqual(8, pyramid[3].Width);
+            Assert.AreEqual(2, pyramid[3].Height);
+
+            for (int i = 0; i < pyramid[3].Pixels.Length; i++)
+            {
+                Assert.AreEqual(source.Pixels[i % CpuImage.Channels], pyramid[3].Pixels[i], 1e-6);
+            }
+        }
+
+        /// <summary>
+        /// The dual filter spreads a texel over the 4x4 footprint of the taps and keeps the mean of the image.
+        /// </summary>
+        [Test]
+        public void PyramidDualFilterSpreadsTexel()
+        {
+            var source = new CpuImage(8, 8);
+            source.Pixels[((3 * 8) + 3) * CpuImage.Channels] = 1;
+
+            var level = new CpuLensProcessor().BuildPyramid(source, 1)[1];
+
+            float sum = 0;
+            for (int i = 0; i < level.Pixels.Length; i += CpuImage.Channels)
+            {
+                sum += level.Pixels[i];
+            }
+
+            Assert.AreEqual(1.25f / 8, level.Pixels[((1 * 4) + 1) * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(0.25f / 8, level.Pixels[((1 * 4) + 2) * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(0.25f / 8, level.Pixels[((2 * 4) + 1) * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(0.25f / 8, level.Pixels[((2 * 4) + 2) * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(1, sum * 4, 1e-5);
+        }
+
+        /// <summary>
+        /// The bilateral upsample does not blend the texels of a different depth, where a bilinear upsample would.
+        /// </summary>
+        [Test]
+        public void BilateralUpsampleKeepsDepthEdges()
+        {
+            var low = CreateRow(0, 1);
+            var lowDepth = CreateRow(0.2f, 0.8f);
+            var depth = CreateRow(0.2f, 0.2f, 0.8f, 0.8f);
+            var destination = new CpuImage(4, 1);
+
+            new CpuLensProcessor().BilateralUpsample(low, lowDepth, depth, destination, 0.01f);
+
+            Assert.AreEqual(0, destination.Pixels[0 * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(0, destination.Pixels[1 * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(1, destination.Pixels[2 * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(1, destination.Pixels[3 * CpuImage.Channels], 1e-6);
+        }
+
+        /// <summary>
+        /// When a pixel matches the depth of no texel, the texel nearest in depth is used.
+        /// </summary>
+        [Test]
+        public void BilateralUpsampleFallsBackToNearestDepth()
+        {
+            var low = CreateRow(0, 1);
+            var lowDepth = CreateRow(0.2f, 0.8f);
+            var depth = CreateRow(0.2f, 0.45f, 0.55f, 0.8f);
+            var destination = new CpuImage(4, 1);
+
+            new CpuLensProcessor().BilateralUpsample(low, lowDepth, depth, destination, 0.001f);
+
+            Assert.AreEqual(0, destination.Pixels[1 * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(1, destination.Pixels[2 * CpuImage.Channels], 1e-6);
+        }
+
+        /// <summary>
+        /// With the same depth everywhere the bilateral upsample is a bilinear upsample.
+        /// </summary>
+        [Test]
+        public void BilateralUpsampleIsBilinearOnFlatDepth()
+        {
+            var low = CreateRandomImage(8, 6, 3);
+            var lowDepth = CreateImage(8, 6, 0.5f, 0, 0, 1);
+            var depth = CreateImage(32, 24, 0.5f, 0, 0, 1);
+            var destination = new CpuImage(32, 24);
+            var expected = new float[CpuImage.Channels];
+
+            new CpuLensProcessor().BilateralUpsample(low, lowDepth, depth, destination, 0.01f);
+
+            for (int y = 0; y < destination.Height; y++)
+            {
+                for (int x = 0; x < destination.Width; x++)
+                {
+                    low.Sample((x + 0.5f) / destination.Width, (y + 0.5f) / destination.Height, expected, 0);
+                    for (int c = 0; c < CpuImage.Channels; c++)
+                    {
+                        Assert.AreEqual(expected[c], destination.Pixels[(((y * destination.Width) + x) * CpuImage.Channels) + c], 1e-5);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Runs of pointwise lenses are counted as one pass each.
+        /// </summary>
+        [Test]
+        public void PassCountFusesPointwiseRuns()
+        {
+            var lenses = CreateChain();
+
+            Assert.AreEqual(6, CpuLensProcessor.GetPassCount(lenses, false));
+            Assert.AreEqual(3, CpuLensProcessor.GetPassCount(lenses, true));
+        }
+
+        /// <summary>
+        /// On the CPU, where the intermediate images are float, the fused chain gives the same pixels as the unfused one.
+        /// </summary>
+        [Test]
+        public void FusedChainMatchesUnfusedChain()
+        {
+            var source = CreateRandomImage(61, 35, 45);
+            var fused = new CpuImage(source.Width, source.Height);
+            var unfused = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+
+            processor.FuseLenses = true;
+            processor.Render(CreateChain(), source, fused);
+            Assert.AreEqual(3, processor.PassesSaved);
+
+            processor.FuseLenses = false;
+            processor.Render(CreateChain(), source, unfused);
+            Assert.AreEqual(0, processor.PassesSaved);
+
+            CollectionAssert.AreEqual(unfused.Pixels, fused.Pixels);
+        }
+
+        /// <summary>
+        /// A chain rendered one lens at a time through 8 bit images, as a GPU chain is, stays within a few levels of the fused chain.
+        /// </summary>
+        [Test]
+        public void EightBitChainStaysCloseToFusedChain()
+        {
+            var source = CreateRandomImage(61, 35, 46);
+            var fused = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+            var lenses = CreateChain();
+
+            processor.Render(lenses, source, fused);
+
+            var image = source;
+            foreach (var lens in lenses)
+            {
+                var output = new CpuImage(source.Width, source.Height);
+                processor.FuseLenses = false;
+                processor.Render(new[] { lens }, image, output);
+                image = CpuImage.FromRgba32(output.Width, output.Height, output.ToRgba32());
+            }
+
+            int maxError;
+            image.Compare(fused, out maxError);
+            Assert.LessOrEqual(maxError, 3);
+        }
+
+        /// <summary>
+        /// Renders check their arguments.
+        /// </summary>
+        [Test]
+        public void RenderRejectsInvalidImages()
+        {
+            var processor = new CpuLensProcessor();
+            var image = new CpuImage(4, 4);
+
+            Assert.Throws<ArgumentNullException>(() => processor.Render(new InvertLens(), null, image));
+            Assert.Throws<ArgumentException>(() => processor.Render(new InvertLens(), image, new CpuImage(2, 4)));
+            Assert.Throws<ArgumentException>(() => processor.Render(new InvertLens(), image, image));
+        }
+
+        /// <summary>
+        /// The lenses that resample the source, with any parameters, keep a constant image unchanged.
+        /// </summary>
+        [Test]
+        public void ResamplingLensesKeepConstantImage()
+        {
+            var source = CreateImage(32, 24, 0.25f, 0.5f, 0.75f, 1);
+            var processor = new CpuLensProcessor();
+            processor.DistortionNormal = CreateRandomImage(8, 8, 47);
+
+            var lenses = new Lens[]
+            {
+                new ChromaticAberrationLens() { AberrationStrength = 10 },
+                new DistortionLens() { Power = 0.1f },
+                new FishEyeLens() { StrengthX = 0.1f, StrengthY = 0.2f },
+                new PixelateLens() { PixelSize = new Vector2(4, 3) },
+                new RadialBlurLens() { Nsamples = 10, BlurWidth = 0.3f, Center = new Vector2(0.3f, 0.6f) },
+                new TilingLens() { NumTiles = 4, Threshhold = 0, EdgeColor = new Vector3(0.7f, 0.7f, 0.7f) },
+                new FastBlurLens() { BlurScale = 4 },
+                new GlowLens() { GlowScale = 4, Intensity = 0 },
+                new TiltShiftLens() { BlurScale = 1, DownSampleScale = 4, Power = 3, TiltPosition = 0.3f },
+            };
+
+            foreach (var lens in lenses)
+            {
+                var destination = new CpuImage(source.Width, source.Height);
+                processor.Render(new[] { lens }, source, destination);
+
+                for (int i = 0; i < destination.Pixels.Length; i += CpuImage.Channels)
+                {
+                    Assert.AreEqual(0.25f, destination.Pixels[i], 1e-5, lens.GetType().Name);
+                    Assert.AreEqual(0.5f, destination.Pixels[i + 1], 1e-5, lens.GetType().Name);
+                    Assert.AreEqual(0.75f, destination.Pixels[i + 2], 1e-5, lens.GetType().Name);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Every lens of the library has a CPU implementation.
+        /// </summary>
+        [Test]
+        public void ChainRendersEveryLens()
+        {
+            var source = CreateRandomImage(24, 16, 48);
+            var destination = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+            processor.DistortionNormal = CreateRandomImage(8, 8, 49);
+            processor.FilmGrainTexture = CreateRandomImage(8, 8, 50);
+
+            var lenses = new Lens[]
+            {
+                new GrayScaleLens(),
+                new InvertLens(),
+                new SepiaLens() { ImageTone = new Vector3(1, 0.9f, 0.5f), GreyTransfer = new Vector3(0.3f, 0.59f, 0.11f), Toning = 1, GlobalAlpha = 1 },
+                new ToneMappingLens(),
+                new PosterizeLens() { Gamma = 0.6f, Regions = 8 },
+                new VignetteLens() { Power = 0.5f, Radio = 1.5f },
+                new ScanlinesLens() { LinesFactor = 400, Attenuation = 0.05f },
+                new ConvolutionLens() { Filter = ConvolutionMaterial.FilterType.Sharpen },
+                new GaussianBlurLens() { Factor = 1, Sigma = 2 },
+                new BloomLens() { BloomThreshold = 0.5f, BloomScale = 4, Intensity = 1, BloomTint = new Vector3(1, 1, 1) },
+                new ChromaticAberrationLens() { AberrationStrength = 10 },
+                new DistortionLens() { Power = 0.1f },
+                new FishEyeLens() { StrengthX = 0.1f, StrengthY = 0.1f },
+                new FilmGrainLens(),
+                new PixelateLens(),
+                new RadialBlurLens(),
+                new SobelLens() { Effect = SobelMaterial.SobelEffect.SobelEdgeColor, Threshold = 0.5f },
+                new TilingLens() { NumTiles = 4, Threshhold = 0.15f, EdgeColor = new Vector3(0.7f, 0.7f, 0.7f) },
+                new TiltShiftLens(),
+                new GlowLens(),
+                new FastBlurLens(),
+                new ColorCorrectionLens(),
+            };
+
+            processor.FuseLenses = false;
+            processor.Render(lenses, source, destination);
+
+            foreach (float component in destination.Pixels)
+            {
+                Assert.IsFalse(float.IsNaN(component));
+            }
+        }
+
+        /// <summary>
+        /// Every block of the pixelate lens takes a single color, sampled at its top left corner.
+        /// </summary>
+        [Test]
+        public void PixelateRepeatsBlockColor()
+        {
+            var source = CreateRandomImage(16, 12, 51);
+            var destination = new CpuImage(source.Width, source.Height);
+
+            new CpuLensProcessor().Render(new PixelateLens() { PixelSize = new Vector2(4, 3) }, source, destination);
+
+            // The corner of the first block is clamped to its first pixel
+            Assert.AreEqual(source.Pixels[0], destination.Pixels[0], 1e-6);
+
+            for (int y = 0; y < source.Height; y++)
+            {
+                for (int x = 0; x < source.Width; x++)
+                {
+                    int i = ((y * source.Width) + x) * CpuImage.Channels;
+                    int corner = ((((y / 3) * 3) * source.Width) + ((x / 4) * 4)) * CpuImage.Channels;
+                    for (int c = 0; c < CpuImage.Channels; c++)
+                    {
+                        Assert.AreEqual(destination.Pixels[corner + c], destination.Pixels[i + c]);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// The sobel lens finds the edge between two flat regions, and nothing inside them.
+        /// </summary>
+        [Test]
+        public void SobelFindsVerticalEdge()
+        {
+            var source = new CpuImage(8, 4);
+            for (int y = 0; y < source.Height; y++)
+            {
+                for (int x = 4; x < source.Width; x++)
+                {
+                    int i = ((y * source.Width) + x) * CpuImage.Channels;
+                    source.Pixels[i] = source.Pixels[i + 1] = source.Pixels[i + 2] = 1;
+                }
+            }
+
+            var destination = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+
+            processor.Render(new SobelLens() { Effect = SobelMaterial.SobelEffect.Sobel }, source, destination);
+            Assert.AreEqual(0, destination.Pixels[(8 + 1) * CpuImage.Channels], 1e-6);
+            Assert.AreEqual(4, destination.Pixels[(8 + 3) * CpuImage.Channels], 1e-5);
+            Assert.AreEqual(4, destination.Pixels[(8 + 4) * CpuImage.Channels], 1e-5);
+            Assert.AreEqual(0, destination.Pixels[(8 + 6) * CpuImage.Channels], 1e-6);
+
+            processor.Render(new SobelLens() { Effect = SobelMaterial.SobelEffect.SobelEdge, Threshold = 1 }, source, destination);
+            Assert.AreEqual(1, destination.Pixels[(8 + 1) * CpuImage.Channels]);
+            Assert.AreEqual(0, destination.Pixels[(8 + 3) * CpuImage.Channels]);
+            Assert.AreEqual(1, destination.Pixels[((8 + 3) * CpuImage.Channels) + 3]);
+        }
+
+        /// <summary>
+        /// The default color correction table keeps the colors, in both color spaces.
+        /// </summary>
+        [Test]
+        public void ColorCorrectionIdentityTableKeepsColors()
+        {
+            var source = CreateRandomImage(17, 9, 52);
+            var destination = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+
+            foreach (var colorSpace in new[] { ColorCorrectionMaterial.ColorSpaceType.Default, ColorCorrectionMaterial.ColorSpaceType.Linear })
+            {
+                processor.Render(new ColorCorrectionLens() { ColorSpace = colorSpace }, source, destination);
+
+                for (int i = 0; i < source.Pixels.Length; i += CpuImage.Channels)
+                {
+                    for (int c = 0; c < 3; c++)
+                    {
+                        Assert.AreEqual(source.Pixels[i + c], destination.Pixels[i + c], 1e-5);
+                    }
+
+                    Assert.AreEqual(1, destination.Pixels[i + 3]);
+                }
+            }
+        }
+
+        /// <summary>
+        /// A color correction table is interpolated between its entries.
+        /// </summary>
+        [Test]
+        public void ColorCorrectionInterpolatesTable()
+        {
+            var source = CreateRandomImage(17, 9, 53);
+            var destination = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+
+            // A table of 4 entries that inverts the colors, which is linear so the interpolation is exact
+            var table = CpuLensProcessor.CreateColorTable(4);
+            for (int i = 0; i < table.Pixels.Length; i += CpuImage.Channels)
+            {
+                table.Pixels[i] = 1 - table.Pixels[i];
+                table.Pixels[i + 1] = 1 - table.Pixels[i + 1];
+                table.Pixels[i + 2] = 1 - table.Pixels[i + 2];
+            }
+
+            processor.ColorCorrectionTable = table;
+            processor.Render(new ColorCorrectionLens(), source, destination);
+
+            for (int i = 0; i < source.Pixels.Length; i += CpuImage.Channels)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    Assert.AreEqual(1 - source.Pixels[i + c], destination.Pixels[i + c], 1e-5);
+                }
+            }
+
+            processor.ColorCorrectionTable = new CpuImage(4, 4);
+            Assert.Throws<InvalidOperationException>(() => processor.Render(new ColorCorrectionLens(), source, destination));
+        }
+
+        /// <summary>
+        /// The film grain adds the grain texture, centered at 0.5, scaled by an intensity between the minimum and the maximum.
+        /// </summary>
+        [Test]
+        public void FilmGrainAddsGrain()
+        {
+            var source = CreateRandomImage(16, 8, 54);
+            var destination = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+            var lens = new FilmGrainLens() { GrainIntensityMin = 0.1f, GrainIntensityMax = 0.2f, GrainSize = 2 };
+
+            Assert.Throws<InvalidOperationException>(() => processor.Render(lens, source, destination));
+
+            processor.FilmGrainTexture = CreateImage(4, 4, 0.5f, 0.5f, 0.5f, 1);
+            processor.Render(lens, source, destination);
+            for (int i = 0; i < source.Pixels.Length; i += CpuImage.Channels)
+            {
+                Assert.AreEqual(source.Pixels[i], destination.Pixels[i], 1e-6);
+            }
+
+            processor.FilmGrainTexture = CreateImage(4, 4, 1, 1, 1, 1);
+            processor.Render(lens, source, destination);
+            float intensity = destination.Pixels[0] - source.Pixels[0];
+            Assert.GreaterOrEqual(intensity, 0.1f - 1e-6f);
+            Assert.LessOrEqual(intensity, 0.2f + 1e-6f);
+            for (int i = 0; i < source.Pixels.Length; i++)
+            {
+                float expected = (i % CpuImage.Channels) == 3 ? 1 : source.Pixels[i] + intensity;
+                Assert.AreEqual(expected, destination.Pixels[i], 1e-5);
+            }
+        }
+
+        /// <summary>
+        /// The tilt shift keeps the row at the tilt position and blurs the ones away from it.
+        /// </summary>
+        [Test]
+        public void TiltShiftKeepsFocusedRow()
+        {
+            var source = CreateRandomImage(32, 33, 55);
+            var destination = new CpuImage(source.Width, source.Height);
+
+            new CpuLensProcessor().Render(new TiltShiftLens() { TiltPosition = 0.5f, Power = 3 }, source, destination);
+
+            int row = 16 * source.Width * CpuImage.Channels;
+            for (int i = row; i < row + (source.Width * CpuImage.Channels); i += CpuImage.Channels)
+            {
+                Assert.AreEqual(source.Pixels[i], destination.Pixels[i], 1e-5);
+            }
+
+            Assert.AreNotEqual(source.Pixels[0], destination.Pixels[0]);
+        }
+
+        /// <summary>
+        /// The lenses that read a texture of their material fail without the image of the texture.
+        /// </summary>
+        [Test]
+        public void TextureLensesNeedTheirImages()
+        {
+            var processor = new CpuLensProcessor();
+            var image = CreateRandomImage(4, 4, 56);
+
+            Assert.Throws<InvalidOperationException>(() => processor.Render(new DistortionLens(), image, new CpuImage(4, 4)));
+            Assert.Throws<InvalidOperationException>(() => processor.Render(new FilmGrainLens(), image, new CpuImage(4, 4)));
+        }
+
+        /// <summary>
+        /// Fusing the pointwise lenses that read textures gives the same pixels, with the same random grain.
+        /// </summary>
+        [Test]
+        public void FusedTextureLensesMatchUnfused()
+        {
+            var source = CreateRandomImage(29, 17, 57);
+            var grain = CreateRandomImage(8, 8, 58);
+            var lenses = new Lens[]
+            {
+                new ColorCorrectionLens() { ColorSpace = ColorCorrectionMaterial.ColorSpaceType.Linear },
+                new FilmGrainLens(),
+                new GrayScaleLens(),
+            };
+
+            var fused = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor() { FilmGrainTexture = grain };
+            processor.Render(lenses, source, fused);
+            Assert.AreEqual(2, processor.PassesSaved);
+
+            var unfused = new CpuImage(source.Width, source.Height);
+            processor = new CpuLensProcessor() { FilmGrainTexture = grain, FuseLenses = false };
+            processor.Render(lenses, source, unfused);
+
+            CollectionAssert.AreEqual(unfused.Pixels, fused.Pixels);
+        }
+
+        /// <summary>
+        /// Creates a chain with two runs of pointwise lenses around a blur
+        /// </summary>
+        /// <returns>The lenses</returns>
+        private static Lens[] CreateChain()
+        {
+            return new Lens[]
+            {
+                new SepiaLens()
+                {
+                    ImageTone = new Vector3(1, 0.9f, 0.5f),
+                    DarkTone = new Vector3(0.2f, 0.05f, 0),
+                    GreyTransfer = new Vector3(0.3f, 0.59f, 0.11f),
+                    Desaturation = 0.5f,
+                    Toning = 1,
+                    GlobalAlpha = 1,
+                },
+                new VignetteLens() { Power = 0.5f, Radio = 1.5f },
+                new GaussianBlurLens() { Factor = 1, Sigma = 2 },
+                new InvertLens(),
+                new GrayScaleLens(),
+                new ScanlinesLens() { LinesFactor = 400, Attenuation = 0.05f },
+            };
+        }
+
+        /// <summary>
+        /// Creates an image of one row, with the red component of each pixel
+        /// </summary>
+        /// <param name="red">The red components.</param>
+        /// <returns>The image</returns>
+        private static CpuImage CreateRow(params float[] red)
+        {
+            var image = new CpuImage(red.Length, 1);
+            for (int x = 0; x < red.Length; x++)
+            {
+                image.Pixels[x * CpuImage.Channels] = red[x];
+            }
+
+            return image;
+        }
+
+        /// <summary>
+        /// Creates an image filled with a color
+        /// </summary>
+        /// <param name="width">The width.</param>
+        /// <param name="height">The height.</param>
+        /// <param name="r">The red component.</param>
+        /// <param name="g">The green component.</param>
+        /// <param name="b">The blue component.</param>
+        /// <param name="a">The alpha component.</param>
+        /// <returns>The image</returns>
+        internal static CpuImage CreateImage(int width, int height, float r, float g, float b, float a)
+        {
+            var image = new CpuImage(width, height);
+            for (int i = 0; i < image.Pixels.Length; i += CpuImage.Channels)
+            {
+                image.Pixels[i] = r;
+                image.Pixels[i + 1] = g;
+                image.Pixels[i + 2] = b;
+                image.Pixels[i + 3] = a;
+            }
+
+            return image;
+        }
+
+        /// <summary>
+        /// Creates an image with random components between 0 and 1
+        /// </summary>
+        /// <param name="width">The width.</param>
+        /// <param name="height">The height.</param>
+        /// <param name="seed">The random seed.</param>
+        /// <returns>The image</returns>
+        internal static CpuImage CreateRandomImage(int width, int height, int seed)
+        {
+            var random = new Random(seed);
+            var image = new CpuImage(width, height);
+            for (int i = 0; i < image.Pixels.Length; i++)
+            {
+                image.Pixels[i] = (float)random.NextDouble();
+            }
+
+            return image;
+        }
+    }
+}
@@ -0,0 +1,210 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using NUnit.Framework;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework.Graphics;
+
+namespace WaveEngine.ImageEffects.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="FusedPointwiseLens"/> and <see cref="FusedPointwiseStages"/>, evaluated with the <see cref="CpuLensProcessor"/>
+    /// </summary>
+    [TestFixture]
+    public class FusedPointwiseLensTests
+    {
+        /// <summary>
+        /// Fuse replaces every run of lenses that fits in the fused shader, up to four stages and an ending color correction.
+        /// </summary>
+        [Test]
+        public void FuseReplacesRunsOfPointwiseLenses()
+        {
+            var chain = new Lens[]
+            {
+                new SepiaLens(),
+                new VignetteLens(),
+                new GaussianBlurLens(),
+                new InvertLens(),
+                new GrayScaleLens(),
+                new ScanlinesLens(),
+                new PosterizeLens(),
+                new VignetteLens(),
+                new ColorCorrectionLens(),
+                new InvertLens(),
+                new ToneMappingLens(),
+                new InvertLens(),
+            };
+
+            var fused = FusedPointwiseLens.Fuse(chain);
+
+            Assert.AreEqual(7, fused.Count);
+            Assert.AreEqual(2, ((FusedPointwiseLens)fused[0]).Lenses.Count);
+            Assert.AreSame(chain[2], fused[1]);
+            Assert.AreEqual(FusedPointwiseStages.MaxStages, ((FusedPointwiseLens)fused[2]).Lenses.Count);
+            Assert.AreEqual(2, ((FusedPointwiseLens)fused[3]).Lenses.Count);
+            Assert.IsTrue(((FusedPointwiseLens)fused[3]).Stages.UsesLookup);
+            Assert.AreSame(chain[9], fused[4]);
+            Assert.AreSame(chain[10], fused[5]);
+            Assert.AreSame(chain[11], fused[6]);
+
+            int passesSaved = chain.Length - fused.Count;
+            TestContext.Progress.WriteLine("{0} lenses rendered in {1} passes, {2} passes saved", chain.Length, fused.Count, passesSaved);
+            Assert.AreEqual(5, passesSaved);
+        }
+
+        /// <summary>
+        /// A fused lens gives the pixels of its lenses rendered one by one, saturating every pass as the render targets of a GPU chain do.
+        /// </summary>
+        [Test]
+        public void FusedLensMatchesSaturatedUnfusedChain()
+        {
+            var source = CpuLensProcessorTests.CreateRandomImage(61, 35, 47);
+            var processor = new CpuLensProcessor();
+
+            foreach (var lenses in CreateRuns())
+            {
+                var unfused = RenderSaturated(processor, lenses, source);
+
+                var fused = new CpuImage(source.Width, source.Height);
+                var lens = new FusedPointwiseLens(lenses);
+                processor.Render(lens, source, fused);
+
+                int passesSaved = lenses.Length - 1;
+                TestContext.Progress.WriteLine("{0} lenses fused, {1} passes saved", lenses.Length, passesSaved);
+                AssertClose(unfused, fused);
+            }
+        }
+
+        /// <summary>
+        /// The parameters of the fused lenses are read on every render, so they can be animated.
+        /// </summary>
+        [Test]
+        public void FusedLensReadsParametersOnEveryRender()
+        {
+            var source = CpuLensProcessorTests.CreateRandomImage(16, 16, 48);
+            var processor = new CpuLensProcessor();
+            var vignette = new VignetteLens() { Power = 0.2f, Radio = 1 };
+            var scanlines = new ScanlinesLens() { LinesFactor = 100, Attenuation = 0.02f };
+            var lens = ImageEffects.FusedPointwise(vignette, scanlines);
+
+            var fused = new CpuImage(source.Width, source.Height);
+            processor.Render(lens, source, fused);
+
+            vignette.Power = 1.5f;
+            scanlines.Attenuation = 0.1f;
+            processor.Render(lens, source, fused);
+
+            AssertClose(RenderSaturated(processor, new Lens[] { vignette, scanlines }, source), fused);
+        }
+
+        /// <summary>
+        /// Neutral stages leave the colors unchanged, and the stages of a lens only change what its shader does.
+        /// </summary>
+        [Test]
+        public void StagesWithoutLensesKeepColors()
+        {
+            var source = CpuLensProcessorTests.CreateRandomImage(16, 16, 49);
+            var destination = new CpuImage(source.Width, source.Height);
+
+            new CpuLensProcessor().Render(new FusedPointwiseLens(), source, destination);
+
+            CollectionAssert.AreEqual(source.Pixels, destination.Pixels);
+        }
+
+        /// <summary>
+        /// A fused lens only accepts the lenses that fit in a single pass.
+        /// </summary>
+        [Test]
+        public void FusedLensRejectsRunsThatDoNotFit()
+        {
+            Assert.Throws<ArgumentException>(() => new FusedPointwiseLens(new Lens[] { new InvertLens(), new GaussianBlurLens() }));
+            Assert.Throws<ArgumentException>(() => new FusedPointwiseLens(new Lens[] { new ColorCorrectionLens(), new InvertLens() }));
+
+            var tooMany = new List<Lens>();
+            for (int i = 0; i <= FusedPointwiseStages.MaxStages; i++)
+            {
+                tooMany.Add(new InvertLens());
+            }
+
+            Assert.Throws<ArgumentException>(() => new FusedPointwiseLens(tooMany));
+            Assert.AreEqual(FusedPointwiseStages.MaxStages, FusedPointwiseStages.GetRunLength(tooMany, 0));
+        }
+
+        /// <summary>
+        /// Creates runs of lenses that fit in the fused shader, with parameters that saturate some of the passes
+        /// </summary>
+        /// <returns>The runs</returns>
+        private static Lens[][] CreateRuns()
+        {
+            return new Lens[][]
+            {
+                new Lens[]
+                {
+                    new PosterizeLens() { Gamma = 0.8f, Regions = 4 },
+                    new SepiaLens()
+                    {
+                        ImageTone = new Vector3(1, 0.9f, 0.5f),
+                        DarkTone = new Vector3(0.2f, 0.05f, 0),
+                        GreyTransfer = new Vector3(0.3f, 0.59f, 0.11f),
+                        Desaturation = 0.5f,
+                        Toning = 0.7f,
+                        GlobalAlpha = 0.8f,
+                    },
+                    new VignetteLens() { Power = 0.8f, Radio = 1.5f },
+                    new ScanlinesLens() { LinesFactor = 400, Attenuation = 0.2f },
+                },
+                new Lens[]
+                {
+                    new InvertLens(),
+                    new GrayScaleLens(),
+                    new ColorCorrectionLens() { ColorSpace = ColorCorrectionMaterial.ColorSpaceType.Linear },
+                },
+                new Lens[]
+                {
+                    new ScanlinesLens() { LinesFactor = 250, Attenuation = 0.3f },
+                    new InvertLens(),
+                    new ColorCorrectionLens(),
+                },
+            };
+        }
+
+        /// <summary>
+        /// Renders lenses one by one, saturating the output of each one
+        /// </summary>
+        /// <param name="processor">The processor.</param>
+        /// <param name="lenses">The lenses.</param>
+        /// <param name="source">The source image.</param>
+        /// <returns>The output image</returns>
+        private static CpuImage RenderSaturated(CpuLensProcessor processor, IList<Lens> lenses, CpuImage source)
+        {
+            var image = source;
+            foreach (var lens in lenses)
+            {
+                var output = new CpuImage(source.Width, source.Height);
+                processor.Render(new[] { lens }, image, output);
+                for (int i = 0; i < output.Pixels.Length; i++)
+                {
+                    output.Pixels[i] = MathHelper.Clamp(output.Pixels[i], 0, 1);
+                }
+
+                image = output;
+            }
+
+            return image;
+        }
+
+        /// <summary>
+        /// Checks that two images have the same pixels, up to the rounding of the float operations
+        /// </summary>
+        /// <param name="expected">The expected image.</param>
+        /// <param name="actual">The actual image.</param>
+        private static void AssertClose(CpuImage expected, CpuImage actual)
+        {
+            for (int i = 0; i < expected.Pixels.Length; i++)
+            {
+                Assert.AreEqual(expected.Pixels[i], actual.Pixels[i], 1e-5, "Component {0}", i);
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+
+namespace WaveEngine.ImageEffects.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="GaussianKernel"/>
+    /// </summary>
+    [TestFixture]
+    public class GaussianKernelTests
+    {
+        /// <summary>
+        /// The standard deviations tested
+        /// </summary>
+        private static readonly float[] Sigmas = { 0.3f, 0.5f, 1, 1.5f, 2.5f, 4, 7, 16 };
+
+        /// <summary>
+        /// The weights are normalized and the taps fit in the shader.
+        /// </summary>
+        [Test]
+        public void WeightsSumToOne()
+        {
+            foreach (int maxTaps in new[] { 1, 5, GaussianBlurMaterial.MaxTaps })
+            {
+                foreach (var sigma in Sigmas)
+                {
+                    var kernel = GaussianKernel.Create(sigma, maxTaps);
+
+                    float sum = 0;
+                    for (int i = 0; i < kernel.TapCount; i++)
+                    {
+                        Assert.Greater(kernel.Weights[i], 0);
+                        sum += kernel.Weights[i];
+                    }
+
+                    Assert.AreEqual(1, sum, 1e-5);
+                    Assert.LessOrEqual(kernel.TapCount, maxTaps);
+                    Assert.AreEqual(kernel.Offsets.Length, kernel.Weights.Length);
+                }
+            }
+        }
+
+        /// <summary>
+        /// The center tap is followed by pairs of opposite offsets with the same weight, further away on each pair.
+        /// </summary>
+        [Test]
+        public void OffsetsAreSymmetric()
+        {
+            foreach (var sigma in Sigmas)
+            {
+                var kernel = GaussianKernel.Create(sigma, GaussianBlurMaterial.MaxTaps);
+
+                Assert.AreEqual(1, kernel.TapCount % 2);
+                Assert.AreEqual(0, kernel.Offsets[0]);
+
+                float previous = 0;
+                for (int i = 1; i < kernel.TapCount; i += 2)
+                {
+                    Assert.AreEqual(-kernel.Offsets[i], kernel.Offsets[i + 1]);
+                    Assert.AreEqual(kernel.Weights[i], kernel.Weights[i + 1]);
+                    Assert.Greater(kernel.Offsets[i], previous);
+                    Assert.LessOrEqual(kernel.Offsets[i], kernel.Radius);
+                    previous = kernel.Offsets[i];
+                }
+            }
+        }
+
+        /// <summary>
+        /// When the discrete kernel fits in the taps, the linear sampling taps give the same image as one tap per texel.
+        /// </summary>
+        [Test]
+        public void LinearTapsMatchDiscreteKernel()
+        {
+            var source = CpuLensProcessorTests.CreateRandomImage(48, 32, 7);
+            var linear = new CpuImage(source.Width, source.Height);
+            var discrete = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+
+            foreach (var sigma in new[] { 0.5f, 1, 2.5f, 4 })
+            {
+                Assert.AreEqual(1, GaussianKernel.Create(sigma, GaussianBlurMaterial.MaxTaps).Step);
+
+                processor.Render(new GaussianBlurLens() { Factor = 1, Sigma = sigma }, source, linear);
+                processor.RenderDiscreteGaussian(sigma, source, discrete);
+
+                for (int i = 0; i < linear.Pixels.Length; i++)
+                {
+                    Assert.AreEqual(discrete.Pixels[i], linear.Pixels[i], 1e-4);
+                }
+            }
+        }
+
+        /// <summary>
+        /// A kernel stretched to fit the taps stays close to the discrete kernel of the same standard deviation
+        /// on an image without texel sized detail, which the gaps between its taps would alias.
+        /// </summary>
+        [Test]
+        public void StretchedKernelApproximatesDiscreteKernel()
+        {
+            var noise = CpuLensProcessorTests.CreateRandomImage(96, 64, 11);
+            var source = new CpuImage(noise.Width, noise.Height);
+            var linear = new CpuImage(source.Width, source.Height);
+            var discrete = new CpuImage(source.Width, source.Height);
+            var processor = new CpuLensProcessor();
+            processor.RenderDiscreteGaussian(2, noise, source);
+
+            foreach (var sigma in new[] { 7f, 16f })
+            {
+                Assert.Greater(GaussianKernel.Create(sigma, GaussianBlurMaterial.MaxTaps).Step, 1);
+
+                processor.Render(new GaussianBlurLens() { Factor = 1, Sigma = sigma }, source, linear);
+                processor.RenderDiscreteGaussian(sigma, source, discrete);
+
+                int maxError;
+                double psnr = linear.Compare(discrete, out maxError);
+                Assert.Greater(psnr, 45);
+                Assert.LessOrEqual(maxError, 6);
+            }
+        }
+
+        /// <summary>
+        /// Invalid standard deviations and tap counts are rejected.
+        /// </summary>
+        [Test]
+        public void InvalidArgumentsThrow()
+        {
+            Assert.Throws<ArgumentOutOfRangeException>(() => GaussianKernel.Create(0, GaussianBlurMaterial.MaxTaps));
+            Assert.Throws<ArgumentOutOfRangeException>(() => GaussianKernel.Create(-1, GaussianBlurMaterial.MaxTaps));
+            Assert.Throws<ArgumentOutOfRangeException>(() => GaussianKernel.Create(1, 0));
+        }
+    }
+}
@@ -0,0 +1,192 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.IO;
+using NUnit.Framework;
+
+namespace WaveEngine.ImageEffects.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="LensProfiler"/>, with a clock that counts milliseconds
+    /// </summary>
+    [TestFixture]
+    public class LensProfilerTests
+    {
+        /// <summary>
+        /// The current time of the clock, in milliseconds
+        /// </summary>
+        private long now;
+
+        /// <summary>
+        /// The profiler
+        /// </summary>
+        private LensProfiler profiler;
+
+        /// <summary>
+        /// Creates a profiler that keeps 3 frames.
+        /// </summary>
+        [SetUp]
+        public void SetUp()
+        {
+            this.now = 0;
+            this.profiler = new LensProfiler(3, () => this.now, 1000);
+        }
+
+        /// <summary>
+        /// Passes reported outside a frame are not recorded.
+        /// </summary>
+        [Test]
+        public void PassesOutsideFrameAreIgnored()
+        {
+            for (int i = 0; i < 100; i++)
+            {
+                this.profiler.Begin("BloomLens", "Bloom");
+                this.profiler.End();
+            }
+
+            this.profiler.EndFrame();
+
+            Assert.AreEqual(0, this.profiler.FrameCount);
+        }
+
+        /// <summary>
+        /// The samples are relative to the start of the frame, and the frame to the creation of the profiler.
+        /// </summary>
+        [Test]
+        public void RecordsPassTimes()
+        {
+            this.now = 10;
+            this.profiler.BeginFrame();
+            this.now = 12;
+            this.profiler.Begin("BloomLens", "Down sampler");
+            this.now = 15;
+            this.profiler.End();
+            this.profiler.Begin("BloomLens", "Bloom");
+            this.now = 19;
+            this.profiler.End();
+            this.profiler.EndFrame();
+
+            Assert.AreEqual(1, this.profiler.FrameCount);
+            var frame = this.profiler.GetFrame(0);
+            Assert.AreEqual(10, frame.StartMilliseconds, 1e-9);
+            Assert.AreEqual(7, frame.TotalMilliseconds, 1e-9);
+            Assert.AreEqual(2, frame.Samples.Count);
+            Assert.AreEqual("Down sampler", frame.Samples[0].Pass);
+            Assert.AreEqual(2, frame.Samples[0].StartMilliseconds, 1e-9);
+            Assert.AreEqual(3, frame.Samples[0].DurationMilliseconds, 1e-9);
+            Assert.AreEqual(5, frame.Samples[1].StartMilliseconds, 1e-9);
+            Assert.AreEqual(4, frame.Samples[1].DurationMilliseconds, 1e-9);
+        }
+
+        /// <summary>
+        /// A nested pass does not end the outer one, and it is not counted twice in the frame time.
+        /// </summary>
+        [Test]
+        public void NestedPassesKeepOuterPass()
+        {
+            this.profiler.BeginFrame();
+            this.profiler.Begin("BloomLens", "Render");
+            this.now = 1;
+            this.profiler.Begin("BloomLens", "Pyramid");
+            this.now = 3;
+            this.profiler.End();
+            this.now = 6;
+            this.profiler.End();
+            this.profiler.EndFrame();
+
+            var frame = this.profiler.GetFrame(0);
+            Assert.AreEqual(2, frame.Samples.Count);
+            Assert.AreEqual("Pyramid", frame.Samples[0].Pass);
+            Assert.AreEqual(1, frame.Samples[0].Depth);
+            Assert.AreEqual(2, frame.Samples[0].DurationMilliseconds, 1e-9);
+            Assert.AreEqual("Render", frame.Samples[1].Pass);
+            Assert.AreEqual(0, frame.Samples[1].Depth);
+            Assert.AreEqual(6, frame.Samples[1].DurationMilliseconds, 1e-9);
+            Assert.AreEqual(6, frame.TotalMilliseconds, 1e-9);
+        }
+
+        /// <summary>
+        /// Starting a frame stores the previous one and closes its open passes.
+        /// </summary>
+        [Test]
+        public void BeginFrameStoresPreviousFrame()
+        {
+            this.profiler.BeginFrame();
+            this.profiler.Begin("SSAOLens", "AO");
+            this.now = 4;
+            this.profiler.BeginFrame();
+
+            Assert.AreEqual(1, this.profiler.FrameCount);
+            Assert.AreEqual(4, this.profiler.GetFrame(0).Samples[0].DurationMilliseconds, 1e-9);
+
+            // The pass closed by the new frame is not recorded again
+            this.profiler.End();
+            this.profiler.EndFrame();
+            Assert.AreEqual(1, this.profiler.FrameCount);
+        }
+
+        /// <summary>
+        /// The ring buffer keeps the last frames with samples.
+        /// </summary>
+        [Test]
+        public void RingBufferKeepsLastFrames()
+        {
+            for (int i = 0; i < 10; i++)
+            {
+                this.profiler.BeginFrame();
+                if (i % 2 == 0)
+                {
+                    this.profiler.Begin("FogLens", "Render");
+                    this.now += i;
+                    this.profiler.End();
+                }
+            }
+
+            this.profiler.EndFrame();
+
+            Assert.AreEqual(3, this.profiler.FrameCount);
+            Assert.AreEqual(4, this.profiler.GetFrame(0).FrameNumber);
+            Assert.AreEqual(8, this.profiler.GetFrame(0).TotalMilliseconds, 1e-9);
+            Assert.AreEqual(2, this.profiler.GetFrame(2).FrameNumber);
+            Assert.AreEqual(4, this.profiler.GetFrame(2).TotalMilliseconds, 1e-9);
+            Assert.Throws<ArgumentOutOfRangeException>(() => this.profiler.GetFrame(3));
+
+            this.profiler.Clear();
+            Assert.AreEqual(0, this.profiler.FrameCount);
+        }
+
+        /// <summary>
+        /// The overlay and the Chrome trace show the recorded passes.
+        /// </summary>
+        [Test]
+        public void ExportsRecordedPasses()
+        {
+            this.now = 1;
+            this.profiler.BeginFrame();
+            this.now = 2;
+            this.profiler.Begin("BloomLens", "Up\"Combine\"");
+            this.now = 5;
+            this.profiler.End();
+            this.profiler.EndFrame();
+
+            StringAssert.Contains("BloomLens.Up\"Combine\": 3.000 ms avg, 3.000 ms max", this.profiler.GetOverlayText());
+
+            var writer = new StringWriter();
+            this.profiler.ExportChromeTrace(writer);
+            Assert.AreEqual(
+                "{\"traceEvents\":[{\"name\":\"Up\\\"Combine\\\"\",\"cat\":\"BloomLens\",\"ph\":\"X\",\"ts\":2000,\"dur\":3000,\"pid\":1,\"tid\":1,\"args\":{\"frame\":0}}]}",
+                writer.ToString());
+        }
+
+        /// <summary>
+        /// Invalid capacities, clocks and frequencies are rejected.
+        /// </summary>
+        [Test]
+        public void InvalidArgumentsThrow()
+        {
+            Assert.Throws<ArgumentOutOfRangeException>(() => new LensProfiler(0, () => 0, 1000));
+            Assert.Throws<ArgumentNullException>(() => new LensProfiler(1, null, 1000));
+            Assert.Throws<ArgumentOutOfRangeException>(() => new LensProfiler(1, () => 0, 0));
+        }
+    }
+}
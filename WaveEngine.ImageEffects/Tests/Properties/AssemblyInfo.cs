@@ -0,0 +1,10 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+[assembly: AssemblyTitle("WaveEngine.ImageEffects.Tests")]
+[assembly: AssemblyCompany("Wave Engine")]
+[assembly: AssemblyCopyright("Copyright (c) Wave Engine 2018")]
+[assembly: ComVisible(false)]
+[assembly: AssemblyVersion("2.5.0.0000")]
@@ -0,0 +1,129 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+using WaveEngine.Common.Graphics;
+
+namespace WaveEngine.ImageEffects.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="TransientTargetPlanner"/>
+    /// </summary>
+    [TestFixture]
+    public class TransientTargetPlannerTests
+    {
+        /// <summary>
+        /// Targets of the same size whose lifetimes do not overlap share a slot.
+        /// </summary>
+        [Test]
+        public void SequentialTargetsShareSlot()
+        {
+            var planner = new TransientTargetPlanner();
+            int first = planner.Add(320, 180, 0, 1);
+            int second = planner.Add(320, 180, 2, 3);
+            planner.Plan();
+
+            Assert.AreEqual(1, planner.SlotCount);
+            Assert.AreEqual(planner.GetSlot(first), planner.GetSlot(second));
+            Assert.AreEqual(2L * 320 * 180, planner.RequestedPixels);
+            Assert.AreEqual(320L * 180, planner.PlannedPixels);
+        }
+
+        /// <summary>
+        /// Targets alive in the same pass, or with different sizes, get their own slots.
+        /// </summary>
+        [Test]
+        public void OverlappingOrDifferentTargetsDoNotShare()
+        {
+            var planner = new TransientTargetPlanner();
+            int first = planner.Add(320, 180, 0, 1);
+            int overlapping = planner.Add(320, 180, 1, 2);
+            int smaller = planner.Add(160, 90, 3, 4);
+            planner.Plan();
+
+            Assert.AreEqual(3, planner.SlotCount);
+            Assert.AreNotEqual(planner.GetSlot(first), planner.GetSlot(overlapping));
+
+            int width, height;
+            planner.GetSlotSize(planner.GetSlot(smaller), out width, out height);
+            Assert.AreEqual(160, width);
+            Assert.AreEqual(90, height);
+        }
+
+        /// <summary>
+        /// Targets of different pixel formats get their own slots, and the slots keep the format of their targets.
+        /// </summary>
+        [Test]
+        public void TargetsOfDifferentFormatsDoNotShare()
+        {
+            var planner = new TransientTargetPlanner();
+            int color = planner.Add(320, 180, 0, 0);
+            int occlusion = planner.Add(320, 180, 1, 1, PixelFormat.R8);
+            int nextColor = planner.Add(320, 180, 2, 2, PixelFormat.R8G8B8A8);
+            planner.Plan();
+
+            Assert.AreEqual(2, planner.SlotCount);
+            Assert.AreNotEqual(planner.GetSlot(color), planner.GetSlot(occlusion));
+            Assert.AreEqual(planner.GetSlot(color), planner.GetSlot(nextColor));
+            Assert.AreEqual(PixelFormat.R8G8B8A8, planner.GetSlotFormat(planner.GetSlot(color)));
+            Assert.AreEqual(PixelFormat.R8, planner.GetSlotFormat(planner.GetSlot(occlusion)));
+        }
+
+        /// <summary>
+        /// The two quarter size targets of two bloom-like lenses in a chain are planned in two slots instead of four.
+        /// </summary>
+        [Test]
+        public void ChainOfLensesReusesTargets()
+        {
+            var planner = new TransientTargetPlanner();
+            var requests = new[] { new TransientTargetRequest(4, 0, 1), new TransientTargetRequest(4, 1, 2) };
+
+            // The pool numbers the passes of the chain consecutively
+            int passOffset = 0;
+            for (int lens = 0; lens < 2; lens++)
+            {
+                foreach (var request in requests)
+                {
+                    planner.Add(request.GetSize(1280), request.GetSize(720), passOffset + request.FirstPass, passOffset + request.LastPass);
+                }
+
+                passOffset += 3;
+            }
+
+            planner.Plan();
+
+            Assert.AreEqual(4, planner.TargetCount);
+            Assert.AreEqual(2, planner.SlotCount);
+            Assert.AreEqual(2L * 320 * 180, planner.PlannedPixels);
+        }
+
+        /// <summary>
+        /// Slots can not be read before planning, and invalid targets are rejected.
+        /// </summary>
+        [Test]
+        public void InvalidUseThrows()
+        {
+            var planner = new TransientTargetPlanner();
+            int target = planner.Add(16, 16, 0, 0);
+
+            Assert.Throws<InvalidOperationException>(() => planner.GetSlot(target));
+            Assert.Throws<ArgumentOutOfRangeException>(() => planner.Add(0, 16, 0, 0));
+            Assert.Throws<ArgumentOutOfRangeException>(() => planner.Add(16, 16, 2, 1));
+            Assert.Throws<ArgumentOutOfRangeException>(() => new TransientTargetRequest(0, 0, 0));
+        }
+
+        /// <summary>
+        /// Request sizes are divided from the source size and never reach zero.
+        /// </summary>
+        [Test]
+        public void RequestSizeIsAtLeastOne()
+        {
+            var request = new TransientTargetRequest(4, 0, 0);
+
+            Assert.AreEqual(320, request.GetSize(1280));
+            Assert.AreEqual(1, request.GetSize(2));
+            Assert.AreEqual(PixelFormat.R8G8B8A8, request.Format);
+            Assert.AreEqual(PixelFormat.R8, new TransientTargetRequest(4, 0, 0, PixelFormat.R8).Format);
+        }
+    }
+}
@@ -10,6 +10,7 @@ using System.Linq;
 using System.Runtime.Serialization;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Helpers;
+using WaveEngine.Common.Math;
 using WaveEngine.Framework;
 using WaveEngine.Framework.Services;
 #endregion
@@ -20,7 +21,7 @@ namespace WaveEngine.Spine
     /// Behavior to control skeletal 2D animations
     /// </summary>
     [DataContract(Namespace = "WaveEngine.Spine")]
-    public class SkeletalAnimation : Behavior
+    public class SkeletalAnimation : Behavior, IDisposable
     {
         /// <summary>
         /// Event raised when an animation raise a Spine event.
@@ -32,6 +33,11 @@ namespace WaveEngine.Spine
         /// </summary>
         public event AnimationState.StartEndDelegate EndAnimation;
 
+        /// <summary>
+        /// The animation system that updates this animation, or null if it updates by itself
+        /// </summary>
+        internal SkeletalAnimationSystem AnimationSystem;
+
         /// <summary>
         /// The skeletal data
         /// </summary>
@@ -60,6 +66,111 @@ namespace WaveEngine.Spine
         /// </summary>
         private string currentAnimation;
 
+        /// <summary>
+        /// The skeleton data, shared with other instances that load the same file
+        /// </summary>
+        private SkeletonData skeletonData;
+
+        /// <summary>
+        /// Whether the Spine events are queued instead of raised
+        /// </summary>
+        private bool deferEvents;
+
+        /// <summary>
+        /// The Spine events queued while the pose was updated out of the main thread
+        /// </summary>
+        private List<PendingEvent> pendingEvents = new List<PendingEvent>();
+
+        /// <summary>
+        /// Scratch list for the events fired by the event timelines when the animation state is not applied
+        /// </summary>
+        private ExposedList<Event> firedEvents = new ExposedList<Event>();
+
+        /// <summary>
+        /// Whether the skeleton has been drawn by any camera since the last update
+        /// </summary>
+        private bool lodVisible;
+
+        /// <summary>
+        /// The largest fraction of the screen covered by the skeleton since the last update
+        /// </summary>
+        private float lodScreenRatio;
+
+        /// <summary>
+        /// Number of updates since the world transform of the skeleton was last updated
+        /// </summary>
+        private int lodSkippedUpdates;
+
+        /// <summary>
+        /// Whether the world transform must be updated in the next update, regardless of the LOD
+        /// </summary>
+        private bool poseInvalidated;
+
+        /// <summary>
+        /// Whether the world transform was skipped because the skeleton was not visible
+        /// </summary>
+        private bool poseStale;
+
+        /// <summary>
+        /// Whether the cached LOD bounds are valid
+        /// </summary>
+        private bool lodBoundsValid;
+
+        /// <summary>
+        /// The animation of the cached LOD bounds
+        /// </summary>
+        private Animation lodBoundsAnimation;
+
+        /// <summary>
+        /// The cached LOD bounds
+        /// </summary>
+        private BoundingBox lodBounds;
+
+        /// <summary>
+        /// The names of the animations played from baked tables
+        /// </summary>
+        private List<string> bakedAnimationNames = new List<string>();
+
+        /// <summary>
+        /// The baked tables of the current skeleton data and skin
+        /// </summary>
+        private Dictionary<Animation, SpineBakedAnimation> bakedAnimations = new Dictionary<Animation, SpineBakedAnimation>();
+
+        /// <summary>
+        /// The baked animation of the current pose, or null if the pose is in the skeleton
+        /// </summary>
+        private SpineBakedAnimation currentBakedAnimation;
+
+        /// <summary>
+        /// The baked frame of the current pose
+        /// </summary>
+        private int currentBakedFrame;
+
+        /// <summary>
+        /// The skeleton position of the current baked pose, with the Y axis flipped as in the renderer
+        /// </summary>
+        private Vector2 currentBakedPosition;
+
+        /// <summary>
+        /// The skeleton flips of the current baked pose, as a scale of -1 or 1 on each axis
+        /// </summary>
+        private Vector2 currentBakedScale;
+
+        /// <summary>
+        /// The number of frames per second of the baked animations
+        /// </summary>
+        private float bakeSampleRate;
+
+        /// <summary>
+        /// The last entry of track 0 seen by <see cref="GetPlayingBakedAnimation"/>
+        /// </summary>
+        private TrackEntry bakedMixEntry;
+
+        /// <summary>
+        /// The duration of the crossfade into <see cref="bakedMixEntry"/>
+        /// </summary>
+        private float bakedMixDuration;
+
         #region Properties
 
         /// <summary>
@@ -249,6 +360,116 @@ namespace WaveEngine.Spine
         [DataMember]
         public bool Loop { get; set; }
 
+        /// <summary>
+        /// Gets or sets a value indicating whether the animation level of detail is enabled.
+        /// </summary>
+        /// <remarks>
+        /// When it is enabled, skeletons that are not drawn by any camera keep advancing their animations, so events and loops
+        /// stay correct, but their timelines are not applied and their bones are not transformed. Skeletons that cover a small fraction
+        /// of the screen apply their timelines and transform their bones every 2nd or 4th update, and are drawn with the pose of that update
+        /// in between, without interpolating it. It requires a <see cref="SkeletalRenderer"/>, which reports the visibility of the skeleton.
+        /// </remarks>
+        [DataMember]
+        public bool EnableLOD { get; set; }
+
+        /// <summary>
+        /// Gets or sets the fraction of the screen below which the bones are transformed every 2nd update.
+        /// </summary>
+        [DataMember]
+        public float HalfRateScreenRatio { get; set; }
+
+        /// <summary>
+        /// Gets or sets the fraction of the screen below which the bones are transformed every 4th update.
+        /// </summary>
+        [DataMember]
+        public float QuarterRateScreenRatio { get; set; }
+
+        /// <summary>
+        /// Gets a counter that changes each time the world transform of the skeleton is updated
+        /// </summary>
+        internal int PoseVersion { get; private set; }
+
+        /// <summary>
+        /// Gets or sets the number of frames per second of the baked animations.
+        /// Changing it bakes again the animations of <see cref="BakeAnimation"/>.
+        /// </summary>
+        [DataMember]
+        public float BakeSampleRate
+        {
+            get
+            {
+                return this.bakeSampleRate;
+            }
+
+            set
+            {
+                if (value <= 0)
+                {
+                    throw new ArgumentOutOfRangeException("value", "Bake sample rate must be greater than 0");
+                }
+
+                if (this.bakeSampleRate != value)
+                {
+                    this.bakeSampleRate = value;
+                    this.RefreshBakedAnimations();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the time, in seconds, added to the baked animations of this instance, so a crowd does not move in unison.
+        /// </summary>
+        [DataMember]
+        public float BakedTimeOffset { get; set; }
+
+        /// <summary>
+        /// Gets a value indicating whether the current pose comes from a baked animation.
+        /// </summary>
+        [DontRenderProperty]
+        public bool IsPlayingBaked
+        {
+            get { return this.currentBakedAnimation != null; }
+        }
+
+        /// <summary>
+        /// Gets the approximate memory, in bytes, of the baked animations of this instance. They are shared with the other instances
+        /// of the same skeleton data.
+        /// </summary>
+        [DontRenderProperty]
+        public long BakedMemorySize
+        {
+            get
+            {
+                long size = 0;
+                foreach (var bakedAnimation in this.bakedAnimations.Values)
+                {
+                    size += bakedAnimation.MemorySize;
+                }
+
+                return size;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of bone world transforms that the last update did not compute because the pose came from a baked animation.
+        /// </summary>
+        [DontRenderProperty]
+        public int SavedBoneTransforms { get; private set; }
+
+        /// <summary>
+        /// Gets the number of attachment vertices that the last update read from a baked animation instead of computing them.
+        /// </summary>
+        [DontRenderProperty]
+        public int SavedVertexTransforms { get; private set; }
+
+        /// <summary>
+        /// Gets the approximate memory, in bytes, of all the baked animations.
+        /// </summary>
+        public static long TotalBakedMemorySize
+        {
+            get { return SpineResourceCache.BakedAnimationsMemorySize; }
+        }
+
         /// <summary>
         /// A new atlas has been loaded
         /// </summary>
@@ -284,6 +505,11 @@ namespace WaveEngine.Spine
             this.Speed = 1;
             this.PlayAutomatically = false;
             this.Loop = false;
+            this.EnableLOD = false;
+            this.HalfRateScreenRatio = 0.15f;
+            this.QuarterRateScreenRatio = 0.05f;
+            this.bakeSampleRate = 30;
+            this.BakedTimeOffset = 0;
         }
         #endregion
 
@@ -352,6 +578,206 @@ namespace WaveEngine.Spine
             }
         }
 
+        /// <summary>
+        /// Plays an animation from precomputed world-space vertex tables, sampled at <see cref="BakeSampleRate"/>.
+        /// </summary>
+        /// <remarks>
+        /// A baked animation is used while it is the only animation playing, in track 0, and it is not crossfading from
+        /// the previous animation. The bones of the skeleton are not updated meanwhile, so it is meant for background crowds,
+        /// but the Spine events of its timelines are still raised.
+        /// </remarks>
+        /// <param name="animationName">The name of the animation.</param>
+        public void BakeAnimation(string animationName)
+        {
+            if (string.IsNullOrEmpty(animationName))
+            {
+                throw new ArgumentNullException("animationName");
+            }
+
+            if (!this.bakedAnimationNames.Contains(animationName))
+            {
+                this.bakedAnimationNames.Add(animationName);
+                this.RefreshBakedAnimations();
+            }
+        }
+
+        /// <summary>
+        /// Stops playing animations from baked tables.
+        /// </summary>
+        public void ClearBakedAnimations()
+        {
+            this.bakedAnimationNames.Clear();
+            this.RefreshBakedAnimations();
+        }
+
+        /// <summary>
+        /// Releases the shared skeleton data. It is also released when the component is removed from its entity.
+        /// </summary>
+        public void Dispose()
+        {
+            if (this.skeletonData != null)
+            {
+                SpineResourceCache.ReleaseSkeletonData(this.skeletonData);
+                this.skeletonData = null;
+            }
+        }
+
+        #endregion
+
+        #region Internal Methods
+
+        /// <summary>
+        /// Updates the animation state and the skeleton pose.
+        /// </summary>
+        /// <param name="gameTime">The game time.</param>
+        /// <param name="deferEvents">Whether the Spine events are queued until <see cref="DispatchPendingEvents"/> is called.</param>
+        internal void UpdatePose(TimeSpan gameTime, bool deferEvents)
+        {
+            if (this.state != null)
+            {
+                this.deferEvents = deferEvents;
+                this.state.Update((float)gameTime.TotalSeconds * this.Speed);
+                this.SavedBoneTransforms = 0;
+                this.SavedVertexTransforms = 0;
+
+                TrackEntry entry;
+                var bakedAnimation = this.GetPlayingBakedAnimation(out entry);
+                bool updateWorldTransform = this.ShouldUpdateWorldTransform();
+
+                // The timelines of a pose that is not transformed, or that comes from baked tables, would be applied for nothing,
+                // only their events are needed
+                if (bakedAnimation == null && updateWorldTransform)
+                {
+                    this.state.Apply(this.Skeleton);
+                }
+                else
+                {
+                    this.ApplyEvents();
+                }
+
+                if (updateWorldTransform)
+                {
+                    this.UpdateWorldPose(bakedAnimation, entry);
+                }
+
+                this.deferEvents = false;
+            }
+        }
+
+        /// <summary>
+        /// Updates the world transform skipped while the skeleton was not visible, so it is not drawn with an old pose.
+        /// It is called by the renderer when the skeleton passes the visibility test.
+        /// </summary>
+        internal void RefreshStalePose()
+        {
+            if (!this.poseStale || this.state == null)
+            {
+                return;
+            }
+
+            this.poseStale = false;
+            this.lodSkippedUpdates = 0;
+
+            TrackEntry entry;
+            var bakedAnimation = this.GetPlayingBakedAnimation(out entry);
+
+            // The events up to the current time have already been fired, so applying the timelines only poses the bones
+            if (bakedAnimation == null)
+            {
+                this.state.Apply(this.Skeleton);
+            }
+
+            this.UpdateWorldPose(bakedAnimation, entry);
+        }
+
+        /// <summary>
+        /// Gets the baked frame of the current pose.
+        /// </summary>
+        /// <param name="bakedAnimation">The baked animation.</param>
+        /// <param name="frame">The index of the frame.</param>
+        /// <param name="position">The skeleton position added to the baked vertices.</param>
+        /// <param name="scale">The skeleton flips applied to the baked vertices, as a scale of -1 or 1 on each axis.</param>
+        /// <returns>True if the current pose comes from a baked animation, false in other case</returns>
+        internal bool GetBakedFrame(out SpineBakedAnimation bakedAnimation, out int frame, out Vector2 position, out Vector2 scale)
+        {
+            bakedAnimation = this.currentBakedAnimation;
+            frame = this.currentBakedFrame;
+            position = this.currentBakedPosition;
+            scale = this.currentBakedScale;
+            return bakedAnimation != null;
+        }
+
+        /// <summary>
+        /// Reports that the skeleton has been tested against a camera. It is called by the renderer for each camera.
+        /// </summary>
+        /// <param name="visible">Whether the skeleton is inside the camera.</param>
+        /// <param name="screenRatio">The fraction of the screen covered by the skeleton.</param>
+        internal void ReportVisibility(bool visible, float screenRatio)
+        {
+            this.lodVisible |= visible;
+            this.lodScreenRatio = Math.Max(this.lodScreenRatio, screenRatio);
+        }
+
+        /// <summary>
+        /// Gets the bounds, in entity space, that contain every pose of the current animation.
+        /// The shared bounds are computed at the skeleton origin, so the position and flips of the skeleton are applied to them.
+        /// </summary>
+        /// <returns>The LOD bounds</returns>
+        internal BoundingBox GetLODBounds()
+        {
+            var entry = this.state != null ? this.state.GetCurrent(0) : null;
+            var animation = entry != null ? entry.Animation : null;
+
+            if (!this.lodBoundsValid || this.lodBoundsAnimation != animation)
+            {
+                var skinName = this.Skeleton.Skin != null ? this.Skeleton.Skin.Name : null;
+                this.lodBounds = SpineResourceCache.GetAnimationBounds(this.skeletonData, skinName, animation);
+                this.lodBoundsAnimation = animation;
+                this.lodBoundsValid = true;
+            }
+
+            var min = this.lodBounds.Min;
+            var max = this.lodBounds.Max;
+
+            if (this.Skeleton.FlipX)
+            {
+                float minX = min.X;
+                min.X = -max.X;
+                max.X = -minX;
+            }
+
+            if (this.Skeleton.FlipY)
+            {
+                float minY = min.Y;
+                min.Y = -max.Y;
+                max.Y = -minY;
+            }
+
+            // The Y axis is flipped as in the renderer
+            var position = new Vector3(this.Skeleton.X, -this.Skeleton.Y, 0);
+            return new BoundingBox(min + position, max + position);
+        }
+
+        /// <summary>
+        /// Raises the Spine events queued by the last deferred update, in the order they happened.
+        /// </summary>
+        internal void DispatchPendingEvents()
+        {
+            for (int i = 0; i < this.pendingEvents.Count; i++)
+            {
+                var pendingEvent = this.pendingEvents[i];
+                if (pendingEvent.Event != null)
+                {
+                    this.OnEventAnimation(pendingEvent.State, pendingEvent.TrackIndex, pendingEvent.Event);
+                }
+                else
+                {
+                    this.OnEndAnimation(pendingEvent.State, pendingEvent.TrackIndex);
+                }
+            }
+
+            this.pendingEvents.Clear();
+        }
         #endregion
 
         #region Private Methods
@@ -365,6 +791,12 @@ namespace WaveEngine.Spine
 
             this.SkeletalData.OnAtlasRefresh -= this.OnAtlasRefresh;
             this.SkeletalData.OnAtlasRefresh += this.OnAtlasRefresh;
+
+            // A component added again after being removed loads the skeleton data it released
+            if (this.isInitialized && this.skeletonData == null)
+            {
+                this.RefreshAnimation();
+            }
         }
 
         /// <summary>
@@ -374,6 +806,15 @@ namespace WaveEngine.Spine
         {
             this.SkeletalData.OnAtlasRefresh -= this.OnAtlasRefresh;
 
+            // A removed component must not stay registered, or the system would keep updating it
+            if (this.AnimationSystem != null)
+            {
+                this.AnimationSystem.Remove(this);
+            }
+
+            // Removed components are not disposed, so the shared skeleton data is released here
+            this.Dispose();
+
             base.DeleteDependencies();
         }
 
@@ -391,6 +832,213 @@ namespace WaveEngine.Spine
             this.CurrentAnimation = this.currentAnimation;
         }
 
+        /// <summary>
+        /// Gets the baked tables of the animation being played, if it is the only one and it has been baked
+        /// </summary>
+        /// <param name="entry">The track entry of the animation.</param>
+        /// <returns>The baked animation, or null if the pose must be computed</returns>
+        private SpineBakedAnimation GetPlayingBakedAnimation(out TrackEntry entry)
+        {
+            entry = null;
+            if (this.bakedAnimations.Count == 0)
+            {
+                return null;
+            }
+
+            entry = this.state.GetCurrent(0);
+            if (entry == null || this.state.GetCurrent(1) != null)
+            {
+                return null;
+            }
+
+            // Spine crossfades a new entry from the previous one, which needs the timelines applied to the bones
+            if (entry != this.bakedMixEntry)
+            {
+                this.bakedMixDuration = this.bakedMixEntry != null ? this.state.Data.GetMix(this.bakedMixEntry.Animation, entry.Animation) : 0;
+                this.bakedMixEntry = entry;
+            }
+
+            if (entry.Time < this.bakedMixDuration)
+            {
+                return null;
+            }
+
+            SpineBakedAnimation bakedAnimation;
+            this.bakedAnimations.TryGetValue(entry.Animation, out bakedAnimation);
+            return bakedAnimation;
+        }
+
+        /// <summary>
+        /// Gets the baked tables of the selected animations for the current skeleton data and skin
+        /// </summary>
+        private void RefreshBakedAnimations()
+        {
+            this.bakedAnimations.Clear();
+            this.currentBakedAnimation = null;
+            this.bakedMixEntry = null;
+            this.PoseVersion++;
+
+            if (this.Skeleton == null)
+            {
+                return;
+            }
+
+            var skinName = this.Skeleton.Skin != null ? this.Skeleton.Skin.Name : null;
+
+            foreach (var animationName in this.bakedAnimationNames)
+            {
+                var animation = this.skeletonData.FindAnimation(animationName);
+                if (animation == null)
+                {
+                    Debug.WriteLine("The animation [" + animationName + "] can not be baked because it does not exist");
+                    continue;
+                }
+
+                this.bakedAnimations[animation] = SpineResourceCache.GetBakedAnimation(this.skeletonData, skinName, animation, this.BakeSampleRate);
+            }
+        }
+
+        /// <summary>
+        /// Decides, with the visibility reported since the last update, whether the world transform of the skeleton is updated.
+        /// </summary>
+        /// <remarks>
+        /// The animation state is only applied when the world transform is updated, the rest of the updates fire the events with
+        /// <see cref="ApplyEvents"/>.
+        /// </remarks>
+        /// <returns>True if the world transform must be updated, false in other case</returns>
+        private bool ShouldUpdateWorldTransform()
+        {
+            bool visible = this.lodVisible;
+            float screenRatio = this.lodScreenRatio;
+            this.lodVisible = false;
+            this.lodScreenRatio = 0;
+
+            if (!this.EnableLOD || this.poseInvalidated)
+            {
+                this.poseInvalidated = false;
+                this.lodSkippedUpdates = 0;
+                return true;
+            }
+
+            if (!visible)
+            {
+                // The pose is updated as soon as the skeleton becomes visible again, see RefreshStalePose
+                this.lodSkippedUpdates = int.MaxValue;
+                this.poseStale = true;
+                return false;
+            }
+
+            int interval = 1;
+            if (screenRatio < this.QuarterRateScreenRatio)
+            {
+                interval = 4;
+            }
+            else if (screenRatio < this.HalfRateScreenRatio)
+            {
+                interval = 2;
+            }
+
+            if (this.lodSkippedUpdates < int.MaxValue)
+            {
+                this.lodSkippedUpdates++;
+            }
+
+            if (this.lodSkippedUpdates < interval)
+            {
+                return false;
+            }
+
+            this.lodSkippedUpdates = 0;
+            return true;
+        }
+
+        /// <summary>
+        /// Fires the events of the animations being played without applying their timelines to the bones.
+        /// As <see cref="AnimationState.Apply"/>, it fires the events between the last and the current time of each track,
+        /// from track 0 to the first empty one, and moves the last time forward so the loops are completed once.
+        /// </summary>
+        private void ApplyEvents()
+        {
+            TrackEntry entry;
+            for (int trackIndex = 0; (entry = this.state.GetCurrent(trackIndex)) != null; trackIndex++)
+            {
+                var animation = entry.Animation;
+                float lastTime = entry.LastTime;
+                float time = entry.Time;
+
+                if (!entry.Loop && time > entry.EndTime)
+                {
+                    time = entry.EndTime;
+                }
+
+                if (entry.Loop && animation.Duration != 0)
+                {
+                    time %= animation.Duration;
+                    if (lastTime > 0)
+                    {
+                        lastTime %= animation.Duration;
+                    }
+                }
+
+                var timelines = animation.Timelines;
+                for (int i = 0; i < timelines.Count; i++)
+                {
+                    var eventTimeline = timelines.Items[i] as EventTimeline;
+                    if (eventTimeline != null)
+                    {
+                        eventTimeline.Apply(this.Skeleton, lastTime, time, this.firedEvents, 1);
+                    }
+                }
+
+                for (int i = 0; i < this.firedEvents.Count; i++)
+                {
+                    this.OnEventAnimation(this.state, trackIndex, this.firedEvents.Items[i]);
+                }
+
+                this.firedEvents.Clear();
+                entry.LastTime = entry.Time;
+            }
+        }
+
+        /// <summary>
+        /// Updates the world transform of the skeleton, or selects the frame of the baked animation being played
+        /// </summary>
+        /// <param name="bakedAnimation">The baked animation being played, or null if the pose is in the skeleton.</param>
+        /// <param name="entry">The track entry of the baked animation.</param>
+        private void UpdateWorldPose(SpineBakedAnimation bakedAnimation, TrackEntry entry)
+        {
+            this.poseStale = false;
+
+            if (bakedAnimation == null)
+            {
+                this.Skeleton.UpdateWorldTransform();
+                this.currentBakedAnimation = null;
+                this.PoseVersion++;
+            }
+            else
+            {
+                // The tables are baked at the skeleton origin, so the skeleton position and flips are applied when drawing
+                int frame = bakedAnimation.GetFrame(entry.Time + this.BakedTimeOffset, entry.Loop);
+                var position = new Vector2(this.Skeleton.X, -this.Skeleton.Y);
+                var scale = new Vector2(this.Skeleton.FlipX ? -1 : 1, this.Skeleton.FlipY ? -1 : 1);
+
+                if (bakedAnimation != this.currentBakedAnimation
+                 || frame != this.currentBakedFrame
+                 || position != this.currentBakedPosition
+                 || scale != this.currentBakedScale)
+                {
+                    this.currentBakedAnimation = bakedAnimation;
+                    this.currentBakedFrame = frame;
+                    this.currentBakedPosition = position;
+                    this.currentBakedScale = scale;
+                    this.PoseVersion++;
+                }
+
+                this.SavedBoneTransforms = this.Skeleton.Bones.Count;
+                this.SavedVertexTransforms = bakedAnimation.GetFrameVertexCount(frame);
+            }
+        }
+
         /// <summary>
         /// Event handler of the animation event.
         /// </summary>
@@ -399,6 +1047,12 @@ namespace WaveEngine.Spine
         /// <param name="e">event data.</param>
         private void OnEventAnimation(AnimationState state, int trackIndex, Event e)
         {
+            if (this.deferEvents)
+            {
+                this.pendingEvents.Add(new PendingEvent(state, trackIndex, e));
+                return;
+            }
+
             if (this.EventAnimation != null)
             {
                 this.EventAnimation(this, new SpineEvent(e));
@@ -412,6 +1066,12 @@ namespace WaveEngine.Spine
         /// <param name="trackIndex">Index of the track.</param>
         private void OnEndAnimation(AnimationState state, int trackIndex)
         {
+            if (this.deferEvents)
+            {
+                this.pendingEvents.Add(new PendingEvent(state, trackIndex, null));
+                return;
+            }
+
             if (this.EndAnimation != null)
             {
                 this.EndAnimation(state, trackIndex);
@@ -428,11 +1088,9 @@ namespace WaveEngine.Spine
         /// </remarks>
         protected override void Update(TimeSpan gameTime)
         {
-            if (this.state != null)
+            if (this.AnimationSystem == null)
             {
-                this.state.Update((float)gameTime.TotalSeconds * this.Speed);
-                this.state.Apply(this.Skeleton);
-                this.Skeleton.UpdateWorldTransform();
+                this.UpdatePose(gameTime, false);
             }
         }
 
@@ -447,7 +1105,8 @@ namespace WaveEngine.Spine
         }
 
         /// <summary>
-        /// Refresh the animation
+        /// Refresh the animation. The skeleton data is shared by all the instances that load the same file,
+        /// and each instance only creates its own skeleton and animation state.
         /// </summary>
         private void RefreshAnimation()
         {
@@ -468,31 +1127,16 @@ namespace WaveEngine.Spine
                 this.state = null;
             }
 
+            // The previous data is released after acquiring the new one, so refreshing the same file does not parse it again
+            var previousSkeletonData = this.skeletonData;
+            this.skeletonData = null;
+
             try
             {
                 if (!string.IsNullOrEmpty(this.animationPath))
                 {
-                    using (var fileStream = WaveServices.Storage.OpenContentFile(this.animationPath))
-                    {
-                        SkeletonData skeletonData = null;
-                        var pathExtension = Path.GetExtension(this.animationPath.ToLowerInvariant());
-
-                        if (pathExtension == ".skel")
-                        {
-                            SkeletonBinary binary = new SkeletonBinary(this.SkeletalData.Atlas);
-                            skeletonData = binary.ReadSkeletonData(fileStream);
-                        }
-                        else
-                        {
-                            using (var streamReader = new StreamReader(fileStream))
-                            {
-                                SkeletonJson json = new SkeletonJson(this.SkeletalData.Atlas);
-                                skeletonData = json.ReadSkeletonData(streamReader);
-                            }
-                        }
-
-                        this.Skeleton = new Skeleton(skeletonData);
-                    }
+                    this.skeletonData = SpineResourceCache.AcquireSkeletonData(this.animationPath, this.SkeletalData.Atlas);
+                    this.Skeleton = new Skeleton(this.skeletonData);
 
                     if (string.IsNullOrEmpty(this.currentAnimation)
                      || !this.AnimationNames.Any(animation => animation == this.currentAnimation))
@@ -507,6 +1151,7 @@ namespace WaveEngine.Spine
                     }
 
                     this.Skeleton.SetSkin(this.currentSkin);
+                    this.RefreshBakedAnimations();
 
                     if (this.OnAnimationRefresh != null)
                     {
@@ -518,7 +1163,9 @@ namespace WaveEngine.Spine
                     this.state.Event += this.OnEventAnimation;
                     this.state.End += this.OnEndAnimation;
 
-                    this.Update(TimeSpan.Zero);
+                    this.lodBoundsValid = false;
+                    this.poseInvalidated = true;
+                    this.UpdatePose(TimeSpan.Zero, false);
                 }
             }
             catch (Exception e)
@@ -527,6 +1174,50 @@ namespace WaveEngine.Spine
                 this.Skeleton = null;
                 this.state = null;
             }
+            finally
+            {
+                if (previousSkeletonData != null)
+                {
+                    SpineResourceCache.ReleaseSkeletonData(previousSkeletonData);
+                }
+            }
+        }
+        #endregion
+
+        #region Private Structs
+
+        /// <summary>
+        /// A Spine event queued to be raised on the main thread
+        /// </summary>
+        private struct PendingEvent
+        {
+            /// <summary>
+            /// The animation state
+            /// </summary>
+            public AnimationState State;
+
+            /// <summary>
+            /// The index of the track
+            /// </summary>
+            public int TrackIndex;
+
+            /// <summary>
+            /// The Spine event, or null for an end of animation
+            /// </summary>
+            public Event Event;
+
+            /// <summary>
+            /// Initializes a new instance of the <see cref="PendingEvent" /> struct.
+            /// </summary>
+            /// <param name="state">The animation state.</param>
+            /// <param name="trackIndex">The index of the track.</param>
+            /// <param name="e">The Spine event, or null for an end of animation.</param>
+            public PendingEvent(AnimationState state, int trackIndex, Event e)
+            {
+                this.State = state;
+                this.TrackIndex = trackIndex;
+                this.Event = e;
+            }
         }
         #endregion
     }
@@ -0,0 +1,220 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+using WaveEngine.Framework;
+#endregion
+
+namespace WaveEngine.Spine
+{
+    /// <summary>
+    /// Scene behavior that updates the poses of many <see cref="SkeletalAnimation"/> components at once.
+    /// </summary>
+    /// <remarks>
+    /// The poses of the registered animations are updated in parallel. The Spine events raised meanwhile are queued
+    /// and dispatched afterwards on the main thread, in registration order.
+    /// </remarks>
+    public class SkeletalAnimationSystem : SceneBehavior
+    {
+        /// <summary>
+        /// The minimum number of active animations needed to update in parallel
+        /// </summary>
+        private const int DefaultParallelThreshold = 16;
+
+        /// <summary>
+        /// The registered animations
+        /// </summary>
+        private List<SkeletalAnimation> animations;
+
+        /// <summary>
+        /// The animations that need to be updated this frame
+        /// </summary>
+        private SkeletalAnimation[] pending;
+
+        /// <summary>
+        /// The game time of the current frame
+        /// </summary>
+        private TimeSpan currentGameTime;
+
+        /// <summary>
+        /// The cached update delegate
+        /// </summary>
+        private Action<int> updateAction;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the minimum number of active animations needed to update in parallel.
+        /// </summary>
+        public int ParallelThreshold { get; set; }
+
+        /// <summary>
+        /// Gets the number of registered animations.
+        /// </summary>
+        public int Count
+        {
+            get { return this.animations.Count; }
+        }
+
+        /// <summary>
+        /// Gets the number of animations whose pose came from baked tables in the last update,
+        /// skipping the application of the animation and the transform of the bones.
+        /// </summary>
+        public int BakedCount { get; private set; }
+
+        /// <summary>
+        /// Gets the number of bone world transforms that the animations playing baked tables did not compute in the last update.
+        /// </summary>
+        public int SavedBoneTransforms { get; private set; }
+
+        /// <summary>
+        /// Gets the number of attachment vertices that the animations playing baked tables read instead of computing them in the last update.
+        /// </summary>
+        public int SavedVertexTransforms { get; private set; }
+        #endregion
+
+        #region Initialization
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="SkeletalAnimationSystem"/> class.
+        /// </summary>
+        public SkeletalAnimationSystem()
+        {
+            this.animations = new List<SkeletalAnimation>();
+            this.pending = new SkeletalAnimation[0];
+            this.updateAction = this.UpdatePending;
+            this.ParallelThreshold = DefaultParallelThreshold;
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Registers an animation. Registered animations are no longer updated by their own update.
+        /// </summary>
+        /// <param name="animation">The skeletal animation.</param>
+        public void Add(SkeletalAnimation animation)
+        {
+            if (animation == null)
+            {
+                throw new ArgumentNullException("animation");
+            }
+
+            if (animation.AnimationSystem != null)
+            {
+                throw new InvalidOperationException("The skeletal animation is already registered in an animation system");
+            }
+
+            animation.AnimationSystem = this;
+            this.animations.Add(animation);
+        }
+
+        /// <summary>
+        /// Unregisters an animation.
+        /// </summary>
+        /// <param name="animation">The skeletal animation.</param>
+        /// <returns>True if the animation has been removed, false in other case</returns>
+        public bool Remove(SkeletalAnimation animation)
+        {
+            if (animation == null || animation.AnimationSystem != this)
+            {
+                return false;
+            }
+
+            animation.AnimationSystem = null;
+            return this.animations.Remove(animation);
+        }
+
+        /// <summary>
+        /// Updates the poses of all the registered animations and dispatches their events.
+        /// </summary>
+        /// <param name="gameTime">The game time.</param>
+        public void Execute(TimeSpan gameTime)
+        {
+            int count = this.animations.Count;
+            if (this.pending.Length < count)
+            {
+                this.pending = new SkeletalAnimation[count];
+            }
+
+            int pendingCount = 0;
+            for (int i = 0; i < count; i++)
+            {
+                var animation = this.animations[i];
+                if (animation.IsActive)
+                {
+                    this.pending[pendingCount++] = animation;
+                }
+            }
+
+            this.currentGameTime = gameTime;
+
+            if (pendingCount >= this.ParallelThreshold)
+            {
+                Parallel.For(0, pendingCount, this.updateAction);
+            }
+            else
+            {
+                for (int i = 0; i < pendingCount; i++)
+                {
+                    this.UpdatePending(i);
+                }
+            }
+
+            // Events are dispatched once every pose is updated, so the handlers see a consistent frame
+            int bakedCount = 0;
+            int savedBoneTransforms = 0;
+            int savedVertexTransforms = 0;
+            for (int i = 0; i < pendingCount; i++)
+            {
+                var animation = this.pending[i];
+                animation.DispatchPendingEvents();
+
+                if (animation.IsPlayingBaked)
+                {
+                    bakedCount++;
+                }
+
+                savedBoneTransforms += animation.SavedBoneTransforms;
+                savedVertexTransforms += animation.SavedVertexTransforms;
+            }
+
+            this.BakedCount = bakedCount;
+            this.SavedBoneTransforms = savedBoneTransforms;
+            this.SavedVertexTransforms = savedVertexTransforms;
+
+            Array.Clear(this.pending, 0, pendingCount);
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Resolves the dependencies.
+        /// </summary>
+        protected override void ResolveDependencies()
+        {
+        }
+
+        /// <summary>
+        /// Updates the registered animations.
+        /// </summary>
+        /// <param name="gameTime">The game time.</param>
+        protected override void Update(TimeSpan gameTime)
+        {
+            this.Execute(gameTime);
+        }
+
+        /// <summary>
+        /// Updates the pose of a pending animation.
+        /// </summary>
+        /// <param name="index">The index of the pending animation.</param>
+        private void UpdatePending(int index)
+        {
+            this.pending[index].UpdatePose(this.currentGameTime, true);
+        }
+        #endregion
+    }
+}
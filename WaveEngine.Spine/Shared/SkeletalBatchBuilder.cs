@@ -0,0 +1,374 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using WaveEngine.Common.Graphics;
+using WaveEngine.Common.Graphics.VertexFormats;
+using WaveEngine.Common.Math;
+#endregion
+
+namespace WaveEngine.Spine
+{
+    /// <summary>
+    /// Builds the vertex and index streams of a skeleton, grouping consecutive attachments that share a material in batches.
+    /// The streams are reused between frames, so building the same pose again does not allocate.
+    /// </summary>
+    /// <typeparam name="TMaterial">The type of the attachment materials.</typeparam>
+    internal class SkeletalBatchBuilder<TMaterial>
+        where TMaterial : class
+    {
+        /// <summary>
+        /// Maximum number of vertices of a batch segment, so they can be addressed by 16 bit indices
+        /// </summary>
+        public const int MaxSegmentVertices = ushort.MaxValue + 1;
+
+        /// <summary>
+        /// Initial number of vertices of a batch segment
+        /// </summary>
+        private const int InitialSegmentVertices = 256;
+
+        /// <summary>
+        /// The indices of a region attachment, whose corners are given in the order TL, TR, BR, BL
+        /// </summary>
+        /// 3----2
+        /// |    |
+        /// 0----1
+        private static readonly ushort[] QuadIndices = new ushort[6] { 0, 3, 1, 1, 3, 2 };
+
+        /// <summary>
+        /// The segments, reused between frames
+        /// </summary>
+        private List<Segment> segments = new List<Segment>();
+
+        /// <summary>
+        /// Number of segments used in the current frame
+        /// </summary>
+        private int usedSegments;
+
+        /// <summary>
+        /// The material of the open batch
+        /// </summary>
+        private TMaterial batchMaterial;
+
+        /// <summary>
+        /// The first slot of the open batch
+        /// </summary>
+        private int batchFirstSlot;
+
+        /// <summary>
+        /// The first index of the open batch in the current segment
+        /// </summary>
+        private int batchStartIndex;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the segments. Only the first <see cref="UsedSegments"/> belong to the current frame.
+        /// </summary>
+        public List<Segment> Segments
+        {
+            get
+            {
+                return this.segments;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of segments used in the current frame
+        /// </summary>
+        public int UsedSegments
+        {
+            get
+            {
+                return this.usedSegments;
+            }
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Starts building the streams of a new frame
+        /// </summary>
+        public void Begin()
+        {
+            this.usedSegments = 0;
+            this.batchMaterial = null;
+            this.NextSegment();
+        }
+
+        /// <summary>
+        /// Appends a region attachment
+        /// </summary>
+        /// <param name="material">The attachment material.</param>
+        /// <param name="slotIndex">The slot index in the draw order.</param>
+        /// <param name="positions">The positions of the corners, in the order TL, TR, BR, BL.</param>
+        /// <param name="regionUVs">The texture coordinates of the region, in the Spine order X1, Y1, X2, Y2, X3, Y3, X4, Y4.</param>
+        /// <param name="color">The attachment color.</param>
+        public void AppendQuad(TMaterial material, int slotIndex, Vector3[] positions, float[] regionUVs, Color color)
+        {
+            VertexPositionColorTexture tempVertex;
+            var segment = this.AppendToBatch(material, slotIndex, 4, QuadIndices.Length);
+            int vertexId = segment.VertexCount;
+
+            AppendIndices(segment, QuadIndices);
+
+            tempVertex.Color = color;
+
+            // Vertex TL
+            tempVertex.Position = positions[0];
+            tempVertex.TexCoord.X = regionUVs[0];
+            tempVertex.TexCoord.Y = regionUVs[1];
+            segment.Vertices[vertexId] = tempVertex;
+
+            // Vertex TR
+            tempVertex.Position = positions[1];
+            tempVertex.TexCoord.X = regionUVs[6];
+            tempVertex.TexCoord.Y = regionUVs[7];
+            segment.Vertices[vertexId + 1] = tempVertex;
+
+            // Vertex BR
+            tempVertex.Position = positions[2];
+            tempVertex.TexCoord.X = regionUVs[4];
+            tempVertex.TexCoord.Y = regionUVs[5];
+            segment.Vertices[vertexId + 2] = tempVertex;
+
+            // Vertex BL
+            tempVertex.Position = positions[3];
+            tempVertex.TexCoord.X = regionUVs[2];
+            tempVertex.TexCoord.Y = regionUVs[3];
+            segment.Vertices[vertexId + 3] = tempVertex;
+
+            segment.VertexCount += 4;
+        }
+
+        /// <summary>
+        /// Appends a mesh attachment
+        /// </summary>
+        /// <param name="material">The attachment material.</param>
+        /// <param name="slotIndex">The slot index in the draw order.</param>
+        /// <param name="positions">The positions of the vertices.</param>
+        /// <param name="vertexCount">The number of vertices.</param>
+        /// <param name="uvs">The texture coordinates of the vertices, as consecutive pairs.</param>
+        /// <param name="triangles">The triangle indices of the mesh.</param>
+        /// <param name="color">The attachment color.</param>
+        public void AppendMesh(TMaterial material, int slotIndex, Vector3[] positions, int vertexCount, float[] uvs, int[] triangles, Color color)
+        {
+            VertexPositionColorTexture tempVertex;
+            var segment = this.AppendToBatch(material, slotIndex, vertexCount, triangles.Length);
+            int vertexId = segment.VertexCount;
+
+            AppendIndices(segment, triangles);
+
+            tempVertex.Color = color;
+            for (int v = 0, j = 0; j < vertexCount; v += 2, j++)
+            {
+                tempVertex.Position = positions[j];
+                tempVertex.TexCoord.X = uvs[v];
+                tempVertex.TexCoord.Y = uvs[v + 1];
+                segment.Vertices[vertexId + j] = tempVertex;
+            }
+
+            segment.VertexCount += vertexCount;
+        }
+
+        /// <summary>
+        /// Closes the open batch. The streams of the frame are complete.
+        /// </summary>
+        public void End()
+        {
+            this.CloseBatch();
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Appends the indices of an attachment, offset by the current vertex count of the segment
+        /// </summary>
+        /// <param name="segment">The segment.</param>
+        /// <param name="attachmentIndices">The attachment indices.</param>
+        private static void AppendIndices(Segment segment, ushort[] attachmentIndices)
+        {
+            int baseVertex = segment.VertexCount;
+            for (int i = 0; i < attachmentIndices.Length; i++)
+            {
+                segment.Indices[segment.IndexCount++] = (ushort)(baseVertex + attachmentIndices[i]);
+            }
+        }
+
+        /// <summary>
+        /// Appends the indices of an attachment, offset by the current vertex count of the segment
+        /// </summary>
+        /// <param name="segment">The segment.</param>
+        /// <param name="attachmentIndices">The attachment indices.</param>
+        private static void AppendIndices(Segment segment, int[] attachmentIndices)
+        {
+            int baseVertex = segment.VertexCount;
+            for (int i = 0; i < attachmentIndices.Length; i++)
+            {
+                segment.Indices[segment.IndexCount++] = (ushort)(baseVertex + attachmentIndices[i]);
+            }
+        }
+
+        /// <summary>
+        /// Makes room for an attachment in the current batch. A new batch is opened when the material changes,
+        /// and a new segment when the vertices would not be addressable by 16 bit indices.
+        /// </summary>
+        /// <param name="material">The attachment material.</param>
+        /// <param name="slotIndex">The slot index in the draw order.</param>
+        /// <param name="vertexCount">The number of vertices of the attachment.</param>
+        /// <param name="indexCount">The number of indices of the attachment.</param>
+        /// <returns>The segment where the attachment must be written</returns>
+        private Segment AppendToBatch(TMaterial material, int slotIndex, int vertexCount, int indexCount)
+        {
+            var segment = this.segments[this.usedSegments - 1];
+
+            if (segment.VertexCount + vertexCount > MaxSegmentVertices)
+            {
+                this.CloseBatch();
+                segment = this.NextSegment();
+            }
+            else if (material != this.batchMaterial)
+            {
+                this.CloseBatch();
+            }
+
+            if (this.batchMaterial == null)
+            {
+                this.batchMaterial = material;
+                this.batchFirstSlot = slotIndex;
+                this.batchStartIndex = segment.IndexCount;
+            }
+
+            int requiredVertices = segment.VertexCount + vertexCount;
+            if (requiredVertices > segment.Vertices.Length)
+            {
+                Array.Resize(ref segment.Vertices, Math.Min(Math.Max(segment.Vertices.Length * 2, requiredVertices), MaxSegmentVertices));
+            }
+
+            int requiredIndices = segment.IndexCount + indexCount;
+            if (requiredIndices > segment.Indices.Length)
+            {
+                Array.Resize(ref segment.Indices, Math.Max(segment.Indices.Length * 2, requiredIndices));
+            }
+
+            return segment;
+        }
+
+        /// <summary>
+        /// Moves to the next segment, creating it if needed
+        /// </summary>
+        /// <returns>The segment</returns>
+        private Segment NextSegment()
+        {
+            if (this.usedSegments == this.segments.Count)
+            {
+                this.segments.Add(new Segment()
+                {
+                    Vertices = new VertexPositionColorTexture[InitialSegmentVertices],
+                    Indices = new ushort[InitialSegmentVertices * 3 / 2],
+                    Batches = new List<Batch>(),
+                });
+            }
+
+            var segment = this.segments[this.usedSegments++];
+            segment.VertexCount = 0;
+            segment.IndexCount = 0;
+            segment.BatchCount = 0;
+
+            return segment;
+        }
+
+        /// <summary>
+        /// Closes the open batch, storing its range of indices in the current segment
+        /// </summary>
+        private void CloseBatch()
+        {
+            var segment = this.segments[this.usedSegments - 1];
+
+            if (this.batchMaterial != null && segment.IndexCount > this.batchStartIndex)
+            {
+                if (segment.BatchCount == segment.Batches.Count)
+                {
+                    segment.Batches.Add(new Batch());
+                }
+
+                var batch = segment.Batches[segment.BatchCount++];
+                batch.Material = this.batchMaterial;
+                batch.FirstSlot = this.batchFirstSlot;
+                batch.StartIndex = this.batchStartIndex;
+                batch.PrimitiveCount = (segment.IndexCount - this.batchStartIndex) / 3;
+            }
+
+            this.batchMaterial = null;
+        }
+        #endregion
+
+        #region Public Classes
+
+        /// <summary>
+        /// A vertex and index stream whose vertices can be addressed by 16 bit indices
+        /// </summary>
+        public class Segment
+        {
+            /// <summary>
+            /// The vertices of the stream
+            /// </summary>
+            public VertexPositionColorTexture[] Vertices;
+
+            /// <summary>
+            /// The indices of the stream
+            /// </summary>
+            public ushort[] Indices;
+
+            /// <summary>
+            /// Number of vertices written in the current frame
+            /// </summary>
+            public int VertexCount;
+
+            /// <summary>
+            /// Number of indices written in the current frame
+            /// </summary>
+            public int IndexCount;
+
+            /// <summary>
+            /// The batches of the segment, reused between frames
+            /// </summary>
+            public List<Batch> Batches;
+
+            /// <summary>
+            /// Number of batches used in the current frame
+            /// </summary>
+            public int BatchCount;
+        }
+
+        /// <summary>
+        /// A range of indices drawn with the same material
+        /// </summary>
+        public class Batch
+        {
+            /// <summary>
+            /// The material of the batch
+            /// </summary>
+            public TMaterial Material;
+
+            /// <summary>
+            /// The first slot of the batch in the draw order
+            /// </summary>
+            public int FirstSlot;
+
+            /// <summary>
+            /// The first index of the batch
+            /// </summary>
+            public int StartIndex;
+
+            /// <summary>
+            /// Number of triangles of the batch
+            /// </summary>
+            public int PrimitiveCount;
+        }
+        #endregion
+    }
+}
@@ -18,7 +18,7 @@ namespace WaveEngine.Spine
     /// Hold all skeletal 2D info
     /// </summary>
     [DataContract(Namespace = "WaveEngine.Spine")]
-    public class SkeletalData : Component
+    public class SkeletalData : Component, IDisposable
     {
         /// <summary>
         ///     Number of instances of this component created.
@@ -109,8 +109,48 @@ namespace WaveEngine.Spine
         }
         #endregion
 
+        #region Public Methods
+
+        /// <summary>
+        /// Releases the shared atlas. It is also released when the component is removed from its entity.
+        /// </summary>
+        public void Dispose()
+        {
+            if (this.atlas != null)
+            {
+                SpineResourceCache.ReleaseAtlas(this.atlas);
+                this.atlas = null;
+            }
+        }
+        #endregion
+
         #region Private Methods
 
+        /// <summary>
+        /// Resolves the dependencies.
+        /// </summary>
+        protected override void ResolveDependencies()
+        {
+            base.ResolveDependencies();
+
+            // A component added again after being removed loads the atlas it released
+            if (this.isInitialized && this.atlas == null)
+            {
+                this.RefreshAtlas();
+            }
+        }
+
+        /// <summary>
+        /// Deletes the dependencies.
+        /// </summary>
+        protected override void DeleteDependencies()
+        {
+            // Removed components are not disposed, so the shared atlas is released here
+            this.Dispose();
+
+            base.DeleteDependencies();
+        }
+
         /// <summary>
         /// Performs further custom initialization for this instance.
         /// </summary>
@@ -126,27 +166,20 @@ namespace WaveEngine.Spine
         }
 
         /// <summary>
-        /// Refresh the atlas
+        /// Refresh the atlas. Atlases are shared by all the components that load the same file.
         /// </summary>
         private void RefreshAtlas()
         {
-            if (this.atlas != null)
-            {
-                this.atlas.Dispose();
-                this.atlas = null;
-            }
+            // The new atlas is acquired before the old one is released, so reloading the same path
+            // reuses the cached atlas instead of unloading and loading it again
+            Atlas previousAtlas = this.atlas;
+            this.atlas = null;
 
             if (!string.IsNullOrEmpty(this.atlasPath))
             {
                 try
                 {
-                    using (var fileStream = WaveServices.Storage.OpenContentFile(this.atlasPath))
-                    {
-                        using (var streamReader = new StreamReader(fileStream))
-                        {
-                            this.atlas = new Atlas(streamReader, Path.GetDirectoryName(this.atlasPath), new WaveTextureLoader(this.Assets));
-                        }
-                    }
+                    this.atlas = SpineResourceCache.AcquireAtlas(this.atlasPath, this.Assets);
                 }
                 catch (Exception e)
                 {
@@ -155,6 +188,11 @@ namespace WaveEngine.Spine
                 }
             }
 
+            if (previousAtlas != null)
+            {
+                SpineResourceCache.ReleaseAtlas(previousAtlas);
+            }
+
             if (this.OnAtlasRefresh != null)
             {
                 this.OnAtlasRefresh(this, EventArgs.Empty);
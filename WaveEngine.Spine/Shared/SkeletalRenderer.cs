@@ -45,27 +45,39 @@ namespace WaveEngine.Spine
         private ExposedList<Slot> drawOrder;
 
         /// <summary>
-        /// The indices
+        /// The vertex and index streams where the attachments are batched
         /// </summary>
-        private ushort[] indices;
+        private SkeletalBatchBuilder<StandardMaterial> batchBuilder = new SkeletalBatchBuilder<StandardMaterial>();
 
         /// <summary>
-        /// The vertices
+        /// The GPU buffers and meshes of each batch segment
         /// </summary>
-        private VertexPositionColorTexture[] vertices;
+        private List<SegmentBuffers> segmentBuffers = new List<SegmentBuffers>();
 
         /// <summary>
-        /// The mesh
+        /// Scratch buffer for the world vertices computed by Spine, reused between attachments
         /// </summary>
-        private Mesh[] spineMeshes;
+        private float[] spineVertices = new float[8];
 
         /// <summary>
-        /// The quad indices
+        /// Scratch buffer for the vertex positions of an attachment, reused between attachments
         /// </summary>
-        /// 3----2
-        /// |    |
-        /// 0----1
-        private ushort[] quadIndices;
+        private Vector3[] computedVertices = new Vector3[4];
+
+        /// <summary>
+        /// The pose version of the skeleton when the batches were built, or -1 if they must be built again
+        /// </summary>
+        private int batchedPoseVersion = -1;
+
+        /// <summary>
+        /// The opacity when the batches were built
+        /// </summary>
+        private float batchedOpacity;
+
+        /// <summary>
+        /// Scratch buffer for the corners of the camera frustum
+        /// </summary>
+        private Vector3[] frustumCorners = new Vector3[8];
 
         #region Cached fields
         #endregion
@@ -126,7 +138,6 @@ namespace WaveEngine.Spine
         {
             base.DefaultValues();
             this.Transform2D = null;
-            this.quadIndices = new ushort[6] { 0, 3, 1, 1, 3, 2 };
             this.ZOrderBias = 0.0001f;
         }
 
@@ -157,6 +168,10 @@ namespace WaveEngine.Spine
         /// <summary>
         /// Allows to perform custom drawing.
         /// </summary>
+        /// <remarks>
+        /// Consecutive attachments that share an atlas page are appended to a single vertex and index stream,
+        /// and drawn with one mesh each time the material changes.
+        /// </remarks>
         /// <param name="gameTime">The elapsed game time.</param>
         public override void Draw(TimeSpan gameTime)
         {
@@ -171,194 +186,94 @@ namespace WaveEngine.Spine
                 opacity *= DebugAlpha;
             }
 
-            int numVertices = 0;
-            int numPrimitives = 0;
-
-            VertexPositionColorTexture tempVertex;
-            StandardMaterial material = null;
-
-            // Process Mesh
-            for (int i = 0; i < this.drawOrder.Count; i++)
+            if (this.SkeletalAnimation.EnableLOD)
             {
-                var slot = this.drawOrder.Items[i];
-                var attachment = slot.Attachment;
-                var skeleton = this.SkeletalAnimation.Skeleton;
-
-                if (attachment is RegionAttachment)
+                if (!this.LODTest())
                 {
-                    RegionAttachment regionAttachment = attachment as RegionAttachment;
-
-                    byte a = (byte)(skeleton.A * 255 * slot.A * regionAttachment.A * opacity);
-                    byte r = (byte)(skeleton.R * slot.R * regionAttachment.R * a);
-                    byte g = (byte)(skeleton.G * slot.G * regionAttachment.G * a);
-                    byte b = (byte)(skeleton.B * slot.B * regionAttachment.B * a);
-
-                    if (slot.Data.BlendMode == SpineBlendMode.additive)
-                    {
-                        a = 0;
-                    }
-
-                    Color color = new Color(r, g, b, a);
-
-                    float[] uvs = regionAttachment.UVs;
-
-                    var region = (AtlasRegion)regionAttachment.RendererObject;
-                    material = (StandardMaterial)region.page.rendererObject;
-
-                    var computedVertices = this.ComputeAttachmentVertices(regionAttachment, slot);
-                    this.vertices = new VertexPositionColorTexture[4];
-
-                    // Vertex TL
-                    tempVertex.Position = computedVertices[0];
-                    tempVertex.Color = color;
-                    tempVertex.TexCoord.X = uvs[RegionAttachment.X1];
-                    tempVertex.TexCoord.Y = uvs[RegionAttachment.Y1];
-                    this.vertices[0] = tempVertex;
-
-                    // Vertex TR
-                    tempVertex.Position = computedVertices[1];
-                    tempVertex.Color = color;
-                    tempVertex.TexCoord.X = uvs[RegionAttachment.X4];
-                    tempVertex.TexCoord.Y = uvs[RegionAttachment.Y4];
-                    this.vertices[1] = tempVertex;
-
-                    // Vertex BR
-                    tempVertex.Position = computedVertices[2];
-                    tempVertex.Color = color;
-                    tempVertex.TexCoord.X = uvs[RegionAttachment.X3];
-                    tempVertex.TexCoord.Y = uvs[RegionAttachment.Y3];
-                    this.vertices[2] = tempVertex;
-
-                    // Vertex BL
-                    tempVertex.Position = computedVertices[3];
-                    tempVertex.Color = color;
-                    tempVertex.TexCoord.X = uvs[RegionAttachment.X2];
-                    tempVertex.TexCoord.Y = uvs[RegionAttachment.Y2];
-                    this.vertices[3] = tempVertex;
-
-                    numVertices = 4;
-                    numPrimitives = 2;
-                    this.indices = this.quadIndices;
+                    return;
                 }
-                else if (attachment is MeshAttachment)
-                {
-                    var mesh = (MeshAttachment)attachment;
-
-                    byte a = (byte)(skeleton.A * 255 * slot.A * mesh.A * opacity);
-                    byte r = (byte)(skeleton.R * slot.R * mesh.R * a);
-                    byte g = (byte)(skeleton.G * slot.G * mesh.G * a);
-                    byte b = (byte)(skeleton.B * slot.B * mesh.B * a);
-
-                    if (slot.Data.BlendMode == SpineBlendMode.additive)
-                    {
-                        a = 0;
-                    }
-
-                    Color color = new Color(r, g, b, a);
-
-                    numVertices = mesh.Vertices.Length;
-                    this.indices = this.CopyIndices(mesh.Triangles);
-                    numPrimitives = this.indices.Length / 3;
-
-                    var region = (AtlasRegion)mesh.RendererObject;
-                    material = (StandardMaterial)region.page.rendererObject;
 
-                    var computedVertices = this.ComputeAttachmentVertices(mesh, slot);
-                    this.vertices = new VertexPositionColorTexture[numVertices / 2];
+                this.SkeletalAnimation.RefreshStalePose();
 
-                    float[] uvs = mesh.UVs;
-                    for (int v = 0, j = 0; v < numVertices; v += 2, j++)
-                    {
-                        tempVertex.Position = computedVertices[j];
-                        tempVertex.Color = color;
-                        tempVertex.TexCoord.X = uvs[v];
-                        tempVertex.TexCoord.Y = uvs[v + 1];
-                        this.vertices[j] = tempVertex;
-                    }
-                }
-                else if (attachment is WeightedMeshAttachment)
+                // The batches of the last pose are still valid when the bones have not been transformed since then
+                if (this.batchedPoseVersion == this.SkeletalAnimation.PoseVersion
+                 && this.batchedOpacity == opacity)
                 {
-                    var mesh = (WeightedMeshAttachment)attachment;
+                    this.DrawBatches();
+                    return;
+                }
+            }
 
-                    byte a = (byte)(skeleton.A * 255 * slot.A * mesh.A * opacity);
-                    byte r = (byte)(skeleton.R * slot.R * mesh.R * a);
-                    byte g = (byte)(skeleton.G * slot.G * mesh.G * a);
-                    byte b = (byte)(skeleton.B * slot.B * mesh.B * a);
+            var skeleton = this.SkeletalAnimation.Skeleton;
 
-                    if (slot.Data.BlendMode == SpineBlendMode.additive)
-                    {
-                        a = 0;
-                    }
+            this.batchBuilder.Begin();
 
-                    Color color = new Color(r, g, b, a);
+            SpineBakedAnimation bakedAnimation;
+            int bakedFrame;
+            Vector2 bakedPosition, bakedScale;
+            if (this.SkeletalAnimation.GetBakedFrame(out bakedAnimation, out bakedFrame, out bakedPosition, out bakedScale))
+            {
+                this.AppendBakedFrame(skeleton, bakedAnimation, bakedFrame, bakedPosition, bakedScale, opacity);
+                this.EndBatches();
 
-                    numVertices = mesh.UVs.Length;
-                    this.indices = this.CopyIndices(mesh.Triangles);
-                    numPrimitives = this.indices.Length / 3;
+                this.batchedPoseVersion = this.SkeletalAnimation.PoseVersion;
+                this.batchedOpacity = opacity;
+                return;
+            }
 
-                    var computedVertices = this.ComputeAttachmentVertices(mesh, slot);
+            // Process Mesh
+            for (int i = 0; i < this.drawOrder.Count; i++)
+            {
+                var slot = this.drawOrder.Items[i];
+                var attachment = slot.Attachment;
 
-                    var region = (AtlasRegion)mesh.RendererObject;
-                    material = (StandardMaterial)region.page.rendererObject;
+                if (attachment is RegionAttachment)
+                {
+                    RegionAttachment regionAttachment = attachment as RegionAttachment;
+                    Color color = this.GetSlotColor(skeleton, slot, regionAttachment.R, regionAttachment.G, regionAttachment.B, regionAttachment.A, opacity);
 
-                    this.vertices = new VertexPositionColorTexture[numVertices / 2];
+                    var region = (AtlasRegion)regionAttachment.RendererObject;
+                    var material = (StandardMaterial)region.page.rendererObject;
 
-                    float[] uvs = mesh.UVs;
-                    for (int v = 0, j = 0; v < numVertices; v += 2, j++)
-                    {
-                        tempVertex.Position = computedVertices[j];
-                        tempVertex.Color = color;
-                        tempVertex.TexCoord.X = uvs[v];
-                        tempVertex.TexCoord.Y = uvs[v + 1];
-                        this.vertices[j] = tempVertex;
-                    }
+                    this.ComputeAttachmentVertices(regionAttachment, slot);
+                    this.batchBuilder.AppendQuad(material, i, this.computedVertices, regionAttachment.UVs, color);
                 }
-
-                if (attachment != null && material != null)
+                else if (attachment is MeshAttachment || attachment is WeightedMeshAttachment)
                 {
-                    bool reset = false;
+                    float[] uvs;
+                    int[] triangles;
+                    object rendererObject;
+                    Color color;
 
-                    if (this.spineMeshes[i] != null)
+                    if (attachment is MeshAttachment)
                     {
-                        if (this.spineMeshes[i].VertexBuffer.VertexCount != this.vertices.Length ||
-                            this.spineMeshes[i].IndexBuffer.Data.Length != this.indices.Length)
-                        {
-                            Mesh toDispose = this.spineMeshes[i];
-                            this.GraphicsDevice.DestroyIndexBuffer(toDispose.IndexBuffer);
-                            this.GraphicsDevice.DestroyVertexBuffer(toDispose.VertexBuffer);
-
-                            reset = true;
-                        }
+                        var mesh = (MeshAttachment)attachment;
+                        color = this.GetSlotColor(skeleton, slot, mesh.R, mesh.G, mesh.B, mesh.A, opacity);
+                        uvs = mesh.UVs;
+                        triangles = mesh.Triangles;
+                        rendererObject = mesh.RendererObject;
                     }
-
-                    if (this.spineMeshes[i] == null || reset)
+                    else
                     {
-                        Mesh newMesh = new Mesh(
-                            0,
-                            numVertices,
-                            0,
-                            numPrimitives,
-                            new DynamicVertexBuffer(VertexPositionColorTexture.VertexFormat),
-                            new DynamicIndexBuffer(this.indices),
-                            PrimitiveType.TriangleList);
-
-                        this.spineMeshes[i] = newMesh;
+                        var mesh = (WeightedMeshAttachment)attachment;
+                        color = this.GetSlotColor(skeleton, slot, mesh.R, mesh.G, mesh.B, mesh.A, opacity);
+                        uvs = mesh.UVs;
+                        triangles = mesh.Triangles;
+                        rendererObject = mesh.RendererObject;
                     }
 
-                    Mesh mesh = this.spineMeshes[i];
-                    mesh.IndexBuffer.SetData(this.indices);
-                    this.GraphicsDevice.BindIndexBuffer(mesh.IndexBuffer);
-                    mesh.VertexBuffer.SetData(this.vertices);
-                    this.GraphicsDevice.BindVertexBuffer(mesh.VertexBuffer);
-                    mesh.ZOrder = this.Transform2D.DrawOrder - (i * this.ZOrderBias);
-                    mesh.DisableBatch = true;
+                    var region = (AtlasRegion)rendererObject;
+                    var material = (StandardMaterial)region.page.rendererObject;
 
-                    material.LayerId = this.LayerId;
-
-                    Matrix worldTransform = this.Transform2D.WorldTransform;
-                    this.RenderManager.DrawMesh(mesh, material, ref worldTransform, false);
+                    int numVertices = this.ComputeAttachmentVertices(attachment, slot);
+                    this.batchBuilder.AppendMesh(material, i, this.computedVertices, numVertices, uvs, triangles, color);
                 }
             }
+
+            this.EndBatches();
+
+            this.batchedPoseVersion = this.SkeletalAnimation.PoseVersion;
+            this.batchedOpacity = opacity;
         }
 
         /// <summary>
@@ -372,7 +287,6 @@ namespace WaveEngine.Spine
                 this.DisposeMeshes();
 
                 this.drawOrder = this.SkeletalAnimation.Skeleton.DrawOrder;
-                this.spineMeshes = new Mesh[this.drawOrder.Count];
             }
         }
 
@@ -438,8 +352,8 @@ namespace WaveEngine.Spine
                 var slot = this.drawOrder.Items[i];
                 var attachment = slot.Attachment;
 
-                var computedVertices = this.ComputeAttachmentVertices(attachment, slot);
-                int vertexCount = computedVertices.Count;
+                int vertexCount = this.ComputeAttachmentVertices(attachment, slot);
+                var computedVertices = this.computedVertices;
 
                 for (int j = 0; j < vertexCount; j++)
                 {
@@ -480,34 +394,292 @@ namespace WaveEngine.Spine
         /// </summary>
         private void DisposeMeshes()
         {
-            if (this.spineMeshes != null)
+            this.batchedPoseVersion = -1;
+
+            for (int i = 0; i < this.segmentBuffers.Count; i++)
+            {
+                this.DestroySegmentBuffers(this.segmentBuffers[i]);
+                this.segmentBuffers[i].Meshes.Clear();
+            }
+        }
+
+        /// <summary>
+        /// Computes the premultiplied color of an attachment
+        /// </summary>
+        /// <param name="skeleton">The skeleton.</param>
+        /// <param name="slot">The slot.</param>
+        /// <param name="attachmentR">The red component of the attachment.</param>
+        /// <param name="attachmentG">The green component of the attachment.</param>
+        /// <param name="attachmentB">The blue component of the attachment.</param>
+        /// <param name="attachmentA">The alpha component of the attachment.</param>
+        /// <param name="opacity">The renderer opacity.</param>
+        /// <returns>The attachment color</returns>
+        private Color GetSlotColor(Skeleton skeleton, Slot slot, float attachmentR, float attachmentG, float attachmentB, float attachmentA, float opacity)
+        {
+            return this.GetColor(
+                skeleton,
+                slot.R * attachmentR,
+                slot.G * attachmentG,
+                slot.B * attachmentB,
+                slot.A * attachmentA,
+                slot.Data.BlendMode == SpineBlendMode.additive,
+                opacity);
+        }
+
+        /// <summary>
+        /// Computes the premultiplied color of an attachment from its combined slot and attachment color
+        /// </summary>
+        /// <param name="skeleton">The skeleton.</param>
+        /// <param name="slotR">The red component of the slot and attachment.</param>
+        /// <param name="slotG">The green component of the slot and attachment.</param>
+        /// <param name="slotB">The blue component of the slot and attachment.</param>
+        /// <param name="slotA">The alpha component of the slot and attachment.</param>
+        /// <param name="additive">Whether the slot uses additive blending.</param>
+        /// <param name="opacity">The renderer opacity.</param>
+        /// <returns>The attachment color</returns>
+        private Color GetColor(Skeleton skeleton, float slotR, float slotG, float slotB, float slotA, bool additive, float opacity)
+        {
+            byte a = (byte)(skeleton.A * 255 * slotA * opacity);
+            byte r = (byte)(skeleton.R * slotR * a);
+            byte g = (byte)(skeleton.G * slotG * a);
+            byte b = (byte)(skeleton.B * slotB * a);
+
+            // Additive blending is achieved with premultiplied colors and zero alpha, so it shares the material of the page
+            if (additive)
+            {
+                a = 0;
+            }
+
+            return new Color(r, g, b, a);
+        }
+
+        /// <summary>
+        /// Appends the attachments of a baked frame to the batches, reading the vertex positions from the baked tables
+        /// </summary>
+        /// <param name="skeleton">The skeleton.</param>
+        /// <param name="bakedAnimation">The baked animation.</param>
+        /// <param name="frame">The index of the frame.</param>
+        /// <param name="position">The skeleton position added to the baked vertices.</param>
+        /// <param name="scale">The skeleton flips, as a scale of -1 or 1 on each axis.</param>
+        /// <param name="opacity">The renderer opacity.</param>
+        private void AppendBakedFrame(Skeleton skeleton, SpineBakedAnimation bakedAnimation, int frame, Vector2 position, Vector2 scale, float opacity)
+        {
+            var positions = bakedAnimation.Positions;
+            var slots = bakedAnimation.Slots;
+            int end = bakedAnimation.FrameSlotStarts[frame + 1];
+
+            for (int i = bakedAnimation.FrameSlotStarts[frame]; i < end; i++)
+            {
+                var bakedSlot = slots[i];
+                var attachment = bakedSlot.Attachment;
+                Color color = this.GetColor(skeleton, bakedSlot.R, bakedSlot.G, bakedSlot.B, bakedSlot.A, bakedSlot.Additive, opacity);
+
+                int numVertices = bakedSlot.VertexCount;
+                this.EnsureComputedVertices(numVertices);
+                for (int j = 0; j < numVertices; j++)
+                {
+                    this.computedVertices[j] = PlaceBakedVertex(positions[bakedSlot.VertexStart + j], ref position, ref scale);
+                }
+
+                // The corners of the regions are baked in the order TL, TR, BR, BL
+                if (attachment is RegionAttachment)
+                {
+                    var regionAttachment = (RegionAttachment)attachment;
+                    var material = (StandardMaterial)((AtlasRegion)regionAttachment.RendererObject).page.rendererObject;
+                    this.batchBuilder.AppendQuad(material, bakedSlot.DrawIndex, this.computedVertices, regionAttachment.UVs, color);
+                    continue;
+                }
+
+                float[] uvs;
+                int[] triangles;
+                object rendererObject;
+                if (attachment is MeshAttachment)
+                {
+                    var mesh = (MeshAttachment)attachment;
+                    uvs = mesh.UVs;
+                    triangles = mesh.Triangles;
+                    rendererObject = mesh.RendererObject;
+                }
+                else
+                {
+                    var mesh = (WeightedMeshAttachment)attachment;
+                    uvs = mesh.UVs;
+                    triangles = mesh.Triangles;
+                    rendererObject = mesh.RendererObject;
+                }
+
+                var meshMaterial = (StandardMaterial)((AtlasRegion)rendererObject).page.rendererObject;
+                this.batchBuilder.AppendMesh(meshMaterial, bakedSlot.DrawIndex, this.computedVertices, numVertices, uvs, triangles, color);
+            }
+        }
+
+        /// <summary>
+        /// Applies the skeleton flips and position to a baked vertex
+        /// </summary>
+        /// <param name="vertex">The baked vertex.</param>
+        /// <param name="position">The skeleton position.</param>
+        /// <param name="scale">The skeleton flips, as a scale of -1 or 1 on each axis.</param>
+        /// <returns>The vertex position</returns>
+        private static Vector3 PlaceBakedVertex(Vector3 vertex, ref Vector2 position, ref Vector2 scale)
+        {
+            return new Vector3((vertex.X * scale.X) + position.X, (vertex.Y * scale.Y) + position.Y, vertex.Z);
+        }
+
+        /// <summary>
+        /// Uploads the batched geometry and draws a mesh per batch
+        /// </summary>
+        private void EndBatches()
+        {
+            this.batchBuilder.End();
+
+            var segments = this.batchBuilder.Segments;
+            for (int i = 0; i < this.batchBuilder.UsedSegments; i++)
+            {
+                var segment = segments[i];
+                if (segment.BatchCount == 0)
+                {
+                    continue;
+                }
+
+                while (this.segmentBuffers.Count <= i)
+                {
+                    this.segmentBuffers.Add(new SegmentBuffers() { Meshes = new List<Mesh>() });
+                }
+
+                var buffers = this.segmentBuffers[i];
+
+                // Buffers are sized by the capacity of the streams, so they are only created again when they grow
+                if (buffers.VertexBuffer == null
+                 || buffers.VertexBuffer.VertexCount != segment.Vertices.Length
+                 || buffers.IndexBuffer.Data.Length != segment.Indices.Length)
+                {
+                    this.DestroySegmentBuffers(buffers);
+                    buffers.VertexBuffer = new DynamicVertexBuffer(VertexPositionColorTexture.VertexFormat);
+                    buffers.IndexBuffer = new DynamicIndexBuffer(segment.Indices);
+                }
+
+                // Only the used part of the streams is uploaded
+                buffers.IndexBuffer.SetData(segment.Indices, segment.IndexCount);
+                this.GraphicsDevice.BindIndexBuffer(buffers.IndexBuffer);
+                buffers.VertexBuffer.SetData(segment.Vertices, segment.VertexCount);
+                this.GraphicsDevice.BindVertexBuffer(buffers.VertexBuffer);
+            }
+
+            this.DrawBatches();
+        }
+
+        /// <summary>
+        /// Draws a mesh per batch, with the geometry already uploaded
+        /// </summary>
+        private void DrawBatches()
+        {
+            Matrix worldTransform = this.Transform2D.WorldTransform;
+            var segments = this.batchBuilder.Segments;
+
+            for (int i = 0; i < this.batchBuilder.UsedSegments; i++)
             {
-                foreach (Mesh spineMesh in this.spineMeshes)
+                var segment = segments[i];
+                if (segment.BatchCount == 0)
+                {
+                    continue;
+                }
+
+                var buffers = this.segmentBuffers[i];
+                var meshes = buffers.Meshes;
+
+                for (int j = 0; j < segment.BatchCount; j++)
                 {
-                    if (spineMesh != null)
+                    var batch = segment.Batches[j];
+
+                    if (j == meshes.Count)
                     {
-                        this.GraphicsDevice.DestroyIndexBuffer(spineMesh.IndexBuffer);
-                        this.GraphicsDevice.DestroyVertexBuffer(spineMesh.VertexBuffer);
+                        meshes.Add(null);
                     }
+
+                    var mesh = meshes[j];
+                    if (mesh == null
+                     || mesh.VertexBuffer != buffers.VertexBuffer
+                     || mesh.IndexBuffer != buffers.IndexBuffer
+                     || mesh.IndexOffset != batch.StartIndex
+                     || mesh.NumPrimitives != batch.PrimitiveCount)
+                    {
+                        mesh = new Mesh(
+                            0,
+                            segment.Vertices.Length,
+                            batch.StartIndex,
+                            batch.PrimitiveCount,
+                            buffers.VertexBuffer,
+                            buffers.IndexBuffer,
+                            PrimitiveType.TriangleList)
+                        {
+                            DisableBatch = true,
+                        };
+
+                        meshes[j] = mesh;
+                    }
+
+                    mesh.ZOrder = this.Transform2D.DrawOrder - (batch.FirstSlot * this.ZOrderBias);
+                    batch.Material.LayerId = this.LayerId;
+
+                    this.RenderManager.DrawMesh(mesh, batch.Material, ref worldTransform, false);
                 }
             }
         }
 
         /// <summary>
-        /// Convert int[] to ushort[].
+        /// Destroys the GPU buffers of a segment
         /// </summary>
-        /// <param name="fromIndices">int indices array.</param>
-        /// <returns>ushort indices array.</returns>
-        private ushort[] CopyIndices(int[] fromIndices)
+        /// <param name="buffers">The buffers of the segment.</param>
+        private void DestroySegmentBuffers(SegmentBuffers buffers)
         {
-            ushort[] indices = new ushort[fromIndices.Length];
+            if (buffers.VertexBuffer != null)
+            {
+                this.GraphicsDevice.DestroyIndexBuffer(buffers.IndexBuffer);
+                this.GraphicsDevice.DestroyVertexBuffer(buffers.VertexBuffer);
+                buffers.VertexBuffer = null;
+                buffers.IndexBuffer = null;
+            }
+        }
 
-            for (int i = 0; i < indices.Length; i++)
+        /// <summary>
+        /// Tests the LOD bounds of the current animation against the drawing camera, and reports the result to the animation
+        /// </summary>
+        /// <returns>True if the skeleton is visible, false in other case</returns>
+        private bool LODTest()
+        {
+            var camera = this.RenderManager.CurrentDrawingCamera2D;
+            if (camera == null)
+            {
+                this.SkeletalAnimation.ReportVisibility(true, 1);
+                return true;
+            }
+
+            Matrix worldTransform = this.Transform2D.WorldTransform;
+            var bounds = this.SkeletalAnimation.GetLODBounds();
+            bounds.Transform(ref worldTransform);
+
+            if (!camera.BoundingFrustum.Intersects(bounds))
             {
-                indices[i] = (ushort)fromIndices[i];
+                this.SkeletalAnimation.ReportVisibility(false, 0);
+                return false;
             }
 
-            return indices;
+            // The near plane corners of the frustum delimit the visible area of the 2D camera
+            camera.BoundingFrustum.GetCorners(this.frustumCorners);
+            var min = this.frustumCorners[0];
+            var max = this.frustumCorners[0];
+            for (int i = 1; i < 4; i++)
+            {
+                Vector3.Min(ref min, ref this.frustumCorners[i], out min);
+                Vector3.Max(ref max, ref this.frustumCorners[i], out max);
+            }
+
+            float screenRatio = Math.Max(
+                (bounds.Max.X - bounds.Min.X) / Math.Max(max.X - min.X, float.Epsilon),
+                (bounds.Max.Y - bounds.Min.Y) / Math.Max(max.Y - min.Y, float.Epsilon));
+
+            this.SkeletalAnimation.ReportVisibility(true, screenRatio);
+            return true;
         }
 
         private void SkeletalAnimation_OnAnimationRefresh(object sender, EventArgs e)
@@ -517,65 +689,102 @@ namespace WaveEngine.Spine
             this.UpdateBoundingBox();
         }
 
-        private List<Vector3> ComputeAttachmentVertices(Attachment attachment, Slot slot)
+        /// <summary>
+        /// Computes the world positions of the vertices of an attachment into the reused scratch buffer
+        /// </summary>
+        /// <param name="attachment">The attachment.</param>
+        /// <param name="slot">The slot.</param>
+        /// <returns>The number of vertices stored in the scratch buffer</returns>
+        private int ComputeAttachmentVertices(Attachment attachment, Slot slot)
         {
-            var result = new List<Vector3>();
+            int vertexCount = 0;
 
             if (attachment is RegionAttachment)
             {
                 RegionAttachment regionAttachment = attachment as RegionAttachment;
-                float[] spineVertices = new float[8];
+                float[] spineVertices = this.spineVertices;
                 regionAttachment.ComputeWorldVertices(slot.Bone, spineVertices);
 
-                result.Add(new Vector3(
+                vertexCount = 4;
+                this.EnsureComputedVertices(vertexCount);
+
+                this.computedVertices[0] = new Vector3(
                     spineVertices[RegionAttachment.X1],
                     -spineVertices[RegionAttachment.Y1],
-                    0));
+                    0);
 
-                result.Add(new Vector3(
+                this.computedVertices[1] = new Vector3(
                     spineVertices[RegionAttachment.X4],
                     -spineVertices[RegionAttachment.Y4],
-                    0));
+                    0);
 
-                result.Add(new Vector3(
+                this.computedVertices[2] = new Vector3(
                     spineVertices[RegionAttachment.X3],
                     -spineVertices[RegionAttachment.Y3],
-                    0));
+                    0);
 
-                result.Add(new Vector3(
+                this.computedVertices[3] = new Vector3(
                     spineVertices[RegionAttachment.X2],
                     -spineVertices[RegionAttachment.Y2],
-                    0));
+                    0);
             }
             else if (attachment is MeshAttachment || attachment is WeightedMeshAttachment)
             {
-                float[] spineVertices;
+                int numVertices;
 
                 if (attachment is MeshAttachment)
                 {
                     var mesh = attachment as MeshAttachment;
-                    var numVertices = mesh.Vertices.Length;
-                    spineVertices = new float[numVertices];
-                    mesh.ComputeWorldVertices(slot, spineVertices);
+                    numVertices = mesh.Vertices.Length;
+                    this.EnsureSpineVertices(numVertices);
+                    mesh.ComputeWorldVertices(slot, this.spineVertices);
                 }
                 else
                 {
                     var mesh = attachment as WeightedMeshAttachment;
-                    var numVertices = mesh.UVs.Length;
-                    spineVertices = new float[numVertices];
-                    mesh.ComputeWorldVertices(slot, spineVertices);
+                    numVertices = mesh.UVs.Length;
+                    this.EnsureSpineVertices(numVertices);
+                    mesh.ComputeWorldVertices(slot, this.spineVertices);
                 }
 
-                for (int v = 0; v < spineVertices.Length; v += 2)
+                vertexCount = numVertices / 2;
+                this.EnsureComputedVertices(vertexCount);
+
+                float[] spineVertices = this.spineVertices;
+                for (int v = 0, j = 0; j < vertexCount; v += 2, j++)
                 {
-                    result.Add(new Vector3(
+                    this.computedVertices[j] = new Vector3(
                         spineVertices[v],
                         -spineVertices[v + 1],
-                        0));
+                        0);
                 }
             }
 
-            return result;
+            return vertexCount;
+        }
+
+        /// <summary>
+        /// Grows the Spine world vertices scratch buffer if needed
+        /// </summary>
+        /// <param name="length">The required length.</param>
+        private void EnsureSpineVertices(int length)
+        {
+            if (this.spineVertices.Length < length)
+            {
+                this.spineVertices = new float[Math.Max(this.spineVertices.Length * 2, length)];
+            }
+        }
+
+        /// <summary>
+        /// Grows the vertex positions scratch buffer if needed
+        /// </summary>
+        /// <param name="length">The required length.</param>
+        private void EnsureComputedVertices(int length)
+        {
+            if (this.computedVertices.Length < length)
+            {
+                this.computedVertices = new Vector3[Math.Max(this.computedVertices.Length * 2, length)];
+            }
         }
 
         /// <summary>
@@ -593,11 +802,11 @@ namespace WaveEngine.Spine
                     var slot = this.drawOrder.Items[i];
                     var attachment = slot.Attachment;
 
-                    var computedVertices = this.ComputeAttachmentVertices(attachment, slot);
+                    int vertexCount = this.ComputeAttachmentVertices(attachment, slot);
 
-                    for (int j = 0; j < computedVertices.Count; j++)
+                    for (int j = 0; j < vertexCount; j++)
                     {
-                        var vertexPosition = computedVertices[j];
+                        var vertexPosition = this.computedVertices[j];
                         Vector3.Min(ref minVertexPosition, ref vertexPosition, out minVertexPosition);
                         Vector3.Max(ref maxVertexPosition, ref vertexPosition, out maxVertexPosition);
                     }
@@ -613,5 +822,29 @@ namespace WaveEngine.Spine
             }
         }
         #endregion
+
+        #region Private Classes
+
+        /// <summary>
+        /// The GPU resources of a batch segment
+        /// </summary>
+        private class SegmentBuffers
+        {
+            /// <summary>
+            /// The vertex buffer
+            /// </summary>
+            public DynamicVertexBuffer VertexBuffer;
+
+            /// <summary>
+            /// The index buffer
+            /// </summary>
+            public DynamicIndexBuffer IndexBuffer;
+
+            /// <summary>
+            /// The mesh of each batch of the segment, reused between frames
+            /// </summary>
+            public List<Mesh> Meshes;
+        }
+        #endregion
     }
 }
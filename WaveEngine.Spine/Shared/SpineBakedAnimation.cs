@@ -0,0 +1,328 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using Spine;
+using System;
+using System.Collections.Generic;
+using WaveEngine.Common.Math;
+#endregion
+
+namespace WaveEngine.Spine
+{
+    /// <summary>
+    /// An animation sampled at a fixed rate into world-space vertex tables, shared by all the instances of the same skeleton data.
+    /// </summary>
+    internal class SpineBakedAnimation
+    {
+        /// <summary>
+        /// Approximate size in bytes of a baked slot
+        /// </summary>
+        private const int BakedSlotSize = 48;
+
+        /// <summary>
+        /// Size in bytes of a baked vertex position
+        /// </summary>
+        private const int PositionSize = 12;
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the number of frames per second
+        /// </summary>
+        public float SampleRate { get; private set; }
+
+        /// <summary>
+        /// Gets the duration of the animation, in seconds
+        /// </summary>
+        public float Duration { get; private set; }
+
+        /// <summary>
+        /// Gets the number of frames
+        /// </summary>
+        public int FrameCount { get; private set; }
+
+        /// <summary>
+        /// Gets the vertex positions of all the frames, in the order the renderer emits them
+        /// </summary>
+        public Vector3[] Positions { get; private set; }
+
+        /// <summary>
+        /// Gets the drawn slots of all the frames, in draw order
+        /// </summary>
+        public BakedSlot[] Slots { get; private set; }
+
+        /// <summary>
+        /// Gets the index of the first slot of each frame. It has an extra element with the total number of slots.
+        /// </summary>
+        public int[] FrameSlotStarts { get; private set; }
+
+        /// <summary>
+        /// Gets the approximate memory used by the tables, in bytes
+        /// </summary>
+        public long MemorySize
+        {
+            get
+            {
+                return ((long)this.Positions.Length * PositionSize)
+                     + ((long)this.Slots.Length * BakedSlotSize)
+                     + ((long)this.FrameSlotStarts.Length * sizeof(int));
+            }
+        }
+        #endregion
+
+        #region Initialization
+
+        /// <summary>
+        /// Prevents a default instance of the <see cref="SpineBakedAnimation"/> class from being created.
+        /// </summary>
+        private SpineBakedAnimation()
+        {
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Samples an animation on a temporary skeleton
+        /// </summary>
+        /// <param name="skeletonData">The skeleton data.</param>
+        /// <param name="skinName">The name of the skin, or null for the default skin.</param>
+        /// <param name="animation">The animation.</param>
+        /// <param name="sampleRate">The number of frames per second.</param>
+        /// <returns>The baked animation</returns>
+        public static SpineBakedAnimation Bake(SkeletonData skeletonData, string skinName, Animation animation, float sampleRate)
+        {
+            if (animation == null)
+            {
+                throw new ArgumentNullException("animation");
+            }
+
+            if (sampleRate <= 0)
+            {
+                throw new ArgumentOutOfRangeException("sampleRate");
+            }
+
+            var skeleton = new Skeleton(skeletonData);
+            if (!string.IsNullOrEmpty(skinName))
+            {
+                skeleton.SetSkin(skinName);
+            }
+
+            // The last frame holds the pose at the end of the animation
+            int frameCount = (int)Math.Ceiling(animation.Duration * sampleRate) + 1;
+
+            var positions = new List<Vector3>();
+            var slots = new List<BakedSlot>();
+            var frameSlotStarts = new int[frameCount + 1];
+            var events = new ExposedList<Event>();
+            float[] vertices = new float[8];
+
+            for (int frame = 0; frame < frameCount; frame++)
+            {
+                float time = Math.Min(frame / sampleRate, animation.Duration);
+
+                skeleton.SetToSetupPose();
+                animation.Apply(skeleton, time, time, false, events);
+                events.Clear();
+                skeleton.UpdateWorldTransform();
+
+                frameSlotStarts[frame] = slots.Count;
+
+                var drawOrder = skeleton.DrawOrder;
+                for (int i = 0; i < drawOrder.Count; i++)
+                {
+                    var slot = drawOrder.Items[i];
+                    var attachment = slot.Attachment;
+
+                    float r, g, b, a;
+                    if (!GetAttachmentColor(attachment, out r, out g, out b, out a))
+                    {
+                        continue;
+                    }
+
+                    int length = SpineResourceCache.ComputeWorldVertices(slot, ref vertices);
+
+                    slots.Add(new BakedSlot()
+                    {
+                        DrawIndex = i,
+                        Attachment = attachment,
+                        R = slot.R * r,
+                        G = slot.G * g,
+                        B = slot.B * b,
+                        A = slot.A * a,
+                        Additive = slot.Data.BlendMode == BlendMode.additive,
+                        VertexStart = positions.Count,
+                        VertexCount = length / 2,
+                    });
+
+                    // Region corners are stored in the order the renderer maps their texture coordinates
+                    if (attachment is RegionAttachment)
+                    {
+                        positions.Add(new Vector3(vertices[RegionAttachment.X1], -vertices[RegionAttachment.Y1], 0));
+                        positions.Add(new Vector3(vertices[RegionAttachment.X4], -vertices[RegionAttachment.Y4], 0));
+                        positions.Add(new Vector3(vertices[RegionAttachment.X3], -vertices[RegionAttachment.Y3], 0));
+                        positions.Add(new Vector3(vertices[RegionAttachment.X2], -vertices[RegionAttachment.Y2], 0));
+                    }
+                    else
+                    {
+                        for (int v = 0; v < length; v += 2)
+                        {
+                            positions.Add(new Vector3(vertices[v], -vertices[v + 1], 0));
+                        }
+                    }
+                }
+            }
+
+            frameSlotStarts[frameCount] = slots.Count;
+
+            return new SpineBakedAnimation()
+            {
+                SampleRate = sampleRate,
+                Duration = animation.Duration,
+                FrameCount = frameCount,
+                Positions = positions.ToArray(),
+                Slots = slots.ToArray(),
+                FrameSlotStarts = frameSlotStarts,
+            };
+        }
+
+        /// <summary>
+        /// Gets the number of vertices drawn in a frame
+        /// </summary>
+        /// <param name="frame">The index of the frame.</param>
+        /// <returns>The number of vertices</returns>
+        public int GetFrameVertexCount(int frame)
+        {
+            int vertexCount = 0;
+            int end = this.FrameSlotStarts[frame + 1];
+            for (int i = this.FrameSlotStarts[frame]; i < end; i++)
+            {
+                vertexCount += this.Slots[i].VertexCount;
+            }
+
+            return vertexCount;
+        }
+
+        /// <summary>
+        /// Gets the frame that holds the pose of a time
+        /// </summary>
+        /// <param name="time">The animation time, in seconds.</param>
+        /// <param name="loop">Whether the animation is looped.</param>
+        /// <returns>The index of the frame</returns>
+        public int GetFrame(float time, bool loop)
+        {
+            if (loop && this.Duration > 0)
+            {
+                time %= this.Duration;
+                if (time < 0)
+                {
+                    time += this.Duration;
+                }
+            }
+
+            int frame = (int)(time * this.SampleRate);
+            return Math.Max(0, Math.Min(frame, this.FrameCount - 1));
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Gets the color of a drawable attachment
+        /// </summary>
+        /// <param name="attachment">The attachment.</param>
+        /// <param name="r">The red component.</param>
+        /// <param name="g">The green component.</param>
+        /// <param name="b">The blue component.</param>
+        /// <param name="a">The alpha component.</param>
+        /// <returns>True if the attachment is drawn, false in other case</returns>
+        private static bool GetAttachmentColor(Attachment attachment, out float r, out float g, out float b, out float a)
+        {
+            if (attachment is RegionAttachment)
+            {
+                var region = (RegionAttachment)attachment;
+                r = region.R;
+                g = region.G;
+                b = region.B;
+                a = region.A;
+                return true;
+            }
+            else if (attachment is MeshAttachment)
+            {
+                var mesh = (MeshAttachment)attachment;
+                r = mesh.R;
+                g = mesh.G;
+                b = mesh.B;
+                a = mesh.A;
+                return true;
+            }
+            else if (attachment is WeightedMeshAttachment)
+            {
+                var mesh = (WeightedMeshAttachment)attachment;
+                r = mesh.R;
+                g = mesh.G;
+                b = mesh.B;
+                a = mesh.A;
+                return true;
+            }
+
+            r = g = b = a = 0;
+            return false;
+        }
+        #endregion
+
+        #region Public Structs
+
+        /// <summary>
+        /// A slot drawn in a baked frame
+        /// </summary>
+        public struct BakedSlot
+        {
+            /// <summary>
+            /// The position of the slot in the draw order
+            /// </summary>
+            public int DrawIndex;
+
+            /// <summary>
+            /// The attachment of the slot
+            /// </summary>
+            public Attachment Attachment;
+
+            /// <summary>
+            /// The red component of the slot and attachment colors
+            /// </summary>
+            public float R;
+
+            /// <summary>
+            /// The green component of the slot and attachment colors
+            /// </summary>
+            public float G;
+
+            /// <summary>
+            /// The blue component of the slot and attachment colors
+            /// </summary>
+            public float B;
+
+            /// <summary>
+            /// The alpha component of the slot and attachment colors
+            /// </summary>
+            public float A;
+
+            /// <summary>
+            /// Whether the slot uses additive blending
+            /// </summary>
+            public bool Additive;
+
+            /// <summary>
+            /// The index of the first vertex in the positions table
+            /// </summary>
+            public int VertexStart;
+
+            /// <summary>
+            /// The number of vertices
+            /// </summary>
+            public int VertexCount;
+        }
+        #endregion
+    }
+}
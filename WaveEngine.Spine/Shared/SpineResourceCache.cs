@@ -0,0 +1,349 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using Spine;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework.Graphics;
+using WaveEngine.Framework.Services;
+#endregion
+
+namespace WaveEngine.Spine
+{
+    /// <summary>
+    /// Process-wide cache of the immutable Spine resources, shared by all the components that load the same files.
+    /// Each resource is reference counted and released when the last component stops using it.
+    /// </summary>
+    internal static class SpineResourceCache
+    {
+        /// <summary>
+        /// Number of poses sampled to compute the bounds of an animation
+        /// </summary>
+        private const int AnimationBoundsSamples = 16;
+        /// <summary>
+        /// The lock of the cache
+        /// </summary>
+        private static readonly object lockObject = new object();
+
+        /// <summary>
+        /// The reference counted atlases and skeleton data
+        /// </summary>
+        private static readonly SpineResourceReferences references = new SpineResourceReferences();
+
+        /// <summary>
+        /// The bounds of the animations by skeleton data, skin and animation
+        /// </summary>
+        private static readonly Dictionary<Tuple<SkeletonData, string, Animation>, BoundingBox> animationBounds = new Dictionary<Tuple<SkeletonData, string, Animation>, BoundingBox>();
+
+        /// <summary>
+        /// The baked animations by skeleton data, skin, animation and sample rate
+        /// </summary>
+        private static readonly Dictionary<Tuple<SkeletonData, string, Animation, float>, SpineBakedAnimation> bakedAnimations = new Dictionary<Tuple<SkeletonData, string, Animation, float>, SpineBakedAnimation>();
+
+        /// <summary>
+        /// Scratch buffer for the world vertices of an attachment
+        /// </summary>
+        private static float[] boundsVertices = new float[8];
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the approximate memory used by all the baked animations, in bytes
+        /// </summary>
+        public static long BakedAnimationsMemorySize
+        {
+            get
+            {
+                lock (lockObject)
+                {
+                    long size = 0;
+                    foreach (var bakedAnimation in bakedAnimations.Values)
+                    {
+                        size += bakedAnimation.MemorySize;
+                    }
+
+                    return size;
+                }
+            }
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Gets the atlas of a file, loading it the first time. Atlases are shared by the components of the same assets container,
+        /// because the page textures belong to it.
+        /// </summary>
+        /// <param name="atlasPath">The atlas path.</param>
+        /// <param name="assets">The assets container where the page textures are loaded.</param>
+        /// <returns>The shared atlas</returns>
+        public static Atlas AcquireAtlas(string atlasPath, AssetsContainer assets)
+        {
+            return (Atlas)references.Acquire(assets, atlasPath, () =>
+            {
+                using (var fileStream = WaveServices.Storage.OpenContentFile(atlasPath))
+                {
+                    using (var streamReader = new StreamReader(fileStream))
+                    {
+                        return new Atlas(streamReader, Path.GetDirectoryName(atlasPath), new WaveTextureLoader(assets));
+                    }
+                }
+            });
+        }
+
+        /// <summary>
+        /// Releases an atlas. It is disposed when no component uses it.
+        /// </summary>
+        /// <param name="atlas">The atlas.</param>
+        public static void ReleaseAtlas(Atlas atlas)
+        {
+            if (references.Release(atlas))
+            {
+                atlas.Dispose();
+            }
+        }
+
+        /// <summary>
+        /// Gets the skeleton data of a file (.json or .skel), loading it the first time.
+        /// </summary>
+        /// <param name="animationPath">The animation path.</param>
+        /// <param name="atlas">The atlas used to resolve the attachments.</param>
+        /// <returns>The shared skeleton data</returns>
+        public static SkeletonData AcquireSkeletonData(string animationPath, Atlas atlas)
+        {
+            return (SkeletonData)references.Acquire(atlas, animationPath, () =>
+            {
+                using (var fileStream = WaveServices.Storage.OpenContentFile(animationPath))
+                {
+                    var pathExtension = Path.GetExtension(animationPath.ToLowerInvariant());
+
+                    if (pathExtension == ".skel")
+                    {
+                        SkeletonBinary binary = new SkeletonBinary(atlas);
+                        return binary.ReadSkeletonData(fileStream);
+                    }
+                    else
+                    {
+                        using (var streamReader = new StreamReader(fileStream))
+                        {
+                            SkeletonJson json = new SkeletonJson(atlas);
+                            return json.ReadSkeletonData(streamReader);
+                        }
+                    }
+                }
+            });
+        }
+
+        /// <summary>
+        /// Releases a skeleton data.
+        /// </summary>
+        /// <param name="skeletonData">The skeleton data.</param>
+        public static void ReleaseSkeletonData(SkeletonData skeletonData)
+        {
+            if (references.Release(skeletonData))
+            {
+                lock (lockObject)
+                {
+                    var keys = new List<Tuple<SkeletonData, string, Animation>>();
+                    foreach (var key in animationBounds.Keys)
+                    {
+                        if (key.Item1 == skeletonData)
+                        {
+                            keys.Add(key);
+                        }
+                    }
+
+                    foreach (var key in keys)
+                    {
+                        animationBounds.Remove(key);
+                    }
+
+                    var bakedKeys = new List<Tuple<SkeletonData, string, Animation, float>>();
+                    foreach (var key in bakedAnimations.Keys)
+                    {
+                        if (key.Item1 == skeletonData)
+                        {
+                            bakedKeys.Add(key);
+                        }
+                    }
+
+                    foreach (var key in bakedKeys)
+                    {
+                        bakedAnimations.Remove(key);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the bounds, in skeleton space, that contain every pose of an animation. The bounds are computed the first time
+        /// by sampling the animation, so they can be used to test the visibility of a skeleton without updating its pose.
+        /// </summary>
+        /// <param name="skeletonData">The skeleton data.</param>
+        /// <param name="skinName">The name of the skin, or null for the default skin.</param>
+        /// <param name="animation">The animation, or null for the setup pose.</param>
+        /// <returns>The bounds of the animation</returns>
+        public static BoundingBox GetAnimationBounds(SkeletonData skeletonData, string skinName, Animation animation)
+        {
+            var key = Tuple.Create(skeletonData, skinName, animation);
+
+            lock (lockObject)
+            {
+                BoundingBox bounds;
+                if (!animationBounds.TryGetValue(key, out bounds))
+                {
+                    bounds = ComputeAnimationBounds(skeletonData, skinName, animation);
+                    animationBounds.Add(key, bounds);
+                }
+
+                return bounds;
+            }
+        }
+
+        /// <summary>
+        /// Gets the baked tables of an animation, baking it the first time.
+        /// </summary>
+        /// <param name="skeletonData">The skeleton data.</param>
+        /// <param name="skinName">The name of the skin, or null for the default skin.</param>
+        /// <param name="animation">The animation.</param>
+        /// <param name="sampleRate">The number of frames per second.</param>
+        /// <returns>The baked animation</returns>
+        public static SpineBakedAnimation GetBakedAnimation(SkeletonData skeletonData, string skinName, Animation animation, float sampleRate)
+        {
+            var key = Tuple.Create(skeletonData, skinName, animation, sampleRate);
+
+            lock (lockObject)
+            {
+                SpineBakedAnimation bakedAnimation;
+                if (!bakedAnimations.TryGetValue(key, out bakedAnimation))
+                {
+                    bakedAnimation = SpineBakedAnimation.Bake(skeletonData, skinName, animation, sampleRate);
+                    bakedAnimations.Add(key, bakedAnimation);
+                }
+
+                return bakedAnimation;
+            }
+        }
+
+        /// <summary>
+        /// Computes the world vertices of the attachment of a slot, as pairs of coordinates in Spine space.
+        /// </summary>
+        /// <param name="slot">The slot.</param>
+        /// <param name="vertices">The buffer where the vertices are stored. It grows if needed.</param>
+        /// <returns>The number of coordinates stored, or 0 if the attachment is not drawn</returns>
+        public static int ComputeWorldVertices(Slot slot, ref float[] vertices)
+        {
+            var attachment = slot.Attachment;
+            int length = 0;
+
+            if (attachment is RegionAttachment)
+            {
+                length = 8;
+                EnsureVertices(ref vertices, length);
+                ((RegionAttachment)attachment).ComputeWorldVertices(slot.Bone, vertices);
+            }
+            else if (attachment is MeshAttachment)
+            {
+                var mesh = (MeshAttachment)attachment;
+                length = mesh.Vertices.Length;
+                EnsureVertices(ref vertices, length);
+                mesh.ComputeWorldVertices(slot, vertices);
+            }
+            else if (attachment is WeightedMeshAttachment)
+            {
+                var mesh = (WeightedMeshAttachment)attachment;
+                length = mesh.UVs.Length;
+                EnsureVertices(ref vertices, length);
+                mesh.ComputeWorldVertices(slot, vertices);
+            }
+
+            return length;
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Computes the bounds of an animation sampling its poses on a temporary skeleton
+        /// </summary>
+        /// <param name="skeletonData">The skeleton data.</param>
+        /// <param name="skinName">The name of the skin, or null for the default skin.</param>
+        /// <param name="animation">The animation, or null for the setup pose.</param>
+        /// <returns>The bounds of the animation</returns>
+        private static BoundingBox ComputeAnimationBounds(SkeletonData skeletonData, string skinName, Animation animation)
+        {
+            var skeleton = new Skeleton(skeletonData);
+            if (!string.IsNullOrEmpty(skinName))
+            {
+                skeleton.SetSkin(skinName);
+            }
+
+            skeleton.SetToSetupPose();
+
+            var min = new Vector3(float.MaxValue);
+            var max = new Vector3(float.MinValue);
+            var events = new ExposedList<Event>();
+            int samples = animation != null ? AnimationBoundsSamples : 1;
+
+            for (int s = 0; s < samples; s++)
+            {
+                if (animation != null)
+                {
+                    float time = animation.Duration * s / (samples - 1);
+                    animation.Apply(skeleton, time, time, false, events);
+                    events.Clear();
+                }
+
+                skeleton.UpdateWorldTransform();
+
+                var slots = skeleton.Slots;
+                for (int i = 0; i < slots.Count; i++)
+                {
+                    AddAttachmentBounds(slots.Items[i], ref min, ref max);
+                }
+            }
+
+            if (min.X > max.X)
+            {
+                return new BoundingBox(Vector3.Zero, Vector3.Zero);
+            }
+
+            return new BoundingBox(min, max);
+        }
+
+        /// <summary>
+        /// Expands the bounds with the vertices of the attachment of a slot
+        /// </summary>
+        /// <param name="slot">The slot.</param>
+        /// <param name="min">The minimum of the bounds.</param>
+        /// <param name="max">The maximum of the bounds.</param>
+        private static void AddAttachmentBounds(Slot slot, ref Vector3 min, ref Vector3 max)
+        {
+            int length = ComputeWorldVertices(slot, ref boundsVertices);
+
+            // The Y axis is flipped as in the renderer
+            for (int v = 0; v < length; v += 2)
+            {
+                var position = new Vector3(boundsVertices[v], -boundsVertices[v + 1], 0);
+                Vector3.Min(ref min, ref position, out min);
+                Vector3.Max(ref max, ref position, out max);
+            }
+        }
+
+        /// <summary>
+        /// Grows a vertices buffer if needed
+        /// </summary>
+        /// <param name="vertices">The vertices buffer.</param>
+        /// <param name="length">The required length.</param>
+        private static void EnsureVertices(ref float[] vertices, int length)
+        {
+            if (vertices.Length < length)
+            {
+                vertices = new float[Math.Max(vertices.Length * 2, length)];
+            }
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,152 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+#endregion
+
+namespace WaveEngine.Spine
+{
+    /// <summary>
+    /// Reference counted store of shared resources, keyed by the object they depend on and their path.
+    /// A resource is loaded by the first acquire and removed when it has been released as many times as it was acquired.
+    /// </summary>
+    internal class SpineResourceReferences
+    {
+        /// <summary>
+        /// The lock of the store
+        /// </summary>
+        private readonly object lockObject = new object();
+
+        /// <summary>
+        /// The entries by owner and path
+        /// </summary>
+        private readonly Dictionary<Tuple<object, string>, Entry> entriesByKey = new Dictionary<Tuple<object, string>, Entry>();
+
+        /// <summary>
+        /// The entries by resource
+        /// </summary>
+        private readonly Dictionary<object, Entry> entriesByResource = new Dictionary<object, Entry>();
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the number of resources in use
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                lock (this.lockObject)
+                {
+                    return this.entriesByResource.Count;
+                }
+            }
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Gets a stored resource, or loads it if it is not stored, and adds a reference to it
+        /// </summary>
+        /// <param name="owner">The object the resource depends on.</param>
+        /// <param name="path">The resource path.</param>
+        /// <param name="load">The function that loads the resource.</param>
+        /// <returns>The resource</returns>
+        public object Acquire(object owner, string path, Func<object> load)
+        {
+            var key = Tuple.Create(owner, path);
+
+            lock (this.lockObject)
+            {
+                Entry entry;
+                if (!this.entriesByKey.TryGetValue(key, out entry))
+                {
+                    entry = new Entry()
+                    {
+                        Key = key,
+                        Resource = load(),
+                    };
+
+                    this.entriesByKey.Add(key, entry);
+                    this.entriesByResource.Add(entry.Resource, entry);
+                }
+
+                entry.References++;
+                return entry.Resource;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of references to a resource
+        /// </summary>
+        /// <param name="resource">The resource.</param>
+        /// <returns>The number of references, or 0 if the resource is not stored</returns>
+        public int GetReferences(object resource)
+        {
+            lock (this.lockObject)
+            {
+                Entry entry;
+                if (resource == null || !this.entriesByResource.TryGetValue(resource, out entry))
+                {
+                    return 0;
+                }
+
+                return entry.References;
+            }
+        }
+
+        /// <summary>
+        /// Removes a reference to a resource
+        /// </summary>
+        /// <param name="resource">The resource.</param>
+        /// <returns>True if the resource is no longer used and has been removed, false in other case</returns>
+        public bool Release(object resource)
+        {
+            lock (this.lockObject)
+            {
+                Entry entry;
+                if (resource == null || !this.entriesByResource.TryGetValue(resource, out entry))
+                {
+                    return false;
+                }
+
+                entry.References--;
+                if (entry.References > 0)
+                {
+                    return false;
+                }
+
+                this.entriesByKey.Remove(entry.Key);
+                this.entriesByResource.Remove(resource);
+                return true;
+            }
+        }
+        #endregion
+
+        #region Private Classes
+
+        /// <summary>
+        /// A stored resource
+        /// </summary>
+        private class Entry
+        {
+            /// <summary>
+            /// The key
+            /// </summary>
+            public Tuple<object, string> Key;
+
+            /// <summary>
+            /// The resource
+            /// </summary>
+            public object Resource;
+
+            /// <summary>
+            /// Number of references to the resource
+            /// </summary>
+            public int References;
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,282 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+using WaveEngine.Common.Graphics;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.Spine.Tests
+{
+    /// <summary>
+    /// Tests the vertex and index streams built for the attachments of a skeleton
+    /// </summary>
+    [TestFixture]
+    public class SkeletalBatchBuilderTests
+    {
+        /// <summary>
+        /// Number of attachments of the characters built by <see cref="BuildCharacter"/>
+        /// </summary>
+        internal const int CharacterAttachments = 40;
+
+        /// <summary>
+        /// Number of vertices of the mesh attachments of the characters built by <see cref="BuildCharacter"/>
+        /// </summary>
+        internal const int MeshVertices = 32;
+
+        /// <summary>
+        /// The corners of a region are emitted in the order TL, TR, BR, BL, reading the Spine texture coordinates X1, X4, X3, X2.
+        /// </summary>
+        [Test]
+        public void AppendQuadMapsTheRegionCorners()
+        {
+            var builder = new SkeletalBatchBuilder<string>();
+            var positions = new[] { new Vector3(0, 0, 0), new Vector3(1, 0, 0), new Vector3(1, 1, 0), new Vector3(0, 1, 0) };
+            var regionUVs = new float[] { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f };
+
+            builder.Begin();
+            builder.AppendQuad("page", 0, positions, regionUVs, Color.White);
+            builder.End();
+
+            var segment = builder.Segments[0];
+            Assert.AreEqual(4, segment.VertexCount);
+            Assert.AreEqual(6, segment.IndexCount);
+
+            Assert.AreEqual(0.1f, segment.Vertices[0].TexCoord.X);
+            Assert.AreEqual(0.7f, segment.Vertices[1].TexCoord.X);
+            Assert.AreEqual(0.5f, segment.Vertices[2].TexCoord.X);
+            Assert.AreEqual(0.3f, segment.Vertices[3].TexCoord.X);
+            Assert.AreEqual(0.4f, segment.Vertices[3].TexCoord.Y);
+            Assert.AreEqual(1f, segment.Vertices[2].Position.Y);
+
+            CollectionAssert.AreEqual(new ushort[] { 0, 3, 1, 1, 3, 2 }, Slice(segment.Indices, 0, 6));
+        }
+
+        /// <summary>
+        /// Consecutive attachments of the same atlas page are drawn in one batch, and a new batch starts when the page changes.
+        /// </summary>
+        [Test]
+        public void ConsecutiveAttachmentsOfTheSamePageShareABatch()
+        {
+            var builder = new SkeletalBatchBuilder<string>();
+            var positions = new Vector3[4];
+            var regionUVs = new float[8];
+
+            builder.Begin();
+            builder.AppendQuad("a", 0, positions, regionUVs, Color.White);
+            builder.AppendQuad("a", 1, positions, regionUVs, Color.White);
+            builder.AppendQuad("b", 2, positions, regionUVs, Color.White);
+            builder.AppendQuad("a", 3, positions, regionUVs, Color.White);
+            builder.End();
+
+            Assert.AreEqual(1, builder.UsedSegments);
+            var segment = builder.Segments[0];
+            Assert.AreEqual(3, segment.BatchCount);
+
+            var first = segment.Batches[0];
+            Assert.AreEqual("a", first.Material);
+            Assert.AreEqual(0, first.FirstSlot);
+            Assert.AreEqual(0, first.StartIndex);
+            Assert.AreEqual(4, first.PrimitiveCount);
+
+            var second = segment.Batches[1];
+            Assert.AreEqual("b", second.Material);
+            Assert.AreEqual(2, second.FirstSlot);
+            Assert.AreEqual(12, second.StartIndex);
+            Assert.AreEqual(2, second.PrimitiveCount);
+
+            var third = segment.Batches[2];
+            Assert.AreEqual("a", third.Material);
+            Assert.AreEqual(3, third.FirstSlot);
+            Assert.AreEqual(18, third.StartIndex);
+        }
+
+        /// <summary>
+        /// The indices of an attachment point at its own vertices, after the ones already written in the segment.
+        /// </summary>
+        [Test]
+        public void MeshIndicesAreOffsetByThePreviousVertices()
+        {
+            var builder = new SkeletalBatchBuilder<string>();
+            var positions = new Vector3[4];
+            var uvs = new float[8];
+
+            builder.Begin();
+            builder.AppendQuad("a", 0, positions, uvs, Color.White);
+            builder.AppendMesh("a", 1, positions, 3, uvs, new[] { 0, 1, 2 }, Color.White);
+            builder.End();
+
+            var segment = builder.Segments[0];
+            Assert.AreEqual(7, segment.VertexCount);
+            CollectionAssert.AreEqual(new ushort[] { 4, 5, 6 }, Slice(segment.Indices, 6, 3));
+            Assert.AreEqual(1, segment.BatchCount);
+            Assert.AreEqual(3, segment.Batches[0].PrimitiveCount);
+        }
+
+        /// <summary>
+        /// An attachment whose vertices would not be addressable by 16 bit indices starts a new segment.
+        /// </summary>
+        [Test]
+        public void VerticesBeyondSixteenBitIndicesOpenANewSegment()
+        {
+            var builder = new SkeletalBatchBuilder<string>();
+            int vertexCount = 40000;
+            var positions = new Vector3[vertexCount];
+            var uvs = new float[vertexCount * 2];
+            var triangles = new[] { 0, 1, vertexCount - 1 };
+
+            builder.Begin();
+            builder.AppendMesh("a", 0, positions, vertexCount, uvs, triangles, Color.White);
+            builder.AppendMesh("a", 1, positions, vertexCount, uvs, triangles, Color.White);
+            builder.End();
+
+            Assert.AreEqual(2, builder.UsedSegments);
+            for (int i = 0; i < builder.UsedSegments; i++)
+            {
+                var segment = builder.Segments[i];
+                Assert.AreEqual(vertexCount, segment.VertexCount);
+                Assert.AreEqual(1, segment.BatchCount);
+                Assert.AreEqual(vertexCount - 1, (int)segment.Indices[2]);
+            }
+
+            Assert.AreEqual(1, builder.Segments[1].Batches[0].FirstSlot);
+        }
+
+        /// <summary>
+        /// Building the same character again reuses the streams and batches of the previous frame.
+        /// </summary>
+        [Test]
+        public void BuildingAgainReusesTheStreams()
+        {
+            var builder = new SkeletalBatchBuilder<string>();
+            var pages = new[] { "a", "b", "c" };
+            var positions = new Vector3[MeshVertices];
+            var uvs = new float[MeshVertices * 2];
+            var triangles = CreateFanTriangles(MeshVertices);
+
+            BuildCharacter(builder, pages, positions, uvs, triangles, 0);
+            var vertices = builder.Segments[0].Vertices;
+            int vertexCount = builder.Segments[0].VertexCount;
+            int batchCount = builder.Segments[0].BatchCount;
+
+            BuildCharacter(builder, pages, positions, uvs, triangles, 1);
+            Assert.AreSame(vertices, builder.Segments[0].Vertices);
+            Assert.AreEqual(vertexCount, builder.Segments[0].VertexCount);
+            Assert.AreEqual(batchCount, builder.Segments[0].BatchCount);
+            Assert.AreEqual(1, builder.UsedSegments);
+        }
+
+        /// <summary>
+        /// Once the streams have grown to the size of a character, building it again every frame allocates nothing.
+        /// </summary>
+        [Test]
+        public void SteadyStateBuildDoesNotAllocate()
+        {
+            var builder = new SkeletalBatchBuilder<string>();
+            var pages = new[] { "a", "b", "c" };
+            var positions = new Vector3[MeshVertices];
+            var uvs = new float[MeshVertices * 2];
+            var triangles = CreateFanTriangles(MeshVertices);
+
+            Action frames = () =>
+            {
+                for (int frame = 0; frame < 1000; frame++)
+                {
+                    BuildCharacter(builder, pages, positions, uvs, triangles, frame * 0.01f);
+                }
+            };
+
+            // The first frames grow the streams and the batch lists, and let the JIT settle
+            frames();
+
+            Assert.AreEqual(0, MeasureAllocatedBytes(frames));
+        }
+
+        /// <summary>
+        /// Measures the managed memory allocated by an action
+        /// </summary>
+        /// <param name="action">The action.</param>
+        /// <returns>The allocated bytes</returns>
+        internal static long MeasureAllocatedBytes(Action action)
+        {
+            // The allocation counter of the domain is brought up to date by a collection
+            AppDomain.MonitoringIsEnabled = true;
+            GC.Collect();
+            long before = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+
+            action();
+
+            GC.Collect();
+            return AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize - before;
+        }
+
+        /// <summary>
+        /// Builds the streams of a character with <see cref="CharacterAttachments"/> attachments spread over the atlas pages,
+        /// where one of every four attachments is a mesh.
+        /// </summary>
+        /// <param name="builder">The builder.</param>
+        /// <param name="pages">The materials of the atlas pages.</param>
+        /// <param name="positions">Scratch buffer for the vertex positions, with room for <see cref="MeshVertices"/>.</param>
+        /// <param name="uvs">The texture coordinates of the mesh attachments.</param>
+        /// <param name="triangles">The triangle indices of the mesh attachments.</param>
+        /// <param name="offset">An offset applied to the positions, standing for the pose of the frame.</param>
+        internal static void BuildCharacter(SkeletalBatchBuilder<string> builder, string[] pages, Vector3[] positions, float[] uvs, int[] triangles, float offset)
+        {
+            builder.Begin();
+
+            for (int i = 0; i < CharacterAttachments; i++)
+            {
+                string page = pages[(i / 8) % pages.Length];
+                bool isMesh = (i % 4) == 3;
+                int vertexCount = isMesh ? MeshVertices : 4;
+
+                for (int j = 0; j < vertexCount; j++)
+                {
+                    positions[j] = new Vector3(offset + i + (j % 4), offset + (j / 4), 0);
+                }
+
+                if (isMesh)
+                {
+                    builder.AppendMesh(page, i, positions, vertexCount, uvs, triangles, Color.White);
+                }
+                else
+                {
+                    builder.AppendQuad(page, i, positions, uvs, Color.White);
+                }
+            }
+
+            builder.End();
+        }
+
+        /// <summary>
+        /// Creates the indices of a triangle fan
+        /// </summary>
+        /// <param name="vertexCount">The number of vertices of the fan.</param>
+        /// <returns>The indices</returns>
+        internal static int[] CreateFanTriangles(int vertexCount)
+        {
+            var triangles = new int[(vertexCount - 2) * 3];
+            for (int i = 0; i < vertexCount - 2; i++)
+            {
+                triangles[i * 3] = 0;
+                triangles[(i * 3) + 1] = i + 1;
+                triangles[(i * 3) + 2] = i + 2;
+            }
+
+            return triangles;
+        }
+
+        /// <summary>
+        /// Copies a range of an array
+        /// </summary>
+        /// <param name="array">The array.</param>
+        /// <param name="start">The first element of the range.</param>
+        /// <param name="length">The length of the range.</param>
+        /// <returns>The copy of the range</returns>
+        private static ushort[] Slice(ushort[] array, int start, int length)
+        {
+            var slice = new ushort[length];
+            Array.Copy(array, start, slice, 0, length);
+            return slice;
+        }
+    }
+}
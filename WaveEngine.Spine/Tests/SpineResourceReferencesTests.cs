@@ -0,0 +1,104 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System.IO;
+using NUnit.Framework;
+
+namespace WaveEngine.Spine.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="SpineResourceReferences"/>
+    /// </summary>
+    [TestFixture]
+    public class SpineResourceReferencesTests
+    {
+        /// <summary>
+        /// Acquiring the same path of the same owner loads the resource once and shares it.
+        /// </summary>
+        [Test]
+        public void AcquireSharesTheResourceOfTheSameOwnerAndPath()
+        {
+            var references = new SpineResourceReferences();
+            var owner = new object();
+            int loads = 0;
+
+            var first = references.Acquire(owner, "hero.atlas", () => { loads++; return new object(); });
+            var second = references.Acquire(owner, "hero.atlas", () => { loads++; return new object(); });
+
+            Assert.AreSame(first, second);
+            Assert.AreEqual(1, loads);
+            Assert.AreEqual(2, references.GetReferences(first));
+            Assert.AreEqual(1, references.Count);
+        }
+
+        /// <summary>
+        /// The same path of different owners, like atlases of different assets containers, are different resources.
+        /// </summary>
+        [Test]
+        public void AcquireLoadsTheSamePathOfAnotherOwnerAgain()
+        {
+            var references = new SpineResourceReferences();
+
+            var first = references.Acquire(new object(), "hero.atlas", () => new object());
+            var second = references.Acquire(new object(), "hero.atlas", () => new object());
+
+            Assert.AreNotSame(first, second);
+            Assert.AreEqual(2, references.Count);
+        }
+
+        /// <summary>
+        /// A resource is removed by the release that matches its last acquire, and is loaded again afterwards.
+        /// </summary>
+        [Test]
+        public void ReleaseRemovesTheResourceWithTheLastReference()
+        {
+            var references = new SpineResourceReferences();
+            var owner = new object();
+
+            var resource = references.Acquire(owner, "hero.json", () => new object());
+            references.Acquire(owner, "hero.json", () => new object());
+
+            Assert.IsFalse(references.Release(resource));
+            Assert.AreEqual(1, references.GetReferences(resource));
+
+            Assert.IsTrue(references.Release(resource));
+            Assert.AreEqual(0, references.GetReferences(resource));
+            Assert.AreEqual(0, references.Count);
+
+            var reloaded = references.Acquire(owner, "hero.json", () => new object());
+            Assert.AreNotSame(resource, reloaded);
+            Assert.AreEqual(1, references.GetReferences(reloaded));
+        }
+
+        /// <summary>
+        /// Releasing a resource that is not stored, or has already been removed, does nothing.
+        /// </summary>
+        [Test]
+        public void ReleaseIgnoresUnknownResources()
+        {
+            var references = new SpineResourceReferences();
+            var resource = references.Acquire(new object(), "hero.json", () => new object());
+            Assert.IsTrue(references.Release(resource));
+
+            Assert.IsFalse(references.Release(resource));
+            Assert.IsFalse(references.Release(new object()));
+            Assert.IsFalse(references.Release(null));
+            Assert.AreEqual(0, references.Count);
+        }
+
+        /// <summary>
+        /// A load that throws does not leave an entry behind, so the next acquire tries to load again.
+        /// </summary>
+        [Test]
+        public void FailedLoadIsNotStored()
+        {
+            var references = new SpineResourceReferences();
+            var owner = new object();
+
+            Assert.Throws<FileNotFoundException>(() => references.Acquire(owner, "missing.atlas", () => { throw new FileNotFoundException(); }));
+            Assert.AreEqual(0, references.Count);
+
+            var resource = references.Acquire(owner, "missing.atlas", () => new object());
+            Assert.AreEqual(1, references.GetReferences(resource));
+        }
+    }
+}
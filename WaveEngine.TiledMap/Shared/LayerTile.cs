@@ -6,17 +6,61 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
-using TiledSharp;
 using WaveEngine.Common.Math;
 #endregion
 
 namespace WaveEngine.TiledMap
 {
     /// <summary>
-    /// Represent a single Tile in a Layer
+    /// Represent a single Tile in a Layer. It is a lightweight view over the packed tile data of the layer.
     /// </summary>
-    public class LayerTile
+    public struct LayerTile
     {
+        /// <summary>
+        /// Packed bit indicating horizontal flip, as stored by the TMX format
+        /// </summary>
+        internal const uint FlippedHorizontallyFlag = 0x80000000;
+
+        /// <summary>
+        /// Packed bit indicating vertical flip, as stored by the TMX format
+        /// </summary>
+        internal const uint FlippedVerticallyFlag = 0x40000000;
+
+        /// <summary>
+        /// Packed bit indicating diagonal flip, as stored by the TMX format
+        /// </summary>
+        internal const uint FlippedDiagonallyFlag = 0x20000000;
+
+        /// <summary>
+        /// Mask of the global tile ID in the packed data
+        /// </summary>
+        internal const uint GidMask = 0x1FFFFFFF;
+
+        /// <summary>
+        /// The X coordinate of the tile
+        /// </summary>
+        private readonly int x;
+
+        /// <summary>
+        /// The Y coordinate of the tile
+        /// </summary>
+        private readonly int y;
+
+        /// <summary>
+        /// The packed global tile ID and flip bits
+        /// </summary>
+        private readonly uint data;
+
+        /// <summary>
+        /// The associated tileset
+        /// </summary>
+        private readonly Tileset tileset;
+
+        /// <summary>
+        /// The tile local position
+        /// </summary>
+        private readonly Vector2 localPosition;
+
         #region Properties
 
         /// <summary>
@@ -24,8 +68,15 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public int Id
         {
-            get;
-            private set;
+            get { return this.tileset != null ? this.Gid - this.tileset.FirstGid : 0; }
+        }
+
+        /// <summary>
+        /// Gets the global tile ID, or 0 for an empty tile.
+        /// </summary>
+        public int Gid
+        {
+            get { return (int)(this.data & GidMask); }
         }
 
         /// <summary>
@@ -33,8 +84,7 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public int X
         {
-            get;
-            private set;
+            get { return this.x; }
         }
 
         /// <summary>
@@ -42,8 +92,7 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public int Y
         {
-            get;
-            private set;
+            get { return this.y; }
         }
 
         /// <summary>
@@ -51,8 +100,7 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public bool HorizontalFlip
         {
-            get;
-            private set;
+            get { return (this.data & FlippedHorizontallyFlag) != 0; }
         }
 
         /// <summary>
@@ -60,8 +108,7 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public bool VerticalFlip
         {
-            get;
-            private set;
+            get { return (this.data & FlippedVerticallyFlag) != 0; }
         }
 
         /// <summary>
@@ -69,8 +116,7 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public bool DiagonalFlip
         {
-            get;
-            private set;
+            get { return (this.data & FlippedDiagonallyFlag) != 0; }
         }
 
         /// <summary>
@@ -78,8 +124,7 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public Tileset Tileset
         {
-            get;
-            private set;
+            get { return this.tileset; }
         }
 
         /// <summary>
@@ -87,8 +132,7 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public TilesetTile TilesetTile
         {
-            get;
-            private set;
+            get { return this.tileset != null ? this.tileset.TilesTable[this.Id] : null; }
         }
 
         /// <summary>
@@ -96,33 +140,27 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public Vector2 LocalPosition
         {
-            get;
-            internal set;
+            get { return this.localPosition; }
         }
         #endregion
 
         #region Initialization
 
         /// <summary>
-        /// Initializes a new instance of the <see cref="LayerTile" /> class.
-        /// </summary>>
-        /// <param name="tmxTile">The TMX parsed tile.</param>
-        /// <param name="tileset">Th</param>
-        public LayerTile(TmxLayerTile tmxTile, Tileset tileset)
+        /// Initializes a new instance of the <see cref="LayerTile" /> struct.
+        /// </summary>
+        /// <param name="x">The X coordinate of the tile.</param>
+        /// <param name="y">The Y coordinate of the tile.</param>
+        /// <param name="data">The packed global tile ID and flip bits.</param>
+        /// <param name="tileset">The tileset that contains the global tile ID.</param>
+        /// <param name="localPosition">The tile local position.</param>
+        internal LayerTile(int x, int y, uint data, Tileset tileset, Vector2 localPosition)
         {
-            this.X = tmxTile.X;
-            this.Y = tmxTile.Y;
-            this.HorizontalFlip = tmxTile.HorizontalFlip;
-            this.VerticalFlip = tmxTile.VerticalFlip;
-            this.DiagonalFlip = tmxTile.DiagonalFlip;
-
-            if (tileset != null)
-            {
-                this.Tileset = tileset;
-                this.Id = tmxTile.Gid - this.Tileset.FirstGid;
-
-                this.TilesetTile = this.Tileset.TilesTable[this.Id];
-            }
+            this.x = x;
+            this.y = y;
+            this.data = data;
+            this.tileset = tileset;
+            this.localPosition = localPosition;
         }
         #endregion
 
@@ -139,5 +177,38 @@ namespace WaveEngine.TiledMap
             return string.Format("{0}, {1} [{2}]", this.X, this.Y, this.Id);
         }
         #endregion
+
+        #region Internal Methods
+
+        /// <summary>
+        /// Packs a global tile ID and its flip flags into a single value
+        /// </summary>
+        /// <param name="gid">The global tile ID.</param>
+        /// <param name="horizontalFlip">Whether the tile has horizontal flip.</param>
+        /// <param name="verticalFlip">Whether the tile has vertical flip.</param>
+        /// <param name="diagonalFlip">Whether the tile has diagonal flip.</param>
+        /// <returns>The packed tile data</returns>
+        internal static uint Pack(int gid, bool horizontalFlip, bool verticalFlip, bool diagonalFlip)
+        {
+            uint data = (uint)gid & GidMask;
+
+            if (horizontalFlip)
+            {
+                data |= FlippedHorizontallyFlag;
+            }
+
+            if (verticalFlip)
+            {
+                data |= FlippedVerticallyFlag;
+            }
+
+            if (diagonalFlip)
+            {
+                data |= FlippedDiagonallyFlag;
+            }
+
+            return data;
+        }
+        #endregion
     }
 }
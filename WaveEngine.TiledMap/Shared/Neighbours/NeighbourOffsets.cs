@@ -0,0 +1,127 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Text;
+using WaveEngine.Common.Math;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// Precomputed neighbour offsets for each map orientation, in the same clockwise order as <see cref="NeighboursCollection"/>.
+    /// An offset of (0, 0) means that there is no neighbour in that direction.
+    /// </summary>
+    internal static class NeighbourOffsets
+    {
+        /// <summary>
+        /// Number of neighbour directions
+        /// </summary>
+        public const int Count = 8;
+
+        /// <summary>
+        /// Offsets of orthogonal and isometric maps
+        /// </summary>
+        private static readonly Point[] Orthogonal = new Point[]
+        {
+            new Point(0, -1), new Point(1, -1), new Point(1, 0), new Point(1, 1),
+            new Point(0, 1), new Point(-1, 1), new Point(-1, 0), new Point(-1, -1),
+        };
+
+        /// <summary>
+        /// Offsets of staggered maps, indexed by stagger axis (X, Y) and parity (shifted, not shifted)
+        /// </summary>
+        private static readonly Point[][] Staggered = new Point[][]
+        {
+            new Point[]
+            {
+                new Point(1, -1), new Point(2, 0), new Point(1, 0), new Point(0, 1),
+                new Point(-1, 0), new Point(-2, 0), new Point(-1, -1), new Point(0, -1),
+            },
+            new Point[]
+            {
+                new Point(1, 0), new Point(2, 0), new Point(1, 1), new Point(0, 1),
+                new Point(-1, 1), new Point(-2, 0), new Point(-1, 0), new Point(0, -1),
+            },
+            new Point[]
+            {
+                new Point(0, -1), new Point(1, 0), new Point(0, 1), new Point(0, 2),
+                new Point(-1, 1), new Point(-1, 0), new Point(-1, -1), new Point(0, -2),
+            },
+            new Point[]
+            {
+                new Point(1, -1), new Point(1, 0), new Point(1, 1), new Point(0, 2),
+                new Point(0, 1), new Point(-1, 0), new Point(0, -1), new Point(0, -2),
+            },
+        };
+
+        /// <summary>
+        /// Offsets of hexagonal maps, indexed by stagger axis (X, Y) and parity (shifted, not shifted)
+        /// </summary>
+        private static readonly Point[][] Hexagonal = new Point[][]
+        {
+            new Point[]
+            {
+                new Point(0, -1), new Point(1, -1), new Point(0, 0), new Point(1, 0),
+                new Point(0, 1), new Point(-1, 0), new Point(0, 0), new Point(-1, -1),
+            },
+            new Point[]
+            {
+                new Point(0, -1), new Point(1, 0), new Point(0, 0), new Point(1, 1),
+                new Point(0, 1), new Point(-1, 1), new Point(0, 0), new Point(-1, 0),
+            },
+            new Point[]
+            {
+                new Point(0, 0), new Point(0, -1), new Point(1, 0), new Point(0, 1),
+                new Point(0, 0), new Point(-1, 1), new Point(-1, 0), new Point(-1, -1),
+            },
+            new Point[]
+            {
+                new Point(0, 0), new Point(1, -1), new Point(1, 0), new Point(1, 1),
+                new Point(0, 0), new Point(0, 1), new Point(-1, 0), new Point(0, -1),
+            },
+        };
+
+        /// <summary>
+        /// Gets the offset tables of a map, for shifted and not shifted rows or columns
+        /// </summary>
+        /// <param name="orientation">The map orientation.</param>
+        /// <param name="staggerAxis">The stagger axis.</param>
+        /// <param name="shiftedTable">The offsets of the shifted rows or columns.</param>
+        /// <param name="unshiftedTable">The offsets of the not shifted rows or columns.</param>
+        public static void GetTables(TiledMapOrientationType orientation, TiledMapStaggerAxisType staggerAxis, out Point[] shiftedTable, out Point[] unshiftedTable)
+        {
+            int axisIndex = staggerAxis == TiledMapStaggerAxisType.X ? 0 : 2;
+
+            switch (orientation)
+            {
+                case TiledMapOrientationType.Staggered:
+                    shiftedTable = Staggered[axisIndex];
+                    unshiftedTable = Staggered[axisIndex + 1];
+                    break;
+
+                case TiledMapOrientationType.Hexagonal:
+                    shiftedTable = Hexagonal[axisIndex];
+                    unshiftedTable = Hexagonal[axisIndex + 1];
+                    break;
+
+                default:
+                    shiftedTable = Orthogonal;
+                    unshiftedTable = Orthogonal;
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Checks whether a row or column uses the shifted offsets
+        /// </summary>
+        /// <param name="coordinate">The coordinate along the stagger axis.</param>
+        /// <param name="staggerIndex">The stagger index.</param>
+        /// <returns>True if the shifted table must be used, false in other case</returns>
+        public static bool IsShifted(int coordinate, TiledMapStaggerIndexType staggerIndex)
+        {
+            return ((coordinate & 1) == 0) == (staggerIndex == TiledMapStaggerIndexType.Odd);
+        }
+    }
+}
@@ -11,7 +11,7 @@ namespace WaveEngine.TiledMap
     /// <summary>
     /// NeighboursCollection
     /// </summary>
-    public abstract class NeighboursCollection : IEnumerable<LayerTile>
+    public abstract class NeighboursCollection : IEnumerable<LayerTile?>
     {
         /// <summary>
         /// The tile map layer
@@ -31,7 +31,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top neighbour.
         /// </value>
-        public abstract LayerTile Top { get; }
+        public abstract LayerTile? Top { get; }
 
         /// <summary>
         /// Gets the top right neighbour.
@@ -39,7 +39,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top right neighbour.
         /// </value>
-        public abstract LayerTile TopRight { get; }
+        public abstract LayerTile? TopRight { get; }
 
         /// <summary>
         /// Gets the right neighbour.
@@ -47,7 +47,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The right neighbour.
         /// </value>
-        public abstract LayerTile Right { get; }
+        public abstract LayerTile? Right { get; }
 
         /// <summary>
         /// Gets the bottom right neighbour.
@@ -55,7 +55,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom right neighbour.
         /// </value>
-        public abstract LayerTile BottomRight { get; }
+        public abstract LayerTile? BottomRight { get; }
 
         /// <summary>
         /// Gets the bottom neighbour.
@@ -63,7 +63,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom neighbour.
         /// </value>
-        public abstract LayerTile Bottom { get; }
+        public abstract LayerTile? Bottom { get; }
 
         /// <summary>
         /// Gets the bottom left neighbour.
@@ -71,7 +71,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom left neighbour.
         /// </value>
-        public abstract LayerTile BottomLeft { get; }
+        public abstract LayerTile? BottomLeft { get; }
 
         /// <summary>
         /// Gets the left neighbour.
@@ -79,7 +79,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The left neighbour.
         /// </value>
-        public abstract LayerTile Left { get; }
+        public abstract LayerTile? Left { get; }
 
         /// <summary>
         /// Gets the top left neighbour.
@@ -87,7 +87,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top left neighbour.
         /// </value>
-        public abstract LayerTile TopLeft { get; }
+        public abstract LayerTile? TopLeft { get; }
 
         /// <summary>
         /// Gets the <see cref="LayerTile"/> neighbour at the specified index. Starting from top neighbour in clockwise order.
@@ -97,7 +97,7 @@ namespace WaveEngine.TiledMap
         /// </value>
         /// <param name="index">The index.</param>
         /// <returns>Neighbour at the specified index. Starting from top neighbour in clockwise order.</returns>
-        public LayerTile this[int index]
+        public LayerTile? this[int index]
         {
             get
             {
@@ -137,7 +137,7 @@ namespace WaveEngine.TiledMap
         /// Gets the enumerator.
         /// </summary>
         /// <returns>IEnumerator_LayerTile</returns>
-        public IEnumerator<LayerTile> GetEnumerator()
+        public IEnumerator<LayerTile?> GetEnumerator()
         {
             for (int i = 0; i < 8; i++)
             {
@@ -21,7 +21,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top neighbour.
         /// </value>
-        public override LayerTile Top
+        public override LayerTile? Top
         {
             get { return this.tileMapLayer.GetLayerTileByMapCoordinates(this.center.X, this.center.Y - 1); }
         }
@@ -32,7 +32,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top right neighbour.
         /// </value>
-        public override LayerTile TopRight
+        public override LayerTile? TopRight
         {
             get { return this.tileMapLayer.GetLayerTileByMapCoordinates(this.center.X + 1, this.center.Y - 1); }
         }
@@ -43,7 +43,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The right neighbour.
         /// </value>
-        public override LayerTile Right
+        public override LayerTile? Right
         {
             get { return this.tileMapLayer.GetLayerTileByMapCoordinates(this.center.X + 1, this.center.Y); }
         }
@@ -54,7 +54,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom right neighbour.
         /// </value>
-        public override LayerTile BottomRight
+        public override LayerTile? BottomRight
         {
             get { return this.tileMapLayer.GetLayerTileByMapCoordinates(this.center.X + 1, this.center.Y + 1); }
         }
@@ -65,7 +65,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom neighbour.
         /// </value>
-        public override LayerTile Bottom
+        public override LayerTile? Bottom
         {
             get { return this.tileMapLayer.GetLayerTileByMapCoordinates(this.center.X, this.center.Y + 1); }
         }
@@ -76,7 +76,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom left neighbour.
         /// </value>
-        public override LayerTile BottomLeft
+        public override LayerTile? BottomLeft
         {
             get { return this.tileMapLayer.GetLayerTileByMapCoordinates(this.center.X - 1, this.center.Y + 1); }
         }
@@ -87,7 +87,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The left neighbour.
         /// </value>
-        public override LayerTile Left
+        public override LayerTile? Left
         {
             get { return this.tileMapLayer.GetLayerTileByMapCoordinates(this.center.X - 1, this.center.Y); }
         }
@@ -98,7 +98,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top left neighbour.
         /// </value>
-        public override LayerTile TopLeft
+        public override LayerTile? TopLeft
         {
             get { return this.tileMapLayer.GetLayerTileByMapCoordinates(this.center.X - 1, this.center.Y - 1); }
         }
@@ -31,7 +31,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top neighbour.
         /// </value>
-        public override LayerTile Top
+        public override LayerTile? Top
         {
             get
             {
@@ -72,7 +72,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top right neighbour.
         /// </value>
-        public override LayerTile TopRight
+        public override LayerTile? TopRight
         {
             get
             {
@@ -93,7 +93,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The right neighbour.
         /// </value>
-        public override LayerTile Right
+        public override LayerTile? Right
         {
             get
             {
@@ -134,7 +134,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom right neighbour.
         /// </value>
-        public override LayerTile BottomRight
+        public override LayerTile? BottomRight
         {
             get
             {
@@ -155,7 +155,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom neighbour.
         /// </value>
-        public override LayerTile Bottom
+        public override LayerTile? Bottom
         {
             get
             {
@@ -196,7 +196,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The bottom left neighbour.
         /// </value>
-        public override LayerTile BottomLeft
+        public override LayerTile? BottomLeft
         {
             get
             {
@@ -217,7 +217,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The left neighbour.
         /// </value>
-        public override LayerTile Left
+        public override LayerTile? Left
         {
             get
             {
@@ -258,7 +258,7 @@ namespace WaveEngine.TiledMap
         /// <value>
         /// The top left neighbour.
         /// </value>
-        public override LayerTile TopLeft
+        public override LayerTile? TopLeft
         {
             get
             {
@@ -1,6 +1,14 @@
 ﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
 
+using System.Runtime.CompilerServices;
 using WaveEngine.Common.Attributes;
 
+[assembly: InternalsVisibleTo("WaveEngine.TiledMap.Tests, PublicKey=" +
+    "0024000004800000940000000602000000240000525341310004000001000100632aab6143e1cc" +
+    "48df7eabb31b8714ecaa7e2549fe62d16f12ab977ce1975d2cb635b716902c06b1c07be49c3d30" +
+    "d49da7fbd27251997f9ed0ea3c2de045ddd933337929075ca4edfa54b63062e1829d38d15fc794" +
+    "279993c80e48c9b6653a39d813ab215197f0baa8ad5eeae3ab2ff4e601536d31200cc1c904e000" +
+    "78cf72b1")]
+
 // This line is necessary to mark this assembly as a Wave Engine game assembly
 [assembly: WaveEngineAssembly(WaveAssemblyUsage.Extension)]
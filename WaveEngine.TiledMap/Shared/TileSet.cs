@@ -4,6 +4,7 @@
 using System;
 using System.Collections.Generic;
 using System.Collections.ObjectModel;
+using System.IO;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
@@ -178,6 +179,11 @@ namespace WaveEngine.TiledMap
         /// <param name="tiledMap">The tiled map</param>
         public Tileset(TmxTileset tmxTileset, TiledMap tiledMap)
         {
+            if (tmxTileset.Image == null)
+            {
+                throw new NotSupportedException(string.Format("The tileset '{0}' is a collection of images, which is not supported by TiledMap. Use a tileset based on a single image.", tmxTileset.Name));
+            }
+
             this.tiledMap = tiledMap;
 
             this.Name = tmxTileset.Name;
@@ -215,9 +221,57 @@ namespace WaveEngine.TiledMap
                 this.TilesTable[tilesetTile.ID] = tilesetTile;
             }
 
-            string fullPath = tmxTileset.Image.Source;
-            string relativePath = fullPath.Substring(fullPath.IndexOf("Content"));
-            this.Image = this.tiledMap.Owner.Scene.Assets.LoadAsset<Texture2D>(relativePath);
+            this.Image = this.tiledMap.Owner.Scene.Assets.LoadAsset<Texture2D>(TiledMapCooker.GetContentRelativePath(tmxTileset.Image.Source));
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="Tileset" /> class.
+        /// </summary>
+        /// <param name="reader">The cooked map reader</param>
+        /// <param name="tiledMap">The tiled map</param>
+        internal Tileset(BinaryReader reader, TiledMap tiledMap)
+        {
+            this.tiledMap = tiledMap;
+
+            this.Name = reader.ReadString();
+            this.FirstGid = reader.ReadInt32();
+            this.TileWidth = reader.ReadInt32();
+            this.TileHeight = reader.ReadInt32();
+            this.Spacing = reader.ReadInt32();
+            this.Margin = reader.ReadInt32();
+
+            int imageWidth = reader.ReadInt32();
+            int imageHeight = reader.ReadInt32();
+            this.XTilesCount = (imageWidth - (2 * this.Margin) + this.Spacing) / (this.TileWidth + this.Spacing);
+            this.YTilesCount = (imageHeight - (2 * this.Margin) + this.Spacing) / (this.TileHeight + this.Spacing);
+            this.XDrawingOffset = reader.ReadInt32();
+            this.YDrawingOffset = reader.ReadInt32();
+            this.Colums = reader.ReadInt32();
+            this.LastGid = this.FirstGid + (this.XTilesCount * this.YTilesCount) - 1;
+
+            string imagePath = reader.ReadString();
+
+            this.terrains = new Dictionary<string, TilesetTerrain>();
+            this.Terrains = new ReadOnlyDictionary<string, TilesetTerrain>(this.terrains);
+            int terrainCount = reader.ReadInt32();
+            for (int i = 0; i < terrainCount; i++)
+            {
+                var terrain = new TilesetTerrain(reader);
+                this.terrains.Add(terrain.Name, terrain);
+            }
+
+            this.tiles = new List<TilesetTile>();
+            this.TilesTable = new TilesetTile[this.XTilesCount * this.YTilesCount];
+            int tileCount = reader.ReadInt32();
+            for (int i = 0; i < tileCount; i++)
+            {
+                var tilesetTile = new TilesetTile(reader, this);
+
+                this.tiles.Add(tilesetTile);
+                this.TilesTable[tilesetTile.ID] = tilesetTile;
+            }
+
+            this.Image = this.tiledMap.Owner.Scene.Assets.LoadAsset<Texture2D>(imagePath);
         }
         #endregion
 
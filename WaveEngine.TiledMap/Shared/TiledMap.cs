@@ -56,9 +56,19 @@ namespace WaveEngine.TiledMap
         private string tmxStreamAssetsPath;
 
         /// <summary>
-        /// The tmx parsed instance
+        /// The map has been loaded
         /// </summary>
-        internal TmxMap TmxMap;
+        private bool isMapLoaded;
+
+        /// <summary>
+        /// The map properties
+        /// </summary>
+        private Dictionary<string, string> properties;
+
+        /// <summary>
+        /// The tile layer data, in file order
+        /// </summary>
+        internal List<TiledMapLayerData> LayerData;
 
         /// <summary>
         /// The list of tilesets
@@ -95,7 +105,8 @@ namespace WaveEngine.TiledMap
         #region Properties
 
         /// <summary>
-        /// Gets or sets the Path of the Tiled Map TMX file
+        /// Gets or sets the Path of the Tiled Map TMX file. If a cooked map with the same name and the
+        /// <see cref="TiledMapCooker.CookedMapExtension"/> extension exists, it is loaded instead.
         /// </summary>
         [RenderPropertyAsAsset(AssetType.Unknown, ".tmx")]
         public string TmxPath
@@ -199,7 +210,7 @@ namespace WaveEngine.TiledMap
         {
             get
             {
-                return this.TmxMap.Properties;
+                return this.properties;
             }
         }
 
@@ -318,6 +329,7 @@ namespace WaveEngine.TiledMap
             this.maxLayerDrawOrder = 100;
 
             this.tilesets = new List<Tileset>();
+            this.LayerData = new List<TiledMapLayerData>();
             this.tileLayers = new Dictionary<string, TiledMapLayer>();
             this.objectLayers = new Dictionary<string, TiledMapObjectLayer>();
             this.imageLayers = new Dictionary<string, TiledMapImageLayer>();
@@ -359,7 +371,7 @@ namespace WaveEngine.TiledMap
         /// <param name="position">The tile position</param>
         internal void GetTilePosition(int x, int y, Tileset tileset, out Vector2 position)
         {
-            if (this.TmxMap == null)
+            if (!this.isMapLoaded)
             {
                 position = Vector2.Zero;
                 return;
@@ -439,7 +451,7 @@ namespace WaveEngine.TiledMap
             RectangleF rectangle = new RectangleF();
 
             Vector2 position;
-            this.GetTilePosition(this.TmxMap.Width, this.TmxMap.Height, null, out position);
+            this.GetTilePosition(this.Width, this.Height, null, out position);
 
             rectangle = new RectangleF(0, 0, position.X, position.Y);
 
@@ -454,199 +466,36 @@ namespace WaveEngine.TiledMap
         /// <param name="tileY">Out tile Y coordinate</param>
         public void GetTileCoordinatesByWorldPosition(Vector2 position, out int tileX, out int tileY)
         {
-            int sideLengthX = 0;
-            int sideLengthY = 0;
-            bool staggerX = this.StaggerAxis == TiledMapStaggerAxisType.X;
-            bool staggerEven = this.StaggerIndex == TiledMapStaggerIndexType.Even;
+            Matrix inverse = this.transform.WorldInverseTransform;
+            this.CreateCoordinateConverter().GetTileCoordinates(position, ref inverse, this.transform.DrawOrder, out tileX, out tileY);
+        }
 
-            if (this.Orientation == TiledMapOrientationType.Hexagonal)
+        /// <summary>
+        /// Get the Tile coordinates (x, y) of several world positions.
+        /// The inverse world transform and the map orientation are resolved once for the whole batch.
+        /// </summary>
+        /// <param name="positions">The world positions</param>
+        /// <param name="tileCoordinates">The array where the tile coordinates of each position are stored</param>
+        /// <param name="count">The number of positions to convert</param>
+        public void GetTileCoordinatesByWorldPositions(Vector2[] positions, Point[] tileCoordinates, int count)
+        {
+            if (positions == null)
             {
-                if (this.StaggerAxis == TiledMapStaggerAxisType.X)
-                {
-                    sideLengthX = this.HexSideLength;
-                }
-                else
-                {
-                    sideLengthY = this.HexSideLength;
-                }
+                throw new ArgumentNullException("positions");
             }
 
-            position = Vector3.Transform(position.ToVector3(this.transform.DrawOrder), this.transform.WorldInverseTransform).ToVector2();
-
-            Vector2 referencePosition = new Vector2(
-                position.X / (this.TileWidth + sideLengthX),
-                position.Y / (this.TileHeight + sideLengthY));
-
-            if (referencePosition.X < 0)
+            if (tileCoordinates == null)
             {
-                referencePosition.X -= 1;
+                throw new ArgumentNullException("tileCoordinates");
             }
 
-            if (referencePosition.Y < 0)
+            if (count < 0 || count > positions.Length || count > tileCoordinates.Length)
             {
-                referencePosition.Y -= 1;
+                throw new ArgumentOutOfRangeException("count");
             }
 
-            switch (this.Orientation)
-            {
-                case TiledMapOrientationType.Orthogonal:
-                    tileX = (int)referencePosition.X;
-                    tileY = (int)referencePosition.Y;
-                    break;
-
-                case TiledMapOrientationType.Isometric:
-                    float halfHeight = this.Height * 0.5f;
-                    tileX = (int)(-halfHeight + (referencePosition.X + referencePosition.Y));
-
-                    float y = halfHeight + (-referencePosition.X + referencePosition.Y);
-                    y = (y >= 0) ? y : y - 1;
-                    tileY = (int)y;
-                    break;
-
-                case TiledMapOrientationType.Staggered:
-
-                    if (staggerEven)
-                    {
-                        if (staggerX)
-                        {
-                            referencePosition.Y -= 0.5f;
-                        }
-                        else
-                        {
-                            referencePosition.X -= 0.5f;
-                        }
-                    }
-
-                    int coordX = (int)(-0.5f + (referencePosition.X + referencePosition.Y));
-
-                    y = 0.5f + (-referencePosition.X + referencePosition.Y);
-                    y = (y >= 0) ? y : y - 1;
-                    int coordY = (int)y;
-
-                    int evenOffset = staggerEven ? 1 : 0;
-
-                    if (staggerX)
-                    {
-                        tileX = coordX - coordY;
-                        tileY = (coordX + coordY + evenOffset) / 2;
-                    }
-                    else
-                    {
-                        tileX = (coordX - coordY + evenOffset) / 2;
-                        tileY = coordX + coordY;
-                    }
-
-                    break;
-
-                case TiledMapOrientationType.Hexagonal:
-                    Vector2 tileCoordinates = Vector2.Zero;
-                    var sideOffsetX = (this.TileWidth - sideLengthX) / 2;
-                    var sideOffsetY = (this.TileHeight - sideLengthY) / 2;
-
-                    if (staggerX)
-                    {
-                        position.X -= staggerEven ? this.TileWidth : sideOffsetX;
-                    }
-                    else
-                    {
-                        position.Y -= staggerEven ? this.TileHeight : sideOffsetY;
-                    }
-
-                    referencePosition = new Vector2(
-                        (float)Math.Floor(position.X / (this.TileWidth + sideLengthX)),
-                        (float)Math.Floor(position.Y / (this.TileHeight + sideLengthY)));
-
-                    // Relative x and y position on the base square of the grid-aligned tile
-                    Vector2 rel = new Vector2(
-                        position.X - (referencePosition.X * (this.TileWidth + sideLengthX)),
-                        position.Y - (referencePosition.Y * (this.TileHeight + sideLengthY)));
-
-                    // Adjust the reference point to the correct tile coordinates
-                    // Determine the nearest hexagon tile by the distance to the center
-                    Vector2[] centers = new Vector2[4];
-                    var columnWidth = sideOffsetX + sideLengthX;
-                    var rowHeight = sideOffsetY + sideLengthY;
-
-                    if (staggerX)
-                    {
-                        int left = sideLengthX / 2;
-                        int centerX = left + columnWidth;
-                        int centerY = this.TileHeight / 2;
-
-                        centers[0] = new Vector2(left, centerY);
-                        centers[1] = new Vector2(centerX, centerY - rowHeight);
-                        centers[2] = new Vector2(centerX, centerY + rowHeight);
-                        centers[3] = new Vector2(centerX + columnWidth, centerY);
-
-                        referencePosition.X *= 2;
-
-                        if (staggerEven)
-                        {
-                            referencePosition.X += 1;
-                        }
-                    }
-                    else
-                    {
-                        int top = sideLengthY / 2;
-                        int centerX = this.TileWidth / 2;
-                        int centerY = top + rowHeight;
-
-                        centers[0] = new Vector2(centerX, top);
-                        centers[1] = new Vector2(centerX - columnWidth, centerY);
-                        centers[2] = new Vector2(centerX + columnWidth, centerY);
-                        centers[3] = new Vector2(centerX, centerY + rowHeight);
-
-                        referencePosition.Y *= 2;
-
-                        if (staggerEven)
-                        {
-                            referencePosition.Y += 1;
-                        }
-                    }
-
-                    int nearest = 0;
-                    float minDist = float.MaxValue;
-
-                    for (int i = 0; i < 4; ++i)
-                    {
-                        Vector2 center = centers[i];
-                        float dc = (center - rel).LengthSquared();
-
-                        if (dc < minDist)
-                        {
-                            minDist = dc;
-                            nearest = i;
-                        }
-                    }
-
-                    var offsetsStaggerX = new Vector2[]
-                    {
-                        new Vector2(0,  0),
-                        new Vector2(+1, -1),
-                        new Vector2(+1,  0),
-                        new Vector2(+2,  0),
-                    };
-
-                    var offsetsStaggerY = new Vector2[]
-                    {
-                        new Vector2(0,  0),
-                        new Vector2(-1, +1),
-                        new Vector2(0, +1),
-                        new Vector2(0, +2),
-                    };
-
-                    var offsets = staggerX ? offsetsStaggerX : offsetsStaggerY;
-                    tileCoordinates = referencePosition + offsets[nearest];
-
-                    tileX = (int)tileCoordinates.X;
-                    tileY = (int)tileCoordinates.Y;
-                    break;
-
-                default:
-                    tileX = 0;
-                    tileY = 0;
-                    break;
-            }
+            Matrix inverse = this.transform.WorldInverseTransform;
+            this.CreateCoordinateConverter().GetTileCoordinates(positions, tileCoordinates, count, ref inverse, this.transform.DrawOrder);
         }
 
         /// <summary>
@@ -678,6 +527,22 @@ namespace WaveEngine.TiledMap
 
         #region Private Methods
 
+        /// <summary>
+        /// Creates the converter of local positions to tile coordinates of the map
+        /// </summary>
+        /// <returns>The converter</returns>
+        private TiledMapCoordinateConverter CreateCoordinateConverter()
+        {
+            return new TiledMapCoordinateConverter(
+                this.Orientation,
+                this.TileWidth,
+                this.TileHeight,
+                this.Height,
+                this.StaggerAxis,
+                this.StaggerIndex,
+                this.HexSideLength);
+        }
+
         /// <summary>
         /// Initializes Tiled Map
         /// </summary>
@@ -702,7 +567,9 @@ namespace WaveEngine.TiledMap
         /// </summary>
         private void UnloadTmxFile()
         {
-            this.TmxMap = null;
+            this.isMapLoaded = false;
+            this.properties = null;
+            this.LayerData.Clear();
 
             foreach (var tileset in this.tilesets)
             {
@@ -716,7 +583,7 @@ namespace WaveEngine.TiledMap
         }
 
         /// <summary>
-        /// Load TMX file
+        /// Load TMX file, or its cooked version if it exists
         /// </summary>
         private void LoadTmxFile()
         {
@@ -727,34 +594,28 @@ namespace WaveEngine.TiledMap
 
             try
             {
+                string cookedPath = null;
                 if (!string.IsNullOrEmpty(this.tmxPath))
                 {
-                    this.TmxMap = new TmxMap(new WaveDocumentLoader(), this.tmxPath);
-                }
-                else
-                {
-                    this.TmxMap = new TmxMap(new WaveDocumentLoader(), this.tmxStream, this.tmxStreamAssetsPath);
+                    cookedPath = Path.ChangeExtension(this.tmxPath, TiledMapCooker.CookedMapExtension);
                 }
 
-                this.Version = this.TmxMap.Version;
-
-                this.Orientation = (TiledMapOrientationType)((int)this.TmxMap.Orientation);
-                this.RenderOrder = (TiledMapRenderOrderType)((int)this.TmxMap.RenderOrder);
-                this.StaggerAxis = (TiledMapStaggerAxisType)((int)this.TmxMap.StaggerAxis);
-                this.StaggerIndex = (TiledMapStaggerIndexType)((int)this.TmxMap.StaggerIndex);
-                this.Width = this.TmxMap.Width;
-                this.Height = this.TmxMap.Height;
-                this.TileWidth = this.TmxMap.TileWidth;
-                this.TileHeight = this.TmxMap.TileHeight;
-                this.BackgroundColor = new Color(this.TmxMap.BackgroundColor.R, this.TmxMap.BackgroundColor.G, this.TmxMap.BackgroundColor.B, this.TmxMap.BackgroundColor.A);
-
-                if (this.TmxMap.HexSideLength.HasValue)
+                if (cookedPath == null || !this.TryLoadCookedMap(cookedPath))
                 {
-                    this.HexSideLength = this.TmxMap.HexSideLength.Value;
+                    TmxMap tmxMap;
+                    if (!string.IsNullOrEmpty(this.tmxPath))
+                    {
+                        tmxMap = new TmxMap(new WaveDocumentLoader(), this.tmxPath);
+                    }
+                    else
+                    {
+                        tmxMap = new TmxMap(new WaveDocumentLoader(), this.tmxStream, this.tmxStreamAssetsPath);
+                    }
+
+                    this.LoadTmxMap(tmxMap);
                 }
 
-                this.CreateTilesets();
-                this.CreateObjectLayers();
+                this.isMapLoaded = true;
 
                 this.transform.Rectangle = this.CalcRectangle();
                 this.CreateImageLayers();
@@ -769,32 +630,151 @@ namespace WaveEngine.TiledMap
         }
 
         /// <summary>
-        /// Create tilesets associated to this map.
+        /// Load the map data from a parsed TMX map
         /// </summary>
-        private void CreateTilesets()
+        /// <param name="tmxMap">The TMX parsed map.</param>
+        private void LoadTmxMap(TmxMap tmxMap)
         {
+            this.Version = tmxMap.Version;
+
+            this.Orientation = (TiledMapOrientationType)((int)tmxMap.Orientation);
+            this.RenderOrder = (TiledMapRenderOrderType)((int)tmxMap.RenderOrder);
+            this.StaggerAxis = (TiledMapStaggerAxisType)((int)tmxMap.StaggerAxis);
+            this.StaggerIndex = (TiledMapStaggerIndexType)((int)tmxMap.StaggerIndex);
+            this.Width = tmxMap.Width;
+            this.Height = tmxMap.Height;
+            this.TileWidth = tmxMap.TileWidth;
+            this.TileHeight = tmxMap.TileHeight;
+            this.BackgroundColor = new Color(tmxMap.BackgroundColor.R, tmxMap.BackgroundColor.G, tmxMap.BackgroundColor.B, tmxMap.BackgroundColor.A);
+            this.properties = new Dictionary<string, string>(tmxMap.Properties);
+
+            if (tmxMap.HexSideLength.HasValue)
+            {
+                this.HexSideLength = tmxMap.HexSideLength.Value;
+            }
+
             // Load tilesets
-            foreach (var tmxTileset in this.TmxMap.Tilesets)
+            foreach (var tmxTileset in tmxMap.Tilesets)
             {
                 var tileset = new Tileset(tmxTileset, this);
                 this.tilesets.Add(tileset);
             }
+
+            // Load object layers
+            foreach (var tmxObjectLayer in tmxMap.ObjectGroups)
+            {
+                var tileMapObjectLayer = new TiledMapObjectLayer(tmxObjectLayer);
+                this.objectLayers.Add(tmxObjectLayer.Name, tileMapObjectLayer);
+            }
+
+            // Load image layers
+            foreach (var tmxImageLayer in tmxMap.ImageLayers)
+            {
+                var tiledMapImageLayer = new TiledMapImageLayer(tmxImageLayer, this);
+                this.imageLayers.Add(tmxImageLayer.Name, tiledMapImageLayer);
+            }
+
+            // Load tile layers
+            foreach (var tmxLayer in tmxMap.Layers)
+            {
+                this.LayerData.Add(new TiledMapLayerData(tmxLayer, this.Width * this.Height));
+            }
         }
 
         /// <summary>
-        /// Load object layers
+        /// Loads the cooked version of the TMX file, if it exists and it was cooked from the current TMX file
         /// </summary>
-        private void CreateObjectLayers()
+        /// <param name="cookedPath">The path of the cooked map.</param>
+        /// <returns>True if the cooked map has been loaded, false if the TMX file must be loaded instead</returns>
+        private bool TryLoadCookedMap(string cookedPath)
         {
-            foreach (var tmxObjectLayer in this.TmxMap.ObjectGroups)
+            if (!WaveServices.Storage.ExistsContentFile(cookedPath))
             {
-                var tileMapObjectLayer = new TiledMapObjectLayer(tmxObjectLayer);
-                this.objectLayers.Add(tmxObjectLayer.Name, tileMapObjectLayer);
+                return false;
             }
+
+            // Maps shipped only in cooked form can't be checked against their source
+            bool hasSource = WaveServices.Storage.ExistsContentFile(this.tmxPath);
+
+            using (var cookedStream = WaveServices.Storage.OpenContentFile(cookedPath))
+            using (var reader = new BinaryReader(cookedStream, Encoding.UTF8, true))
+            {
+                ulong sourceHash;
+                if (!TiledMapCooker.TryReadHeader(reader, out sourceHash))
+                {
+                    if (!hasSource)
+                    {
+                        throw new FormatException(string.Format("The cooked TiledMap '{0}' has an unsupported format version.", cookedPath));
+                    }
+
+                    return false;
+                }
+
+                if (hasSource && sourceHash != TiledMapCooker.NoSourceHash)
+                {
+                    using (var sourceStream = WaveServices.Storage.OpenContentFile(this.tmxPath))
+                    {
+                        if (TiledMapCooker.ComputeSourceHash(sourceStream) != sourceHash)
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                this.LoadCookedMap(reader);
+            }
+
+            return true;
         }
 
         /// <summary>
-        /// Create tile layers
+        /// Load the map data from a cooked map, in a single streaming pass
+        /// </summary>
+        /// <param name="reader">The cooked map reader, placed after the header.</param>
+        private void LoadCookedMap(BinaryReader reader)
+        {
+            this.Version = reader.ReadString();
+            this.Orientation = (TiledMapOrientationType)reader.ReadInt32();
+            this.RenderOrder = (TiledMapRenderOrderType)reader.ReadInt32();
+            this.StaggerAxis = (TiledMapStaggerAxisType)reader.ReadInt32();
+            this.StaggerIndex = (TiledMapStaggerIndexType)reader.ReadInt32();
+            this.Width = reader.ReadInt32();
+            this.Height = reader.ReadInt32();
+            this.TileWidth = reader.ReadInt32();
+            this.TileHeight = reader.ReadInt32();
+            this.HexSideLength = reader.ReadInt32();
+            this.BackgroundColor = TiledMapCooker.ReadColor(reader);
+            this.properties = TiledMapCooker.ReadProperties(reader);
+
+            int tilesetCount = reader.ReadInt32();
+            for (int i = 0; i < tilesetCount; i++)
+            {
+                this.tilesets.Add(new Tileset(reader, this));
+            }
+
+            int tileLayerCount = reader.ReadInt32();
+            for (int i = 0; i < tileLayerCount; i++)
+            {
+                this.LayerData.Add(new TiledMapLayerData(reader, this.Width * this.Height));
+            }
+
+            int imageLayerCount = reader.ReadInt32();
+            for (int i = 0; i < imageLayerCount; i++)
+            {
+                var tiledMapImageLayer = new TiledMapImageLayer(reader);
+                this.imageLayers.Add(tiledMapImageLayer.ImageLayerName, tiledMapImageLayer);
+            }
+
+            int objectLayerCount = reader.ReadInt32();
+            for (int i = 0; i < objectLayerCount; i++)
+            {
+                var tileMapObjectLayer = new TiledMapObjectLayer(reader);
+                this.objectLayers.Add(tileMapObjectLayer.ObjectLayerName, tileMapObjectLayer);
+            }
+        }
+
+        /// <summary>
+        /// Create image layers
         /// </summary>
         private void CreateImageLayers()
         {
@@ -805,10 +785,9 @@ namespace WaveEngine.TiledMap
             }
 
             // Create layers
-            for (int i = 0; i < this.TmxMap.ImageLayers.Count; i++)
+            foreach (var tiledMapImageLayer in this.imageLayers.Values)
             {
-                var tmxImageLayer = this.TmxMap.ImageLayers[i];
-                this.CreateChildTileImageLayer(tmxImageLayer, i, oldImageEntities);
+                this.CreateChildTileImageLayer(tiledMapImageLayer, oldImageEntities);
             }
 
             foreach (var entity in oldImageEntities)
@@ -829,10 +808,9 @@ namespace WaveEngine.TiledMap
             }
 
             // Create layers
-            for (int i = 0; i < this.TmxMap.Layers.Count; i++)
+            for (int i = 0; i < this.LayerData.Count; i++)
             {
-                var tmxLayer = this.TmxMap.Layers[i];
-                this.CreateChildTileLayer(tmxLayer, i, oldTileEntities);
+                this.CreateChildTileLayer(this.LayerData[i], oldTileEntities);
             }
 
             foreach (var entity in oldTileEntities)
@@ -844,14 +822,11 @@ namespace WaveEngine.TiledMap
         /// <summary>
         /// Create the tile image layer as a child entity
         /// </summary>
-        /// <param name="tmxImageLayer">The tmx image layer.</param>
-        /// <param name="layerIndex">The layer index</param>
+        /// <param name="tiledMapImageLayer">The image layer.</param>
         /// <param name="previousEntities">previousEntities</param>
-        private void CreateChildTileImageLayer(TmxImageLayer tmxImageLayer, int layerIndex, IList<Entity> previousEntities)
+        private void CreateChildTileImageLayer(TiledMapImageLayer tiledMapImageLayer, IList<Entity> previousEntities)
         {
-            var tmxLayerName = tmxImageLayer.Name;
-
-            var tiledMapImageLayer = new TiledMapImageLayer(tmxImageLayer, this);
+            var tmxLayerName = tiledMapImageLayer.ImageLayerName;
 
             Entity layerEntity = null;
             if (previousEntities != null)
@@ -860,7 +835,7 @@ namespace WaveEngine.TiledMap
                 previousEntities.Remove(layerEntity);
             }
 
-            var tileLayerOffset = new Vector2((float)tmxImageLayer.OffsetX, (float)tmxImageLayer.OffsetY);
+            var tileLayerOffset = tiledMapImageLayer.Offset;
 
             if (layerEntity != null)
             {
@@ -892,24 +867,22 @@ namespace WaveEngine.TiledMap
                     {
                         LocalPosition = tileLayerOffset,
                         Origin = this.transform.Origin,
-                        Opacity = (float)tmxImageLayer.Opacity
+                        Opacity = (float)tiledMapImageLayer.Opacity
                     })
                     .AddComponent(new SpriteRenderer());
             }
 
             this.Owner.AddChild(layerEntity);
-            this.imageLayers.Add(tmxLayerName, tiledMapImageLayer);
         }
 
         /// <summary>
         /// Create the tile layer as a child entity
         /// </summary>
-        /// <param name="tmxLayer">The tmx layer.</param>
-        /// <param name="layerIndex">The layer index</param>
+        /// <param name="layerData">The tile layer data.</param>
         /// <param name="previousEntities">previousEntities</param>
-        private void CreateChildTileLayer(TmxLayer tmxLayer, int layerIndex, IList<Entity> previousEntities)
+        private void CreateChildTileLayer(TiledMapLayerData layerData, IList<Entity> previousEntities)
         {
-            var tmxLayerName = tmxLayer.Name;
+            var tmxLayerName = layerData.Name;
 
             Entity layerEntity = null;
             TiledMapLayer tileMapLayer = null;
@@ -919,7 +892,7 @@ namespace WaveEngine.TiledMap
                 previousEntities.Remove(layerEntity);
             }
 
-            var tileLayerOffset = new Vector2((float)tmxLayer.OffsetX, (float)tmxLayer.OffsetY);
+            var tileLayerOffset = layerData.Offset;
 
             if (layerEntity != null)
             {
@@ -932,6 +905,11 @@ namespace WaveEngine.TiledMap
                     tileMapTransform.LocalPosition = tileLayerOffset;
                     tileMapLayer.TmxLayerName = tmxLayerName;
                     layerEntity.Name = tmxLayerName;
+
+                    if (layerEntity.FindComponent<TiledMapLayerBehavior>() == null)
+                    {
+                        layerEntity.AddComponent(new TiledMapLayerBehavior());
+                    }
                 }
                 else
                 {
@@ -956,9 +934,10 @@ namespace WaveEngine.TiledMap
                     {
                         LocalPosition = tileLayerOffset,
                         Origin = this.transform.Origin,
-                        Opacity = (float)tmxLayer.Opacity
+                        Opacity = (float)layerData.Opacity
                     })
-                    .AddComponent(new TiledMapLayerRenderer());
+                    .AddComponent(new TiledMapLayerRenderer())
+                    .AddComponent(new TiledMapLayerBehavior());
             }
 
             this.Owner.AddChild(layerEntity);
@@ -972,20 +951,21 @@ namespace WaveEngine.TiledMap
         {
             float drawOrderStep;
 
-            if (this.TmxMap == null)
+            if (!this.isMapLoaded)
             {
                 return;
             }
 
-            var tmxLayers = this.TmxMap.Layers
-                                .Cast<ITmxLayer>()
-                                .Concat(this.TmxMap.ImageLayers)
+            var layerNames = this.LayerData
+                                .Select(l => new { l.Name, l.OrderIndex })
+                                .Concat(this.imageLayers.Values.Select(l => new { Name = l.ImageLayerName, l.OrderIndex }))
                                 .OrderBy(l => l.OrderIndex)
-                                .Cast<ITmxElement>();
+                                .Select(l => l.Name)
+                                .ToList();
 
-            if (tmxLayers.Count() > 1)
+            if (layerNames.Count > 1)
             {
-                drawOrderStep = (this.minLayerDrawOrder - this.maxLayerDrawOrder) / (tmxLayers.Count() - 1);
+                drawOrderStep = (this.minLayerDrawOrder - this.maxLayerDrawOrder) / (layerNames.Count - 1);
             }
             else
             {
@@ -998,9 +978,9 @@ namespace WaveEngine.TiledMap
             }
 
             int i = 0;
-            foreach (var tmxLayer in tmxLayers)
+            foreach (var layerName in layerNames)
             {
-                Entity childLayer = this.Owner.FindChild(tmxLayer.Name);
+                Entity childLayer = this.Owner.FindChild(layerName);
                 Transform2D transform = childLayer.FindComponent<Transform2D>();
 
                 transform.LocalDrawOrder = this.maxLayerDrawOrder + (drawOrderStep * i);
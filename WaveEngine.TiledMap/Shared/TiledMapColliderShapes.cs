@@ -0,0 +1,168 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Text;
+using WaveEngine.Common.Math;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// The collision shapes built by <see cref="TiledMapLayerCollider"/>, independent of the entities that hold them
+    /// </summary>
+    internal static class TiledMapColliderShapes
+    {
+        #region Public Methods
+
+        /// <summary>
+        /// Merges the solid tiles of a chunk into maximal rectangles. The solid flags are cleared.
+        /// </summary>
+        /// <param name="solidTiles">Whether each tile of the chunk is solid, indexed by x + y * width.</param>
+        /// <param name="width">The chunk width in tiles.</param>
+        /// <param name="height">The chunk height in tiles.</param>
+        /// <param name="rectangles">The list where the rectangles are added, in tiles relative to the chunk.</param>
+        public static void MergeSolidTiles(bool[] solidTiles, int width, int height, List<Rectangle> rectangles)
+        {
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    int index = x + (y * width);
+                    if (!solidTiles[index])
+                    {
+                        continue;
+                    }
+
+                    // Grows the rectangle to the right, and then down while every tile of the row is solid
+                    int rectangleWidth = 1;
+                    while (x + rectangleWidth < width && solidTiles[index + rectangleWidth])
+                    {
+                        rectangleWidth++;
+                    }
+
+                    int rectangleHeight = 1;
+                    while (y + rectangleHeight < height && IsSolidRow(solidTiles, x, y + rectangleHeight, rectangleWidth, width))
+                    {
+                        rectangleHeight++;
+                    }
+
+                    for (int j = y; j < y + rectangleHeight; j++)
+                    {
+                        for (int i = x; i < x + rectangleWidth; i++)
+                        {
+                            solidTiles[i + (j * width)] = false;
+                        }
+                    }
+
+                    rectangles.Add(new Rectangle(x, y, rectangleWidth, rectangleHeight));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the outline of a collision shape of a tile, in layer coordinates
+        /// </summary>
+        /// <param name="tile">The layer tile.</param>
+        /// <param name="collisionObject">The collision shape.</param>
+        /// <param name="tileWidth">The tile width of the tileset.</param>
+        /// <param name="tileHeight">The tile height of the tileset.</param>
+        /// <param name="outline">The list where the outline points are added. It is cleared first.</param>
+        /// <param name="closed">Whether the outline is a closed shape.</param>
+        /// <returns>False if the shape type is not supported, true in other case</returns>
+        public static bool GetTileShapeOutline(LayerTile tile, TiledMapObject collisionObject, float tileWidth, float tileHeight, List<Vector2> outline, out bool closed)
+        {
+            closed = true;
+            outline.Clear();
+
+            switch (collisionObject.ObjectType)
+            {
+                case TiledMapObjectType.Basic:
+                    outline.Add(Vector2.Zero);
+                    outline.Add(new Vector2(collisionObject.Width, 0));
+                    outline.Add(new Vector2(collisionObject.Width, collisionObject.Height));
+                    outline.Add(new Vector2(0, collisionObject.Height));
+                    break;
+
+                case TiledMapObjectType.Polygon:
+                case TiledMapObjectType.Polyline:
+                    if (collisionObject.Points == null || collisionObject.Points.Count < 2)
+                    {
+                        return false;
+                    }
+
+                    for (int i = 0; i < collisionObject.Points.Count; i++)
+                    {
+                        outline.Add(new Vector2((float)collisionObject.Points[i].X, (float)collisionObject.Points[i].Y));
+                    }
+
+                    closed = collisionObject.ObjectType == TiledMapObjectType.Polygon;
+                    break;
+
+                default:
+                    // Only rectangle, polygon and polyline shapes are supported
+                    return false;
+            }
+
+            // Applies the object rotation and position, and then the tile flips
+            double rotation = collisionObject.Rotation * Math.PI / 180.0;
+            float cos = (float)Math.Cos(rotation);
+            float sin = (float)Math.Sin(rotation);
+
+            for (int i = 0; i < outline.Count; i++)
+            {
+                var point = outline[i];
+                point = new Vector2(
+                    collisionObject.X + (point.X * cos) - (point.Y * sin),
+                    collisionObject.Y + (point.X * sin) + (point.Y * cos));
+
+                if (tile.DiagonalFlip)
+                {
+                    point = new Vector2(point.Y, point.X);
+                }
+
+                if (tile.HorizontalFlip)
+                {
+                    point.X = tileWidth - point.X;
+                }
+
+                if (tile.VerticalFlip)
+                {
+                    point.Y = tileHeight - point.Y;
+                }
+
+                outline[i] = point + tile.LocalPosition;
+            }
+
+            return true;
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Checks whether a run of tiles of the chunk are solid
+        /// </summary>
+        /// <param name="solidTiles">Whether each tile of the chunk is solid.</param>
+        /// <param name="x">The X coord of the first tile in the chunk.</param>
+        /// <param name="y">The Y coord of the row in the chunk.</param>
+        /// <param name="count">The number of tiles.</param>
+        /// <param name="width">The chunk width in tiles.</param>
+        /// <returns>True if all the tiles are solid, false in other case</returns>
+        private static bool IsSolidRow(bool[] solidTiles, int x, int y, int count, int width)
+        {
+            int index = x + (y * width);
+            for (int i = 0; i < count; i++)
+            {
+                if (!solidTiles[index + i])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        #endregion
+    }
+}
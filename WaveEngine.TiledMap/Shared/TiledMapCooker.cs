@@ -0,0 +1,507 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Xml.Linq;
+using TiledSharp;
+using WaveEngine.Common.Graphics;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// Converts Tiled Maps (.TMX) files into a compact binary format that <see cref="TiledMap"/> loads without XML parsing.
+    /// A cooked map placed next to its .tmx file, with the <see cref="CookedMapExtension"/> extension, is loaded instead of the TMX.
+    /// </summary>
+    /// <remarks>
+    /// Cooked maps store a hash of the TMX file they were cooked from. When the TMX file is also present and its hash
+    /// doesn't match, the cooked map is stale and the TMX file is loaded instead. External tilesets are not part of the hash.
+    /// </remarks>
+    public static class TiledMapCooker
+    {
+        /// <summary>
+        /// The file extension of cooked maps
+        /// </summary>
+        public const string CookedMapExtension = ".tmxc";
+
+        /// <summary>
+        /// The magic number of cooked maps ("WTMC")
+        /// </summary>
+        internal const int Magic = 0x434D5457;
+
+        /// <summary>
+        /// The cooked map format version
+        /// </summary>
+        internal const int FormatVersion = 4;
+
+        /// <summary>
+        /// The source hash of cooked maps whose TMX file is unknown. They are never considered stale.
+        /// </summary>
+        public const ulong NoSourceHash = 0;
+
+        /// <summary>
+        /// The FNV-1a offset basis
+        /// </summary>
+        private const ulong HashOffsetBasis = 14695981039346656037;
+
+        /// <summary>
+        /// The FNV-1a prime
+        /// </summary>
+        private const ulong HashPrime = 1099511628211;
+
+        #region Public Methods
+
+        /// <summary>
+        /// Cooks a TMX file from the file system. Intended to be used offline, as part of the content pipeline.
+        /// </summary>
+        /// <param name="tmxPath">The TMX file path.</param>
+        /// <param name="output">The stream where the cooked map is written.</param>
+        public static void Cook(string tmxPath, Stream output)
+        {
+            if (string.IsNullOrEmpty(tmxPath))
+            {
+                throw new ArgumentNullException("tmxPath");
+            }
+
+            ulong sourceHash;
+            using (var source = File.OpenRead(tmxPath))
+            {
+                sourceHash = ComputeSourceHash(source);
+            }
+
+            Cook(new TmxMap(new FileDocumentLoader(), tmxPath), output, sourceHash);
+        }
+
+        /// <summary>
+        /// Cooks a parsed TMX map. The cooked map is never considered stale, as its TMX file is unknown.
+        /// </summary>
+        /// <param name="tmxMap">The TMX parsed map.</param>
+        /// <param name="output">The stream where the cooked map is written.</param>
+        public static void Cook(TmxMap tmxMap, Stream output)
+        {
+            Cook(tmxMap, output, NoSourceHash);
+        }
+
+        /// <summary>
+        /// Cooks a parsed TMX map.
+        /// </summary>
+        /// <param name="tmxMap">The TMX parsed map.</param>
+        /// <param name="output">The stream where the cooked map is written.</param>
+        /// <param name="sourceHash">The <see cref="ComputeSourceHash"/> of the TMX file, used to detect stale cooked maps.</param>
+        public static void Cook(TmxMap tmxMap, Stream output, ulong sourceHash)
+        {
+            if (tmxMap == null)
+            {
+                throw new ArgumentNullException("tmxMap");
+            }
+
+            if (output == null)
+            {
+                throw new ArgumentNullException("output");
+            }
+
+            using (var writer = new BinaryWriter(output, Encoding.UTF8, true))
+            {
+                writer.Write(Magic);
+                writer.Write(FormatVersion);
+                writer.Write(sourceHash);
+
+                writer.Write(tmxMap.Version ?? string.Empty);
+                writer.Write((int)tmxMap.Orientation);
+                writer.Write((int)tmxMap.RenderOrder);
+                writer.Write((int)tmxMap.StaggerAxis);
+                writer.Write((int)tmxMap.StaggerIndex);
+                writer.Write(tmxMap.Width);
+                writer.Write(tmxMap.Height);
+                writer.Write(tmxMap.TileWidth);
+                writer.Write(tmxMap.TileHeight);
+                writer.Write(tmxMap.HexSideLength.HasValue ? tmxMap.HexSideLength.Value : 0);
+                WriteColor(writer, tmxMap.BackgroundColor);
+                WriteProperties(writer, tmxMap.Properties);
+
+                writer.Write(tmxMap.Tilesets.Count);
+                foreach (var tmxTileset in tmxMap.Tilesets)
+                {
+                    WriteTileset(writer, tmxTileset);
+                }
+
+                writer.Write(tmxMap.Layers.Count);
+                foreach (var tmxLayer in tmxMap.Layers)
+                {
+                    WriteTileLayer(writer, tmxLayer, tmxMap.Width * tmxMap.Height);
+                }
+
+                writer.Write(tmxMap.ImageLayers.Count);
+                foreach (var tmxImageLayer in tmxMap.ImageLayers)
+                {
+                    writer.Write(tmxImageLayer.Name ?? string.Empty);
+                    writer.Write(tmxImageLayer.OrderIndex);
+                    writer.Write(tmxImageLayer.Opacity);
+                    writer.Write(tmxImageLayer.Visible);
+                    writer.Write(tmxImageLayer.OffsetX);
+                    writer.Write(tmxImageLayer.OffsetY);
+                    writer.Write(GetContentRelativePath(tmxImageLayer.Image.Source));
+                    WriteProperties(writer, tmxImageLayer.Properties);
+                }
+
+                writer.Write(tmxMap.ObjectGroups.Count);
+                foreach (var tmxObjectGroup in tmxMap.ObjectGroups)
+                {
+                    WriteObjectLayer(writer, tmxObjectGroup);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Computes the hash of a TMX file stored in the cooked maps, used to detect stale cooked maps.
+        /// </summary>
+        /// <param name="source">The TMX file stream.</param>
+        /// <returns>The 64-bit FNV-1a hash of the stream contents</returns>
+        public static ulong ComputeSourceHash(Stream source)
+        {
+            if (source == null)
+            {
+                throw new ArgumentNullException("source");
+            }
+
+            ulong hash = HashOffsetBasis;
+            var buffer = new byte[4096];
+            int read;
+
+            while ((read = source.Read(buffer, 0, buffer.Length)) > 0)
+            {
+                for (int i = 0; i < read; i++)
+                {
+                    hash = (hash ^ buffer[i]) * HashPrime;
+                }
+            }
+
+            // The reserved value is never returned for a real file
+            return hash != NoSourceHash ? hash : HashOffsetBasis;
+        }
+        #endregion
+
+        #region Internal Methods
+
+        /// <summary>
+        /// Reads the header of a cooked map
+        /// </summary>
+        /// <param name="reader">The cooked map reader.</param>
+        /// <param name="sourceHash">The hash of the TMX file the map was cooked from.</param>
+        /// <returns>True if the stream is a cooked map of the current format version, false in other case</returns>
+        internal static bool TryReadHeader(BinaryReader reader, out ulong sourceHash)
+        {
+            sourceHash = NoSourceHash;
+
+            if (reader.ReadInt32() != Magic
+             || reader.ReadInt32() != FormatVersion)
+            {
+                return false;
+            }
+
+            sourceHash = reader.ReadUInt64();
+            return true;
+        }
+
+        /// <summary>
+        /// Reads a property dictionary
+        /// </summary>
+        /// <param name="reader">The cooked map reader.</param>
+        /// <returns>The properties</returns>
+        internal static Dictionary<string, string> ReadProperties(BinaryReader reader)
+        {
+            int count = reader.ReadInt32();
+            var properties = new Dictionary<string, string>(count);
+
+            for (int i = 0; i < count; i++)
+            {
+                var key = reader.ReadString();
+                properties[key] = reader.ReadString();
+            }
+
+            return properties;
+        }
+
+        /// <summary>
+        /// Reads a color
+        /// </summary>
+        /// <param name="reader">The cooked map reader.</param>
+        /// <returns>The color</returns>
+        internal static Color ReadColor(BinaryReader reader)
+        {
+            byte r = reader.ReadByte();
+            byte g = reader.ReadByte();
+            byte b = reader.ReadByte();
+            byte a = reader.ReadByte();
+
+            return new Color(r, g, b, a);
+        }
+
+        /// <summary>
+        /// Reads a packed tile array written as a single block
+        /// </summary>
+        /// <param name="reader">The cooked map reader.</param>
+        /// <returns>The packed tiles</returns>
+        internal static uint[] ReadTiles(BinaryReader reader)
+        {
+            int count = reader.ReadInt32();
+            var tiles = new uint[count];
+
+            var bytes = reader.ReadBytes(count * sizeof(uint));
+            if (bytes.Length != count * sizeof(uint))
+            {
+                throw new EndOfStreamException();
+            }
+
+            Buffer.BlockCopy(bytes, 0, tiles, 0, bytes.Length);
+
+            return tiles;
+        }
+
+        /// <summary>
+        /// Gets the content relative path of a TMX image source
+        /// </summary>
+        /// <param name="fullPath">The image source.</param>
+        /// <returns>The path relative to the content folder</returns>
+        internal static string GetContentRelativePath(string fullPath)
+        {
+            return fullPath.Substring(fullPath.IndexOf("Content"));
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Writes a tileset
+        /// </summary>
+        /// <param name="writer">The cooked map writer.</param>
+        /// <param name="tmxTileset">The TMX parsed tileset.</param>
+        private static void WriteTileset(BinaryWriter writer, TmxTileset tmxTileset)
+        {
+            if (tmxTileset.Image == null)
+            {
+                throw new NotSupportedException(string.Format("The tileset '{0}' is a collection of images, which is not supported by TiledMap. Use a tileset based on a single image.", tmxTileset.Name));
+            }
+
+            writer.Write(tmxTileset.Name ?? string.Empty);
+            writer.Write(tmxTileset.FirstGid);
+            writer.Write(tmxTileset.TileWidth);
+            writer.Write(tmxTileset.TileHeight);
+            writer.Write(tmxTileset.Spacing);
+            writer.Write(tmxTileset.Margin);
+            writer.Write((int)tmxTileset.Image.Width);
+            writer.Write((int)tmxTileset.Image.Height);
+            writer.Write((int)tmxTileset.TileOffset.X);
+            writer.Write((int)tmxTileset.TileOffset.Y);
+            writer.Write(tmxTileset.Colums.HasValue ? tmxTileset.Colums.Value : 0);
+            writer.Write(GetContentRelativePath(tmxTileset.Image.Source));
+
+            writer.Write(tmxTileset.Terrains.Count);
+            foreach (var tmxTerrain in tmxTileset.Terrains)
+            {
+                writer.Write(tmxTerrain.Name ?? string.Empty);
+                writer.Write(tmxTerrain.Tile);
+                WriteProperties(writer, tmxTerrain.Properties);
+            }
+
+            writer.Write(tmxTileset.Tiles.Count);
+            foreach (var tmxTilesetTile in tmxTileset.Tiles)
+            {
+                writer.Write(tmxTilesetTile.Id);
+                writer.Write(tmxTilesetTile.Probability);
+                WriteProperties(writer, tmxTilesetTile.Properties);
+                WriteTerrainName(writer, tmxTilesetTile.TopLeft);
+                WriteTerrainName(writer, tmxTilesetTile.TopRight);
+                WriteTerrainName(writer, tmxTilesetTile.BottomLeft);
+                WriteTerrainName(writer, tmxTilesetTile.BottomRight);
+
+                if (tmxTilesetTile.AnimationFrames == null)
+                {
+                    writer.Write(0);
+                }
+                else
+                {
+                    writer.Write(tmxTilesetTile.AnimationFrames.Count);
+                    foreach (var tmxAnimationFrame in tmxTilesetTile.AnimationFrames)
+                    {
+                        writer.Write(tmxAnimationFrame.Id);
+                        writer.Write(tmxAnimationFrame.Duration);
+                    }
+                }
+
+                if (tmxTilesetTile.ObjectGroups == null)
+                {
+                    writer.Write(0);
+                }
+                else
+                {
+                    writer.Write(tmxTilesetTile.ObjectGroups.Sum(g => g.Objects.Count));
+                    foreach (var tmxObjectGroup in tmxTilesetTile.ObjectGroups)
+                    {
+                        foreach (var tmxObject in tmxObjectGroup.Objects)
+                        {
+                            WriteObject(writer, tmxObject);
+                        }
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Writes a tile layer
+        /// </summary>
+        /// <param name="writer">The cooked map writer.</param>
+        /// <param name="tmxLayer">The TMX parsed layer.</param>
+        /// <param name="tileCount">The number of tiles of the map.</param>
+        private static void WriteTileLayer(BinaryWriter writer, TmxLayer tmxLayer, int tileCount)
+        {
+            writer.Write(tmxLayer.Name ?? string.Empty);
+            writer.Write(tmxLayer.OrderIndex);
+            writer.Write(tmxLayer.Opacity);
+            writer.Write(tmxLayer.Visible);
+            writer.Write(tmxLayer.OffsetX);
+            writer.Write(tmxLayer.OffsetY);
+
+            writer.Write(tileCount);
+            for (int i = 0; i < tileCount; i++)
+            {
+                uint data = 0;
+
+                if (i < tmxLayer.Tiles.Count)
+                {
+                    var tmxTile = tmxLayer.Tiles[i];
+                    data = LayerTile.Pack(tmxTile.Gid, tmxTile.HorizontalFlip, tmxTile.VerticalFlip, tmxTile.DiagonalFlip);
+                }
+
+                writer.Write(data);
+            }
+        }
+
+        /// <summary>
+        /// Writes an object layer
+        /// </summary>
+        /// <param name="writer">The cooked map writer.</param>
+        /// <param name="tmxObjectGroup">The TMX parsed object group.</param>
+        private static void WriteObjectLayer(BinaryWriter writer, TmxObjectGroup tmxObjectGroup)
+        {
+            writer.Write(tmxObjectGroup.Name ?? string.Empty);
+            WriteColor(writer, tmxObjectGroup.Color);
+            writer.Write(tmxObjectGroup.Opacity);
+            writer.Write(tmxObjectGroup.Visible);
+            writer.Write(tmxObjectGroup.OffsetX);
+            writer.Write(tmxObjectGroup.OffsetY);
+            WriteProperties(writer, tmxObjectGroup.Properties);
+
+            writer.Write(tmxObjectGroup.Objects.Count);
+            foreach (var tmxObject in tmxObjectGroup.Objects)
+            {
+                WriteObject(writer, tmxObject);
+            }
+        }
+
+        /// <summary>
+        /// Writes an object
+        /// </summary>
+        /// <param name="writer">The cooked map writer.</param>
+        /// <param name="tmxObject">The TMX parsed object.</param>
+        private static void WriteObject(BinaryWriter writer, TmxObject tmxObject)
+        {
+            writer.Write(tmxObject.Name ?? string.Empty);
+            writer.Write((int)tmxObject.ObjectType);
+            writer.Write(tmxObject.Type ?? string.Empty);
+            writer.Write((float)tmxObject.X);
+            writer.Write((float)tmxObject.Y);
+            writer.Write((float)tmxObject.Width);
+            writer.Write((float)tmxObject.Height);
+            writer.Write(tmxObject.Rotation);
+            writer.Write(tmxObject.Visible);
+            WriteProperties(writer, tmxObject.Properties);
+
+            if (tmxObject.Points == null)
+            {
+                writer.Write(-1);
+            }
+            else
+            {
+                writer.Write(tmxObject.Points.Count);
+                foreach (var point in tmxObject.Points)
+                {
+                    writer.Write(point.X);
+                    writer.Write(point.Y);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Writes a property dictionary
+        /// </summary>
+        /// <param name="writer">The cooked map writer.</param>
+        /// <param name="properties">The properties.</param>
+        private static void WriteProperties(BinaryWriter writer, IDictionary<string, string> properties)
+        {
+            if (properties == null)
+            {
+                writer.Write(0);
+                return;
+            }
+
+            writer.Write(properties.Count);
+            foreach (var pair in properties)
+            {
+                writer.Write(pair.Key);
+                writer.Write(pair.Value ?? string.Empty);
+            }
+        }
+
+        /// <summary>
+        /// Writes a color
+        /// </summary>
+        /// <param name="writer">The cooked map writer.</param>
+        /// <param name="color">The TMX color.</param>
+        private static void WriteColor(BinaryWriter writer, TmxColor color)
+        {
+            if (color == null)
+            {
+                // Transparent black, four zero bytes
+                writer.Write(0);
+                return;
+            }
+
+            writer.Write((byte)color.R);
+            writer.Write((byte)color.G);
+            writer.Write((byte)color.B);
+            writer.Write((byte)color.A);
+        }
+
+        /// <summary>
+        /// Writes the name of a terrain, or an empty string if there is no terrain
+        /// </summary>
+        /// <param name="writer">The cooked map writer.</param>
+        /// <param name="tmxTerrain">The TMX terrain.</param>
+        private static void WriteTerrainName(BinaryWriter writer, TmxTerrain tmxTerrain)
+        {
+            writer.Write(tmxTerrain != null ? tmxTerrain.Name : string.Empty);
+        }
+        #endregion
+
+        /// <summary>
+        /// Loads TMX and TSX documents from the file system
+        /// </summary>
+        private class FileDocumentLoader : IDocumentLoader
+        {
+            /// <summary>
+            /// Loads the specified document.
+            /// </summary>
+            /// <param name="path">The path.</param>
+            /// <returns>XDocument</returns>
+            public XDocument Load(string path)
+            {
+                return XDocument.Load(path);
+            }
+        }
+    }
+}
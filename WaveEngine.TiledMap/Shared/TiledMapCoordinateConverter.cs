@@ -0,0 +1,436 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Text;
+using WaveEngine.Common.Math;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// Converts positions to the tile coordinates of a map, from the map geometry
+    /// </summary>
+    internal struct TiledMapCoordinateConverter
+    {
+        /// <summary>
+        /// Tile offsets of the nearest hexagon centers when the X axis is staggered
+        /// </summary>
+        private static readonly Vector2[] HexagonOffsetsStaggerX = new Vector2[]
+        {
+            new Vector2(0,  0),
+            new Vector2(+1, -1),
+            new Vector2(+1,  0),
+            new Vector2(+2,  0),
+        };
+
+        /// <summary>
+        /// Tile offsets of the nearest hexagon centers when the Y axis is staggered
+        /// </summary>
+        private static readonly Vector2[] HexagonOffsetsStaggerY = new Vector2[]
+        {
+            new Vector2(0,  0),
+            new Vector2(-1, +1),
+            new Vector2(0, +1),
+            new Vector2(0, +2),
+        };
+
+        /// <summary>
+        /// The map orientation
+        /// </summary>
+        private readonly TiledMapOrientationType orientation;
+
+        /// <summary>
+        /// The tile width of the map
+        /// </summary>
+        private readonly int tileWidth;
+
+        /// <summary>
+        /// The tile height of the map
+        /// </summary>
+        private readonly int tileHeight;
+
+        /// <summary>
+        /// The map height in tiles
+        /// </summary>
+        private readonly int mapHeight;
+
+        /// <summary>
+        /// The stagger axis of the map
+        /// </summary>
+        private readonly TiledMapStaggerAxisType staggerAxis;
+
+        /// <summary>
+        /// The stagger index of the map
+        /// </summary>
+        private readonly TiledMapStaggerIndexType staggerIndex;
+
+        /// <summary>
+        /// The side length of the hexagons of the map
+        /// </summary>
+        private readonly int hexSideLength;
+
+        #region Initialization
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapCoordinateConverter" /> struct.
+        /// </summary>
+        /// <param name="orientation">The map orientation.</param>
+        /// <param name="tileWidth">The tile width of the map.</param>
+        /// <param name="tileHeight">The tile height of the map.</param>
+        /// <param name="mapHeight">The map height in tiles.</param>
+        /// <param name="staggerAxis">The stagger axis of the map.</param>
+        /// <param name="staggerIndex">The stagger index of the map.</param>
+        /// <param name="hexSideLength">The side length of the hexagons of the map.</param>
+        public TiledMapCoordinateConverter(
+            TiledMapOrientationType orientation,
+            int tileWidth,
+            int tileHeight,
+            int mapHeight,
+            TiledMapStaggerAxisType staggerAxis,
+            TiledMapStaggerIndexType staggerIndex,
+            int hexSideLength)
+        {
+            this.orientation = orientation;
+            this.tileWidth = tileWidth;
+            this.tileHeight = tileHeight;
+            this.mapHeight = mapHeight;
+            this.staggerAxis = staggerAxis;
+            this.staggerIndex = staggerIndex;
+            this.hexSideLength = hexSideLength;
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Get the Tile coordinates of a world position
+        /// </summary>
+        /// <param name="position">The world position</param>
+        /// <param name="inverse">The inverse world transform of the map</param>
+        /// <param name="drawOrder">The draw order of the map</param>
+        /// <param name="tileX">Out tile X coordinate</param>
+        /// <param name="tileY">Out tile Y coordinate</param>
+        public void GetTileCoordinates(Vector2 position, ref Matrix inverse, float drawOrder, out int tileX, out int tileY)
+        {
+            position = Vector3.Transform(position.ToVector3(drawOrder), inverse).ToVector2();
+
+            switch (this.orientation)
+            {
+                case TiledMapOrientationType.Orthogonal:
+                    this.GetOrthogonalTileCoordinates(position, out tileX, out tileY);
+                    break;
+
+                case TiledMapOrientationType.Isometric:
+                    this.GetIsometricTileCoordinates(position, out tileX, out tileY);
+                    break;
+
+                case TiledMapOrientationType.Staggered:
+                    this.GetStaggeredTileCoordinates(position, out tileX, out tileY);
+                    break;
+
+                case TiledMapOrientationType.Hexagonal:
+                    this.GetHexagonalTileCoordinates(position, out tileX, out tileY);
+                    break;
+
+                default:
+                    tileX = 0;
+                    tileY = 0;
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Get the Tile coordinates of several world positions.
+        /// The orientation is resolved once for the whole batch.
+        /// </summary>
+        /// <param name="positions">The world positions</param>
+        /// <param name="tileCoordinates">The array where the tile coordinates of each position are stored</param>
+        /// <param name="count">The number of positions to convert</param>
+        /// <param name="inverse">The inverse world transform of the map</param>
+        /// <param name="drawOrder">The draw order of the map</param>
+        public void GetTileCoordinates(Vector2[] positions, Point[] tileCoordinates, int count, ref Matrix inverse, float drawOrder)
+        {
+            // Only the 2D part of the inverse transform is needed, with the draw order as Z
+            float m11 = inverse.M11, m12 = inverse.M12, m21 = inverse.M21, m22 = inverse.M22;
+            float offsetX = (drawOrder * inverse.M31) + inverse.M41;
+            float offsetY = (drawOrder * inverse.M32) + inverse.M42;
+
+            Vector2 local = Vector2.Zero;
+            int tileX, tileY;
+
+            switch (this.orientation)
+            {
+                case TiledMapOrientationType.Orthogonal:
+                    for (int i = 0; i < count; i++)
+                    {
+                        local.X = (positions[i].X * m11) + (positions[i].Y * m21) + offsetX;
+                        local.Y = (positions[i].X * m12) + (positions[i].Y * m22) + offsetY;
+                        this.GetOrthogonalTileCoordinates(local, out tileX, out tileY);
+                        tileCoordinates[i] = new Point(tileX, tileY);
+                    }
+
+                    break;
+
+                case TiledMapOrientationType.Isometric:
+                    for (int i = 0; i < count; i++)
+                    {
+                        local.X = (positions[i].X * m11) + (positions[i].Y * m21) + offsetX;
+                        local.Y = (positions[i].X * m12) + (positions[i].Y * m22) + offsetY;
+                        this.GetIsometricTileCoordinates(local, out tileX, out tileY);
+                        tileCoordinates[i] = new Point(tileX, tileY);
+                    }
+
+                    break;
+
+                case TiledMapOrientationType.Staggered:
+                    for (int i = 0; i < count; i++)
+                    {
+                        local.X = (positions[i].X * m11) + (positions[i].Y * m21) + offsetX;
+                        local.Y = (positions[i].X * m12) + (positions[i].Y * m22) + offsetY;
+                        this.GetStaggeredTileCoordinates(local, out tileX, out tileY);
+                        tileCoordinates[i] = new Point(tileX, tileY);
+                    }
+
+                    break;
+
+                case TiledMapOrientationType.Hexagonal:
+                    for (int i = 0; i < count; i++)
+                    {
+                        local.X = (positions[i].X * m11) + (positions[i].Y * m21) + offsetX;
+                        local.Y = (positions[i].X * m12) + (positions[i].Y * m22) + offsetY;
+                        this.GetHexagonalTileCoordinates(local, out tileX, out tileY);
+                        tileCoordinates[i] = new Point(tileX, tileY);
+                    }
+
+                    break;
+
+                default:
+                    Array.Clear(tileCoordinates, 0, count);
+                    break;
+            }
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Get the Tile coordinates of a local position in an orthogonal map
+        /// </summary>
+        /// <param name="position">The local position</param>
+        /// <param name="tileX">Out tile X coordinate</param>
+        /// <param name="tileY">Out tile Y coordinate</param>
+        private void GetOrthogonalTileCoordinates(Vector2 position, out int tileX, out int tileY)
+        {
+            float referenceX = position.X / this.tileWidth;
+            float referenceY = position.Y / this.tileHeight;
+
+            tileX = (int)(referenceX < 0 ? referenceX - 1 : referenceX);
+            tileY = (int)(referenceY < 0 ? referenceY - 1 : referenceY);
+        }
+
+        /// <summary>
+        /// Get the Tile coordinates of a local position in an isometric map
+        /// </summary>
+        /// <param name="position">The local position</param>
+        /// <param name="tileX">Out tile X coordinate</param>
+        /// <param name="tileY">Out tile Y coordinate</param>
+        private void GetIsometricTileCoordinates(Vector2 position, out int tileX, out int tileY)
+        {
+            float referenceX = position.X / this.tileWidth;
+            float referenceY = position.Y / this.tileHeight;
+
+            if (referenceX < 0)
+            {
+                referenceX -= 1;
+            }
+
+            if (referenceY < 0)
+            {
+                referenceY -= 1;
+            }
+
+            float halfHeight = this.mapHeight * 0.5f;
+            tileX = (int)(-halfHeight + (referenceX + referenceY));
+
+            float y = halfHeight + (-referenceX + referenceY);
+            y = (y >= 0) ? y : y - 1;
+            tileY = (int)y;
+        }
+
+        /// <summary>
+        /// Get the Tile coordinates of a local position in a staggered map
+        /// </summary>
+        /// <param name="position">The local position</param>
+        /// <param name="tileX">Out tile X coordinate</param>
+        /// <param name="tileY">Out tile Y coordinate</param>
+        private void GetStaggeredTileCoordinates(Vector2 position, out int tileX, out int tileY)
+        {
+            bool staggerX = this.staggerAxis == TiledMapStaggerAxisType.X;
+            bool staggerEven = this.staggerIndex == TiledMapStaggerIndexType.Even;
+
+            Vector2 referencePosition = new Vector2(
+                position.X / this.tileWidth,
+                position.Y / this.tileHeight);
+
+            if (referencePosition.X < 0)
+            {
+                referencePosition.X -= 1;
+            }
+
+            if (referencePosition.Y < 0)
+            {
+                referencePosition.Y -= 1;
+            }
+
+            if (staggerEven)
+            {
+                if (staggerX)
+                {
+                    referencePosition.Y -= 0.5f;
+                }
+                else
+                {
+                    referencePosition.X -= 0.5f;
+                }
+            }
+
+            int coordX = (int)(-0.5f + (referencePosition.X + referencePosition.Y));
+
+            float y = 0.5f + (-referencePosition.X + referencePosition.Y);
+            y = (y >= 0) ? y : y - 1;
+            int coordY = (int)y;
+
+            int evenOffset = staggerEven ? 1 : 0;
+
+            if (staggerX)
+            {
+                tileX = coordX - coordY;
+                tileY = (coordX + coordY + evenOffset) / 2;
+            }
+            else
+            {
+                tileX = (coordX - coordY + evenOffset) / 2;
+                tileY = coordX + coordY;
+            }
+        }
+
+        /// <summary>
+        /// Get the Tile coordinates of a local position in a hexagonal map
+        /// </summary>
+        /// <param name="position">The local position</param>
+        /// <param name="tileX">Out tile X coordinate</param>
+        /// <param name="tileY">Out tile Y coordinate</param>
+        private void GetHexagonalTileCoordinates(Vector2 position, out int tileX, out int tileY)
+        {
+            int sideLengthX = 0;
+            int sideLengthY = 0;
+            bool staggerX = this.staggerAxis == TiledMapStaggerAxisType.X;
+            bool staggerEven = this.staggerIndex == TiledMapStaggerIndexType.Even;
+
+            if (staggerX)
+            {
+                sideLengthX = this.hexSideLength;
+            }
+            else
+            {
+                sideLengthY = this.hexSideLength;
+            }
+
+            var sideOffsetX = (this.tileWidth - sideLengthX) / 2;
+            var sideOffsetY = (this.tileHeight - sideLengthY) / 2;
+
+            if (staggerX)
+            {
+                position.X -= staggerEven ? this.tileWidth : sideOffsetX;
+            }
+            else
+            {
+                position.Y -= staggerEven ? this.tileHeight : sideOffsetY;
+            }
+
+            Vector2 referencePosition = new Vector2(
+                (float)Math.Floor(position.X / (this.tileWidth + sideLengthX)),
+                (float)Math.Floor(position.Y / (this.tileHeight + sideLengthY)));
+
+            // Relative x and y position on the base square of the grid-aligned tile
+            Vector2 rel = new Vector2(
+                position.X - (referencePosition.X * (this.tileWidth + sideLengthX)),
+                position.Y - (referencePosition.Y * (this.tileHeight + sideLengthY)));
+
+            // Adjust the reference point to the correct tile coordinates
+            // Determine the nearest hexagon tile by the distance to the center
+            var columnWidth = sideOffsetX + sideLengthX;
+            var rowHeight = sideOffsetY + sideLengthY;
+            Vector2 center0, center1, center2, center3;
+
+            if (staggerX)
+            {
+                int left = sideLengthX / 2;
+                int centerX = left + columnWidth;
+                int centerY = this.tileHeight / 2;
+
+                center0 = new Vector2(left, centerY);
+                center1 = new Vector2(centerX, centerY - rowHeight);
+                center2 = new Vector2(centerX, centerY + rowHeight);
+                center3 = new Vector2(centerX + columnWidth, centerY);
+
+                referencePosition.X *= 2;
+
+                if (staggerEven)
+                {
+                    referencePosition.X += 1;
+                }
+            }
+            else
+            {
+                int top = sideLengthY / 2;
+                int centerX = this.tileWidth / 2;
+                int centerY = top + rowHeight;
+
+                center0 = new Vector2(centerX, top);
+                center1 = new Vector2(centerX - columnWidth, centerY);
+                center2 = new Vector2(centerX + columnWidth, centerY);
+                center3 = new Vector2(centerX, centerY + rowHeight);
+
+                referencePosition.Y *= 2;
+
+                if (staggerEven)
+                {
+                    referencePosition.Y += 1;
+                }
+            }
+
+            int nearest = 0;
+            float minDist = (center0 - rel).LengthSquared();
+            float dc = (center1 - rel).LengthSquared();
+
+            if (dc < minDist)
+            {
+                minDist = dc;
+                nearest = 1;
+            }
+
+            dc = (center2 - rel).LengthSquared();
+            if (dc < minDist)
+            {
+                minDist = dc;
+                nearest = 2;
+            }
+
+            dc = (center3 - rel).LengthSquared();
+            if (dc < minDist)
+            {
+                nearest = 3;
+            }
+
+            var offsets = staggerX ? HexagonOffsetsStaggerX : HexagonOffsetsStaggerY;
+            Vector2 tileCoordinates = referencePosition + offsets[nearest];
+
+            tileX = (int)tileCoordinates.X;
+            tileY = (int)tileCoordinates.Y;
+        }
+        #endregion
+    }
+}
@@ -3,6 +3,7 @@
 #region Using Statements
 using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
@@ -55,6 +56,11 @@ namespace WaveEngine.TiledMap
         /// Gets the object layer properties
         /// </summary>
         public IReadOnlyDictionary<string, string> Properties { get; private set; }
+
+        /// <summary>
+        /// Gets the layer order index, shared with tile layers
+        /// </summary>
+        internal int OrderIndex { get; private set; }
         #endregion
 
         #region Initialziation
@@ -70,12 +76,26 @@ namespace WaveEngine.TiledMap
             this.Opacity = tmxImageLayer.Opacity;
             this.Visible = tmxImageLayer.Visible;
             this.Offset = new Vector2((float)tmxImageLayer.OffsetX, (float)tmxImageLayer.OffsetY);
+            this.OrderIndex = tmxImageLayer.OrderIndex;
 
             this.Properties = new Dictionary<string, string>(tmxImageLayer.Properties);
 
-            string fullPath = tmxImageLayer.Image.Source;
-            string relativePath = fullPath.Substring(fullPath.IndexOf("Content"));
-            this.ImagePath = relativePath;
+            this.ImagePath = TiledMapCooker.GetContentRelativePath(tmxImageLayer.Image.Source);
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapImageLayer" /> class.
+        /// </summary>
+        /// <param name="reader">The cooked map reader</param>
+        internal TiledMapImageLayer(BinaryReader reader)
+        {
+            this.ImageLayerName = reader.ReadString();
+            this.OrderIndex = reader.ReadInt32();
+            this.Opacity = reader.ReadDouble();
+            this.Visible = reader.ReadBoolean();
+            this.Offset = new Vector2((float)reader.ReadDouble(), (float)reader.ReadDouble());
+            this.ImagePath = reader.ReadString();
+            this.Properties = TiledMapCooker.ReadProperties(reader);
         }
         #endregion
     }
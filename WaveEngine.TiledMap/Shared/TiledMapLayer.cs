@@ -7,7 +7,6 @@ using System.Linq;
 using System.Runtime.Serialization;
 using System.Text;
 using System.Threading.Tasks;
-using TiledSharp;
 using WaveEngine.Common.Attributes;
 using WaveEngine.Common.Graphics;
 using WaveEngine.Common.Math;
@@ -24,9 +23,9 @@ namespace WaveEngine.TiledMap
     public class TiledMapLayer : Component, IDisposable
     {
         /// <summary>
-        /// The tmx parsed layer
+        /// The layer data of the map
         /// </summary>
-        private TmxLayer tmxLayer;
+        private TiledMapLayerData layerData;
 
         /// <summary>
         /// The tile map instance.
@@ -34,19 +33,29 @@ namespace WaveEngine.TiledMap
         private TiledMap tiledMap;
 
         /// <summary>
-        /// Tile list of this layer
+        /// Packed global tile ID and flip bits of each tile, indexed by x + y * width. Shared with the map layer data.
         /// </summary>
-        private List<LayerTile> tiles;
+        private uint[] tileData;
 
         /// <summary>
-        /// Tile arranged by its map coordinates
+        /// Meshes need to be refreshed
         /// </summary>
-        private LayerTile[,] tileTable;
+        internal bool NeedRefresh;
 
         /// <summary>
-        /// Meshes need to be refreshed
+        /// Indices (x + y * width) of the tiles changed since the last refresh
         /// </summary>
-        internal bool NeedRefresh;
+        internal List<int> DirtyTiles = new List<int>();
+
+        /// <summary>
+        /// The layer has been loaded or unloaded
+        /// </summary>
+        internal event EventHandler OnLayerRefresh;
+
+        /// <summary>
+        /// A tile of the layer has changed. The arguments are the X and Y coords of the tile.
+        /// </summary>
+        internal event Action<int, int> OnTileChanged;
 
         // The TMX Layer name
         [DataMember]
@@ -57,8 +66,31 @@ namespace WaveEngine.TiledMap
         /// </summary>
         private bool isLayerLoaded;
 
+        /// <summary>
+        /// Tile coordinates reused by the batch queries
+        /// </summary>
+        private Point[] coordinatesBuffer;
+
+        /// <summary>
+        /// Neighbour offsets of the shifted rows or columns of the map
+        /// </summary>
+        private Point[] shiftedNeighbourOffsets;
+
+        /// <summary>
+        /// Neighbour offsets of the not shifted rows or columns of the map
+        /// </summary>
+        private Point[] unshiftedNeighbourOffsets;
+
         #region Properties
 
+        /// <summary>
+        /// Gets a value indicating whether the layer is loaded
+        /// </summary>
+        internal bool IsLayerLoaded
+        {
+            get { return this.isLayerLoaded; }
+        }
+
         /// <summary>
         /// Gets the layer names.
         /// </summary>
@@ -72,7 +104,7 @@ namespace WaveEngine.TiledMap
             {
                 if (this.isLayerLoaded)
                 {
-                    return this.tiledMap.TmxMap.Layers.Select(l => l.Name);
+                    return this.tiledMap.LayerData.Select(l => l.Name);
                 }
 
                 return new List<string>();
@@ -84,7 +116,19 @@ namespace WaveEngine.TiledMap
         /// </summary>
         public IEnumerable<LayerTile> Tiles
         {
-            get { return this.tiles; }
+            get
+            {
+                if (!this.isLayerLoaded)
+                {
+                    yield break;
+                }
+
+                int width = this.tiledMap.Width;
+                for (int i = 0; i < this.tileData.Length; i++)
+                {
+                    yield return this.CreateLayerTile(i % width, i / width);
+                }
+            }
         }
 
         /// <summary>
@@ -144,14 +188,8 @@ namespace WaveEngine.TiledMap
         /// </summary>
         /// <param name="tile">The tile.</param>
         /// <returns>NeighboursCollection</returns>
-        /// <exception cref="System.ArgumentNullException">The tile argument can not be null</exception>
         public NeighboursCollection GetNeighboursFromTile(LayerTile tile)
         {
-            if (tile == null)
-            {
-                throw new ArgumentNullException("The tile argument can not be null");
-            }
-
             if (!this.isLayerLoaded)
             {
                 return null;
@@ -176,12 +214,97 @@ namespace WaveEngine.TiledMap
             }
         }
 
+        /// <summary>
+        /// Gets the indices (x + y * width) of the neighbours of a tile without allocating, starting from the top
+        /// neighbour in clockwise order, like <see cref="NeighboursCollection"/>.
+        /// </summary>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        /// <param name="neighbours">An array of at least 8 elements where the neighbour indices are stored.
+        /// Directions without neighbour, or outside the map, are set to -1.</param>
+        /// <returns>The number of neighbours found</returns>
+        public int GetNeighbourIndices(int x, int y, int[] neighbours)
+        {
+            if (neighbours == null)
+            {
+                throw new ArgumentNullException("neighbours");
+            }
+
+            if (neighbours.Length < NeighbourOffsets.Count)
+            {
+                throw new ArgumentException("The neighbours array must have at least 8 elements", "neighbours");
+            }
+
+            if (!this.isLayerLoaded)
+            {
+                for (int i = 0; i < NeighbourOffsets.Count; i++)
+                {
+                    neighbours[i] = -1;
+                }
+
+                return 0;
+            }
+
+            return this.FillNeighbourIndices(x, y, this.GetNeighbourOffsets(x, y), neighbours);
+        }
+
+        /// <summary>
+        /// Visits every tile of the layer with the indices of its neighbours, as returned by <see cref="GetNeighbourIndices"/>.
+        /// The neighbours array passed to the action is reused between tiles, so it must not be stored.
+        /// </summary>
+        /// <param name="action">The action invoked with the index (x + y * width) of each tile and its neighbour indices.</param>
+        public void ForEachTileNeighbours(Action<int, int[]> action)
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+
+            if (!this.isLayerLoaded)
+            {
+                return;
+            }
+
+            int width = this.tiledMap.Width;
+            int height = this.tiledMap.Height;
+            var neighbours = new int[NeighbourOffsets.Count];
+
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    this.FillNeighbourIndices(x, y, this.GetNeighbourOffsets(x, y), neighbours);
+                    action(x + (y * width), neighbours);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the global tile ID of a tile by its index (x + y * width), without building a <see cref="LayerTile"/>.
+        /// </summary>
+        /// <param name="index">The tile index.</param>
+        /// <returns>The global tile ID, or 0 if the tile is empty</returns>
+        public int GetTileGidByIndex(int index)
+        {
+            if (!this.isLayerLoaded)
+            {
+                throw new InvalidOperationException("The layer is not loaded");
+            }
+
+            if (index < 0 || index >= this.tileData.Length)
+            {
+                throw new ArgumentOutOfRangeException("index");
+            }
+
+            return (int)(this.tileData[index] & LayerTile.GidMask);
+        }
+
         /// <summary>
         /// Get Tile coordinates (x, y) by world position
         /// </summary>
         /// <param name="position">The world position</param>
-        /// <returns>LayerTile</returns>
-        public LayerTile GetLayerTileByWorldPosition(Vector2 position)
+        /// <returns>LayerTile, or null if the position is outside the map</returns>
+        public LayerTile? GetLayerTileByWorldPosition(Vector2 position)
         {
             if (!this.isLayerLoaded)
             {
@@ -193,15 +316,64 @@ namespace WaveEngine.TiledMap
             return this.GetLayerTileByMapCoordinates(tileX, tileY);
         }
 
+        /// <summary>
+        /// Gets the global tile ID of the tile at several world positions.
+        /// </summary>
+        /// <param name="positions">The world positions</param>
+        /// <param name="gids">The array where the global tile ID of each position is stored, or 0 if the position is outside the map or the tile is empty</param>
+        /// <param name="count">The number of positions to query</param>
+        public void GetTileGidsByWorldPositions(Vector2[] positions, int[] gids, int count)
+        {
+            if (gids == null)
+            {
+                throw new ArgumentNullException("gids");
+            }
+
+            if (count < 0 || count > gids.Length)
+            {
+                throw new ArgumentOutOfRangeException("count");
+            }
+
+            if (!this.isLayerLoaded)
+            {
+                Array.Clear(gids, 0, count);
+                return;
+            }
+
+            if (this.coordinatesBuffer == null || this.coordinatesBuffer.Length < count)
+            {
+                this.coordinatesBuffer = new Point[count];
+            }
+
+            this.tiledMap.GetTileCoordinatesByWorldPositions(positions, this.coordinatesBuffer, count);
+
+            int width = this.tiledMap.Width;
+            int height = this.tiledMap.Height;
+            for (int i = 0; i < count; i++)
+            {
+                var coordinates = this.coordinatesBuffer[i];
+
+                // A single unsigned comparison discards negative coordinates too
+                if ((uint)coordinates.X < (uint)width && (uint)coordinates.Y < (uint)height)
+                {
+                    gids[i] = (int)(this.tileData[coordinates.X + (coordinates.Y * width)] & LayerTile.GidMask);
+                }
+                else
+                {
+                    gids[i] = 0;
+                }
+            }
+        }
+
         /// <summary>
         /// Gets a tile by its map coordinates
         /// </summary>
         /// <param name="x">The X coord of the tile.</param>
         /// <param name="y">The Y coord of the tile.</param>
-        /// <returns>LayerTile</returns>
-        public LayerTile GetLayerTileByMapCoordinates(int x, int y)
+        /// <returns>LayerTile, or null if the coordinates are outside the map</returns>
+        public LayerTile? GetLayerTileByMapCoordinates(int x, int y)
         {
-            LayerTile result = null;
+            LayerTile? result = null;
 
             if (this.isLayerLoaded
              && x >= 0
@@ -209,12 +381,84 @@ namespace WaveEngine.TiledMap
              && y >= 0
              && y < this.tiledMap.Height)
             {
-                result = this.tileTable[x, y];
+                result = this.CreateLayerTile(x, y);
             }
 
             return result;
         }
 
+        /// <summary>
+        /// Changes a tile of the layer. Only the vertices of the tile are updated when it keeps its tileset,
+        /// otherwise the chunk that contains the tile is rebuilt.
+        /// </summary>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        /// <param name="gid">The global tile ID, or 0 to clear the tile.</param>
+        /// <param name="horizontalFlip">Whether the tile has horizontal flip.</param>
+        /// <param name="verticalFlip">Whether the tile has vertical flip.</param>
+        /// <param name="diagonalFlip">Whether the tile has diagonal flip.</param>
+        /// <exception cref="System.InvalidOperationException">The layer is not loaded</exception>
+        /// <exception cref="System.ArgumentOutOfRangeException">The coordinates are outside the map, or no tileset contains the global tile ID</exception>
+        public void SetTile(int x, int y, int gid, bool horizontalFlip = false, bool verticalFlip = false, bool diagonalFlip = false)
+        {
+            if (!this.isLayerLoaded)
+            {
+                throw new InvalidOperationException("The layer is not loaded");
+            }
+
+            if (x < 0 || x >= this.tiledMap.Width)
+            {
+                throw new ArgumentOutOfRangeException("x");
+            }
+
+            if (y < 0 || y >= this.tiledMap.Height)
+            {
+                throw new ArgumentOutOfRangeException("y");
+            }
+
+            Tileset tileset = null;
+            if (gid != 0)
+            {
+                tileset = this.tiledMap.GetTilesetByGid(gid);
+
+                if (tileset == null)
+                {
+                    throw new ArgumentOutOfRangeException("gid", "There is no tileset that contains the global tile ID " + gid);
+                }
+            }
+
+            this.tileData[x + (y * this.tiledMap.Width)] = LayerTile.Pack(gid, horizontalFlip, verticalFlip, diagonalFlip);
+            this.InvalidateTile(x, y);
+
+            if (this.OnTileChanged != null)
+            {
+                this.OnTileChanged(x, y);
+            }
+        }
+
+        /// <summary>
+        /// Clears a tile of the layer.
+        /// </summary>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        public void ClearTile(int x, int y)
+        {
+            this.SetTile(x, y, 0);
+        }
+
+        /// <summary>
+        /// Marks a tile to be refreshed by the layer renderer. Only the chunk containing the tile is rebuilt.
+        /// </summary>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        internal void InvalidateTile(int x, int y)
+        {
+            if (!this.NeedRefresh)
+            {
+                this.DirtyTiles.Add(x + (y * this.tiledMap.Width));
+            }
+        }
+
         /// <summary>
         /// Dispose this component
         /// </summary>
@@ -226,6 +470,74 @@ namespace WaveEngine.TiledMap
 
         #region Private Methods
 
+        /// <summary>
+        /// Gets the neighbour offsets of a tile
+        /// </summary>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        /// <returns>The neighbour offsets</returns>
+        private Point[] GetNeighbourOffsets(int x, int y)
+        {
+            int coordinate = this.tiledMap.StaggerAxis == TiledMapStaggerAxisType.X ? x : y;
+
+            return NeighbourOffsets.IsShifted(coordinate, this.tiledMap.StaggerIndex)
+                ? this.shiftedNeighbourOffsets
+                : this.unshiftedNeighbourOffsets;
+        }
+
+        /// <summary>
+        /// Stores the neighbour indices of a tile
+        /// </summary>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        /// <param name="offsets">The neighbour offsets.</param>
+        /// <param name="neighbours">The array where the neighbour indices are stored.</param>
+        /// <returns>The number of neighbours found</returns>
+        private int FillNeighbourIndices(int x, int y, Point[] offsets, int[] neighbours)
+        {
+            int width = this.tiledMap.Width;
+            int height = this.tiledMap.Height;
+            int count = 0;
+
+            for (int i = 0; i < NeighbourOffsets.Count; i++)
+            {
+                var offset = offsets[i];
+                int neighbourX = x + offset.X;
+                int neighbourY = y + offset.Y;
+
+                if ((offset.X != 0 || offset.Y != 0)
+                 && (uint)neighbourX < (uint)width
+                 && (uint)neighbourY < (uint)height)
+                {
+                    neighbours[i] = neighbourX + (neighbourY * width);
+                    count++;
+                }
+                else
+                {
+                    neighbours[i] = -1;
+                }
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        /// Creates the tile view of a cell from its packed data
+        /// </summary>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        /// <returns>LayerTile</returns>
+        private LayerTile CreateLayerTile(int x, int y)
+        {
+            uint data = this.tileData[x + (y * this.tiledMap.Width)];
+            var tileset = this.tiledMap.GetTilesetByGid((int)(data & LayerTile.GidMask));
+
+            Vector2 tileLocalPosition;
+            this.tiledMap.GetTilePosition(x, y, tileset, out tileLocalPosition);
+
+            return new LayerTile(x, y, data, tileset, tileLocalPosition);
+        }
+
         /// <summary>
         /// Refresh the layer
         /// </summary>
@@ -233,6 +545,11 @@ namespace WaveEngine.TiledMap
         {
             this.UnloadLayer();
             this.LoadLayer();
+
+            if (this.OnLayerRefresh != null)
+            {
+                this.OnLayerRefresh(this, EventArgs.Empty);
+            }
         }
 
         /// <summary>
@@ -241,9 +558,8 @@ namespace WaveEngine.TiledMap
         private void UnloadLayer()
         {
             this.tiledMap = null;
-            this.tileTable = null;
-            this.tiles = null;
-            this.tmxLayer = null;
+            this.tileData = null;
+            this.layerData = null;
 
             this.isLayerLoaded = false;
         }
@@ -253,8 +569,6 @@ namespace WaveEngine.TiledMap
         /// </summary>
         private void LoadLayer()
         {
-            this.tiles = new List<LayerTile>();
-
             if (this.Owner.Parent == null)
             {
                 return;
@@ -262,43 +576,18 @@ namespace WaveEngine.TiledMap
 
             this.tiledMap = this.Owner.Parent.FindComponent<TiledMap>();
 
-            if (this.tiledMap != null && this.tiledMap.TmxMap != null)
+            if (this.tiledMap != null && this.tiledMap.LayerData != null)
             {
-                this.tmxLayer = this.tiledMap.TmxMap.Layers.FirstOrDefault(l => l.Name == this.tmxLayerName);
+                this.layerData = this.tiledMap.LayerData.FirstOrDefault(l => l.Name == this.tmxLayerName);
 
-                if (this.tmxLayer != null)
+                if (this.layerData != null)
                 {
-                    this.tileTable = new LayerTile[this.tiledMap.Width, this.tiledMap.Height];
-
-                    for (int i = 0; i < this.tmxLayer.Tiles.Count; i++)
-                    {
-                        var tmxTile = this.tmxLayer.Tiles[i];
-
-                        Tileset selectedTileset = null;
-
-                        if (tmxTile.Gid > 0)
-                        {
-                            foreach (var tileset in this.tiledMap.Tilesets)
-                            {
-                                if (tmxTile.Gid <= tileset.LastGid)
-                                {
-                                    selectedTileset = tileset;
-                                    break;
-                                }
-                            }
-                        }
-
-                        LayerTile tile = new LayerTile(tmxTile, selectedTileset);
-                        this.tiles.Add(tile);
-
-                        Vector2 tileLocalPosition;
-                        this.tiledMap.GetTilePosition(tile.X, tile.Y, selectedTileset, out tileLocalPosition);
-                        tile.LocalPosition = tileLocalPosition;
-
-                        int x = i % this.tiledMap.Width;
-                        int y = i / this.tiledMap.Width;
-                        this.tileTable[x, y] = tile;
-                    }
+                    this.tileData = this.layerData.Tiles;
+                    NeighbourOffsets.GetTables(
+                        this.tiledMap.Orientation,
+                        this.tiledMap.StaggerAxis,
+                        out this.shiftedNeighbourOffsets,
+                        out this.unshiftedNeighbourOffsets);
 
                     this.isLayerLoaded = true;
                     this.NeedRefresh = true;
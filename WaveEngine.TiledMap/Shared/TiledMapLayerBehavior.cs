@@ -0,0 +1,50 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.Serialization;
+using System.Text;
+using System.Threading.Tasks;
+using WaveEngine.Framework;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// Advances the state of a TiledMap Layer once per frame. The layer renderer draws once per camera,
+    /// so the tile animations and the chunk streaming are updated here instead.
+    /// </summary>
+    [DataContract]
+    public class TiledMapLayerBehavior : Behavior
+    {
+        /// <summary>
+        /// This component requires a TiledMapLayerRenderer component.
+        /// </summary>
+        [RequiredComponent]
+        private TiledMapLayerRenderer tiledMapLayerRenderer = null;
+
+        #region Initialization
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapLayerBehavior" /> class.
+        /// </summary>
+        public TiledMapLayerBehavior()
+        {
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Advances the tile animations and the chunk streaming of the layer
+        /// </summary>
+        /// <param name="gameTime">The current time</param>
+        protected override void Update(TimeSpan gameTime)
+        {
+            this.tiledMapLayerRenderer.UpdateFrame(gameTime);
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,486 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.Serialization;
+using System.Text;
+using System.Threading.Tasks;
+using WaveEngine.Common.Math;
+using WaveEngine.Framework;
+using WaveEngine.Framework.Graphics;
+using WaveEngine.Framework.Physics2D;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// Generates static colliders from the collision shapes of the tiles of a TiledMap Layer.
+    /// The layer is split into chunks, and each chunk is rebuilt only when one of its tiles changes.
+    /// </summary>
+    /// <remarks>
+    /// In orthogonal maps, adjacent tiles whose collision shape covers the whole tile are merged into
+    /// maximal rectangles. Any other collision shape generates its own collider.
+    /// </remarks>
+    [DataContract]
+    public class TiledMapLayerCollider : Behavior
+    {
+        /// <summary>
+        /// The default chunk size in tiles
+        /// </summary>
+        private const int DefaultChunkSize = 32;
+
+        /// <summary>
+        /// This component requires a TiledMapLayer component.
+        /// </summary>
+        [RequiredComponent]
+        private TiledMapLayer tiledMapLayer = null;
+
+        /// <summary>
+        /// The associated tiled map
+        /// </summary>
+        private TiledMap tiledMap;
+
+        /// <summary>
+        /// The chunk size
+        /// </summary>
+        [DataMember]
+        private int chunkSize;
+
+        /// <summary>
+        /// The chunk size of the current chunks, which keeps its value until they are created again
+        /// </summary>
+        private int builtChunkSize;
+
+        /// <summary>
+        /// The collision entity of each chunk, or null if the chunk has no colliders
+        /// </summary>
+        private Entity[] chunkEntities;
+
+        /// <summary>
+        /// Whether each chunk needs to be rebuilt
+        /// </summary>
+        private bool[] dirtyChunks;
+
+        /// <summary>
+        /// Whether any chunk needs to be rebuilt
+        /// </summary>
+        private bool hasDirtyChunks;
+
+        /// <summary>
+        /// Whether all the chunks need to be created again
+        /// </summary>
+        private bool needsFullRebuild;
+
+        /// <summary>
+        /// Number of chunks in the X axis
+        /// </summary>
+        private int chunksX;
+
+        /// <summary>
+        /// Number of chunks in the Y axis
+        /// </summary>
+        private int chunksY;
+
+        /// <summary>
+        /// Tiles of the chunk being built that are fully solid
+        /// </summary>
+        private bool[] solidTiles;
+
+        /// <summary>
+        /// The outline of the shape being built
+        /// </summary>
+        private List<Vector2> outline = new List<Vector2>();
+
+        /// <summary>
+        /// The merged rectangles of the chunk being built, in tiles
+        /// </summary>
+        private List<Rectangle> mergedRectangles = new List<Rectangle>();
+
+        /// <summary>
+        /// The collider entities of the chunk being built
+        /// </summary>
+        private List<Entity> chunkColliders = new List<Entity>();
+
+        #region Initialization
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapLayerCollider" /> class.
+        /// </summary>
+        public TiledMapLayerCollider()
+        {
+        }
+
+        /// <summary>
+        /// Sets the default values
+        /// </summary>
+        protected override void DefaultValues()
+        {
+            base.DefaultValues();
+            this.chunkSize = DefaultChunkSize;
+        }
+
+        /// <summary>
+        /// Initializes this component
+        /// </summary>
+        protected override void Initialize()
+        {
+            base.Initialize();
+            this.needsFullRebuild = true;
+        }
+
+        /// <summary>
+        /// Resolves the dependencies needed for this instance to work.
+        /// </summary>
+        protected override void ResolveDependencies()
+        {
+            base.ResolveDependencies();
+
+            this.tiledMapLayer.OnLayerRefresh -= this.TiledMapLayer_OnLayerRefresh;
+            this.tiledMapLayer.OnLayerRefresh += this.TiledMapLayer_OnLayerRefresh;
+            this.tiledMapLayer.OnTileChanged -= this.TiledMapLayer_OnTileChanged;
+            this.tiledMapLayer.OnTileChanged += this.TiledMapLayer_OnTileChanged;
+        }
+
+        /// <summary>
+        /// Delete dependencies
+        /// </summary>
+        protected override void DeleteDependencies()
+        {
+            this.tiledMapLayer.OnLayerRefresh -= this.TiledMapLayer_OnLayerRefresh;
+            this.tiledMapLayer.OnTileChanged -= this.TiledMapLayer_OnTileChanged;
+
+            base.DeleteDependencies();
+        }
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the size in tiles of the chunks the colliders are grouped into.
+        /// Tiles are only merged with other tiles of the same chunk.
+        /// </summary>
+        public int ChunkSize
+        {
+            get
+            {
+                return this.chunkSize;
+            }
+
+            set
+            {
+                if (value < 1)
+                {
+                    throw new ArgumentOutOfRangeException("value", "Chunk size must be greater than 0");
+                }
+
+                this.chunkSize = value;
+                this.needsFullRebuild = true;
+            }
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Rebuilds the colliders of the chunks whose tiles have changed
+        /// </summary>
+        /// <param name="gameTime">The current time</param>
+        protected override void Update(TimeSpan gameTime)
+        {
+            if (this.needsFullRebuild)
+            {
+                this.needsFullRebuild = false;
+                this.CreateChunks();
+            }
+
+            if (!this.hasDirtyChunks)
+            {
+                return;
+            }
+
+            this.hasDirtyChunks = false;
+            for (int i = 0; i < this.dirtyChunks.Length; i++)
+            {
+                if (this.dirtyChunks[i])
+                {
+                    this.dirtyChunks[i] = false;
+                    this.RefreshChunk(i % this.chunksX, i / this.chunksX);
+                }
+            }
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Removes the current chunks and marks the chunks of the layer to be built
+        /// </summary>
+        private void CreateChunks()
+        {
+            this.RemoveChunks();
+
+            this.tiledMap = this.Owner.Parent != null ? this.Owner.Parent.FindComponent<TiledMap>() : null;
+
+            if (this.tiledMap == null || !this.tiledMapLayer.IsLayerLoaded)
+            {
+                return;
+            }
+
+            this.builtChunkSize = this.chunkSize;
+            this.chunksX = (this.tiledMap.Width + this.builtChunkSize - 1) / this.builtChunkSize;
+            this.chunksY = (this.tiledMap.Height + this.builtChunkSize - 1) / this.builtChunkSize;
+            this.chunkEntities = new Entity[this.chunksX * this.chunksY];
+            this.dirtyChunks = new bool[this.chunkEntities.Length];
+            this.solidTiles = new bool[this.builtChunkSize * this.builtChunkSize];
+
+            for (int i = 0; i < this.dirtyChunks.Length; i++)
+            {
+                this.dirtyChunks[i] = true;
+            }
+
+            this.hasDirtyChunks = this.dirtyChunks.Length > 0;
+        }
+
+        /// <summary>
+        /// Removes the collision entities of all the chunks
+        /// </summary>
+        private void RemoveChunks()
+        {
+            if (this.chunkEntities != null)
+            {
+                for (int i = 0; i < this.chunkEntities.Length; i++)
+                {
+                    if (this.chunkEntities[i] != null)
+                    {
+                        this.Owner.RemoveChild(this.chunkEntities[i].Name);
+                    }
+                }
+            }
+
+            this.chunkEntities = null;
+            this.dirtyChunks = null;
+            this.hasDirtyChunks = false;
+        }
+
+        /// <summary>
+        /// Creates again the colliders of a chunk
+        /// </summary>
+        /// <param name="chunkX">The X coord of the chunk.</param>
+        /// <param name="chunkY">The Y coord of the chunk.</param>
+        private void RefreshChunk(int chunkX, int chunkY)
+        {
+            int chunkIndex = chunkX + (chunkY * this.chunksX);
+            if (this.chunkEntities[chunkIndex] != null)
+            {
+                this.Owner.RemoveChild(this.chunkEntities[chunkIndex].Name);
+                this.chunkEntities[chunkIndex] = null;
+            }
+
+            int startX = chunkX * this.builtChunkSize;
+            int startY = chunkY * this.builtChunkSize;
+            int width = Math.Min(this.builtChunkSize, this.tiledMap.Width - startX);
+            int height = Math.Min(this.builtChunkSize, this.tiledMap.Height - startY);
+            bool mergeTiles = this.tiledMap.Orientation == TiledMapOrientationType.Orthogonal;
+
+            this.chunkColliders.Clear();
+            Array.Clear(this.solidTiles, 0, this.solidTiles.Length);
+
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    var tile = this.tiledMapLayer.GetLayerTileByMapCoordinates(startX + x, startY + y);
+                    var tilesetTile = tile.HasValue ? tile.Value.TilesetTile : null;
+
+                    if (tilesetTile == null || tilesetTile.CollisionObjects.Count == 0)
+                    {
+                        continue;
+                    }
+
+                    if (mergeTiles && this.IsSolidTile(tilesetTile))
+                    {
+                        this.solidTiles[x + (y * width)] = true;
+                        continue;
+                    }
+
+                    for (int i = 0; i < tilesetTile.CollisionObjects.Count; i++)
+                    {
+                        this.AddTileShape(tile.Value, tilesetTile.CollisionObjects[i]);
+                    }
+                }
+            }
+
+            if (mergeTiles)
+            {
+                this.AddMergedRectangles(startX, startY, width, height);
+            }
+
+            // Chunks without colliders don't get an entity
+            if (this.chunkColliders.Count == 0)
+            {
+                return;
+            }
+
+            var chunkEntity = new Entity(string.Format("collisionChunk_{0}_{1}", chunkX, chunkY))
+                .AddComponent(new Transform2D());
+
+            for (int i = 0; i < this.chunkColliders.Count; i++)
+            {
+                chunkEntity.AddChild(this.chunkColliders[i]);
+            }
+
+            this.chunkColliders.Clear();
+            this.Owner.AddChild(chunkEntity);
+            this.chunkEntities[chunkIndex] = chunkEntity;
+        }
+
+        /// <summary>
+        /// Checks whether a collision shape of the tile covers the whole map cell.
+        /// Tiles of tilesets with a drawing offset are not aligned with the map cells, so they are never merged.
+        /// </summary>
+        /// <param name="tilesetTile">The tileset tile.</param>
+        /// <returns>True if the tile is fully solid, false in other case</returns>
+        private bool IsSolidTile(TilesetTile tilesetTile)
+        {
+            var tileset = tilesetTile.Tileset;
+            if (tileset.TileWidth != this.tiledMap.TileWidth
+             || tileset.TileHeight != this.tiledMap.TileHeight
+             || tileset.XDrawingOffset != 0
+             || tileset.YDrawingOffset != 0)
+            {
+                return false;
+            }
+
+            for (int i = 0; i < tilesetTile.CollisionObjects.Count; i++)
+            {
+                var collisionObject = tilesetTile.CollisionObjects[i];
+
+                if (collisionObject.ObjectType == TiledMapObjectType.Basic
+                 && collisionObject.Rotation == 0
+                 && collisionObject.X <= 0
+                 && collisionObject.Y <= 0
+                 && collisionObject.X + collisionObject.Width >= tileset.TileWidth
+                 && collisionObject.Y + collisionObject.Height >= tileset.TileHeight)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Merges the solid tiles of the chunk into maximal rectangles, and adds a collider for each one
+        /// </summary>
+        /// <param name="startX">The X coord of the first tile of the chunk.</param>
+        /// <param name="startY">The Y coord of the first tile of the chunk.</param>
+        /// <param name="width">The chunk width in tiles.</param>
+        /// <param name="height">The chunk height in tiles.</param>
+        private void AddMergedRectangles(int startX, int startY, int width, int height)
+        {
+            this.mergedRectangles.Clear();
+            TiledMapColliderShapes.MergeSolidTiles(this.solidTiles, width, height, this.mergedRectangles);
+
+            for (int i = 0; i < this.mergedRectangles.Count; i++)
+            {
+                var merged = this.mergedRectangles[i];
+                var rectangle = new RectangleF(
+                    (startX + merged.X) * this.tiledMap.TileWidth,
+                    (startY + merged.Y) * this.tiledMap.TileHeight,
+                    merged.Width * this.tiledMap.TileWidth,
+                    merged.Height * this.tiledMap.TileHeight);
+
+                this.AddRectangleCollider(rectangle);
+            }
+        }
+
+        /// <summary>
+        /// Adds a collider for a collision shape of a tile
+        /// </summary>
+        /// <param name="tile">The layer tile.</param>
+        /// <param name="collisionObject">The collision shape.</param>
+        private void AddTileShape(LayerTile tile, TiledMapObject collisionObject)
+        {
+            bool closed;
+            if (!TiledMapColliderShapes.GetTileShapeOutline(tile, collisionObject, tile.Tileset.TileWidth, tile.Tileset.TileHeight, this.outline, out closed))
+            {
+                return;
+            }
+
+            if (collisionObject.ObjectType == TiledMapObjectType.Basic && collisionObject.Rotation == 0)
+            {
+                // Flips keep the rectangle axis aligned
+                var min = Vector2.Min(this.outline[0], this.outline[2]);
+                var max = Vector2.Max(this.outline[0], this.outline[2]);
+                this.AddRectangleCollider(new RectangleF(min.X, min.Y, max.X - min.X, max.Y - min.Y));
+            }
+            else
+            {
+                if (closed)
+                {
+                    this.outline.Add(this.outline[0]);
+                }
+
+                this.chunkColliders.Add(new Entity(string.Format("collider{0}", this.chunkColliders.Count))
+                    .AddComponent(new Transform2D())
+                    .AddComponent(new EdgeCollider2D()
+                    {
+                        Vertices = this.outline.ToArray()
+                    })
+                    .AddComponent(new RigidBody2D()
+                    {
+                        PhysicBodyType = RigidBodyType2D.Static
+                    }));
+            }
+        }
+
+        /// <summary>
+        /// Adds a rectangle collider to the chunk being built
+        /// </summary>
+        /// <param name="rectangle">The rectangle in layer coordinates.</param>
+        private void AddRectangleCollider(RectangleF rectangle)
+        {
+            this.chunkColliders.Add(new Entity(string.Format("collider{0}", this.chunkColliders.Count))
+                .AddComponent(new Transform2D()
+                {
+                    LocalPosition = new Vector2(rectangle.X, rectangle.Y),
+                    Rectangle = new RectangleF(0, 0, rectangle.Width, rectangle.Height),
+                    Origin = Vector2.Zero
+                })
+                .AddComponent(new RectangleCollider2D())
+                .AddComponent(new RigidBody2D()
+                {
+                    PhysicBodyType = RigidBodyType2D.Static
+                }));
+        }
+
+        /// <summary>
+        /// Handles the layer refresh
+        /// </summary>
+        /// <param name="sender">The sender.</param>
+        /// <param name="e">The event args.</param>
+        private void TiledMapLayer_OnLayerRefresh(object sender, EventArgs e)
+        {
+            this.needsFullRebuild = true;
+        }
+
+        /// <summary>
+        /// Marks the chunk of a changed tile to be rebuilt
+        /// </summary>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        private void TiledMapLayer_OnTileChanged(int x, int y)
+        {
+            if (this.dirtyChunks == null)
+            {
+                return;
+            }
+
+            this.dirtyChunks[(x / this.builtChunkSize) + ((y / this.builtChunkSize) * this.chunksX)] = true;
+            this.hasDirtyChunks = true;
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,98 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using TiledSharp;
+using WaveEngine.Common.Math;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// The tile layer data of a map, independent of the file it was loaded from
+    /// </summary>
+    internal class TiledMapLayerData
+    {
+        #region Properties
+
+        /// <summary>
+        /// Gets the layer name
+        /// </summary>
+        public string Name { get; private set; }
+
+        /// <summary>
+        /// Gets the layer order index, shared with image layers
+        /// </summary>
+        public int OrderIndex { get; private set; }
+
+        /// <summary>
+        /// Gets the layer opacity
+        /// </summary>
+        public double Opacity { get; private set; }
+
+        /// <summary>
+        /// Gets a value indicating whether the layer is visible
+        /// </summary>
+        public bool Visible { get; private set; }
+
+        /// <summary>
+        /// Gets the layer offset
+        /// </summary>
+        public Vector2 Offset { get; private set; }
+
+        /// <summary>
+        /// Gets the packed global tile ID and flip bits of each tile, indexed by x + y * width
+        /// </summary>
+        public uint[] Tiles { get; private set; }
+        #endregion
+
+        #region Initialization
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapLayerData" /> class.
+        /// </summary>
+        /// <param name="tmxLayer">The TMX parsed layer.</param>
+        /// <param name="tileCount">The number of tiles of the map.</param>
+        public TiledMapLayerData(TmxLayer tmxLayer, int tileCount)
+        {
+            this.Name = tmxLayer.Name;
+            this.OrderIndex = tmxLayer.OrderIndex;
+            this.Opacity = tmxLayer.Opacity;
+            this.Visible = tmxLayer.Visible;
+            this.Offset = new Vector2((float)tmxLayer.OffsetX, (float)tmxLayer.OffsetY);
+            this.Tiles = new uint[tileCount];
+
+            int count = Math.Min(tmxLayer.Tiles.Count, tileCount);
+            for (int i = 0; i < count; i++)
+            {
+                var tmxTile = tmxLayer.Tiles[i];
+                this.Tiles[i] = LayerTile.Pack(tmxTile.Gid, tmxTile.HorizontalFlip, tmxTile.VerticalFlip, tmxTile.DiagonalFlip);
+            }
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapLayerData" /> class.
+        /// </summary>
+        /// <param name="reader">The cooked map reader.</param>
+        /// <param name="tileCount">The number of tiles of the map.</param>
+        public TiledMapLayerData(BinaryReader reader, int tileCount)
+        {
+            this.Name = reader.ReadString();
+            this.OrderIndex = reader.ReadInt32();
+            this.Opacity = reader.ReadDouble();
+            this.Visible = reader.ReadBoolean();
+            this.Offset = new Vector2((float)reader.ReadDouble(), (float)reader.ReadDouble());
+            this.Tiles = TiledMapCooker.ReadTiles(reader);
+
+            if (this.Tiles.Length != tileCount)
+            {
+                throw new FormatException("The cooked layer " + this.Name + " does not match the map size.");
+            }
+        }
+        #endregion
+    }
+}
@@ -2,6 +2,7 @@
 
 #region Using Statements
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Linq;
 using System.Runtime.Serialization;
@@ -21,6 +22,10 @@ namespace WaveEngine.TiledMap
     /// <summary>
     /// Render a TiledMap Layer
     /// </summary>
+    /// <remarks>
+    /// The layer is drawn once per camera. The tile animations and the chunk streaming advance once per frame,
+    /// through the <see cref="TiledMapLayerBehavior"/> of the layer entity.
+    /// </remarks>
     [DataContract]
     public class TiledMapLayerRenderer : Drawable2D
     {
@@ -39,6 +44,31 @@ namespace WaveEngine.TiledMap
         /// </summary>
         private const int MaxTilesPerBuffer = ushort.MaxValue / IndicesPerTile;
 
+        /// <summary>
+        /// The default chunk size in tiles
+        /// </summary>
+        private const int DefaultChunkSize = 32;
+
+        /// <summary>
+        /// The maximum chunk size in tiles, so the indices of a square chunk fit in a single 16-bit index buffer
+        /// </summary>
+        private static readonly int MaxChunkSize = (int)Math.Sqrt(MaxTilesPerBuffer);
+
+        /// <summary>
+        /// The default number of chunks kept in memory when streaming
+        /// </summary>
+        private const int DefaultMaxResidentChunks = 64;
+
+        /// <summary>
+        /// The default distance around the camera view where chunks are loaded in advance when streaming
+        /// </summary>
+        private const float DefaultStreamingDistance = 512;
+
+        /// <summary>
+        /// Maximum number of streamed chunks uploaded to the GPU in a single frame
+        /// </summary>
+        private const int MaxUploadsPerFrame = 4;
+
         /// <summary>
         /// The associated tiled map
         /// </summary>
@@ -50,29 +80,113 @@ namespace WaveEngine.TiledMap
         private List<StandardMaterial> materials;
 
         /// <summary>
-        /// Meshes list
+        /// The material index of each tileset
+        /// </summary>
+        private Dictionary<Tileset, int> materialIndices;
+
+        /// <summary>
+        /// The chunk size
+        /// </summary>
+        [DataMember]
+        private int chunkSize;
+
+        /// <summary>
+        /// The layer chunks
+        /// </summary>
+        private Chunk[] chunks;
+
+        /// <summary>
+        /// The chunk indices sorted by the map render order
+        /// </summary>
+        private int[] chunkDrawOrder;
+
+        /// <summary>
+        /// Width of a chunk in tiles
+        /// </summary>
+        private int chunkWidth;
+
+        /// <summary>
+        /// Height of a chunk in tiles
+        /// </summary>
+        private int chunkHeight;
+
+        /// <summary>
+        /// Number of chunks in the X axis
+        /// </summary>
+        private int chunksX;
+
+        /// <summary>
+        /// The visible chunks of the row of chunks being drawn
+        /// </summary>
+        private Chunk[] visibleChunks;
+
+        /// <summary>
+        /// The index buffer shared by all the chunks
+        /// </summary>
+        private IndexBuffer indexBuffer;
+
+        /// <summary>
+        /// The chunks touched by the current dirty pass
+        /// </summary>
+        private List<Chunk> dirtyChunks = new List<Chunk>();
+
+        /// <summary>
+        /// Whether the chunks are loaded on demand around the camera
+        /// </summary>
+        [DataMember]
+        private bool streamingEnabled;
+
+        /// <summary>
+        /// The maximum number of chunks kept in memory when streaming
+        /// </summary>
+        [DataMember]
+        private int maxResidentChunks;
+
+        /// <summary>
+        /// The distance around the camera view where chunks are loaded in advance
+        /// </summary>
+        [DataMember]
+        private float streamingDistance;
+
+        /// <summary>
+        /// Chunks whose geometry has been built in a background thread, waiting for the GPU upload
+        /// </summary>
+        private ConcurrentQueue<Chunk> builtChunks = new ConcurrentQueue<Chunk>();
+
+        /// <summary>
+        /// The resident chunks, from the most to the least recently visible
+        /// </summary>
+        private LinkedList<Chunk> residentChunks = new LinkedList<Chunk>();
+
+        /// <summary>
+        /// Vertex arrays of evicted chunks, reused by the next loaded chunks
         /// </summary>
-        private List<Mesh> meshes;
+        private Stack<VertexPositionColorTexture[]> vertexPool = new Stack<VertexPositionColorTexture[]>();
 
         /// <summary>
-        /// Tiles count
+        /// Number of chunks being built in background threads
         /// </summary>
-        private int nTiles;
+        private int pendingBuilds;
 
         /// <summary>
-        /// Vertices data
+        /// Maximum number of chunks built at the same time
         /// </summary>
-        private VertexPositionColorTexture[][] vertices;
+        private int maxPendingBuilds;
 
         /// <summary>
-        /// The layer vertex buffer
+        /// Current streaming frame, used to know which chunks are visible
         /// </summary>
-        private DynamicVertexBuffer[] vertexBuffer;
+        private int streamingFrame;
 
         /// <summary>
-        /// The layer index buffer
+        /// Incremented each time the chunks are removed, so background builds of old chunks are ignored
         /// </summary>
-        private IndexBuffer[] indexBuffer;
+        private volatile int buildGeneration;
+
+        /// <summary>
+        /// The time used to play the tile animations
+        /// </summary>
+        private TimeSpan animationTime;
 
         /// <summary>
         /// This component requires a Transfrom2D
@@ -122,11 +236,111 @@ namespace WaveEngine.TiledMap
         {
             base.DefaultValues();
             this.materials = new List<StandardMaterial>();
-            this.meshes = new List<Mesh>();
+            this.materialIndices = new Dictionary<Tileset, int>();
+            this.chunkSize = DefaultChunkSize;
+            this.maxResidentChunks = DefaultMaxResidentChunks;
+            this.streamingDistance = DefaultStreamingDistance;
+            this.maxPendingBuilds = Math.Max(1, Environment.ProcessorCount - 1);
             this.originTranslation = Matrix.Identity;
         }
         #endregion
 
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the size in tiles of the chunks the layer is split into.
+        /// Each chunk is culled and refreshed independently.
+        /// </summary>
+        /// <remarks>
+        /// In non orthogonal maps the tiles of a row overlap the tiles of the next one, so the chunks of a row of chunks
+        /// are drawn interleaved, one row of tiles at a time, to keep the render order of the map.
+        /// </remarks>
+        public int ChunkSize
+        {
+            get
+            {
+                return this.chunkSize;
+            }
+
+            set
+            {
+                if (value < 1 || value > MaxChunkSize)
+                {
+                    throw new ArgumentOutOfRangeException("value", string.Format("Chunk size must be between 1 and {0}", MaxChunkSize));
+                }
+
+                this.chunkSize = value;
+                if (this.isInitialized)
+                {
+                    this.tiledMapLayer.NeedRefresh = true;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets a value indicating whether the chunks are loaded on demand as the camera approaches them,
+        /// instead of keeping the whole layer geometry in memory.
+        /// </summary>
+        /// <remarks>
+        /// Chunk geometry is built in background threads, and only the GPU upload runs on the main thread.
+        /// When more than <see cref="MaxResidentChunks"/> chunks are loaded, the least recently visible ones are evicted.
+        /// </remarks>
+        public bool StreamingEnabled
+        {
+            get
+            {
+                return this.streamingEnabled;
+            }
+
+            set
+            {
+                this.streamingEnabled = value;
+                if (this.isInitialized)
+                {
+                    this.tiledMapLayer.NeedRefresh = true;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the maximum number of chunks kept in memory when streaming.
+        /// Visible chunks are never evicted, so this limit can be exceeded if the camera sees more chunks.
+        /// </summary>
+        public int MaxResidentChunks
+        {
+            get
+            {
+                return this.maxResidentChunks;
+            }
+
+            set
+            {
+                if (value < 1)
+                {
+                    throw new ArgumentOutOfRangeException("value", "The maximum number of resident chunks must be greater than 0");
+                }
+
+                this.maxResidentChunks = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the distance, in layer units, around the camera view where chunks are loaded in advance when streaming.
+        /// </summary>
+        public float StreamingDistance
+        {
+            get
+            {
+                return this.streamingDistance;
+            }
+
+            set
+            {
+                this.streamingDistance = Math.Max(0, value);
+            }
+        }
+        #endregion
+
         #region Public Methods
 
         /// <summary>
@@ -348,8 +562,19 @@ namespace WaveEngine.TiledMap
         {
             if (this.tiledMapLayer.NeedRefresh)
             {
-                this.RefreshMeshes();
+                this.RefreshChunks();
                 this.tiledMapLayer.NeedRefresh = false;
+                this.tiledMapLayer.DirtyTiles.Clear();
+            }
+            else if (this.tiledMapLayer.DirtyTiles.Count > 0)
+            {
+                this.RefreshDirtyChunks();
+                this.tiledMapLayer.DirtyTiles.Clear();
+            }
+
+            if (this.chunks == null)
+            {
+                return;
             }
 
             if (this.cachedOrigin != this.transform2D.Origin)
@@ -370,33 +595,150 @@ namespace WaveEngine.TiledMap
                 opacity *= DebugAlpha;
             }
 
-            for (int i = 0; i < this.meshes.Count; i++)
+            if (this.streamingEnabled)
             {
-                var mesh = this.meshes[i];
+                this.RequestVisibleChunks(ref worldTransform);
+            }
+
+            for (int i = 0; i < this.materials.Count; i++)
+            {
+                var material = this.materials[i];
+                material.Alpha = opacity;
+                material.LayerId = this.LayerId;
+            }
 
-                if (this.CullingTest(mesh, ref worldTransform))
+            if (this.tiledMap.Orientation == TiledMapOrientationType.Orthogonal)
+            {
+                for (int i = 0; i < this.chunkDrawOrder.Length; i++)
                 {
-                    var material = this.materials[mesh.MaterialIndex];
+                    var chunk = this.chunks[this.chunkDrawOrder[i]];
 
-                    material.Alpha = opacity;
-                    material.LayerId = this.LayerId;
-                    mesh.ZOrder = drawOrder;
-                    this.RenderManager.DrawMesh(mesh, material, ref worldTransform);
+                    if (!this.IsChunkVisible(chunk, ref worldTransform))
+                    {
+                        continue;
+                    }
+
+                    for (int j = 0; j < chunk.Meshes.Count; j++)
+                    {
+                        this.DrawChunkMesh(chunk.Meshes[j], drawOrder, ref worldTransform);
+                    }
                 }
             }
+            else
+            {
+                this.DrawInterleavedChunks(drawOrder, ref worldTransform);
+            }
+        }
+
+        /// <summary>
+        /// Advances the layer state once per frame, no matter how many cameras draw it
+        /// </summary>
+        /// <param name="gameTime">The elapsed time since the last frame.</param>
+        internal void UpdateFrame(TimeSpan gameTime)
+        {
+            this.animationTime += gameTime;
+
+            if (this.streamingEnabled && this.chunks != null)
+            {
+                this.UpdateStreaming();
+            }
+
+            this.streamingFrame++;
         }
         #endregion
 
         #region Private Methods
-        private bool CullingTest(Mesh mesh, ref Matrix worldTransform)
+
+        /// <summary>
+        /// Draws the chunks of a non orthogonal map. The visible chunks of each row of chunks are drawn one row
+        /// of tiles at a time, so the tiles keep the map render order across the chunk borders.
+        /// </summary>
+        /// <param name="drawOrder">The layer draw order.</param>
+        /// <param name="worldTransform">The layer world transform.</param>
+        private void DrawInterleavedChunks(float drawOrder, ref Matrix worldTransform)
+        {
+            // The chunk draw order keeps the chunks of a row of chunks together
+            for (int first = 0; first < this.chunkDrawOrder.Length; first += this.chunksX)
+            {
+                int visibleCount = 0;
+                for (int i = 0; i < this.chunksX; i++)
+                {
+                    var chunk = this.chunks[this.chunkDrawOrder[first + i]];
+
+                    if (this.IsChunkVisible(chunk, ref worldTransform))
+                    {
+                        chunk.DrawnMeshes = 0;
+                        this.visibleChunks[visibleCount++] = chunk;
+                    }
+                }
+
+                if (visibleCount == 0)
+                {
+                    continue;
+                }
+
+                // All the chunks of a row of chunks have the same height
+                int rows = this.visibleChunks[0].Height;
+                for (int row = 0; row < rows; row++)
+                {
+                    for (int i = 0; i < visibleCount; i++)
+                    {
+                        var chunk = this.visibleChunks[i];
+
+                        while (chunk.DrawnMeshes < chunk.Meshes.Count && chunk.MeshRanges[chunk.DrawnMeshes].Row == row)
+                        {
+                            this.DrawChunkMesh(chunk.Meshes[chunk.DrawnMeshes], drawOrder, ref worldTransform);
+                            chunk.DrawnMeshes++;
+                        }
+                    }
+                }
+
+                Array.Clear(this.visibleChunks, 0, visibleCount);
+            }
+        }
+
+        /// <summary>
+        /// Checks whether a chunk has something to draw inside the camera view, and updates its animated tiles if so
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        /// <param name="worldTransform">The layer world transform.</param>
+        /// <returns>True if the chunk must be drawn, false in other case</returns>
+        private bool IsChunkVisible(Chunk chunk, ref Matrix worldTransform)
+        {
+            if (chunk.Meshes.Count == 0
+             || !this.CullingTest(ref chunk.BoundingBox, ref worldTransform))
+            {
+                return false;
+            }
+
+            if (chunk.AnimatedTiles.Count > 0)
+            {
+                this.UpdateAnimatedTiles(chunk);
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Draws a mesh of a chunk
+        /// </summary>
+        /// <param name="mesh">The mesh.</param>
+        /// <param name="drawOrder">The layer draw order.</param>
+        /// <param name="worldTransform">The layer world transform.</param>
+        private void DrawChunkMesh(Mesh mesh, float drawOrder, ref Matrix worldTransform)
+        {
+            mesh.ZOrder = drawOrder;
+            this.RenderManager.DrawMesh(mesh, this.materials[mesh.MaterialIndex], ref worldTransform);
+        }
+
+        private bool CullingTest(ref BoundingBox boundingBox, ref Matrix worldTransform)
         {
             bool passesTest = true;
             var camera = this.RenderManager.CurrentDrawingCamera2D;
 
-            if (camera != null &&
-                mesh.BoundingBox.HasValue)
+            if (camera != null)
             {
-                var bbox = mesh.BoundingBox.Value;
+                var bbox = boundingBox;
 
                 bbox.Transform(ref worldTransform);
 
@@ -435,117 +777,557 @@ namespace WaveEngine.TiledMap
         }
 
         /// <summary>
-        /// Refresh layer meshes.
+        /// Splits the layer in chunks and refreshes all of them.
         /// </summary>
-        private void RefreshMeshes()
+        private void RefreshChunks()
         {
-            this.meshes.Clear();
+            this.RemoveBuffers();
 
-            // If the tiles count is changed, clear the previous buffers an init a new ones
-            int newNTiles = this.tiledMapLayer.Tiles.Count();
-            if (newNTiles != this.nTiles)
+            int width = this.tiledMap.Width;
+            int height = this.tiledMap.Height;
+
+            if (width == 0 || height == 0)
             {
-                this.RemoveBuffers();
-                this.nTiles = newNTiles;
+                return;
+            }
 
-                var bufferCount = (int)Math.Ceiling((float)newNTiles / MaxTilesPerBuffer);
+            this.chunkWidth = Math.Min(this.chunkSize, width);
+            this.chunkHeight = Math.Min(this.chunkSize, height);
+            this.chunksX = (width + this.chunkWidth - 1) / this.chunkWidth;
+            int chunksY = (height + this.chunkHeight - 1) / this.chunkHeight;
 
-                this.vertices = new VertexPositionColorTexture[bufferCount][];
-                this.vertexBuffer = new DynamicVertexBuffer[bufferCount];
-                this.indexBuffer = new IndexBuffer[bufferCount];
+            // All the chunks share the same index buffer, as the indices only depend on the tile index inside the chunk
+            int tilesPerChunk = this.chunkWidth * this.chunkHeight;
+            ushort[] indices = new ushort[tilesPerChunk * IndicesPerTile];
+            for (int i = 0; i < tilesPerChunk; i++)
+            {
+                indices[i * 6] = (ushort)(i * 4);
+                indices[(i * 6) + 1] = (ushort)((i * 4) + 1);
+                indices[(i * 6) + 2] = (ushort)((i * 4) + 2);
+                indices[(i * 6) + 3] = (ushort)((i * 4) + 2);
+                indices[(i * 6) + 4] = (ushort)((i * 4) + 3);
+                indices[(i * 6) + 5] = (ushort)(i * 4);
+            }
+
+            this.indexBuffer = new IndexBuffer(indices);
+
+            this.chunks = new Chunk[this.chunksX * chunksY];
+            this.chunkDrawOrder = new int[this.chunks.Length];
+            this.visibleChunks = new Chunk[this.chunksX];
+
+            // The largest tile drawn by the layer, used to bound the chunks before their geometry is built
+            var maxTileSize = new Vector2(this.tiledMap.TileWidth, this.tiledMap.TileHeight);
+            foreach (var tileset in this.tiledMap.Tilesets)
+            {
+                maxTileSize.X = Math.Max(maxTileSize.X, tileset.TileWidth + Math.Abs(tileset.XDrawingOffset));
+                maxTileSize.Y = Math.Max(maxTileSize.Y, tileset.TileHeight + Math.Abs(tileset.YDrawingOffset));
+            }
 
-                for (int j = 0; j < bufferCount; j++)
+            for (int i = 0; i < chunksY; i++)
+            {
+                for (int j = 0; j < this.chunksX; j++)
                 {
-                    int nBufferTiles = Math.Min(MaxTilesPerBuffer, this.nTiles - (j * MaxTilesPerBuffer));
+                    var chunk = new Chunk()
+                    {
+                        Generation = this.buildGeneration,
+                        X = j * this.chunkWidth,
+                        Y = i * this.chunkHeight,
+                        Width = Math.Min(this.chunkWidth, width - (j * this.chunkWidth)),
+                        Height = Math.Min(this.chunkHeight, height - (i * this.chunkHeight)),
+                        Meshes = new List<Mesh>(),
+                        MeshRanges = new List<MeshRange>(),
+                        AnimatedTiles = new List<AnimatedTile>(),
+                    };
 
-                    // Vertices
-                    this.vertices[j] = new VertexPositionColorTexture[nBufferTiles * VerticesPerTile];
-                    this.vertexBuffer[j] = new DynamicVertexBuffer(VertexPositionColorTexture.VertexFormat);
+                    this.chunks[j + (i * this.chunksX)] = chunk;
 
-                    // Indices
-                    ushort[] indices = new ushort[nBufferTiles * IndicesPerTile];
-                    for (int i = 0; i < nBufferTiles; i++)
+                    if (this.streamingEnabled)
+                    {
+                        chunk.State = ChunkState.Unloaded;
+                        this.CalcStreamingBounds(chunk, ref maxTileSize);
+                    }
+                    else
                     {
-                        indices[i * 6] = (ushort)(i * 4);
-                        indices[(i * 6) + 1] = (ushort)((i * 4) + 1);
-                        indices[(i * 6) + 2] = (ushort)((i * 4) + 2);
-                        indices[(i * 6) + 3] = (ushort)((i * 4) + 2);
-                        indices[(i * 6) + 4] = (ushort)((i * 4) + 3);
-                        indices[(i * 6) + 5] = (ushort)(i * 4);
+                        chunk.Vertices = new VertexPositionColorTexture[chunk.Width * chunk.Height * VerticesPerTile];
+                        this.RefreshChunk(chunk);
                     }
 
-                    this.indexBuffer[j] = new IndexBuffer(indices);
+                    // Chunks are drawn following the same render order of the tiles
+                    int x, y;
+                    this.GetCellRenderOrderByIndex(j, i, this.chunksX, chunksY, out x, out y);
+                    this.chunkDrawOrder[j + (i * this.chunksX)] = x + (y * this.chunksX);
                 }
             }
 
+            this.transform2D.Rectangle = this.tiledMap.CalcRectangle();
+        }
+
+        /// <summary>
+        /// Refreshes the chunks that contain tiles changed since the last frame.
+        /// Tiles that keep their tileset are patched in place, otherwise the whole chunk is rebuilt.
+        /// </summary>
+        private void RefreshDirtyChunks()
+        {
+            if (this.chunks == null)
+            {
+                return;
+            }
+
+            var dirtyTiles = this.tiledMapLayer.DirtyTiles;
+            int width = this.tiledMap.Width;
+
+            for (int i = 0; i < dirtyTiles.Count; i++)
+            {
+                int x = dirtyTiles[i] % width;
+                int y = dirtyTiles[i] / width;
+                var chunk = this.chunks[(x / this.chunkWidth) + ((y / this.chunkHeight) * this.chunksX)];
+
+                if (chunk.State == ChunkState.Building)
+                {
+                    // The geometry being built may be stale, so it is rebuilt once uploaded
+                    chunk.RebuildWhenLoaded = true;
+                    continue;
+                }
+                else if (chunk.State == ChunkState.Unloaded)
+                {
+                    continue;
+                }
+
+                if (!chunk.NeedsRebuild && !chunk.NeedsUpload)
+                {
+                    chunk.FirstDirtySlot = int.MaxValue;
+                    chunk.LastDirtySlot = -1;
+                    this.dirtyChunks.Add(chunk);
+                }
+
+                if (chunk.NeedsRebuild)
+                {
+                    continue;
+                }
+
+                int slot = chunk.TileSlots[(x - chunk.X) + ((y - chunk.Y) * chunk.Width)];
+                LayerTile? tile = this.tiledMapLayer.GetLayerTileByMapCoordinates(x, y);
+
+                if (slot >= 0
+                 && IsDrawable(tile)
+                 && tile.Value.Tileset == chunk.SlotTilesets[slot]
+                 && chunk.AnimatedTiles.Count == 0
+                 && !IsAnimated(tile.Value))
+                {
+                    // The tile keeps its place in the mesh, so only its vertices change
+                    var boundingBox = chunk.BoundingBox;
+                    this.FillTile(tile.Value.Tileset, tile.Value, chunk.Vertices, slot, ref boundingBox);
+                    chunk.FirstDirtySlot = Math.Min(chunk.FirstDirtySlot, slot);
+                    chunk.LastDirtySlot = Math.Max(chunk.LastDirtySlot, slot);
+                    chunk.NeedsUpload = true;
+                }
+                else
+                {
+                    chunk.NeedsRebuild = true;
+                }
+            }
+
+            for (int i = 0; i < this.dirtyChunks.Count; i++)
+            {
+                var chunk = this.dirtyChunks[i];
+
+                if (chunk.NeedsRebuild)
+                {
+                    this.RefreshChunk(chunk);
+                }
+                else
+                {
+                    this.UploadChunkSlots(chunk, chunk.FirstDirtySlot, chunk.LastDirtySlot);
+                }
+
+                chunk.NeedsRebuild = false;
+                chunk.NeedsUpload = false;
+            }
+
+            this.dirtyChunks.Clear();
+        }
+
+        /// <summary>
+        /// Checks whether a tile is animated
+        /// </summary>
+        /// <param name="tile">The tile.</param>
+        /// <returns>True if the tile has animation frames, false in other case</returns>
+        private static bool IsAnimated(LayerTile tile)
+        {
+            var tilesetTile = tile.TilesetTile;
+            return tilesetTile != null && tilesetTile.IsAnimated;
+        }
+
+        /// <summary>
+        /// Checks whether a tile has something to draw
+        /// </summary>
+        /// <param name="tile">The tile.</param>
+        /// <returns>True if the tile must be drawn, false in other case</returns>
+        private static bool IsDrawable(LayerTile? tile)
+        {
+            return tile.HasValue && tile.Value.Id >= 0 && tile.Value.Tileset != null && tile.Value.Tileset.Image != null;
+        }
+
+        /// <summary>
+        /// Refreshes the vertices and meshes of a chunk
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        private void RefreshChunk(Chunk chunk)
+        {
+            this.BuildChunkGeometry(chunk);
+            this.UploadChunkGeometry(chunk);
+        }
+
+        /// <summary>
+        /// Fills the vertices of a chunk and splits them in runs of tiles that share a tileset.
+        /// It only reads the layer data, so it can run in a background thread.
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        private void BuildChunkGeometry(Chunk chunk)
+        {
+            chunk.MeshRanges.Clear();
+            chunk.AnimatedTiles.Clear();
+            chunk.BoundingBox = new BoundingBox(new Vector3(float.MaxValue), new Vector3(float.MinValue));
+
+            if (chunk.TileSlots == null)
+            {
+                chunk.TileSlots = new int[chunk.Width * chunk.Height];
+                chunk.SlotTilesets = new Tileset[chunk.Width * chunk.Height];
+            }
+
+            for (int i = 0; i < chunk.TileSlots.Length; i++)
+            {
+                chunk.TileSlots[i] = -1;
+            }
+
             int tileIndex = 0;
             int startIndex = 0;
-            int currentIndexCount = 0;
-            int bufferIndex = 0;
-            var boundingBox = new BoundingBox(new Vector3(float.MaxValue), new Vector3(float.MinValue));
+            int startRow = 0;
+            var boundingBox = chunk.BoundingBox;
             Tileset currentTileset = null;
 
-            for (int i = 0; i < this.tiledMap.Height; i++)
+            // Non orthogonal chunks are drawn one row at a time, so their runs of tiles can't span several rows
+            bool splitRows = this.tiledMap.Orientation != TiledMapOrientationType.Orthogonal;
+
+            for (int i = 0; i < chunk.Height; i++)
             {
-                for (int j = 0; j < this.tiledMap.Width; j++)
+                if (splitRows && currentTileset != null)
+                {
+                    this.NewMeshRange(chunk, startIndex, tileIndex - startIndex, startRow, currentTileset, ref boundingBox);
+
+                    startIndex = tileIndex;
+                    currentTileset = null;
+                    boundingBox = new BoundingBox(new Vector3(float.MaxValue), new Vector3(float.MinValue));
+                }
+
+                for (int j = 0; j < chunk.Width; j++)
                 {
                     int x, y;
-                    this.GetCellRenderOrderByIndex(j, i, out x, out y);
+                    this.GetCellRenderOrderByIndex(j, i, chunk.Width, chunk.Height, out x, out y);
 
-                    LayerTile tile = this.tiledMapLayer.GetLayerTileByMapCoordinates(x, y);
+                    LayerTile? tile = this.tiledMapLayer.GetLayerTileByMapCoordinates(chunk.X + x, chunk.Y + y);
 
-                    if (tile == null || tile.Id < 0 || tile.Tileset == null || tile.Tileset.Image == null)
+                    if (!IsDrawable(tile))
                     {
                         continue;
                     }
 
-                    Tileset tileset = tile.Tileset;
+                    Tileset tileset = tile.Value.Tileset;
 
                     if (currentTileset == null)
                     {
                         currentTileset = tileset;
+                        startRow = i;
                     }
                     else if (tileset != currentTileset)
                     {
-                        this.NewMesh(startIndex, currentIndexCount, bufferIndex, currentTileset.Image, ref boundingBox);
+                        this.NewMeshRange(chunk, startIndex, tileIndex - startIndex, startRow, currentTileset, ref boundingBox);
 
                         startIndex = tileIndex;
-                        currentIndexCount = 0;
+                        startRow = i;
                         currentTileset = tileset;
                         boundingBox = new BoundingBox(new Vector3(float.MaxValue), new Vector3(float.MinValue));
                     }
 
-                    this.FillTile(currentTileset, tile, bufferIndex, tileIndex, ref boundingBox);
+                    this.FillTile(currentTileset, tile.Value, chunk.Vertices, tileIndex, ref boundingBox);
 
-                    tileIndex++;
-                    currentIndexCount++;
+                    chunk.TileSlots[x + (y * chunk.Width)] = tileIndex;
+                    chunk.SlotTilesets[tileIndex] = currentTileset;
 
-                    if (tileIndex == MaxTilesPerBuffer)
+                    if (IsAnimated(tile.Value))
                     {
-                        this.vertexBuffer[bufferIndex].SetData(this.vertices[bufferIndex]);
-                        this.GraphicsDevice.BindVertexBuffer(this.vertexBuffer[bufferIndex]);
+                        // The frame is set the first time the chunk is drawn
+                        chunk.AnimatedTiles.Add(new AnimatedTile()
+                        {
+                            Slot = tileIndex,
+                            TilesetTile = tile.Value.TilesetTile,
+                            FrameId = tile.Value.Id,
+                            HorizontalFlip = tile.Value.HorizontalFlip,
+                            VerticalFlip = tile.Value.VerticalFlip,
+                            DiagonalFlip = tile.Value.DiagonalFlip,
+                        });
+                    }
 
-                        this.NewMesh(startIndex, currentIndexCount, bufferIndex, currentTileset.Image, ref boundingBox);
+                    tileIndex++;
+                }
+            }
 
-                        tileIndex = 0;
-                        startIndex = 0;
-                        currentIndexCount = 0;
-                        currentTileset = null;
-                        boundingBox = new BoundingBox(new Vector3(float.MaxValue), new Vector3(float.MinValue));
-                        bufferIndex++;
+            if (currentTileset != null)
+            {
+                this.NewMeshRange(chunk, startIndex, tileIndex - startIndex, startRow, currentTileset, ref boundingBox);
+            }
+        }
+
+        /// <summary>
+        /// Creates the meshes of a chunk from its built geometry and uploads its vertices to the GPU
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        private void UploadChunkGeometry(Chunk chunk)
+        {
+            chunk.Meshes.Clear();
+
+            if (chunk.MeshRanges.Count == 0)
+            {
+                return;
+            }
+
+            if (chunk.VertexBuffer == null)
+            {
+                chunk.VertexBuffer = new DynamicVertexBuffer(VertexPositionColorTexture.VertexFormat);
+            }
+
+            for (int i = 0; i < chunk.MeshRanges.Count; i++)
+            {
+                var range = chunk.MeshRanges[i];
+
+                var mesh = new Mesh(
+                    0,
+                    chunk.Vertices.Length,
+                    range.StartIndex * IndicesPerTile,
+                    range.Count * 2,
+                    chunk.VertexBuffer,
+                    this.indexBuffer,
+                    PrimitiveType.TriangleList)
+                {
+                    DisableBatch = true,
+                    MaterialIndex = this.GetMaterialIndex(range.Tileset),
+                    BoundingBox = range.BoundingBox,
+                };
+
+                chunk.Meshes.Add(mesh);
+            }
+
+            chunk.VertexBuffer.SetData(chunk.Vertices);
+            this.GraphicsDevice.BindVertexBuffer(chunk.VertexBuffer);
+        }
+
+        /// <summary>
+        /// Updates the texture coordinates of the animated tiles of a chunk whose frame changed, and uploads the chunk if needed
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        private void UpdateAnimatedTiles(Chunk chunk)
+        {
+            int firstSlot = int.MaxValue;
+            int lastSlot = -1;
+            var animatedTiles = chunk.AnimatedTiles;
+
+            for (int i = 0; i < animatedTiles.Count; i++)
+            {
+                var animatedTile = animatedTiles[i];
+                int frameId = animatedTile.TilesetTile.GetAnimationFrameId(this.animationTime);
+
+                if (frameId != animatedTile.FrameId)
+                {
+                    this.FillTileTexCoords(
+                        animatedTile.TilesetTile.Tileset,
+                        frameId,
+                        animatedTile.HorizontalFlip,
+                        animatedTile.VerticalFlip,
+                        animatedTile.DiagonalFlip,
+                        chunk.Vertices,
+                        animatedTile.Slot * VerticesPerTile);
+
+                    animatedTile.FrameId = frameId;
+                    animatedTiles[i] = animatedTile;
+                    firstSlot = Math.Min(firstSlot, animatedTile.Slot);
+                    lastSlot = Math.Max(lastSlot, animatedTile.Slot);
+                }
+            }
+
+            if (lastSlot >= 0)
+            {
+                this.UploadChunkSlots(chunk, firstSlot, lastSlot);
+            }
+        }
+
+        /// <summary>
+        /// Uploads to the GPU only the vertices of a range of vertex slots of a chunk
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        /// <param name="firstSlot">The first slot of the range.</param>
+        /// <param name="lastSlot">The last slot of the range.</param>
+        private void UploadChunkSlots(Chunk chunk, int firstSlot, int lastSlot)
+        {
+            // The chunk vertices mirror the vertex buffer, so the range has the same offset in both
+            int startVertex = firstSlot * VerticesPerTile;
+            int vertexCount = (lastSlot - firstSlot + 1) * VerticesPerTile;
+
+            chunk.VertexBuffer.SetData(chunk.Vertices, vertexCount, startVertex);
+            this.GraphicsDevice.BindVertexBuffer(chunk.VertexBuffer);
+        }
+
+        /// <summary>
+        /// Uploads the chunks built in background, and evicts the least recently visible ones.
+        /// It runs once per frame, after all the cameras have requested their visible chunks.
+        /// </summary>
+        private void UpdateStreaming()
+        {
+            // Upload the chunks built in background
+            Chunk builtChunk;
+            int uploads = 0;
+            while (uploads < MaxUploadsPerFrame && this.builtChunks.TryDequeue(out builtChunk))
+            {
+                if (builtChunk.Generation != this.buildGeneration)
+                {
+                    // Built for chunks that have been removed, and already discounted from the pending builds
+                    continue;
+                }
+
+                this.pendingBuilds--;
+                this.UploadChunkGeometry(builtChunk);
+                builtChunk.State = ChunkState.Resident;
+                builtChunk.ResidentNode = this.residentChunks.AddFirst(builtChunk);
+                uploads++;
+
+                if (builtChunk.RebuildWhenLoaded)
+                {
+                    builtChunk.RebuildWhenLoaded = false;
+                    this.RefreshChunk(builtChunk);
+                }
+            }
+
+            // Evict the least recently visible chunks that no camera requested in the last frame
+            while (this.residentChunks.Count > this.maxResidentChunks)
+            {
+                var chunk = this.residentChunks.Last.Value;
+                if (chunk.VisibleFrame == this.streamingFrame)
+                {
+                    break;
+                }
+
+                this.UnloadChunk(chunk);
+            }
+        }
+
+        /// <summary>
+        /// Marks the chunks near the current camera as visible in this frame, and loads them if needed.
+        /// </summary>
+        /// <param name="worldTransform">The layer world transform.</param>
+        private void RequestVisibleChunks(ref Matrix worldTransform)
+        {
+            var distance = new Vector3(this.streamingDistance, this.streamingDistance, 0);
+            for (int i = 0; i < this.chunkDrawOrder.Length; i++)
+            {
+                var chunk = this.chunks[this.chunkDrawOrder[i]];
+
+                var bounds = chunk.StreamingBounds;
+                bounds.Min -= distance;
+                bounds.Max += distance;
+
+                if (!this.CullingTest(ref bounds, ref worldTransform))
+                {
+                    continue;
+                }
+
+                chunk.VisibleFrame = this.streamingFrame;
+
+                if (chunk.State == ChunkState.Resident)
+                {
+                    this.residentChunks.Remove(chunk.ResidentNode);
+                    this.residentChunks.AddFirst(chunk.ResidentNode);
+                }
+                else if (chunk.State == ChunkState.Unloaded && this.pendingBuilds < this.maxPendingBuilds)
+                {
+                    this.LoadChunkAsync(chunk);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Builds the geometry of a chunk in a background thread
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        private void LoadChunkAsync(Chunk chunk)
+        {
+            int vertexCount = this.chunkWidth * this.chunkHeight * VerticesPerTile;
+            chunk.Vertices = this.vertexPool.Count > 0 ? this.vertexPool.Pop() : new VertexPositionColorTexture[vertexCount];
+            chunk.State = ChunkState.Building;
+            this.pendingBuilds++;
+
+            Task.Run(() =>
+            {
+                try
+                {
+                    if (chunk.Generation == this.buildGeneration)
+                    {
+                        this.BuildChunkGeometry(chunk);
                     }
                 }
+                finally
+                {
+                    this.builtChunks.Enqueue(chunk);
+                }
+            });
+        }
+
+        /// <summary>
+        /// Releases the geometry and the GPU buffer of a resident chunk
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        private void UnloadChunk(Chunk chunk)
+        {
+            this.residentChunks.Remove(chunk.ResidentNode);
+            chunk.ResidentNode = null;
+
+            if (chunk.VertexBuffer != null)
+            {
+                this.RenderManager.GraphicsDevice.DestroyVertexBuffer(chunk.VertexBuffer);
+                chunk.VertexBuffer = null;
             }
 
-            if (currentTileset != null)
+            this.vertexPool.Push(chunk.Vertices);
+            chunk.Vertices = null;
+            chunk.TileSlots = null;
+            chunk.SlotTilesets = null;
+            chunk.Meshes.Clear();
+            chunk.MeshRanges.Clear();
+            chunk.AnimatedTiles.Clear();
+            chunk.State = ChunkState.Unloaded;
+        }
+
+        /// <summary>
+        /// Calculates bounds that contain all the tiles a chunk may draw, before its geometry is built
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        /// <param name="maxTileSize">The size of the largest tile of the layer.</param>
+        private void CalcStreamingBounds(Chunk chunk, ref Vector2 maxTileSize)
+        {
+            var min = new Vector3(float.MaxValue);
+            var max = new Vector3(float.MinValue);
+
+            for (int i = 0; i < 4; i++)
             {
-                this.vertexBuffer[bufferIndex].SetData(this.vertices[bufferIndex]);
-                this.GraphicsDevice.BindVertexBuffer(this.vertexBuffer[bufferIndex]);
+                Vector2 position;
+                this.tiledMap.GetTilePosition(chunk.X + ((i & 1) * chunk.Width), chunk.Y + ((i >> 1) * chunk.Height), null, out position);
 
-                this.NewMesh(startIndex, currentIndexCount, bufferIndex, currentTileset.Image, ref boundingBox);
+                var corner = new Vector3(position.X, position.Y, 0);
+                Vector3.Min(ref min, ref corner, out min);
+                Vector3.Max(ref max, ref corner, out max);
             }
 
-            this.transform2D.Rectangle = this.tiledMap.CalcRectangle();
+            // Tiles can be drawn beyond their cell, so the bounds are expanded by the largest tile size
+            var margin = new Vector3(maxTileSize.X, maxTileSize.Y, 0);
+            chunk.StreamingBounds = new BoundingBox(min - margin, max + margin);
         }
 
         /// <summary>
@@ -553,9 +1335,11 @@ namespace WaveEngine.TiledMap
         /// </summary>
         /// <param name="i">The tile x coordinate</param>
         /// <param name="j">The tile y coordinate</param>
+        /// <param name="width">The width of the region</param>
+        /// <param name="height">The height of the region</param>
         /// <param name="x">The tile x render order</param>
         /// <param name="y">The tile y render order</param>
-        private void GetCellRenderOrderByIndex(int i, int j, out int x, out int y)
+        private void GetCellRenderOrderByIndex(int i, int j, int width, int height, out int x, out int y)
         {
             switch (this.tiledMap.RenderOrder)
             {
@@ -566,15 +1350,15 @@ namespace WaveEngine.TiledMap
                     break;
                 case TiledMapRenderOrderType.Right_Up:
                     x = i;
-                    y = this.tiledMap.Height - j - 1;
+                    y = height - j - 1;
                     break;
                 case TiledMapRenderOrderType.Left_Down:
-                    x = this.tiledMap.Width - i - 1;
+                    x = width - i - 1;
                     y = j;
                     break;
                 case TiledMapRenderOrderType.Left_Up:
-                    x = this.tiledMap.Width - i - 1;
-                    y = this.tiledMap.Height - j - 1;
+                    x = width - i - 1;
+                    y = height - j - 1;
                     break;
             }
         }
@@ -584,15 +1368,61 @@ namespace WaveEngine.TiledMap
         /// </summary>
         /// <param name="tileset">The tileset.</param>
         /// <param name="tile">The tile information.</param>
-        /// <param name="bufferIndex">The buffer index</param>
+        /// <param name="vertices">The vertices to fill</param>
         /// <param name="tileIndex">Current tileId</param>
         /// <param name="boundingBox">Mesh bounding box</param>
-        private void FillTile(Tileset tileset, LayerTile tile, int bufferIndex, int tileIndex, ref BoundingBox boundingBox)
+        private void FillTile(Tileset tileset, LayerTile tile, VertexPositionColorTexture[] vertices, int tileIndex, ref BoundingBox boundingBox)
+        {
+            int vertexId = tileIndex * VerticesPerTile;
+
+            Vector2 position = tile.LocalPosition;
+
+            var position0 = new Vector3(position.X, position.Y, 0);
+            var position1 = new Vector3(position.X + tileset.TileWidth, position.Y, 0);
+            var position2 = new Vector3(position.X + tileset.TileWidth, position.Y + tileset.TileHeight, 0);
+            var position3 = new Vector3(position.X, position.Y + tileset.TileHeight, 0);
+
+            Vector3.Min(ref position0, ref boundingBox.Min, out boundingBox.Min);
+            Vector3.Max(ref position2, ref boundingBox.Max, out boundingBox.Max);
+
+            // Vertex 0
+            vertices[vertexId].Position = position0;
+            vertices[vertexId].Color = Color.White;
+            vertexId++;
+
+            // Vertex 1
+            vertices[vertexId].Position = position1;
+            vertices[vertexId].Color = Color.White;
+            vertexId++;
+
+            // Vertex 2
+            vertices[vertexId].Position = position2;
+            vertices[vertexId].Color = Color.White;
+            vertexId++;
+
+            // Vertex 3
+            vertices[vertexId].Position = position3;
+            vertices[vertexId].Color = Color.White;
+
+            this.FillTileTexCoords(tileset, tile.Id, tile.HorizontalFlip, tile.VerticalFlip, tile.DiagonalFlip, vertices, tileIndex * VerticesPerTile);
+        }
+
+        /// <summary>
+        /// Fill the texture coordinates of a tile
+        /// </summary>
+        /// <param name="tileset">The tileset.</param>
+        /// <param name="tileId">The ID of the tile in the tileset.</param>
+        /// <param name="horizontalFlip">Whether the tile has horizontal flip.</param>
+        /// <param name="verticalFlip">Whether the tile has vertical flip.</param>
+        /// <param name="diagonalFlip">Whether the tile has diagonal flip.</param>
+        /// <param name="vertices">The vertices to fill</param>
+        /// <param name="vertexId">The first vertex of the tile</param>
+        private void FillTileTexCoords(Tileset tileset, int tileId, bool horizontalFlip, bool verticalFlip, bool diagonalFlip, VertexPositionColorTexture[] vertices, int vertexId)
         {
             int textureWidth = tileset.Image.Width;
             int textureHeight = tileset.Image.Height;
 
-            var rect = TiledMapUtils.GetRectangleTileByID(tileset, tile.Id);
+            var rect = TiledMapUtils.GetRectangleTileByID(tileset, tileId);
 
             RectangleF tileRectangle = new RectangleF(
                 rect.X / (float)textureWidth,
@@ -600,27 +1430,13 @@ namespace WaveEngine.TiledMap
                 rect.Width / (float)textureWidth,
                 rect.Height / (float)textureHeight);
 
-            int vertexId = tileIndex * VerticesPerTile;
-
-            Vector2 position;
-            this.tiledMap.GetTilePosition(tile.X, tile.Y, tileset, out position);
-            tile.LocalPosition = position;
-
-            var position0 = new Vector3(position.X, position.Y, 0);
-            var position1 = new Vector3(position.X + tileset.TileWidth, position.Y, 0);
-            var position2 = new Vector3(position.X + tileset.TileWidth, position.Y + tileset.TileHeight, 0);
-            var position3 = new Vector3(position.X, position.Y + tileset.TileHeight, 0);
-
             var textCoord0 = new Vector2(tileRectangle.X, tileRectangle.Y);
             var textCoord1 = new Vector2(tileRectangle.X + tileRectangle.Width, tileRectangle.Y);
             var textCoord2 = new Vector2(tileRectangle.X + tileRectangle.Width, tileRectangle.Y + tileRectangle.Height);
             var textCoord3 = new Vector2(tileRectangle.X, tileRectangle.Y + tileRectangle.Height);
 
-            Vector3.Min(ref position0, ref boundingBox.Min, out boundingBox.Min);
-            Vector3.Max(ref position2, ref boundingBox.Max, out boundingBox.Max);
-
             #region Flip calculation
-            if (tile.HorizontalFlip)
+            if (horizontalFlip)
             {
                 var texCoordAux = textCoord0;
                 textCoord0 = textCoord1;
@@ -631,7 +1447,7 @@ namespace WaveEngine.TiledMap
                 textCoord3 = texCoordAux;
             }
 
-            if (tile.VerticalFlip)
+            if (verticalFlip)
             {
                 var texCoordAux = textCoord0;
                 textCoord0 = textCoord3;
@@ -642,7 +1458,7 @@ namespace WaveEngine.TiledMap
                 textCoord1 = texCoordAux;
             }
 
-            if (tile.DiagonalFlip)
+            if (diagonalFlip)
             {
                 var texCoordAux = textCoord0;
                 textCoord0 = textCoord2;
@@ -650,64 +1466,59 @@ namespace WaveEngine.TiledMap
             }
             #endregion
 
-            // Vertex 0
-            this.vertices[bufferIndex][vertexId].Position = position0;
-            this.vertices[bufferIndex][vertexId].Color = Color.White;
-            this.vertices[bufferIndex][vertexId].TexCoord = textCoord0;
-            vertexId++;
-
-            // Vertex 1
-            this.vertices[bufferIndex][vertexId].Position = position1;
-            this.vertices[bufferIndex][vertexId].Color = Color.White;
-            this.vertices[bufferIndex][vertexId].TexCoord = textCoord1;
-            vertexId++;
-
-            // Vertex 2
-            this.vertices[bufferIndex][vertexId].Position = position2;
-            this.vertices[bufferIndex][vertexId].Color = Color.White;
-            this.vertices[bufferIndex][vertexId].TexCoord = textCoord2;
-            vertexId++;
-
-            // Vertex 3
-            this.vertices[bufferIndex][vertexId].Position = position3;
-            this.vertices[bufferIndex][vertexId].Color = Color.White;
-            this.vertices[bufferIndex][vertexId].TexCoord = textCoord3;
-            vertexId++;
+            vertices[vertexId].TexCoord = textCoord0;
+            vertices[vertexId + 1].TexCoord = textCoord1;
+            vertices[vertexId + 2].TexCoord = textCoord2;
+            vertices[vertexId + 3].TexCoord = textCoord3;
         }
 
         /// <summary>
-        /// Creates a new layer mesh
+        /// Adds a new run of tiles that share a tileset to a chunk
         /// </summary>
-        /// <param name="startIndex">Start index.</param>
-        /// <param name="count">Count indices</param>
-        /// <param name="bufferIndex">The buffer index</param>
-        /// <param name="image">Mesh material</param>
-        /// <param name="boundingBox">Mesh bounding box</param>
-        private void NewMesh(int startIndex, int count, int bufferIndex, Texture2D image, ref BoundingBox boundingBox)
-        {
-            var mesh = new Mesh(
-                0,
-                this.vertices.Length,
-                startIndex * IndicesPerTile,
-                count * 2,
-                this.vertexBuffer[bufferIndex],
-                this.indexBuffer[bufferIndex],
-                PrimitiveType.TriangleList)
-            {
-                DisableBatch = true,
-                MaterialIndex = this.materials.Count,
+        /// <param name="chunk">The chunk.</param>
+        /// <param name="startIndex">The first tile of the run.</param>
+        /// <param name="count">The number of tiles of the run</param>
+        /// <param name="row">The row, in render order, of the first tile of the run</param>
+        /// <param name="tileset">The tileset of the run tiles</param>
+        /// <param name="boundingBox">The run bounding box</param>
+        private void NewMeshRange(Chunk chunk, int startIndex, int count, int row, Tileset tileset, ref BoundingBox boundingBox)
+        {
+            chunk.MeshRanges.Add(new MeshRange()
+            {
+                StartIndex = startIndex,
+                Count = count,
+                Row = row,
+                Tileset = tileset,
                 BoundingBox = boundingBox,
-            };
+            });
 
-            var material = new StandardMaterial(this.LayerId, image)
+            Vector3.Min(ref boundingBox.Min, ref chunk.BoundingBox.Min, out chunk.BoundingBox.Min);
+            Vector3.Max(ref boundingBox.Max, ref chunk.BoundingBox.Max, out chunk.BoundingBox.Max);
+        }
+
+        /// <summary>
+        /// Gets the index of the material used to draw the tiles of a tileset, creating it if needed.
+        /// </summary>
+        /// <param name="tileset">The tileset.</param>
+        /// <returns>The material index</returns>
+        private int GetMaterialIndex(Tileset tileset)
+        {
+            int index;
+            if (!this.materialIndices.TryGetValue(tileset, out index))
             {
-                LightingEnabled = false
-            };
+                var material = new StandardMaterial(this.LayerId, tileset.Image)
+                {
+                    LightingEnabled = false
+                };
 
-            material.Initialize(this.Assets);
+                material.Initialize(this.Assets);
 
-            this.materials.Add(material);
-            this.meshes.Add(mesh);
+                index = this.materials.Count;
+                this.materials.Add(material);
+                this.materialIndices.Add(tileset, index);
+            }
+
+            return index;
         }
 
         /// <summary>
@@ -715,22 +1526,42 @@ namespace WaveEngine.TiledMap
         /// </summary>
         private void RemoveBuffers()
         {
-            this.vertices = null;
-            if (this.vertexBuffer != null)
+            if (this.chunks != null)
             {
-                for (int i = 0; i < this.vertexBuffer.Length; i++)
+                for (int i = 0; i < this.chunks.Length; i++)
                 {
-                    this.RenderManager.GraphicsDevice.DestroyVertexBuffer(this.vertexBuffer[i]);
+                    var vertexBuffer = this.chunks[i].VertexBuffer;
+                    if (vertexBuffer != null)
+                    {
+                        this.RenderManager.GraphicsDevice.DestroyVertexBuffer(vertexBuffer);
+                    }
                 }
+
+                this.chunks = null;
+                this.chunkDrawOrder = null;
+                this.visibleChunks = null;
+            }
+
+            // Chunks still being built in background are ignored when their build finishes
+            this.buildGeneration++;
+            this.pendingBuilds = 0;
+
+            Chunk builtChunk;
+            while (this.builtChunks.TryDequeue(out builtChunk))
+            {
             }
 
+            this.residentChunks.Clear();
+            this.vertexPool.Clear();
+
             if (this.indexBuffer != null)
             {
-                for (int i = 0; i < this.indexBuffer.Length; i++)
-                {
-                    this.RenderManager.GraphicsDevice.DestroyIndexBuffer(this.indexBuffer[i]);
-                }
+                this.RenderManager.GraphicsDevice.DestroyIndexBuffer(this.indexBuffer);
+                this.indexBuffer = null;
             }
+
+            this.materials.Clear();
+            this.materialIndices.Clear();
         }
 
         /// <summary>
@@ -745,5 +1576,214 @@ namespace WaveEngine.TiledMap
             this.RemoveBuffers();
         }
         #endregion
+
+        /// <summary>
+        /// A rectangular region of the layer with its own vertex buffer and bounding box
+        /// </summary>
+        private class Chunk
+        {
+            /// <summary>
+            /// The X coordinate of the first tile of the chunk
+            /// </summary>
+            public int X;
+
+            /// <summary>
+            /// The Y coordinate of the first tile of the chunk
+            /// </summary>
+            public int Y;
+
+            /// <summary>
+            /// The width of the chunk in tiles
+            /// </summary>
+            public int Width;
+
+            /// <summary>
+            /// The height of the chunk in tiles
+            /// </summary>
+            public int Height;
+
+            /// <summary>
+            /// The chunk vertices
+            /// </summary>
+            public VertexPositionColorTexture[] Vertices;
+
+            /// <summary>
+            /// The chunk vertex buffer
+            /// </summary>
+            public DynamicVertexBuffer VertexBuffer;
+
+            /// <summary>
+            /// The chunk meshes, one for each run of tiles that share a tileset
+            /// </summary>
+            public List<Mesh> Meshes;
+
+            /// <summary>
+            /// The bounding box of all the chunk meshes
+            /// </summary>
+            public BoundingBox BoundingBox;
+
+            /// <summary>
+            /// The vertex slot of each tile of the chunk, or -1 if the tile is not drawn
+            /// </summary>
+            public int[] TileSlots;
+
+            /// <summary>
+            /// The tileset of each vertex slot
+            /// </summary>
+            public Tileset[] SlotTilesets;
+
+            /// <summary>
+            /// Whether the chunk meshes must be rebuilt in the current dirty pass
+            /// </summary>
+            public bool NeedsRebuild;
+
+            /// <summary>
+            /// Whether the chunk vertices must be uploaded in the current dirty pass
+            /// </summary>
+            public bool NeedsUpload;
+
+            /// <summary>
+            /// The first vertex slot patched in the current dirty pass
+            /// </summary>
+            public int FirstDirtySlot;
+
+            /// <summary>
+            /// The last vertex slot patched in the current dirty pass
+            /// </summary>
+            public int LastDirtySlot;
+
+            /// <summary>
+            /// The runs of tiles that share a tileset, built before the meshes are created
+            /// </summary>
+            public List<MeshRange> MeshRanges;
+
+            /// <summary>
+            /// The streaming state of the chunk
+            /// </summary>
+            public ChunkState State;
+
+            /// <summary>
+            /// Bounds that contain the chunk tiles before its geometry is built
+            /// </summary>
+            public BoundingBox StreamingBounds;
+
+            /// <summary>
+            /// The node of the chunk in the resident list
+            /// </summary>
+            public LinkedListNode<Chunk> ResidentNode;
+
+            /// <summary>
+            /// The last streaming frame in which the chunk was near the camera
+            /// </summary>
+            public int VisibleFrame;
+
+            /// <summary>
+            /// Whether the chunk tiles changed while its geometry was being built
+            /// </summary>
+            public bool RebuildWhenLoaded;
+
+            /// <summary>
+            /// The build generation of the layer when the chunk was created
+            /// </summary>
+            public int Generation;
+
+            /// <summary>
+            /// The animated tiles of the chunk
+            /// </summary>
+            public List<AnimatedTile> AnimatedTiles;
+
+            /// <summary>
+            /// The number of meshes already drawn while the chunk is interleaved with the other chunks of its row
+            /// </summary>
+            public int DrawnMeshes;
+        }
+
+        /// <summary>
+        /// An animated tile of a chunk
+        /// </summary>
+        private struct AnimatedTile
+        {
+            /// <summary>
+            /// The vertex slot of the tile
+            /// </summary>
+            public int Slot;
+
+            /// <summary>
+            /// The animated tileset tile
+            /// </summary>
+            public TilesetTile TilesetTile;
+
+            /// <summary>
+            /// The ID of the tile shown by the current vertices
+            /// </summary>
+            public int FrameId;
+
+            /// <summary>
+            /// Whether the tile has horizontal flip
+            /// </summary>
+            public bool HorizontalFlip;
+
+            /// <summary>
+            /// Whether the tile has vertical flip
+            /// </summary>
+            public bool VerticalFlip;
+
+            /// <summary>
+            /// Whether the tile has diagonal flip
+            /// </summary>
+            public bool DiagonalFlip;
+        }
+
+        /// <summary>
+        /// A run of tiles of a chunk that share a tileset, drawn with a single mesh
+        /// </summary>
+        private struct MeshRange
+        {
+            /// <summary>
+            /// The first tile of the run
+            /// </summary>
+            public int StartIndex;
+
+            /// <summary>
+            /// The number of tiles of the run
+            /// </summary>
+            public int Count;
+
+            /// <summary>
+            /// The row of the chunk, in render order, of the first tile of the run
+            /// </summary>
+            public int Row;
+
+            /// <summary>
+            /// The tileset of the run tiles
+            /// </summary>
+            public Tileset Tileset;
+
+            /// <summary>
+            /// The bounding box of the run tiles
+            /// </summary>
+            public BoundingBox BoundingBox;
+        }
+
+        /// <summary>
+        /// The streaming state of a chunk
+        /// </summary>
+        private enum ChunkState
+        {
+            /// <summary>
+            /// The chunk geometry is in memory. Chunks of layers that are not streamed are always resident.
+            /// </summary>
+            Resident,
+
+            /// <summary>
+            /// The chunk geometry is not in memory
+            /// </summary>
+            Unloaded,
+
+            /// <summary>
+            /// The chunk geometry is being built in a background thread
+            /// </summary>
+            Building,
+        }
     }
 }
@@ -3,10 +3,12 @@
 #region Using Statements
 using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
 using TiledSharp;
+using WaveEngine.Common.Math;
 #endregion
 
 namespace WaveEngine.TiledMap
@@ -61,7 +63,7 @@ namespace WaveEngine.TiledMap
         /// <summary>
         /// Gets the asociated tile
         /// </summary>
-        public LayerTile Tile { get; private set; }
+        public LayerTile? Tile { get; private set; }
 
         /// <summary>
         /// Gets a value indicating whether this object is visible
@@ -77,6 +79,11 @@ namespace WaveEngine.TiledMap
         /// Gets the object property list
         /// </summary>
         public IReadOnlyDictionary<string, string> Properties { get; private set; }
+
+        /// <summary>
+        /// Gets the axis aligned rectangle that contains the object, including its rotation and points
+        /// </summary>
+        public RectangleF BoundingRectangle { get; private set; }
         #endregion
 
         #region Initialization
@@ -102,6 +109,95 @@ namespace WaveEngine.TiledMap
             {
                 this.Points = new List<TmxObjectPoint>(tmxObject.Points);
             }
+
+            this.BoundingRectangle = this.CalculateBoundingRectangle();
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapObject" /> class.
+        /// </summary>
+        /// <param name="reader">The cooked map reader</param>
+        internal TiledMapObject(BinaryReader reader)
+        {
+            this.Name = reader.ReadString();
+            this.ObjectType = (TiledMapObjectType)reader.ReadInt32();
+            this.Type = reader.ReadString();
+            this.X = reader.ReadSingle();
+            this.Y = reader.ReadSingle();
+            this.Width = reader.ReadSingle();
+            this.Height = reader.ReadSingle();
+            this.Rotation = reader.ReadDouble();
+            this.Visible = reader.ReadBoolean();
+
+            this.Properties = TiledMapCooker.ReadProperties(reader);
+
+            int pointCount = reader.ReadInt32();
+            if (pointCount >= 0)
+            {
+                this.Points = new List<TmxObjectPoint>(pointCount);
+                for (int i = 0; i < pointCount; i++)
+                {
+                    double x = reader.ReadDouble();
+                    double y = reader.ReadDouble();
+                    this.Points.Add(new TmxObjectPoint(x, y));
+                }
+            }
+
+            this.BoundingRectangle = this.CalculateBoundingRectangle();
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Calculates the axis aligned rectangle that contains the object
+        /// </summary>
+        /// <returns>The bounding rectangle</returns>
+        private RectangleF CalculateBoundingRectangle()
+        {
+            Vector2 min, max;
+
+            if (this.Points != null && this.Points.Count > 0)
+            {
+                min = new Vector2(float.MaxValue);
+                max = new Vector2(float.MinValue);
+
+                for (int i = 0; i < this.Points.Count; i++)
+                {
+                    var point = new Vector2((float)this.Points[i].X, (float)this.Points[i].Y);
+                    Vector2.Min(ref min, ref point, out min);
+                    Vector2.Max(ref max, ref point, out max);
+                }
+            }
+            else if (this.ObjectType == TiledMapObjectType.Tile)
+            {
+                // Tile objects are aligned to their bottom left corner
+                min = new Vector2(0, -this.Height);
+                max = new Vector2(this.Width, 0);
+            }
+            else
+            {
+                min = Vector2.Zero;
+                max = new Vector2(this.Width, this.Height);
+            }
+
+            if (this.Rotation != 0)
+            {
+                // The object is rotated around its position
+                double rotation = this.Rotation * Math.PI / 180.0;
+                float cos = (float)Math.Cos(rotation);
+                float sin = (float)Math.Sin(rotation);
+
+                var corner0 = new Vector2((min.X * cos) - (min.Y * sin), (min.X * sin) + (min.Y * cos));
+                var corner1 = new Vector2((max.X * cos) - (min.Y * sin), (max.X * sin) + (min.Y * cos));
+                var corner2 = new Vector2((max.X * cos) - (max.Y * sin), (max.X * sin) + (max.Y * cos));
+                var corner3 = new Vector2((min.X * cos) - (max.Y * sin), (min.X * sin) + (max.Y * cos));
+
+                min = Vector2.Min(Vector2.Min(corner0, corner1), Vector2.Min(corner2, corner3));
+                max = Vector2.Max(Vector2.Max(corner0, corner1), Vector2.Max(corner2, corner3));
+            }
+
+            return new RectangleF(this.X + min.X, this.Y + min.Y, max.X - min.X, max.Y - min.Y);
         }
         #endregion
     }
@@ -0,0 +1,362 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using WaveEngine.Common.Math;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// Static uniform grid over the bounding rectangles of a list of objects.
+    /// Each cell stores a range in a single packed array of object indices, so queries do not allocate.
+    /// </summary>
+    /// <remarks>
+    /// The cell size follows the median object size. Objects that would cover too many cells are kept
+    /// in a separate list that every query tests, so a few big objects don't make the grid coarser.
+    /// </remarks>
+    internal class TiledMapObjectIndex
+    {
+        /// <summary>
+        /// Maximum number of cells an object is stored in. Bigger objects are kept in the large object list.
+        /// </summary>
+        private const int MaxCellsPerObject = 4;
+
+        /// <summary>
+        /// The indexed objects
+        /// </summary>
+        private readonly TiledMapObject[] objects;
+
+        /// <summary>
+        /// The bounding rectangle of each object
+        /// </summary>
+        private readonly RectangleF[] bounds;
+
+        /// <summary>
+        /// The start of each cell in the item array. The last entry is the item count.
+        /// </summary>
+        private readonly int[] cellStarts;
+
+        /// <summary>
+        /// The object indices of all cells, stored consecutively
+        /// </summary>
+        private readonly int[] cellItems;
+
+        /// <summary>
+        /// The indices of the objects too big to be stored in the grid
+        /// </summary>
+        private readonly int[] largeItems;
+
+        /// <summary>
+        /// The origin of the grid
+        /// </summary>
+        private readonly Vector2 origin;
+
+        /// <summary>
+        /// The inverse of the cell size
+        /// </summary>
+        private readonly float inverseCellSize;
+
+        /// <summary>
+        /// The number of columns of the grid
+        /// </summary>
+        private readonly int columns;
+
+        /// <summary>
+        /// The number of rows of the grid
+        /// </summary>
+        private readonly int rows;
+
+        #region Initialization
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapObjectIndex" /> class.
+        /// </summary>
+        /// <param name="objects">The objects to index.</param>
+        public TiledMapObjectIndex(IList<TiledMapObject> objects)
+        {
+            int count = objects.Count;
+            this.objects = new TiledMapObject[count];
+            this.bounds = new RectangleF[count];
+
+            var min = new Vector2(float.MaxValue);
+            var max = new Vector2(float.MinValue);
+            var extents = new float[count];
+
+            for (int i = 0; i < count; i++)
+            {
+                var rectangle = objects[i].BoundingRectangle;
+                this.objects[i] = objects[i];
+                this.bounds[i] = rectangle;
+
+                min.X = Math.Min(min.X, rectangle.X);
+                min.Y = Math.Min(min.Y, rectangle.Y);
+                max.X = Math.Max(max.X, rectangle.X + rectangle.Width);
+                max.Y = Math.Max(max.Y, rectangle.Y + rectangle.Height);
+                extents[i] = Math.Max(rectangle.Width, rectangle.Height);
+            }
+
+            if (count == 0)
+            {
+                min = max = Vector2.Zero;
+            }
+
+            // Cells close to the median object size, with about one cell per object for sparse layers
+            Array.Sort(extents);
+            float medianExtent = count > 0 ? extents[count / 2] : 0;
+            float width = max.X - min.X;
+            float height = max.Y - min.Y;
+            float cellSize = Math.Max(medianExtent, (float)Math.Sqrt((width * height) / Math.Max(count, 1)));
+            if (cellSize <= 0 || float.IsNaN(cellSize) || float.IsInfinity(cellSize))
+            {
+                cellSize = Math.Max(Math.Max(width, height), 1);
+            }
+
+            this.origin = min;
+            this.inverseCellSize = 1 / cellSize;
+            this.columns = Math.Max((int)Math.Ceiling(width * this.inverseCellSize), 1);
+            this.rows = Math.Max((int)Math.Ceiling(height * this.inverseCellSize), 1);
+
+            // Counts the objects of each cell, and then fills the packed item array
+            this.cellStarts = new int[(this.columns * this.rows) + 1];
+            var largeItems = new List<int>();
+            for (int i = 0; i < count; i++)
+            {
+                int minX, minY, maxX, maxY;
+                this.GetCellRange(ref this.bounds[i], out minX, out minY, out maxX, out maxY);
+
+                if ((long)(maxX - minX + 1) * (maxY - minY + 1) > MaxCellsPerObject)
+                {
+                    largeItems.Add(i);
+                    continue;
+                }
+
+                for (int y = minY; y <= maxY; y++)
+                {
+                    for (int x = minX; x <= maxX; x++)
+                    {
+                        this.cellStarts[x + (y * this.columns) + 1]++;
+                    }
+                }
+            }
+
+            for (int i = 1; i < this.cellStarts.Length; i++)
+            {
+                this.cellStarts[i] += this.cellStarts[i - 1];
+            }
+
+            this.largeItems = largeItems.ToArray();
+            this.cellItems = new int[this.cellStarts[this.cellStarts.Length - 1]];
+            var cellFill = new int[this.columns * this.rows];
+            int nextLargeItem = 0;
+            for (int i = 0; i < count; i++)
+            {
+                if (nextLargeItem < this.largeItems.Length && this.largeItems[nextLargeItem] == i)
+                {
+                    nextLargeItem++;
+                    continue;
+                }
+
+                int minX, minY, maxX, maxY;
+                this.GetCellRange(ref this.bounds[i], out minX, out minY, out maxX, out maxY);
+
+                for (int y = minY; y <= maxY; y++)
+                {
+                    for (int x = minX; x <= maxX; x++)
+                    {
+                        int cell = x + (y * this.columns);
+                        this.cellItems[this.cellStarts[cell] + cellFill[cell]++] = i;
+                    }
+                }
+            }
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Adds to a list the objects whose bounding rectangle intersects a rectangle
+        /// </summary>
+        /// <param name="rectangle">The rectangle.</param>
+        /// <param name="results">The list where the objects are added.</param>
+        /// <returns>The number of objects added</returns>
+        public int QueryRectangle(RectangleF rectangle, List<TiledMapObject> results)
+        {
+            return this.Query(rectangle, Vector2.Zero, -1, results);
+        }
+
+        /// <summary>
+        /// Adds to a list the objects whose bounding rectangle contains a point
+        /// </summary>
+        /// <param name="point">The point.</param>
+        /// <param name="results">The list where the objects are added.</param>
+        /// <returns>The number of objects added</returns>
+        public int QueryPoint(Vector2 point, List<TiledMapObject> results)
+        {
+            return this.Query(new RectangleF(point.X, point.Y, 0, 0), Vector2.Zero, -1, results);
+        }
+
+        /// <summary>
+        /// Adds to a list the objects whose bounding rectangle intersects a circle
+        /// </summary>
+        /// <param name="center">The center of the circle.</param>
+        /// <param name="radius">The radius of the circle.</param>
+        /// <param name="results">The list where the objects are added.</param>
+        /// <returns>The number of objects added</returns>
+        public int QueryRadius(Vector2 center, float radius, List<TiledMapObject> results)
+        {
+            var rectangle = new RectangleF(center.X - radius, center.Y - radius, radius * 2, radius * 2);
+            return this.Query(rectangle, center, radius * radius, results);
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Adds to a list the objects whose bounding rectangle intersects a rectangle, and optionally a circle
+        /// </summary>
+        /// <param name="rectangle">The rectangle.</param>
+        /// <param name="center">The center of the circle.</param>
+        /// <param name="squaredRadius">The squared radius of the circle, or a negative value to skip the circle test.</param>
+        /// <param name="results">The list where the objects are added.</param>
+        /// <returns>The number of objects added</returns>
+        private int Query(RectangleF rectangle, Vector2 center, float squaredRadius, List<TiledMapObject> results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+
+            if (this.objects.Length == 0 || rectangle.Width < 0 || rectangle.Height < 0)
+            {
+                return 0;
+            }
+
+            int minX, minY, maxX, maxY;
+            this.GetCellRange(ref rectangle, out minX, out minY, out maxX, out maxY);
+
+            int added = 0;
+            for (int y = minY; y <= maxY; y++)
+            {
+                for (int x = minX; x <= maxX; x++)
+                {
+                    int cell = x + (y * this.columns);
+                    int end = this.cellStarts[cell + 1];
+
+                    for (int i = this.cellStarts[cell]; i < end; i++)
+                    {
+                        int index = this.cellItems[i];
+                        var objectBounds = this.bounds[index];
+
+                        if (!Intersects(ref objectBounds, ref rectangle, ref center, squaredRadius))
+                        {
+                            continue;
+                        }
+
+                        // An object stored in several cells is only reported from the cell
+                        // that contains the top left corner of its intersection with the query
+                        if (this.GetCellX(Math.Max(objectBounds.X, rectangle.X)) != x
+                         || this.GetCellY(Math.Max(objectBounds.Y, rectangle.Y)) != y)
+                        {
+                            continue;
+                        }
+
+                        results.Add(this.objects[index]);
+                        added++;
+                    }
+                }
+            }
+
+            for (int i = 0; i < this.largeItems.Length; i++)
+            {
+                int index = this.largeItems[i];
+
+                if (Intersects(ref this.bounds[index], ref rectangle, ref center, squaredRadius))
+                {
+                    results.Add(this.objects[index]);
+                    added++;
+                }
+            }
+
+            return added;
+        }
+
+        /// <summary>
+        /// Checks whether the bounding rectangle of an object intersects a rectangle, and optionally a circle
+        /// </summary>
+        /// <param name="objectBounds">The bounding rectangle of the object.</param>
+        /// <param name="rectangle">The rectangle.</param>
+        /// <param name="center">The center of the circle.</param>
+        /// <param name="squaredRadius">The squared radius of the circle, or a negative value to skip the circle test.</param>
+        /// <returns>True if the object intersects the query, false in other case</returns>
+        private static bool Intersects(ref RectangleF objectBounds, ref RectangleF rectangle, ref Vector2 center, float squaredRadius)
+        {
+            float objectRight = objectBounds.X + objectBounds.Width;
+            float objectBottom = objectBounds.Y + objectBounds.Height;
+
+            if (objectBounds.X > rectangle.X + rectangle.Width
+             || objectRight < rectangle.X
+             || objectBounds.Y > rectangle.Y + rectangle.Height
+             || objectBottom < rectangle.Y)
+            {
+                return false;
+            }
+
+            if (squaredRadius >= 0)
+            {
+                float dx = center.X - Math.Max(objectBounds.X, Math.Min(center.X, objectRight));
+                float dy = center.Y - Math.Max(objectBounds.Y, Math.Min(center.Y, objectBottom));
+
+                if ((dx * dx) + (dy * dy) > squaredRadius)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Gets the range of cells covered by a rectangle, clamped to the grid
+        /// </summary>
+        /// <param name="rectangle">The rectangle.</param>
+        /// <param name="minX">The first column.</param>
+        /// <param name="minY">The first row.</param>
+        /// <param name="maxX">The last column.</param>
+        /// <param name="maxY">The last row.</param>
+        private void GetCellRange(ref RectangleF rectangle, out int minX, out int minY, out int maxX, out int maxY)
+        {
+            minX = this.GetCellX(rectangle.X);
+            minY = this.GetCellY(rectangle.Y);
+            maxX = this.GetCellX(rectangle.X + rectangle.Width);
+            maxY = this.GetCellY(rectangle.Y + rectangle.Height);
+        }
+
+        /// <summary>
+        /// Gets the column that contains a coordinate, clamped to the grid
+        /// </summary>
+        /// <param name="x">The X coordinate.</param>
+        /// <returns>The column</returns>
+        private int GetCellX(float x)
+        {
+            float cell = (x - this.origin.X) * this.inverseCellSize;
+            return cell <= 0 ? 0 : (cell >= this.columns - 1 ? this.columns - 1 : (int)cell);
+        }
+
+        /// <summary>
+        /// Gets the row that contains a coordinate, clamped to the grid
+        /// </summary>
+        /// <param name="y">The Y coordinate.</param>
+        /// <returns>The row</returns>
+        private int GetCellY(float y)
+        {
+            float cell = (y - this.origin.Y) * this.inverseCellSize;
+            return cell <= 0 ? 0 : (cell >= this.rows - 1 ? this.rows - 1 : (int)cell);
+        }
+        #endregion
+    }
+}
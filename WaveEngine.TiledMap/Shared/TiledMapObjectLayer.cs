@@ -3,6 +3,7 @@
 #region Using Statements
 using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
@@ -19,6 +20,16 @@ namespace WaveEngine.TiledMap
     /// </summary>
     public class TiledMapObjectLayer
     {
+        /// <summary>
+        /// The spatial index of the objects, built on the first query
+        /// </summary>
+        private TiledMapObjectIndex objectIndex;
+
+        /// <summary>
+        /// The number of objects when the spatial index was built
+        /// </summary>
+        private int indexedCount;
+
         #region Properties
 
         /// <summary>
@@ -48,6 +59,8 @@ namespace WaveEngine.TiledMap
 
         /// <summary>
         /// Gets the objects contained in the object layer.
+        /// The spatial index is rebuilt when objects are added or removed. Call <see cref="RefreshIndex"/>
+        /// after replacing objects without changing the number of objects.
         /// </summary>
         public List<TiledMapObject> Objects { get; private set; }
 
@@ -80,6 +93,93 @@ namespace WaveEngine.TiledMap
                 this.Objects.Add(tiledMapObject);
             }
         }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TiledMapObjectLayer" /> class.
+        /// </summary>
+        /// <param name="reader">The cooked map reader</param>
+        internal TiledMapObjectLayer(BinaryReader reader)
+        {
+            this.ObjectLayerName = reader.ReadString();
+            this.Color = TiledMapCooker.ReadColor(reader);
+            this.Opacity = reader.ReadDouble();
+            this.Visible = reader.ReadBoolean();
+            this.Offset = new Vector2((float)reader.ReadDouble(), (float)reader.ReadDouble());
+            this.Properties = TiledMapCooker.ReadProperties(reader);
+
+            int objectCount = reader.ReadInt32();
+            this.Objects = new List<TiledMapObject>(objectCount);
+            for (int i = 0; i < objectCount; i++)
+            {
+                this.Objects.Add(new TiledMapObject(reader));
+            }
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Adds to a list the objects whose bounding rectangle intersects a rectangle.
+        /// The list is not cleared, so it can be reused between queries without allocations.
+        /// </summary>
+        /// <param name="rectangle">The rectangle, in map coordinates without the layer offset.</param>
+        /// <param name="results">The list where the objects are added.</param>
+        /// <returns>The number of objects added</returns>
+        public int GetObjectsInRectangle(RectangleF rectangle, List<TiledMapObject> results)
+        {
+            return this.GetObjectIndex().QueryRectangle(rectangle, results);
+        }
+
+        /// <summary>
+        /// Adds to a list the objects whose bounding rectangle contains a point.
+        /// The list is not cleared, so it can be reused between queries without allocations.
+        /// </summary>
+        /// <param name="point">The point, in map coordinates without the layer offset.</param>
+        /// <param name="results">The list where the objects are added.</param>
+        /// <returns>The number of objects added</returns>
+        public int GetObjectsAtPoint(Vector2 point, List<TiledMapObject> results)
+        {
+            return this.GetObjectIndex().QueryPoint(point, results);
+        }
+
+        /// <summary>
+        /// Adds to a list the objects whose bounding rectangle intersects a circle.
+        /// The list is not cleared, so it can be reused between queries without allocations.
+        /// </summary>
+        /// <param name="center">The center of the circle, in map coordinates without the layer offset.</param>
+        /// <param name="radius">The radius of the circle.</param>
+        /// <param name="results">The list where the objects are added.</param>
+        /// <returns>The number of objects added</returns>
+        public int GetObjectsInRadius(Vector2 center, float radius, List<TiledMapObject> results)
+        {
+            return this.GetObjectIndex().QueryRadius(center, radius, results);
+        }
+
+        /// <summary>
+        /// Rebuilds the spatial index of the objects on the next query.
+        /// </summary>
+        public void RefreshIndex()
+        {
+            this.objectIndex = null;
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Gets the spatial index of the objects, building it if the objects have changed
+        /// </summary>
+        /// <returns>The spatial index</returns>
+        private TiledMapObjectIndex GetObjectIndex()
+        {
+            if (this.objectIndex == null || this.indexedCount != this.Objects.Count)
+            {
+                this.objectIndex = new TiledMapObjectIndex(this.Objects);
+                this.indexedCount = this.Objects.Count;
+            }
+
+            return this.objectIndex;
+        }
         #endregion
     }
 }
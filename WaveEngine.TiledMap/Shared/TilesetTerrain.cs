@@ -3,6 +3,7 @@
 #region Using Statements
 using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
@@ -44,5 +45,16 @@ namespace WaveEngine.TiledMap
             this.Properties = new Dictionary<string, string>(tmxTerrain.Properties);
             this.Tile = tmxTerrain.Tile;
         }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TilesetTerrain" /> class.
+        /// </summary>
+        /// <param name="reader">The cooked map reader</param>
+        internal TilesetTerrain(BinaryReader reader)
+        {
+            this.Name = reader.ReadString();
+            this.Tile = reader.ReadInt32();
+            this.Properties = TiledMapCooker.ReadProperties(reader);
+        }
     }
 }
@@ -3,6 +3,7 @@
 #region Using Statements
 using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
@@ -62,6 +63,30 @@ namespace WaveEngine.TiledMap
         /// Gets the associated tileset
         /// </summary>
         public Tileset Tileset { get; private set; }
+
+        /// <summary>
+        /// Gets the animation frames of the tile. It is empty if the tile is not animated.
+        /// </summary>
+        public IReadOnlyList<TilesetTileAnimationFrame> AnimationFrames { get; private set; }
+
+        /// <summary>
+        /// Gets the duration of a whole animation cycle
+        /// </summary>
+        public TimeSpan AnimationDuration { get; private set; }
+
+        /// <summary>
+        /// Gets a value indicating whether the tile is animated
+        /// </summary>
+        public bool IsAnimated
+        {
+            get { return this.AnimationDuration > TimeSpan.Zero; }
+        }
+
+        /// <summary>
+        /// Gets the collision shapes of the tile, relative to the top left corner of the tile.
+        /// It is empty if the tile has no collision shapes.
+        /// </summary>
+        public IReadOnlyList<TiledMapObject> CollisionObjects { get; private set; }
         #endregion
 
         #region Initialization
@@ -78,6 +103,31 @@ namespace WaveEngine.TiledMap
             this.Probability = tmxTilesetTile.Probability;
             this.Properties = new Dictionary<string, string>(tmxTilesetTile.Properties);
 
+            var animationFrames = new List<TilesetTileAnimationFrame>();
+            if (tmxTilesetTile.AnimationFrames != null)
+            {
+                foreach (var tmxAnimationFrame in tmxTilesetTile.AnimationFrames)
+                {
+                    animationFrames.Add(new TilesetTileAnimationFrame(tmxAnimationFrame));
+                }
+            }
+
+            this.SetAnimationFrames(animationFrames);
+
+            var collisionObjects = new List<TiledMapObject>();
+            if (tmxTilesetTile.ObjectGroups != null)
+            {
+                foreach (var tmxObjectGroup in tmxTilesetTile.ObjectGroups)
+                {
+                    foreach (var tmxObject in tmxObjectGroup.Objects)
+                    {
+                        collisionObjects.Add(new TiledMapObject(tmxObject));
+                    }
+                }
+            }
+
+            this.CollisionObjects = collisionObjects;
+
             this.TerrainEdges = new List<TilesetTerrain>();
 
             if (tmxTilesetTile.BottomRight != null)
@@ -104,6 +154,124 @@ namespace WaveEngine.TiledMap
                 this.TerrainEdges.Add(this.TopLeft);
             }
         }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TilesetTile" /> class.
+        /// </summary>
+        /// <param name="reader">The cooked map reader.</param>
+        /// <param name="tileset">The associated tileset</param>
+        internal TilesetTile(BinaryReader reader, Tileset tileset)
+        {
+            this.Tileset = tileset;
+            this.ID = reader.ReadInt32();
+            this.Probability = reader.ReadDouble();
+            this.Properties = TiledMapCooker.ReadProperties(reader);
+
+            this.TopLeft = this.ReadTerrain(reader);
+            this.TopRight = this.ReadTerrain(reader);
+            this.BottomLeft = this.ReadTerrain(reader);
+            this.BottomRight = this.ReadTerrain(reader);
+
+            int frameCount = reader.ReadInt32();
+            var animationFrames = new List<TilesetTileAnimationFrame>(frameCount);
+            for (int i = 0; i < frameCount; i++)
+            {
+                int id = reader.ReadInt32();
+                animationFrames.Add(new TilesetTileAnimationFrame(id, TimeSpan.FromMilliseconds(reader.ReadInt32())));
+            }
+
+            this.SetAnimationFrames(animationFrames);
+
+            int collisionObjectCount = reader.ReadInt32();
+            var collisionObjects = new List<TiledMapObject>(collisionObjectCount);
+            for (int i = 0; i < collisionObjectCount; i++)
+            {
+                collisionObjects.Add(new TiledMapObject(reader));
+            }
+
+            this.CollisionObjects = collisionObjects;
+
+            this.TerrainEdges = new List<TilesetTerrain>();
+
+            if (this.BottomRight != null)
+            {
+                this.TerrainEdges.Add(this.BottomRight);
+            }
+
+            if (this.BottomLeft != null)
+            {
+                this.TerrainEdges.Add(this.BottomLeft);
+            }
+
+            if (this.TopRight != null)
+            {
+                this.TerrainEdges.Add(this.TopRight);
+            }
+
+            if (this.TopLeft != null)
+            {
+                this.TerrainEdges.Add(this.TopLeft);
+            }
+        }
+        #endregion
+
+        #region Public Methods
+
+        /// <summary>
+        /// Gets the ID of the tile shown by the animation at the specified time. The animation loops.
+        /// </summary>
+        /// <param name="time">The animation time.</param>
+        /// <returns>The ID of the tile shown at that time, or the tile ID if it is not animated.</returns>
+        public int GetAnimationFrameId(TimeSpan time)
+        {
+            if (!this.IsAnimated)
+            {
+                return this.ID;
+            }
+
+            long ticks = time.Ticks % this.AnimationDuration.Ticks;
+            for (int i = 0; i < this.AnimationFrames.Count; i++)
+            {
+                var frame = this.AnimationFrames[i];
+                if (ticks < frame.Duration.Ticks)
+                {
+                    return frame.Id;
+                }
+
+                ticks -= frame.Duration.Ticks;
+            }
+
+            return this.AnimationFrames[this.AnimationFrames.Count - 1].Id;
+        }
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Sets the animation frames of the tile
+        /// </summary>
+        /// <param name="animationFrames">The animation frames.</param>
+        private void SetAnimationFrames(List<TilesetTileAnimationFrame> animationFrames)
+        {
+            this.AnimationFrames = animationFrames;
+            this.AnimationDuration = TimeSpan.Zero;
+
+            for (int i = 0; i < animationFrames.Count; i++)
+            {
+                this.AnimationDuration += animationFrames[i].Duration;
+            }
+        }
+
+        /// <summary>
+        /// Reads a terrain reference of the tile
+        /// </summary>
+        /// <param name="reader">The cooked map reader.</param>
+        /// <returns>The terrain, or null if there is no terrain</returns>
+        private TilesetTerrain ReadTerrain(BinaryReader reader)
+        {
+            string name = reader.ReadString();
+            return string.IsNullOrEmpty(name) ? null : this.Tileset.Terrains[name];
+        }
         #endregion
     }
 }
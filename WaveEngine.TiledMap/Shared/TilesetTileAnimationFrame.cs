@@ -0,0 +1,55 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+#region Using Statements
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using TiledSharp;
+#endregion
+
+namespace WaveEngine.TiledMap
+{
+    /// <summary>
+    /// A frame of an animated tileset tile
+    /// </summary>
+    public class TilesetTileAnimationFrame
+    {
+        #region Properties
+
+        /// <summary>
+        /// Gets the ID of the tile shown in this frame
+        /// </summary>
+        public int Id { get; private set; }
+
+        /// <summary>
+        /// Gets the frame duration
+        /// </summary>
+        public TimeSpan Duration { get; private set; }
+        #endregion
+
+        #region Initialization
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TilesetTileAnimationFrame" /> class.
+        /// </summary>
+        /// <param name="tmxAnimationFrame">The TMX parsed animation frame</param>
+        public TilesetTileAnimationFrame(TmxAnimationFrame tmxAnimationFrame)
+            : this(tmxAnimationFrame.Id, TimeSpan.FromMilliseconds(tmxAnimationFrame.Duration))
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TilesetTileAnimationFrame" /> class.
+        /// </summary>
+        /// <param name="id">The ID of the tile shown in this frame</param>
+        /// <param name="duration">The frame duration</param>
+        internal TilesetTileAnimationFrame(int id, TimeSpan duration)
+        {
+            this.Id = id;
+            this.Duration = duration;
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,80 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Tests of the packed tile data read by <see cref="LayerTile"/>
+    /// </summary>
+    [TestFixture]
+    public class LayerTileTests
+    {
+        /// <summary>
+        /// Every combination of flips round trips through the packed value.
+        /// </summary>
+        [Test]
+        public void PackRoundTripsFlips()
+        {
+            for (int flags = 0; flags < 8; flags++)
+            {
+                bool horizontal = (flags & 1) != 0;
+                bool vertical = (flags & 2) != 0;
+                bool diagonal = (flags & 4) != 0;
+
+                uint data = LayerTile.Pack(1234, horizontal, vertical, diagonal);
+                var tile = new LayerTile(3, 4, data, null, Vector2.Zero);
+
+                Assert.AreEqual(1234, tile.Gid);
+                Assert.AreEqual(horizontal, tile.HorizontalFlip);
+                Assert.AreEqual(vertical, tile.VerticalFlip);
+                Assert.AreEqual(diagonal, tile.DiagonalFlip);
+                Assert.AreEqual(3, tile.X);
+                Assert.AreEqual(4, tile.Y);
+            }
+        }
+
+        /// <summary>
+        /// The packed value uses the same bit layout as the TMX format.
+        /// </summary>
+        [Test]
+        public void PackMatchesTmxLayout()
+        {
+            Assert.AreEqual(0x80000005u, LayerTile.Pack(5, true, false, false));
+            Assert.AreEqual(0x40000005u, LayerTile.Pack(5, false, true, false));
+            Assert.AreEqual(0x20000005u, LayerTile.Pack(5, false, false, true));
+            Assert.AreEqual(0xE0000005u, LayerTile.Pack(5, true, true, true));
+        }
+
+        /// <summary>
+        /// Global IDs that don't fit in the ID bits never change the flip bits.
+        /// </summary>
+        [Test]
+        public void PackMasksGidOverflow()
+        {
+            uint data = LayerTile.Pack(unchecked((int)0xFFFFFFFF), false, false, false);
+            var tile = new LayerTile(0, 0, data, null, Vector2.Zero);
+
+            Assert.AreEqual((int)LayerTile.GidMask, tile.Gid);
+            Assert.IsFalse(tile.HorizontalFlip);
+            Assert.IsFalse(tile.VerticalFlip);
+            Assert.IsFalse(tile.DiagonalFlip);
+        }
+
+        /// <summary>
+        /// An empty cell has no tileset, so its local ID and tileset tile are empty.
+        /// </summary>
+        [Test]
+        public void EmptyTileHasNoTilesetTile()
+        {
+            var tile = new LayerTile(0, 0, 0, null, Vector2.Zero);
+
+            Assert.AreEqual(0, tile.Gid);
+            Assert.AreEqual(0, tile.Id);
+            Assert.IsNull(tile.Tileset);
+            Assert.IsNull(tile.TilesetTile);
+        }
+    }
+}
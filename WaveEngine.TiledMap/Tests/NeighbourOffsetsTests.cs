@@ -0,0 +1,175 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using NUnit.Framework;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="NeighbourOffsets"/>
+    /// </summary>
+    [TestFixture]
+    public class NeighbourOffsetsTests
+    {
+        /// <summary>
+        /// The map orientations with neighbour tables
+        /// </summary>
+        private static readonly TiledMapOrientationType[] Orientations = new TiledMapOrientationType[]
+        {
+            TiledMapOrientationType.Orthogonal,
+            TiledMapOrientationType.Isometric,
+            TiledMapOrientationType.Staggered,
+            TiledMapOrientationType.Hexagonal,
+        };
+
+        /// <summary>
+        /// The stagger axes
+        /// </summary>
+        private static readonly TiledMapStaggerAxisType[] StaggerAxes = new TiledMapStaggerAxisType[]
+        {
+            TiledMapStaggerAxisType.X,
+            TiledMapStaggerAxisType.Y,
+        };
+
+        /// <summary>
+        /// The stagger indices
+        /// </summary>
+        private static readonly TiledMapStaggerIndexType[] StaggerIndices = new TiledMapStaggerIndexType[]
+        {
+            TiledMapStaggerIndexType.Odd,
+            TiledMapStaggerIndexType.Even,
+        };
+
+        /// <summary>
+        /// If B is the neighbour of A in one direction, A is the neighbour of B in the opposite direction.
+        /// </summary>
+        [Test]
+        public void NeighboursAreSymmetric()
+        {
+            foreach (var orientation in Orientations)
+            {
+                foreach (var staggerAxis in StaggerAxes)
+                {
+                    foreach (var staggerIndex in StaggerIndices)
+                    {
+                        this.CheckSymmetry(orientation, staggerAxis, staggerIndex);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Every tile has eight distinct neighbours, except on hexagonal maps, which have six.
+        /// </summary>
+        [Test]
+        public void NeighboursAreDistinct()
+        {
+            foreach (var orientation in Orientations)
+            {
+                foreach (var staggerAxis in StaggerAxes)
+                {
+                    Point[] shiftedTable, unshiftedTable;
+                    NeighbourOffsets.GetTables(orientation, staggerAxis, out shiftedTable, out unshiftedTable);
+
+                    int expected = orientation == TiledMapOrientationType.Hexagonal ? 6 : 8;
+                    Assert.AreEqual(expected, CountDistinct(shiftedTable), string.Format("{0} {1}", orientation, staggerAxis));
+                    Assert.AreEqual(expected, CountDistinct(unshiftedTable), string.Format("{0} {1}", orientation, staggerAxis));
+                }
+            }
+        }
+
+        /// <summary>
+        /// The stagger index selects which rows or columns are shifted.
+        /// </summary>
+        [Test]
+        public void StaggerIndexSelectsShiftedRows()
+        {
+            Assert.IsTrue(NeighbourOffsets.IsShifted(0, TiledMapStaggerIndexType.Odd));
+            Assert.IsFalse(NeighbourOffsets.IsShifted(1, TiledMapStaggerIndexType.Odd));
+            Assert.IsFalse(NeighbourOffsets.IsShifted(0, TiledMapStaggerIndexType.Even));
+            Assert.IsTrue(NeighbourOffsets.IsShifted(1, TiledMapStaggerIndexType.Even));
+        }
+
+        /// <summary>
+        /// Checks that the neighbours of the tiles of a map are symmetric
+        /// </summary>
+        /// <param name="orientation">The map orientation.</param>
+        /// <param name="staggerAxis">The stagger axis.</param>
+        /// <param name="staggerIndex">The stagger index.</param>
+        private void CheckSymmetry(TiledMapOrientationType orientation, TiledMapStaggerAxisType staggerAxis, TiledMapStaggerIndexType staggerIndex)
+        {
+            for (int y = 2; y < 6; y++)
+            {
+                for (int x = 2; x < 6; x++)
+                {
+                    var offsets = GetOffsets(orientation, staggerAxis, staggerIndex, x, y);
+
+                    for (int direction = 0; direction < NeighbourOffsets.Count; direction++)
+                    {
+                        var offset = offsets[direction];
+                        if (offset.X == 0 && offset.Y == 0)
+                        {
+                            continue;
+                        }
+
+                        int neighbourX = x + offset.X;
+                        int neighbourY = y + offset.Y;
+                        var back = GetOffsets(orientation, staggerAxis, staggerIndex, neighbourX, neighbourY)[(direction + 4) % NeighbourOffsets.Count];
+
+                        var message = string.Format("{0} {1} {2}, direction {3} of tile ({4}, {5})", orientation, staggerAxis, staggerIndex, direction, x, y);
+                        Assert.AreEqual(x, neighbourX + back.X, message);
+                        Assert.AreEqual(y, neighbourY + back.Y, message);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the neighbour offsets of a tile
+        /// </summary>
+        /// <param name="orientation">The map orientation.</param>
+        /// <param name="staggerAxis">The stagger axis.</param>
+        /// <param name="staggerIndex">The stagger index.</param>
+        /// <param name="x">The X coord of the tile.</param>
+        /// <param name="y">The Y coord of the tile.</param>
+        /// <returns>The offsets</returns>
+        private static Point[] GetOffsets(TiledMapOrientationType orientation, TiledMapStaggerAxisType staggerAxis, TiledMapStaggerIndexType staggerIndex, int x, int y)
+        {
+            Point[] shiftedTable, unshiftedTable;
+            NeighbourOffsets.GetTables(orientation, staggerAxis, out shiftedTable, out unshiftedTable);
+
+            int coordinate = staggerAxis == TiledMapStaggerAxisType.X ? x : y;
+            return NeighbourOffsets.IsShifted(coordinate, staggerIndex) ? shiftedTable : unshiftedTable;
+        }
+
+        /// <summary>
+        /// Counts the distinct non zero offsets of a table
+        /// </summary>
+        /// <param name="table">The offset table.</param>
+        /// <returns>The number of distinct offsets</returns>
+        private static int CountDistinct(Point[] table)
+        {
+            int count = 0;
+            for (int i = 0; i < table.Length; i++)
+            {
+                if (table[i].X == 0 && table[i].Y == 0)
+                {
+                    continue;
+                }
+
+                bool repeated = false;
+                for (int j = 0; j < i; j++)
+                {
+                    repeated |= table[j].X == table[i].X && table[j].Y == table[i].Y;
+                }
+
+                if (!repeated)
+                {
+                    count++;
+                }
+            }
+
+            return count;
+        }
+    }
+}
@@ -0,0 +1,228 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using System.Xml.Linq;
+using NUnit.Framework;
+using TiledSharp;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="TiledMapColliderShapes"/>
+    /// </summary>
+    [TestFixture]
+    public class TiledMapColliderShapesTests
+    {
+        /// <summary>
+        /// The tile size of the tests
+        /// </summary>
+        private const float TileSize = 16;
+
+        /// <summary>
+        /// The tolerance of the compared coordinates
+        /// </summary>
+        private const float Delta = 1e-4f;
+
+        /// <summary>
+        /// The solid tiles of a small chunk are merged into maximal rectangles, growing right and then down.
+        /// </summary>
+        [Test]
+        public void MergeBuildsMaximalRectangles()
+        {
+            var solidTiles = ParseGrid(
+                "XX.X",
+                "XX.X",
+                ".XXX");
+
+            var rectangles = new List<Rectangle>();
+            TiledMapColliderShapes.MergeSolidTiles(solidTiles, 4, 3, rectangles);
+
+            Assert.AreEqual(3, rectangles.Count);
+            Assert.AreEqual(new Rectangle(0, 0, 2, 2), rectangles[0]);
+            Assert.AreEqual(new Rectangle(3, 0, 1, 3), rectangles[1]);
+            Assert.AreEqual(new Rectangle(1, 2, 2, 1), rectangles[2]);
+            CollectionAssert.AreEqual(new bool[12], solidTiles);
+        }
+
+        /// <summary>
+        /// The merged rectangles cover every solid tile once and no empty tile, for random chunks.
+        /// </summary>
+        [Test]
+        public void MergeCoversSolidTilesOnce()
+        {
+            var random = new Random(35);
+            var rectangles = new List<Rectangle>();
+
+            for (int iteration = 0; iteration < 100; iteration++)
+            {
+                int width = random.Next(1, 12);
+                int height = random.Next(1, 12);
+                var solidTiles = new bool[width * height];
+                for (int i = 0; i < solidTiles.Length; i++)
+                {
+                    solidTiles[i] = random.Next(3) != 0;
+                }
+
+                var expected = (bool[])solidTiles.Clone();
+                var covered = new int[solidTiles.Length];
+                rectangles.Clear();
+                TiledMapColliderShapes.MergeSolidTiles(solidTiles, width, height, rectangles);
+
+                foreach (var rectangle in rectangles)
+                {
+                    for (int y = rectangle.Y; y < rectangle.Y + rectangle.Height; y++)
+                    {
+                        for (int x = rectangle.X; x < rectangle.X + rectangle.Width; x++)
+                        {
+                            covered[x + (y * width)]++;
+                        }
+                    }
+                }
+
+                for (int i = 0; i < expected.Length; i++)
+                {
+                    Assert.AreEqual(expected[i] ? 1 : 0, covered[i], "Tile " + i);
+                }
+            }
+        }
+
+        /// <summary>
+        /// A fully solid chunk becomes a single rectangle.
+        /// </summary>
+        [Test]
+        public void MergeFullChunkIsSingleRectangle()
+        {
+            var solidTiles = new bool[5 * 4];
+            for (int i = 0; i < solidTiles.Length; i++)
+            {
+                solidTiles[i] = true;
+            }
+
+            var rectangles = new List<Rectangle>();
+            TiledMapColliderShapes.MergeSolidTiles(solidTiles, 5, 4, rectangles);
+
+            Assert.AreEqual(1, rectangles.Count);
+            Assert.AreEqual(new Rectangle(0, 0, 5, 4), rectangles[0]);
+        }
+
+        /// <summary>
+        /// The flips of the tile are applied to the rectangle shape after its position, within the tile.
+        /// </summary>
+        [Test]
+        public void OutlineAppliesTileFlips()
+        {
+            var shape = CreateShape("<object x=\"2\" y=\"4\" width=\"6\" height=\"8\"/>");
+            var position = new Vector2(32, 0);
+
+            AssertOutline(shape, false, false, false, position, new Vector2(2, 4), new Vector2(8, 4), new Vector2(8, 12), new Vector2(2, 12));
+            AssertOutline(shape, true, false, false, position, new Vector2(14, 4), new Vector2(8, 4), new Vector2(8, 12), new Vector2(14, 12));
+            AssertOutline(shape, false, true, false, position, new Vector2(2, 12), new Vector2(8, 12), new Vector2(8, 4), new Vector2(2, 4));
+            AssertOutline(shape, false, false, true, position, new Vector2(4, 2), new Vector2(4, 8), new Vector2(12, 8), new Vector2(12, 2));
+            AssertOutline(shape, true, true, true, position, new Vector2(12, 14), new Vector2(12, 8), new Vector2(4, 8), new Vector2(4, 14));
+        }
+
+        /// <summary>
+        /// The object rotation turns the shape around its position, before the tile flips.
+        /// </summary>
+        [Test]
+        public void OutlineAppliesRotationBeforeFlips()
+        {
+            var shape = CreateShape("<object x=\"8\" y=\"0\" width=\"4\" height=\"2\" rotation=\"90\"/>");
+
+            AssertOutline(shape, false, false, false, Vector2.Zero, new Vector2(8, 0), new Vector2(8, 4), new Vector2(6, 4), new Vector2(6, 0));
+            AssertOutline(shape, true, false, false, Vector2.Zero, new Vector2(8, 0), new Vector2(8, 4), new Vector2(10, 4), new Vector2(10, 0));
+        }
+
+        /// <summary>
+        /// Polylines are open outlines, polygons are closed, and ellipses are not supported.
+        /// </summary>
+        [Test]
+        public void OutlineOfPointShapes()
+        {
+            var outline = new List<Vector2>();
+            bool closed;
+            var tile = new LayerTile(0, 0, LayerTile.Pack(1, false, false, false), null, Vector2.Zero);
+
+            var polyline = CreateShape("<object x=\"1\" y=\"1\"><polyline points=\"0,0 4,0 4,4\"/></object>");
+            Assert.IsTrue(TiledMapColliderShapes.GetTileShapeOutline(tile, polyline, TileSize, TileSize, outline, out closed));
+            Assert.IsFalse(closed);
+            Assert.AreEqual(3, outline.Count);
+            AssertPoint(new Vector2(5, 5), outline[2]);
+
+            var polygon = CreateShape("<object x=\"1\" y=\"1\"><polygon points=\"0,0 4,0 4,4\"/></object>");
+            Assert.IsTrue(TiledMapColliderShapes.GetTileShapeOutline(tile, polygon, TileSize, TileSize, outline, out closed));
+            Assert.IsTrue(closed);
+            Assert.AreEqual(3, outline.Count);
+
+            var ellipse = CreateShape("<object x=\"1\" y=\"1\" width=\"4\" height=\"4\"><ellipse/></object>");
+            Assert.IsFalse(TiledMapColliderShapes.GetTileShapeOutline(tile, ellipse, TileSize, TileSize, outline, out closed));
+        }
+
+        /// <summary>
+        /// Checks the outline of a shape for a tile with the given flips
+        /// </summary>
+        /// <param name="shape">The collision shape.</param>
+        /// <param name="horizontalFlip">Whether the tile has horizontal flip.</param>
+        /// <param name="verticalFlip">Whether the tile has vertical flip.</param>
+        /// <param name="diagonalFlip">Whether the tile has diagonal flip.</param>
+        /// <param name="position">The local position of the tile.</param>
+        /// <param name="expected">The expected outline, relative to the tile position.</param>
+        private static void AssertOutline(TiledMapObject shape, bool horizontalFlip, bool verticalFlip, bool diagonalFlip, Vector2 position, params Vector2[] expected)
+        {
+            var tile = new LayerTile(2, 0, LayerTile.Pack(1, horizontalFlip, verticalFlip, diagonalFlip), null, position);
+            var outline = new List<Vector2>();
+            bool closed;
+
+            Assert.IsTrue(TiledMapColliderShapes.GetTileShapeOutline(tile, shape, TileSize, TileSize, outline, out closed));
+            Assert.IsTrue(closed);
+            Assert.AreEqual(expected.Length, outline.Count);
+            for (int i = 0; i < expected.Length; i++)
+            {
+                AssertPoint(expected[i] + position, outline[i]);
+            }
+        }
+
+        /// <summary>
+        /// Checks that two points are equal within the tolerance
+        /// </summary>
+        /// <param name="expected">The expected point.</param>
+        /// <param name="actual">The actual point.</param>
+        private static void AssertPoint(Vector2 expected, Vector2 actual)
+        {
+            Assert.AreEqual(expected.X, actual.X, Delta, "X of " + expected);
+            Assert.AreEqual(expected.Y, actual.Y, Delta, "Y of " + expected);
+        }
+
+        /// <summary>
+        /// Creates a collision shape from its TMX element
+        /// </summary>
+        /// <param name="element">The TMX object element.</param>
+        /// <returns>The collision shape</returns>
+        private static TiledMapObject CreateShape(string element)
+        {
+            return new TiledMapObject(new TmxObject(XElement.Parse(element)));
+        }
+
+        /// <summary>
+        /// Parses the rows of a grid where X marks a solid tile
+        /// </summary>
+        /// <param name="rows">The rows.</param>
+        /// <returns>The solid tiles, indexed by x + y * width</returns>
+        private static bool[] ParseGrid(params string[] rows)
+        {
+            int width = rows[0].Length;
+            var solidTiles = new bool[width * rows.Length];
+            for (int y = 0; y < rows.Length; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    solidTiles[x + (y * width)] = rows[y][x] == 'X';
+                }
+            }
+
+            return solidTiles;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Diagnostics;
+using System.IO;
+using System.Text;
+using NUnit.Framework;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Measures the load time of a large map from its cooked version against its TMX file
+    /// </summary>
+    [TestFixture]
+    [Category("Benchmark")]
+    public class TiledMapCookerBenchmark
+    {
+        /// <summary>
+        /// The number of loads measured of each format
+        /// </summary>
+        private const int LoadCount = 5;
+
+        /// <summary>
+        /// Loads the tile layers of a 1000x1000 map with two layers from TMX and from its cooked version.
+        /// </summary>
+        /// <remarks>
+        /// Tilesets load their textures through the scene assets, so the measured map has none.
+        /// </remarks>
+        [Test]
+        [Explicit]
+        public void CookedAgainstTmxOn1000Map()
+        {
+            const int Size = 1000;
+            string tmx = TiledMapLayerDataBenchmark.CreateRandomMap(new Random(31), Size, Size, 2);
+
+            var tmxMap = TiledMapLayerDataBenchmark.Parse(tmx);
+            tmxMap.Tilesets.Clear();
+            byte[] cooked;
+            using (var output = new MemoryStream())
+            {
+                TiledMapCooker.Cook(tmxMap, output);
+                cooked = output.ToArray();
+            }
+
+            TiledMapLayerData[] tmxLayers = null;
+            var stopwatch = Stopwatch.StartNew();
+            for (int i = 0; i < LoadCount; i++)
+            {
+                tmxLayers = TiledMapLayerDataBenchmark.LoadLayers(tmx, Size * Size);
+            }
+
+            stopwatch.Stop();
+            double tmxTime = stopwatch.Elapsed.TotalMilliseconds / LoadCount;
+
+            TiledMapLayerData[] cookedLayers = null;
+            stopwatch.Restart();
+            for (int i = 0; i < LoadCount; i++)
+            {
+                cookedLayers = LoadCookedLayers(cooked);
+            }
+
+            stopwatch.Stop();
+            double cookedTime = stopwatch.Elapsed.TotalMilliseconds / LoadCount;
+
+            Assert.AreEqual(tmxLayers.Length, cookedLayers.Length);
+            for (int i = 0; i < tmxLayers.Length; i++)
+            {
+                CollectionAssert.AreEqual(tmxLayers[i].Tiles, cookedLayers[i].Tiles);
+            }
+
+            TestContext.Progress.WriteLine("TMX ({0:N0} bytes):    {1:F2} ms", Encoding.UTF8.GetByteCount(tmx), tmxTime);
+            TestContext.Progress.WriteLine("Cooked ({0:N0} bytes): {1:F2} ms", cooked.Length, cookedTime);
+        }
+
+        /// <summary>
+        /// Loads the tile layers of a cooked map without tilesets, reading it as <see cref="TiledMap"/> does
+        /// </summary>
+        /// <param name="cooked">The cooked map.</param>
+        /// <returns>The layer data</returns>
+        private static TiledMapLayerData[] LoadCookedLayers(byte[] cooked)
+        {
+            using (var stream = new MemoryStream(cooked))
+            using (var reader = new BinaryReader(stream, Encoding.UTF8, true))
+            {
+                ulong sourceHash;
+                Assert.IsTrue(TiledMapCooker.TryReadHeader(reader, out sourceHash));
+
+                reader.ReadString();
+                for (int i = 0; i < 4; i++)
+                {
+                    reader.ReadInt32();
+                }
+
+                int width = reader.ReadInt32();
+                int height = reader.ReadInt32();
+                reader.ReadInt32();
+                reader.ReadInt32();
+                reader.ReadInt32();
+                TiledMapCooker.ReadColor(reader);
+                TiledMapCooker.ReadProperties(reader);
+                Assert.AreEqual(0, reader.ReadInt32());
+
+                var layers = new TiledMapLayerData[reader.ReadInt32()];
+                for (int i = 0; i < layers.Length; i++)
+                {
+                    layers[i] = new TiledMapLayerData(reader, width * height);
+                }
+
+                return layers;
+            }
+        }
+    }
+}
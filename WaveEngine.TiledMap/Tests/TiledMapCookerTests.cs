@@ -0,0 +1,152 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.IO;
+using System.Text;
+using System.Xml.Linq;
+using NUnit.Framework;
+using TiledSharp;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="TiledMapCooker"/>
+    /// </summary>
+    [TestFixture]
+    public class TiledMapCookerTests
+    {
+        /// <summary>
+        /// A map with a tileset based on a single image
+        /// </summary>
+        private const string ImageTilesetMap =
+            "<map version=\"1.0\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"2\" height=\"1\" tilewidth=\"16\" tileheight=\"16\">" +
+            "<tileset firstgid=\"1\" name=\"terrain\" tilewidth=\"16\" tileheight=\"16\">" +
+            "<image source=\"Content/terrain.png\" width=\"64\" height=\"64\"/>" +
+            "</tileset>" +
+            "</map>";
+
+        /// <summary>
+        /// A map with a tileset made of a collection of images
+        /// </summary>
+        private const string ImageCollectionMap =
+            "<map version=\"1.0\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"2\" height=\"1\" tilewidth=\"16\" tileheight=\"16\">" +
+            "<tileset firstgid=\"1\" name=\"props\" tilewidth=\"16\" tileheight=\"16\">" +
+            "<tile id=\"0\"><image source=\"Content/barrel.png\" width=\"16\" height=\"16\"/></tile>" +
+            "</tileset>" +
+            "</map>";
+
+        /// <summary>
+        /// The hash only depends on the file contents, and any change in them changes it.
+        /// </summary>
+        [Test]
+        public void SourceHashDetectsChanges()
+        {
+            ulong hash = Hash(ImageTilesetMap);
+
+            Assert.AreEqual(hash, Hash(ImageTilesetMap));
+            Assert.AreNotEqual(hash, Hash(ImageTilesetMap.Replace("width=\"2\"", "width=\"3\"")));
+            Assert.AreNotEqual(TiledMapCooker.NoSourceHash, Hash(string.Empty));
+        }
+
+        /// <summary>
+        /// The source hash is written in the header of the cooked map.
+        /// </summary>
+        [Test]
+        public void HeaderStoresSourceHash()
+        {
+            using (var output = new MemoryStream())
+            {
+                TiledMapCooker.Cook(Parse(ImageTilesetMap), output, 0x1234567890ABCDEF);
+
+                output.Position = 0;
+                using (var reader = new BinaryReader(output))
+                {
+                    ulong sourceHash;
+                    Assert.IsTrue(TiledMapCooker.TryReadHeader(reader, out sourceHash));
+                    Assert.AreEqual(0x1234567890ABCDEFul, sourceHash);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Cooked maps of other format versions are rejected, so the TMX file is loaded instead.
+        /// </summary>
+        [Test]
+        public void HeaderRejectsOtherVersions()
+        {
+            using (var output = new MemoryStream())
+            {
+                using (var writer = new BinaryWriter(output, Encoding.UTF8, true))
+                {
+                    writer.Write(TiledMapCooker.Magic);
+                    writer.Write(TiledMapCooker.FormatVersion - 1);
+                    writer.Write(0ul);
+                }
+
+                output.Position = 0;
+                using (var reader = new BinaryReader(output))
+                {
+                    ulong sourceHash;
+                    Assert.IsFalse(TiledMapCooker.TryReadHeader(reader, out sourceHash));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Tilesets made of a collection of images are reported with a clear error.
+        /// </summary>
+        [Test]
+        public void ImageCollectionTilesetIsNotSupported()
+        {
+            var tmxMap = Parse(ImageCollectionMap);
+
+            using (var output = new MemoryStream())
+            {
+                var exception = Assert.Throws<NotSupportedException>(() => TiledMapCooker.Cook(tmxMap, output));
+                StringAssert.Contains("props", exception.Message);
+            }
+        }
+
+        /// <summary>
+        /// Computes the source hash of a text
+        /// </summary>
+        /// <param name="text">The text.</param>
+        /// <returns>The hash</returns>
+        private static ulong Hash(string text)
+        {
+            using (var stream = new MemoryStream(Encoding.UTF8.GetBytes(text)))
+            {
+                return TiledMapCooker.ComputeSourceHash(stream);
+            }
+        }
+
+        /// <summary>
+        /// Parses a TMX map
+        /// </summary>
+        /// <param name="tmx">The TMX document.</param>
+        /// <returns>The parsed map</returns>
+        internal static TmxMap Parse(string tmx)
+        {
+            using (var stream = new MemoryStream(Encoding.UTF8.GetBytes(tmx)))
+            {
+                return new TmxMap(new FileDocumentLoader(), stream, string.Empty);
+            }
+        }
+
+        /// <summary>
+        /// Loads external TSX documents from the file system
+        /// </summary>
+        private class FileDocumentLoader : IDocumentLoader
+        {
+            /// <summary>
+            /// Loads the specified document.
+            /// </summary>
+            /// <param name="path">The path.</param>
+            /// <returns>XDocument</returns>
+            public XDocument Load(string path)
+            {
+                return XDocument.Load(path);
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using NUnit.Framework;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="TiledMapCoordinateConverter"/>
+    /// </summary>
+    [TestFixture]
+    public class TiledMapCoordinateConverterTests
+    {
+        /// <summary>
+        /// The number of positions converted for each map
+        /// </summary>
+        private const int PositionCount = 5000;
+
+        /// <summary>
+        /// The batch conversion returns the same tile coordinates as converting each position, for every orientation.
+        /// </summary>
+        [Test]
+        public void BatchMatchesSinglePositions()
+        {
+            AssertBatchMatchesSinglePositions(TiledMapOrientationType.Orthogonal, TiledMapStaggerAxisType.Y, TiledMapStaggerIndexType.Odd, 0);
+            AssertBatchMatchesSinglePositions(TiledMapOrientationType.Isometric, TiledMapStaggerAxisType.Y, TiledMapStaggerIndexType.Odd, 0);
+
+            foreach (TiledMapStaggerAxisType staggerAxis in Enum.GetValues(typeof(TiledMapStaggerAxisType)))
+            {
+                foreach (TiledMapStaggerIndexType staggerIndex in Enum.GetValues(typeof(TiledMapStaggerIndexType)))
+                {
+                    AssertBatchMatchesSinglePositions(TiledMapOrientationType.Staggered, staggerAxis, staggerIndex, 0);
+                    AssertBatchMatchesSinglePositions(TiledMapOrientationType.Hexagonal, staggerAxis, staggerIndex, 12);
+                }
+            }
+        }
+
+        /// <summary>
+        /// The tile coordinates of an orthogonal map follow the tile size, and round down for negative positions.
+        /// </summary>
+        [Test]
+        public void OrthogonalCoordinates()
+        {
+            var converter = new TiledMapCoordinateConverter(TiledMapOrientationType.Orthogonal, 32, 16, 10, TiledMapStaggerAxisType.Y, TiledMapStaggerIndexType.Odd, 0);
+            var identity = CreateMatrix(1, 0, 0, 1, 0, 0, 0, 0);
+            int tileX, tileY;
+
+            converter.GetTileCoordinates(new Vector2(70, 40), ref identity, 0, out tileX, out tileY);
+            Assert.AreEqual(2, tileX);
+            Assert.AreEqual(2, tileY);
+
+            converter.GetTileCoordinates(new Vector2(-1, -1), ref identity, 0, out tileX, out tileY);
+            Assert.AreEqual(-1, tileX);
+            Assert.AreEqual(-1, tileY);
+        }
+
+        /// <summary>
+        /// Converts random positions with both methods and compares the results
+        /// </summary>
+        /// <param name="orientation">The map orientation.</param>
+        /// <param name="staggerAxis">The stagger axis.</param>
+        /// <param name="staggerIndex">The stagger index.</param>
+        /// <param name="hexSideLength">The side length of the hexagons.</param>
+        private static void AssertBatchMatchesSinglePositions(TiledMapOrientationType orientation, TiledMapStaggerAxisType staggerAxis, TiledMapStaggerIndexType staggerIndex, int hexSideLength)
+        {
+            var converter = new TiledMapCoordinateConverter(orientation, 32, 16, 20, staggerAxis, staggerIndex, hexSideLength);
+            var random = new Random(36);
+
+            // A rotated and scaled map with a draw order, whose values keep the transformed positions exact
+            var inverse = CreateMatrix(0, 0.5f, -0.5f, 0, 0.25f, -0.125f, 37, -11);
+            float drawOrder = 8;
+
+            var positions = new Vector2[PositionCount];
+            for (int i = 0; i < positions.Length; i++)
+            {
+                positions[i] = new Vector2(random.Next(-8000, 8000) / 8f, random.Next(-8000, 8000) / 8f);
+            }
+
+            var tileCoordinates = new Point[PositionCount];
+            converter.GetTileCoordinates(positions, tileCoordinates, PositionCount, ref inverse, drawOrder);
+
+            for (int i = 0; i < positions.Length; i++)
+            {
+                int tileX, tileY;
+                converter.GetTileCoordinates(positions[i], ref inverse, drawOrder, out tileX, out tileY);
+
+                string message = string.Format("{0} {1} {2} at {3}", orientation, staggerAxis, staggerIndex, positions[i]);
+                Assert.AreEqual(tileX, tileCoordinates[i].X, message);
+                Assert.AreEqual(tileY, tileCoordinates[i].Y, message);
+            }
+        }
+
+        /// <summary>
+        /// Creates a transform with a 2D part, a Z contribution and a translation
+        /// </summary>
+        /// <param name="m11">The M11 value.</param>
+        /// <param name="m12">The M12 value.</param>
+        /// <param name="m21">The M21 value.</param>
+        /// <param name="m22">The M22 value.</param>
+        /// <param name="m31">The M31 value.</param>
+        /// <param name="m32">The M32 value.</param>
+        /// <param name="m41">The M41 value.</param>
+        /// <param name="m42">The M42 value.</param>
+        /// <returns>The matrix</returns>
+        private static Matrix CreateMatrix(float m11, float m12, float m21, float m22, float m31, float m32, float m41, float m42)
+        {
+            return new Matrix()
+            {
+                M11 = m11,
+                M12 = m12,
+                M21 = m21,
+                M22 = m22,
+                M31 = m31,
+                M32 = m32,
+                M33 = 1,
+                M41 = m41,
+                M42 = m42,
+                M44 = 1,
+            };
+        }
+    }
+}
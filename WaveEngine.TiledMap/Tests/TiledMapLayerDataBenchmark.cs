@@ -0,0 +1,309 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Text;
+using System.Xml.Linq;
+using NUnit.Framework;
+using TiledSharp;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Measures the packed tile storage of the layers of large maps
+    /// </summary>
+    /// <remarks>
+    /// The vertex patching of <see cref="TiledMapLayerRenderer"/> needs a scene and a graphics device,
+    /// so these benchmarks only measure the layer data side of the work.
+    /// </remarks>
+    [TestFixture]
+    [Category("Benchmark")]
+    public class TiledMapLayerDataBenchmark
+    {
+        /// <summary>
+        /// The number of tiles of the tileset of the generated maps
+        /// </summary>
+        private const int TilesetTileCount = 256;
+
+        /// <summary>
+        /// The number of edits measured per frame
+        /// </summary>
+        private const int EditCount = 10000;
+
+        /// <summary>
+        /// The number of frames measured
+        /// </summary>
+        private const int FrameCount = 100;
+
+        /// <summary>
+        /// Applies 10k random tile edits per frame to a 512x512 layer, reading back every edited tile
+        /// as the renderer does when it patches its vertices.
+        /// </summary>
+        [Test]
+        [Explicit]
+        public void RandomEditsOn512Map()
+        {
+            var random = new Random(29);
+            var layerData = LoadLayers(CreateRandomMap(random, 512, 512, 1), 512 * 512)[0];
+            var tiles = layerData.Tiles;
+
+            var edits = new int[EditCount];
+            var gids = new int[EditCount];
+            long checksum = 0;
+
+            var stopwatch = new Stopwatch();
+            for (int frame = 0; frame < FrameCount; frame++)
+            {
+                for (int i = 0; i < EditCount; i++)
+                {
+                    edits[i] = random.Next(tiles.Length);
+                    gids[i] = random.Next(TilesetTileCount + 1);
+                }
+
+                stopwatch.Start();
+                for (int i = 0; i < EditCount; i++)
+                {
+                    tiles[edits[i]] = LayerTile.Pack(gids[i], (gids[i] & 1) != 0, false, false);
+                }
+
+                for (int i = 0; i < EditCount; i++)
+                {
+                    int index = edits[i];
+                    var tile = new LayerTile(index % 512, index / 512, tiles[index], null, Vector2.Zero);
+                    checksum += tile.Id + (tile.HorizontalFlip ? 1 : 0);
+                }
+
+                stopwatch.Stop();
+            }
+
+            Assert.AreNotEqual(0, checksum);
+            double seconds = stopwatch.Elapsed.TotalSeconds;
+            TestContext.Progress.WriteLine("Edits: {0:F4} ms per {1} edits", stopwatch.Elapsed.TotalMilliseconds / FrameCount, EditCount);
+            TestContext.Progress.WriteLine("Edits: {0:N0} per second", (EditCount * (double)FrameCount) / seconds);
+        }
+
+        /// <summary>
+        /// Loads the layers of a 1000x1000 map as packed data and as one object per tile,
+        /// the storage used before, and compares their load time and retained memory.
+        /// </summary>
+        [Test]
+        [Explicit]
+        public void PackedAgainstPerTileObjectsOn1000Map()
+        {
+            const int Size = 1000;
+            var tmxMap = Parse(CreateRandomMap(new Random(30), Size, Size, 2));
+
+            long memory = GC.GetTotalMemory(true);
+            var stopwatch = Stopwatch.StartNew();
+            var packed = new TiledMapLayerData[tmxMap.Layers.Count];
+            for (int i = 0; i < packed.Length; i++)
+            {
+                packed[i] = new TiledMapLayerData(tmxMap.Layers[i], Size * Size);
+            }
+
+            stopwatch.Stop();
+            long packedMemory = GC.GetTotalMemory(true) - memory;
+            double packedTime = stopwatch.Elapsed.TotalMilliseconds;
+
+            memory = GC.GetTotalMemory(true);
+            stopwatch.Restart();
+            var perTile = new List<PerTileLayer>();
+            for (int i = 0; i < tmxMap.Layers.Count; i++)
+            {
+                perTile.Add(new PerTileLayer(tmxMap.Layers[i], Size, Size));
+            }
+
+            stopwatch.Stop();
+            long perTileMemory = GC.GetTotalMemory(true) - memory;
+            double perTileTime = stopwatch.Elapsed.TotalMilliseconds;
+
+            Assert.AreEqual(perTile[0].Tiles[0].Id, new LayerTile(0, 0, packed[0].Tiles[0], null, Vector2.Zero).Gid);
+            TestContext.Progress.WriteLine("Packed:   {0:F2} ms, {1:N0} bytes", packedTime, packedMemory);
+            TestContext.Progress.WriteLine("Per tile: {0:F2} ms, {1:N0} bytes", perTileTime, perTileMemory);
+            GC.KeepAlive(packed);
+            GC.KeepAlive(perTile);
+        }
+
+        /// <summary>
+        /// Creates a TMX map whose layers are filled with random tiles of a single tileset
+        /// </summary>
+        /// <param name="random">The random generator.</param>
+        /// <param name="width">The map width in tiles.</param>
+        /// <param name="height">The map height in tiles.</param>
+        /// <param name="layerCount">The number of tile layers.</param>
+        /// <returns>The TMX document</returns>
+        internal static string CreateRandomMap(Random random, int width, int height, int layerCount)
+        {
+            var builder = new StringBuilder();
+            builder.AppendFormat("<map version=\"1.0\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"{0}\" height=\"{1}\" tilewidth=\"16\" tileheight=\"16\">", width, height);
+            builder.Append("<tileset firstgid=\"1\" name=\"terrain\" tilewidth=\"16\" tileheight=\"16\">");
+            builder.Append("<image source=\"Content/terrain.png\" width=\"256\" height=\"256\"/>");
+            builder.Append("</tileset>");
+
+            for (int layer = 0; layer < layerCount; layer++)
+            {
+                builder.AppendFormat("<layer name=\"Layer{0}\" width=\"{1}\" height=\"{2}\"><data encoding=\"csv\">", layer, width, height);
+                for (int i = 0; i < width * height; i++)
+                {
+                    if (i > 0)
+                    {
+                        builder.Append(',');
+                    }
+
+                    builder.Append(LayerTile.Pack(random.Next(TilesetTileCount + 1), random.Next(8) == 0, false, false));
+                }
+
+                builder.Append("</data></layer>");
+            }
+
+            builder.Append("</map>");
+            return builder.ToString();
+        }
+
+        /// <summary>
+        /// Parses a TMX map
+        /// </summary>
+        /// <param name="tmx">The TMX document.</param>
+        /// <returns>The parsed map</returns>
+        internal static TmxMap Parse(string tmx)
+        {
+            using (var stream = new MemoryStream(Encoding.UTF8.GetBytes(tmx)))
+            {
+                return new TmxMap(new FileDocumentLoader(), stream, string.Empty);
+            }
+        }
+
+        /// <summary>
+        /// Parses a TMX map and loads its tile layers, as <see cref="TiledMap"/> does
+        /// </summary>
+        /// <param name="tmx">The TMX document.</param>
+        /// <param name="tileCount">The number of tiles of the map.</param>
+        /// <returns>The layer data</returns>
+        internal static TiledMapLayerData[] LoadLayers(string tmx, int tileCount)
+        {
+            var tmxMap = Parse(tmx);
+            var layers = new TiledMapLayerData[tmxMap.Layers.Count];
+            for (int i = 0; i < layers.Length; i++)
+            {
+                layers[i] = new TiledMapLayerData(tmxMap.Layers[i], tileCount);
+            }
+
+            return layers;
+        }
+
+        /// <summary>
+        /// A layer stored with one object per tile, as layers were stored before packing their tiles
+        /// </summary>
+        private class PerTileLayer
+        {
+            /// <summary>
+            /// The tiles indexed by their coordinates
+            /// </summary>
+            public PerTile[,] TileTable;
+
+            /// <summary>
+            /// The tiles of the layer
+            /// </summary>
+            public List<PerTile> Tiles;
+
+            /// <summary>
+            /// Initializes a new instance of the <see cref="PerTileLayer"/> class.
+            /// </summary>
+            /// <param name="tmxLayer">The TMX parsed layer.</param>
+            /// <param name="width">The map width in tiles.</param>
+            /// <param name="height">The map height in tiles.</param>
+            public PerTileLayer(TmxLayer tmxLayer, int width, int height)
+            {
+                this.TileTable = new PerTile[width, height];
+                this.Tiles = new List<PerTile>();
+
+                for (int i = 0; i < tmxLayer.Tiles.Count; i++)
+                {
+                    var tmxTile = tmxLayer.Tiles[i];
+                    var tile = new PerTile()
+                    {
+                        Id = tmxTile.Gid,
+                        X = i % width,
+                        Y = i / width,
+                        HorizontalFlip = tmxTile.HorizontalFlip,
+                        VerticalFlip = tmxTile.VerticalFlip,
+                        DiagonalFlip = tmxTile.DiagonalFlip,
+                    };
+
+                    this.TileTable[tile.X, tile.Y] = tile;
+                    this.Tiles.Add(tile);
+                }
+            }
+        }
+
+        /// <summary>
+        /// A tile with the fields of the former LayerTile class
+        /// </summary>
+        private class PerTile
+        {
+            /// <summary>
+            /// The tile ID
+            /// </summary>
+            public int Id;
+
+            /// <summary>
+            /// The X coordinate
+            /// </summary>
+            public int X;
+
+            /// <summary>
+            /// The Y coordinate
+            /// </summary>
+            public int Y;
+
+            /// <summary>
+            /// Whether the tile has horizontal flip
+            /// </summary>
+            public bool HorizontalFlip;
+
+            /// <summary>
+            /// Whether the tile has vertical flip
+            /// </summary>
+            public bool VerticalFlip;
+
+            /// <summary>
+            /// Whether the tile has diagonal flip
+            /// </summary>
+            public bool DiagonalFlip;
+
+            /// <summary>
+            /// The tileset
+            /// </summary>
+            public Tileset Tileset;
+
+            /// <summary>
+            /// The tileset tile
+            /// </summary>
+            public TilesetTile TilesetTile;
+
+            /// <summary>
+            /// The local position
+            /// </summary>
+            public Vector2 LocalPosition;
+        }
+
+        /// <summary>
+        /// Loads external TSX documents from the file system
+        /// </summary>
+        private class FileDocumentLoader : IDocumentLoader
+        {
+            /// <summary>
+            /// Loads the specified document.
+            /// </summary>
+            /// <param name="path">The path.</param>
+            /// <returns>XDocument</returns>
+            public XDocument Load(string path)
+            {
+                return XDocument.Load(path);
+            }
+        }
+    }
+}
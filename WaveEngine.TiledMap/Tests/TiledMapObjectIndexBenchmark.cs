@@ -0,0 +1,87 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using NUnit.Framework;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Measures the object queries of a layer with 100k objects, against a linear search
+    /// </summary>
+    [TestFixture]
+    [Category("Benchmark")]
+    public class TiledMapObjectIndexBenchmark
+    {
+        /// <summary>
+        /// The number of objects of the layer
+        /// </summary>
+        private const int ObjectCount = 100000;
+
+        /// <summary>
+        /// The number of queries measured
+        /// </summary>
+        private const int QueryCount = 10000;
+
+        /// <summary>
+        /// Builds the index of 100k objects and runs rectangle queries the size of a screen.
+        /// </summary>
+        [Test]
+        [Explicit]
+        public void QueryHundredThousandObjects()
+        {
+            var random = new Random(34);
+            var objects = TiledMapObjectIndexTests.CreateRandomObjects(random, ObjectCount, 20000, 64);
+
+            var stopwatch = Stopwatch.StartNew();
+            var index = new TiledMapObjectIndex(objects);
+            stopwatch.Stop();
+            TestContext.Progress.WriteLine("Build: {0:F2} ms", stopwatch.Elapsed.TotalMilliseconds);
+
+            var queries = new RectangleF[QueryCount];
+            for (int i = 0; i < queries.Length; i++)
+            {
+                queries[i] = new RectangleF((float)(random.NextDouble() * 20000), (float)(random.NextDouble() * 20000), 1280, 720);
+            }
+
+            var results = new List<TiledMapObject>();
+            long indexedCount = 0;
+            stopwatch.Restart();
+            for (int i = 0; i < queries.Length; i++)
+            {
+                results.Clear();
+                indexedCount += index.QueryRectangle(queries[i], results);
+            }
+
+            stopwatch.Stop();
+            double indexedTime = stopwatch.Elapsed.TotalMilliseconds;
+
+            long linearCount = 0;
+            stopwatch.Restart();
+            for (int i = 0; i < queries.Length; i++)
+            {
+                var query = queries[i];
+                for (int j = 0; j < objects.Count; j++)
+                {
+                    var bounds = objects[j].BoundingRectangle;
+                    if (bounds.X <= query.X + query.Width
+                     && query.X <= bounds.X + bounds.Width
+                     && bounds.Y <= query.Y + query.Height
+                     && query.Y <= bounds.Y + bounds.Height)
+                    {
+                        linearCount++;
+                    }
+                }
+            }
+
+            stopwatch.Stop();
+            double linearTime = stopwatch.Elapsed.TotalMilliseconds;
+
+            Assert.AreEqual(linearCount, indexedCount);
+            TestContext.Progress.WriteLine("Index:  {0:F4} ms per query", indexedTime / QueryCount);
+            TestContext.Progress.WriteLine("Linear: {0:F4} ms per query", linearTime / QueryCount);
+        }
+    }
+}
@@ -0,0 +1,171 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Xml.Linq;
+using NUnit.Framework;
+using TiledSharp;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="TiledMapObjectIndex"/>
+    /// </summary>
+    [TestFixture]
+    public class TiledMapObjectIndexTests
+    {
+        /// <summary>
+        /// Rectangle, point and radius queries return the same objects as a linear search, each one once.
+        /// </summary>
+        [Test]
+        public void QueriesMatchLinearSearch()
+        {
+            var random = new Random(34);
+            var objects = CreateRandomObjects(random, 2000, 4000, 32);
+
+            // A few objects much bigger than the rest, which are kept out of the grid
+            objects.Add(CreateObject(-1, 0, 0, 4000, 4000));
+            objects.Add(CreateObject(-2, 1000, -500, 64, 3000));
+
+            var index = new TiledMapObjectIndex(objects);
+            var results = new List<TiledMapObject>();
+
+            for (int i = 0; i < 500; i++)
+            {
+                var rectangle = new RectangleF(
+                    (float)(random.NextDouble() * 4400) - 200,
+                    (float)(random.NextDouble() * 4400) - 200,
+                    (float)(random.NextDouble() * 300),
+                    (float)(random.NextDouble() * 300));
+
+                results.Clear();
+                int added = index.QueryRectangle(rectangle, results);
+                Assert.AreEqual(results.Count, added);
+                CollectionAssert.AreEquivalent(objects.Where(o => Intersects(o.BoundingRectangle, rectangle)).ToList(), results);
+
+                var point = new Vector2(rectangle.X, rectangle.Y);
+                results.Clear();
+                index.QueryPoint(point, results);
+                CollectionAssert.AreEquivalent(objects.Where(o => Intersects(o.BoundingRectangle, new RectangleF(point.X, point.Y, 0, 0))).ToList(), results);
+
+                float radius = rectangle.Width;
+                results.Clear();
+                index.QueryRadius(point, radius, results);
+                CollectionAssert.AreEquivalent(objects.Where(o => DistanceSquared(o.BoundingRectangle, point) <= radius * radius).ToList(), results);
+            }
+        }
+
+        /// <summary>
+        /// A single object covering the whole layer doesn't make the grid coarser, so queries stay local.
+        /// </summary>
+        [Test]
+        public void LargeObjectDoesNotCoarsenGrid()
+        {
+            var objects = new List<TiledMapObject>();
+            for (int y = 0; y < 100; y++)
+            {
+                for (int x = 0; x < 100; x++)
+                {
+                    objects.Add(CreateObject(x + (y * 100), x * 16, y * 16, 8, 8));
+                }
+            }
+
+            var background = CreateObject(-1, 0, 0, 1600, 1600);
+            objects.Add(background);
+
+            var index = new TiledMapObjectIndex(objects);
+            var results = new List<TiledMapObject>();
+
+            index.QueryRectangle(new RectangleF(33, 33, 4, 4), results);
+            Assert.AreEqual(2, results.Count);
+            Assert.IsTrue(results.Contains(background));
+            Assert.IsTrue(results.Contains(objects[2 + (2 * 100)]));
+        }
+
+        /// <summary>
+        /// Queries on an empty index return nothing.
+        /// </summary>
+        [Test]
+        public void EmptyIndexReturnsNothing()
+        {
+            var index = new TiledMapObjectIndex(new List<TiledMapObject>());
+            var results = new List<TiledMapObject>();
+
+            Assert.AreEqual(0, index.QueryRectangle(new RectangleF(0, 0, 100, 100), results));
+            Assert.AreEqual(0, index.QueryRadius(Vector2.Zero, 100, results));
+            Assert.AreEqual(0, results.Count);
+        }
+
+        /// <summary>
+        /// Creates a rectangle object
+        /// </summary>
+        /// <param name="id">The object ID.</param>
+        /// <param name="x">The X position.</param>
+        /// <param name="y">The Y position.</param>
+        /// <param name="width">The width.</param>
+        /// <param name="height">The height.</param>
+        /// <returns>The object</returns>
+        internal static TiledMapObject CreateObject(int id, float x, float y, float width, float height)
+        {
+            var element = new XElement(
+                "object",
+                new XAttribute("id", id),
+                new XAttribute("x", x),
+                new XAttribute("y", y),
+                new XAttribute("width", width),
+                new XAttribute("height", height));
+
+            return new TiledMapObject(new TmxObject(element));
+        }
+
+        /// <summary>
+        /// Creates objects with random positions and sizes
+        /// </summary>
+        /// <param name="random">The random generator.</param>
+        /// <param name="count">The number of objects.</param>
+        /// <param name="area">The size of the square area that contains the objects.</param>
+        /// <param name="maxSize">The maximum object size.</param>
+        /// <returns>The objects</returns>
+        internal static List<TiledMapObject> CreateRandomObjects(Random random, int count, float area, float maxSize)
+        {
+            var objects = new List<TiledMapObject>(count);
+            for (int i = 0; i < count; i++)
+            {
+                objects.Add(CreateObject(
+                    i,
+                    (float)(random.NextDouble() * area),
+                    (float)(random.NextDouble() * area),
+                    (float)(random.NextDouble() * maxSize),
+                    (float)(random.NextDouble() * maxSize)));
+            }
+
+            return objects;
+        }
+
+        /// <summary>
+        /// Checks whether two rectangles intersect, including their borders
+        /// </summary>
+        /// <param name="a">The first rectangle.</param>
+        /// <param name="b">The second rectangle.</param>
+        /// <returns>True if the rectangles intersect</returns>
+        private static bool Intersects(RectangleF a, RectangleF b)
+        {
+            return a.X <= b.X + b.Width && b.X <= a.X + a.Width && a.Y <= b.Y + b.Height && b.Y <= a.Y + a.Height;
+        }
+
+        /// <summary>
+        /// Gets the squared distance from a point to a rectangle
+        /// </summary>
+        /// <param name="rectangle">The rectangle.</param>
+        /// <param name="point">The point.</param>
+        /// <returns>The squared distance, 0 if the point is inside the rectangle</returns>
+        private static float DistanceSquared(RectangleF rectangle, Vector2 point)
+        {
+            float dx = point.X - Math.Max(rectangle.X, Math.Min(point.X, rectangle.X + rectangle.Width));
+            float dy = point.Y - Math.Max(rectangle.Y, Math.Min(point.Y, rectangle.Y + rectangle.Height));
+            return (dx * dx) + (dy * dy);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+﻿// Copyright © 2018 Wave Engine S.L. All rights reserved. Use is subject to license terms.
+
+using System;
+using System.Collections.Generic;
+using NUnit.Framework;
+using WaveEngine.Common.Math;
+
+namespace WaveEngine.TiledMap.Tests
+{
+    /// <summary>
+    /// Tests of the object queries of <see cref="TiledMapObjectLayer"/>
+    /// </summary>
+    [TestFixture]
+    public class TiledMapObjectLayerTests
+    {
+        /// <summary>
+        /// A map with an object layer
+        /// </summary>
+        private const string ObjectLayerMap =
+            "<map version=\"1.0\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"2\" height=\"1\" tilewidth=\"16\" tileheight=\"16\">" +
+            "<objectgroup name=\"objects\">" +
+            "<object id=\"1\" x=\"0\" y=\"0\" width=\"10\" height=\"10\"/>" +
+            "</objectgroup>" +
+            "</map>";
+
+        /// <summary>
+        /// Objects added to or removed from the layer are found by the next query.
+        /// </summary>
+        [Test]
+        public void QueriesFollowAddedAndRemovedObjects()
+        {
+            var layer = CreateLayer();
+            var results = new List<TiledMapObject>();
+            Assert.AreEqual(1, layer.GetObjectsInRectangle(new RectangleF(0, 0, 100, 100), results));
+
+            var added = TiledMapObjectIndexTests.CreateObject(2, 50, 50, 10, 10);
+            layer.Objects.Add(added);
+            results.Clear();
+            Assert.AreEqual(1, layer.GetObjectsAtPoint(new Vector2(55, 55), results));
+            Assert.AreSame(added, results[0]);
+
+            layer.Objects.RemoveAt(0);
+            results.Clear();
+            Assert.AreEqual(1, layer.GetObjectsInRadius(Vector2.Zero, 100, results));
+            Assert.AreSame(added, results[0]);
+        }
+
+        /// <summary>
+        /// Objects replaced without changing the number of objects are found after refreshing the index.
+        /// </summary>
+        [Test]
+        public void RefreshIndexFollowsReplacedObjects()
+        {
+            var layer = CreateLayer();
+            var results = new List<TiledMapObject>();
+            Assert.AreEqual(1, layer.GetObjectsAtPoint(new Vector2(5, 5), results));
+
+            var replacement = TiledMapObjectIndexTests.CreateObject(2, 50, 50, 10, 10);
+            layer.Objects[0] = replacement;
+            layer.RefreshIndex();
+
+            results.Clear();
+            Assert.AreEqual(0, layer.GetObjectsAtPoint(new Vector2(5, 5), results));
+            Assert.AreEqual(1, layer.GetObjectsAtPoint(new Vector2(55, 55), results));
+            Assert.AreSame(replacement, results[0]);
+        }
+
+        /// <summary>
+        /// Creates the object layer of the test map
+        /// </summary>
+        /// <returns>The object layer</returns>
+        private static TiledMapObjectLayer CreateLayer()
+        {
+            var tmxMap = TiledMapCookerTests.Parse(ObjectLayerMap);
+            return new TiledMapObjectLayer(tmxMap.ObjectGroups[0]);
+        }
+    }
+}